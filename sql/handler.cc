@@ -6148,6 +6148,8 @@ handler::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
               for equality ranges to avoid the incurred overhead of 
               index dives in records_in_range().
            c) Index statistics is available.
+           The engine's value distribution for the key is used if it
+           has one, otherwise the average rows per key value.
            Ranges of the form "x IS NULL" will not use index statistics 
            because the number of rows with this value are likely to be 
            very different than the values in the index statistics.
@@ -6161,7 +6163,11 @@ handler::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
              (keyparts_used= my_count_bits(range.start_key.keypart_map)) &&
              table->key_info[keyno].rec_per_key[keyparts_used-1] && // 2c)
              !(range.range_flag & NULL_RANGE))
-      rows= table->key_info[keyno].rec_per_key[keyparts_used-1];
+    {
+      rows= records_in_eq_range_from_stats(keyno, &range.start_key);
+      if (rows == HA_POS_ERROR)
+        rows= table->key_info[keyno].rec_per_key[keyparts_used-1];
+    }
     else
     {
       DBUG_EXECUTE_IF("crash_records_in_range", DBUG_SUICIDE(););
@@ -720,6 +720,7 @@ enum enum_schema_tables
   SCH_TABLE_PRIVILEGES,
   SCH_TABLE_STATS,
   SCH_TEMPORARY_TABLES,
+  SCH_THREAD_POOL_GROUPS,
   SCH_THREAD_STATS,
   SCH_TRIGGERS,
   SCH_USER_PRIVILEGES,
@@ -2478,6 +2479,14 @@ public:
   void ft_end() { ft_handler=NULL; }
   virtual FT_INFO *ft_init_ext(uint flags, uint inx,String *key)
     { return NULL; }
+  /**
+    Like ft_init_ext(), for a search of which no more than limit rows
+    will be read in rank order. An engine may then leave out of the
+    result the rows ranked below the first limit ones.
+  */
+  virtual FT_INFO *ft_init_ext_with_limit(uint flags, uint inx, String *key,
+                                          ha_rows limit)
+    { return ft_init_ext(flags, inx, key); }
   virtual int ft_read(uchar *buf) { return HA_ERR_WRONG_COMMAND; }
 protected:
   /// @returns @see index_read_map().
@@ -2507,6 +2516,19 @@ public:
     { return HA_ERR_WRONG_COMMAND; }
   virtual ha_rows records_in_range(uint inx, key_range *min_key, key_range *max_key)
     { return (ha_rows) 10; }
+  /**
+    Estimate the number of rows that are equal to a key from the value
+    distribution that the engine keeps with its index statistics,
+    without reading the index.
+
+    @param inx  index number
+    @param key  key value to look up
+
+    @return the estimate, or HA_POS_ERROR if the engine has no value
+            distribution for the key
+  */
+  virtual ha_rows records_in_eq_range_from_stats(uint inx, key_range *key)
+    { return HA_POS_ERROR; }
   /*
     If HA_PRIMARY_KEY_REQUIRED_FOR_POSITION is set, then it sets ref
     (reference to the row, aka position, with the primary key given in
@@ -6308,7 +6308,7 @@ void Item_func_match::init_search(bool no_order)
 
   if (join_key && !no_order)
     flags|=FT_SORTED;
-  ft_handler=table->file->ft_init_ext(flags, key, ft_tmp);
+  ft_handler=table->file->ft_init_ext_with_limit(flags, key, ft_tmp, ft_limit);
 
   if (join_key)
     table->file->ft_handler=ft_handler;
@@ -1869,9 +1869,11 @@ public:
   Item *concat_ws;           // Item_func_concat_ws
   String value;              // value of concat_ws
   String search_value;       // key_item()'s value converted to cmp_collation
+  ha_rows ft_limit;          // rows read in rank order, @see set_limit_hint
 
   Item_func_match(List<Item> &a, uint b): Item_real_func(a), key(0), flags(b),
-       join_key(0), ft_handler(0), table(0), master(0), concat_ws(0) { }
+       join_key(0), ft_handler(0), table(0), master(0), concat_ws(0),
+       ft_limit(HA_POS_ERROR) { }
   void cleanup()
   {
     DBUG_ENTER("Item_func_match::cleanup");
@@ -1881,6 +1883,7 @@ public:
     ft_handler= 0;
     concat_ws= 0;
     table= 0;           // required by Item_func_match::eq()
+    ft_limit= HA_POS_ERROR;
     DBUG_VOID_RETURN;
   }
   enum Functype functype() const { return FT_FUNC; }
@@ -1897,6 +1900,18 @@ public:
   bool fix_index();
   void init_search(bool no_order);
 
+  /**
+     Promise that no more than limit rows of the search result will be
+     read, in rank order. Must be called before init_search().
+  */
+  void set_limit_hint(ha_rows limit)
+  {
+    if (master)
+      master->set_limit_hint(limit);
+    else
+      ft_limit= limit;
+  }
+
   /**
      Get number of matching rows from FT handler.
 
@@ -765,6 +765,7 @@ JOIN::optimize()
   if (!(select_options & SELECT_DESCRIBE) &&
       !select_lex->materialized_table_count)
   {
+    set_fts_limit_hint();
     init_ftfuncs(thd, select_lex, order);
     optimize_fts_query();
   }
@@ -9431,6 +9432,41 @@ JOIN::optimize_fts_limit_query()
 }
 
 
+/**
+   Pass the LIMIT of a single table query ordered on the rank of its JT_FT
+   access on to the FTS engine.
+
+   @note The hint is only given when all rows matched by the search are
+         candidates for the result, i.e. when the WHERE clause is the
+         MATCH expression itself and nothing but the ORDER BY and LIMIT
+         is applied to the matching rows.
+*/
+void
+JOIN::set_fts_limit_hint()
+{
+  if (primary_tables != 1 ||
+      join_tab[0].type != JT_FT ||
+      m_select_limit == HA_POS_ERROR ||
+      group_list || select_distinct || implicit_grouping ||
+      conds == NULL ||
+      order == NULL || order->next != NULL ||
+      order->direction != ORDER::ORDER_DESC)
+    return;
+
+  JOIN_TAB * const tab= &(join_tab[0]);
+  if ((tab->table->file->ha_table_flags() & HA_CAN_FULLTEXT_EXT) == 0)
+    return;
+
+  Item_func_match* fts_result= static_cast<Item_func_match*>(tab->keyuse->val);
+
+  if (conds->type() == Item::FUNC_ITEM &&
+      static_cast<Item_func*>(conds)->functype() == Item_func::FT_FUNC &&
+      fts_result->eq(conds, true) &&
+      fts_result->eq(*(order->item), true))
+    fts_result->set_limit_hint(m_select_limit);
+}
+
+
 /**
    For {semijoin,subquery} materialization: calculates various cost
    information, based on a plan in join->best_positions covering the
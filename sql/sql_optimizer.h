@@ -643,6 +643,12 @@ private:
    */
   void optimize_fts_limit_query();
 
+  /**
+     Tell the FTS engine how many rows of a JT_FT access ordered on
+     rank will be read, so that it need not rank the others.
+   */
+  void set_fts_limit_hint();
+
   /**
      Replace all Item_field objects with the given field name with the
      given item in all parts of the query.
@@ -57,6 +57,7 @@
 #include "sql_optimizer.h" // JOIN
 #include "global_threads.h"
 #include "my_default.h"
+#include "threadpool.h"
 
 #include <algorithm>
 using std::max;
@@ -3006,6 +3007,40 @@ int fill_schema_thread_stats(THD* thd, TABLE_LIST* tables, Item* cond)
   DBUG_RETURN(1);
 }
 
+// Sends the statistics of the thread pool groups back to the client.
+int fill_schema_thread_pool_groups(THD* thd, TABLE_LIST* tables, Item* cond)
+{
+  TABLE *table= tables->table;
+  TP_GROUP_STATISTICS stats;
+  DBUG_ENTER("fill_schema_thread_pool_groups");
+
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(1);
+
+  for (uint i= 0; tp_get_group_stats(i, &stats); i++)
+  {
+    restore_record(table, s->default_values);
+    table->field[0]->store(i, true);
+    table->field[1]->store(stats.connections, false);
+    table->field[2]->store(stats.threads, false);
+    table->field[3]->store(stats.active_threads, false);
+    table->field[4]->store(stats.waiting_threads, false);
+    table->field[5]->store(stats.queue_length, true);
+    table->field[6]->store(stats.high_prio_queue_length, true);
+    table->field[7]->store(stats.has_listener ? "YES" : "NO",
+                           stats.has_listener ? 3 : 2, system_charset_info);
+    table->field[8]->store(stats.is_stalled ? "YES" : "NO",
+                           stats.is_stalled ? 3 : 2, system_charset_info);
+    table->field[9]->store(stats.stalls, true);
+    table->field[10]->store(stats.stolen_events, true);
+    table->field[11]->store(stats.lost_events, true);
+
+    if (schema_table_store_record(thd, table))
+      DBUG_RETURN(1);
+  }
+  DBUG_RETURN(0);
+}
+
 // Sends the global table stats back to the client.
 int fill_schema_table_stats(THD* thd, TABLE_LIST* tables, Item* cond)
 {
@@ -8780,6 +8815,34 @@ ST_FIELD_INFO client_stats_fields_info[]=
   {0, 0, MYSQL_TYPE_STRING, 0, 0, 0, 0}
 };
 
+ST_FIELD_INFO thread_pool_groups_fields_info[]=
+{
+  {"GROUP_ID", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0,
+   MY_I_S_UNSIGNED, "Group_id", SKIP_OPEN_TABLE},
+  {"CONNECTIONS", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0, 0,
+   "Connections", SKIP_OPEN_TABLE},
+  {"THREADS", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0, 0,
+   "Threads", SKIP_OPEN_TABLE},
+  {"ACTIVE_THREADS", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0, 0,
+   "Active_threads", SKIP_OPEN_TABLE},
+  {"WAITING_THREADS", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0, 0,
+   "Waiting_threads", SKIP_OPEN_TABLE},
+  {"QUEUE_LENGTH", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0,
+   MY_I_S_UNSIGNED, "Queue_length", SKIP_OPEN_TABLE},
+  {"HIGH_PRIO_QUEUE_LENGTH", MY_INT32_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONG, 0,
+   MY_I_S_UNSIGNED, "High_prio_queue_length", SKIP_OPEN_TABLE},
+  {"HAS_LISTENER", 3, MYSQL_TYPE_STRING, 0, 0, "Has_listener",
+   SKIP_OPEN_TABLE},
+  {"IS_STALLED", 3, MYSQL_TYPE_STRING, 0, 0, "Is_stalled", SKIP_OPEN_TABLE},
+  {"STALLS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, "Stalls", SKIP_OPEN_TABLE},
+  {"STOLEN_EVENTS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, "Stolen_events", SKIP_OPEN_TABLE},
+  {"LOST_EVENTS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, "Lost_events", SKIP_OPEN_TABLE},
+  {0, 0, MYSQL_TYPE_STRING, 0, 0, 0, 0}
+};
+
 ST_FIELD_INFO thread_stats_fields_info[]=
 {
   {"THREAD_ID", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
@@ -9141,6 +9204,8 @@ ST_SCHEMA_TABLE schema_tables[]=
   {"TEMPORARY_TABLES", temporary_table_fields_info, create_schema_table,
    fill_temporary_tables, make_temporary_tables_old_format, 0, 2, 3, 0,
    OPEN_TABLE_ONLY|OPTIMIZE_I_S_TABLE},
+  {"THREAD_POOL_GROUPS", thread_pool_groups_fields_info, create_schema_table,
+    fill_schema_thread_pool_groups, make_old_format, 0, -1, -1, 0, 0},
   {"THREAD_STATISTICS", thread_stats_fields_info, create_schema_table,
     fill_schema_thread_stats, make_old_format, 0, -1, -1, 0, 0},
   {"TRIGGERS", triggers_fields_info, create_schema_table,
@@ -63,6 +63,35 @@ struct TP_STATISTICS
 
 extern TP_STATISTICS tp_stats;
 
+/*
+  Statistics of a single thread group
+*/
+struct TP_GROUP_STATISTICS
+{
+  /* Connections assigned to the group */
+  int connections;
+  /* Worker threads, including the listener */
+  int threads;
+  /* Threads that are executing requests */
+  int active_threads;
+  /* Threads that are blocked between thd_wait_begin()/thd_wait_end() */
+  int waiting_threads;
+  /* Events in the low and high priority queues */
+  uint queue_length;
+  uint high_prio_queue_length;
+  bool has_listener;
+  bool is_stalled;
+  /* Number of stalls detected by the timer */
+  ulonglong stalls;
+  /* Events this group took from the queues of other groups */
+  ulonglong stolen_events;
+  /* Events other groups took from the queues of this group */
+  ulonglong lost_events;
+};
+
+/* Used in INFORMATION_SCHEMA.THREAD_POOL_GROUPS */
+extern bool tp_get_group_stats(uint group_id, TP_GROUP_STATISTICS *stats);
+
 
 /* Functions to set threadpool parameters */
 extern void tp_set_min_threads(uint val);
@@ -118,6 +118,11 @@ struct connection_t
 
   THD *thd;
   thread_group_t *thread_group;
+  /*
+    Group of the worker that currently handles the connection. Differs from
+    thread_group if the event was stolen by a worker of another group.
+  */
+  thread_group_t *worker_group;
   connection_t *next_in_queue;
   connection_t **prev_in_queue;
   ulonglong abs_wait_timeout;
@@ -131,7 +136,7 @@ typedef I_P_List<connection_t,
                      I_P_List_adapter<connection_t,
                                       &connection_t::next_in_queue,
                                       &connection_t::prev_in_queue>,
-                     I_P_List_null_counter,
+                     I_P_List_counter,
                      I_P_List_fast_push_back<connection_t> >
 connection_queue_t;
 
@@ -155,6 +160,10 @@ struct thread_group_t
   int  shutdown_pipe[2];
   bool shutdown;
   bool stalled;
+  /* Stats for INFORMATION_SCHEMA.THREAD_POOL_GROUPS */
+  ulonglong stall_count;
+  ulonglong stolen_event_count;  /* events taken from other groups */
+  ulonglong lost_event_count;    /* events taken by other groups */
   
 } MY_ALIGNED(512);
 
@@ -483,6 +492,127 @@ static connection_t *queue_get(thread_group_t *thread_group)
 }
 
 
+/*
+  Take a pending event from another group.
+
+  Called by a worker that found nothing to do in its own group. Groups are
+  scanned round-robin starting after the worker's group; a group whose mutex
+  is busy is skipped, so two workers stealing from each other's groups cannot
+  deadlock. As in queue_get(), the high priority queue is drained first, and
+  the low priority queue is only looked at if the stealing group is allowed
+  to run one more low priority event.
+
+  If the other group has no listener, because its listener is itself
+  handling an event, the network events of that group are not read by
+  anyone until a worker of the group gets free. In that case a single event
+  is picked from its poll descriptor, without waiting, like get_event() does
+  for the own group.
+*/
+
+static connection_t *queue_steal(thread_group_t *thread_group)
+{
+  DBUG_ENTER("queue_steal");
+  uint own= thread_group - all_groups;
+  uint n_groups= group_count;
+
+  if (own >= n_groups)
+    DBUG_RETURN(NULL);
+
+  for (uint i= 1; i < n_groups; i++)
+  {
+    thread_group_t *victim= &all_groups[(own + i) % n_groups];
+    connection_t *c= NULL;
+
+    if (victim->queue.is_empty() && victim->high_prio_queue.is_empty()
+        && (victim->listener || !victim->connection_count))
+      continue;
+
+    if (mysql_mutex_trylock(&victim->mutex) != 0)
+      continue;
+
+    if (victim->shutdown)
+      c= NULL;
+    else if ((c= victim->high_prio_queue.front()))
+      victim->high_prio_queue.remove(c);
+    else if (!too_many_busy_threads(thread_group) &&
+             (c= victim->queue.front()))
+      victim->queue.remove(c);
+    else if (!victim->listener)
+    {
+      native_event nev;
+      if (io_poll_wait(victim->pollfd, &nev, 1, 0) == 1)
+      {
+        victim->io_event_count++;
+        c= (connection_t *)native_event_get_userdata(&nev);
+
+        if (connection_is_high_prio(c))
+          c->tickets--;
+        else if (too_many_busy_threads(thread_group))
+        {
+          c->tickets= c->thd->variables.threadpool_high_prio_tickets;
+          victim->queue.push_back(c);
+          c= NULL;
+        }
+      }
+    }
+
+    if (c)
+    {
+      victim->queue_event_count++;
+      victim->lost_event_count++;
+      victim->stalled= false;
+    }
+    mysql_mutex_unlock(&victim->mutex);
+
+    if (c)
+    {
+      thread_group->queue_event_count++;
+      thread_group->stolen_event_count++;
+      DBUG_RETURN(c);
+    }
+  }
+  DBUG_RETURN(NULL);
+}
+
+
+/*
+  Wake an idle worker of another group, so that it can steal events pending
+  in the given group. Only groups with a listener are considered, otherwise
+  the woken worker would become the listener instead of stealing.
+
+  @return 0 if a worker was woken, 1 otherwise
+*/
+
+static int wake_thief(thread_group_t *thread_group)
+{
+  DBUG_ENTER("wake_thief");
+  uint own= thread_group - all_groups;
+  uint n_groups= group_count;
+
+  for (uint i= 1; i < n_groups; i++)
+  {
+    thread_group_t *thief= &all_groups[(own + i) % n_groups];
+    int err= 1;
+
+    if (thief->waiting_threads.is_empty())
+      continue;
+
+    if (mysql_mutex_trylock(&thief->mutex) != 0)
+      continue;
+
+    if (!thief->shutdown && thief->listener &&
+        !too_many_active_threads(thief))
+      err= wake_thread(thief);
+
+    mysql_mutex_unlock(&thief->mutex);
+
+    if (!err)
+      DBUG_RETURN(0);
+  }
+  DBUG_RETURN(1);
+}
+
+
 /* 
   Handle wait timeout : 
   Find connections that have been idle for too long and kill them.
@@ -630,6 +760,8 @@ void check_stall(thread_group_t *thread_group)
   if (!thread_group->listener && !thread_group->io_event_count)
   {
     wake_or_create_thread(thread_group);
+    if (thread_group->connection_count)
+      wake_thief(thread_group);
     mysql_mutex_unlock(&thread_group->mutex);
     return;
   }
@@ -666,7 +798,10 @@ void check_stall(thread_group_t *thread_group)
   if (!thread_group->queue_event_count && !queues_are_empty(thread_group))
   {
     thread_group->stalled= true;
+    thread_group->stall_count++;
     wake_or_create_thread(thread_group);
+    /* Let an idle worker of another group help to drain the queue. */
+    wake_thief(thread_group);
   }
   
   /* Reset queue event count */
@@ -837,6 +972,15 @@ static connection_t * listener(worker_thread_t *current_thread,
         }
       }
     }
+    else
+    {
+      /*
+        The workers of this group are busy, and the queue was not empty
+        before. Rather than leaving the events queued until the timer
+        detects a stall, wake an idle worker of another group to steal them.
+      */
+      wake_thief(thread_group);
+    }
     mysql_mutex_unlock(&thread_group->mutex);
   }
 
@@ -1207,6 +1351,11 @@ static connection_t *get_event(worker_thread_t *current_thread,
           break;
         }
       }
+
+      /* Help other groups with their queues before going to sleep. */
+      connection= queue_steal(thread_group);
+      if (connection)
+        break;
     }
 
     /* And now, finally sleep */ 
@@ -1266,7 +1415,6 @@ static void wait_begin(thread_group_t *thread_group)
   thread_group->waiting_thread_count++;
 
   DBUG_ASSERT(thread_group->active_thread_count >=0);
-  DBUG_ASSERT(thread_group->connection_count > 0);
 
 #ifdef THREADPOOL_CREATE_THREADS_ON_WAIT
   if ((thread_group->active_thread_count == 0) && 
@@ -1316,6 +1464,7 @@ static connection_t *alloc_connection(THD *thd)
     connection->bound_to_poll_descriptor= false;
     connection->abs_wait_timeout= ULONGLONG_MAX;
     connection->tickets = 0;
+    connection->worker_group= NULL;
   }
   DBUG_RETURN(connection);
 }
@@ -1410,7 +1559,7 @@ void tp_wait_begin(THD *thd, int type)
   {
     DBUG_ASSERT(!connection->waiting);
     connection->waiting= true;
-    wait_begin(connection->thread_group);
+    wait_begin(connection->worker_group);
   }
   DBUG_VOID_RETURN;
 }
@@ -1430,7 +1579,7 @@ void tp_wait_end(THD *thd)
   {
     DBUG_ASSERT(connection->waiting);
     connection->waiting = false;
-    wait_end(connection->thread_group);
+    wait_end(connection->worker_group);
   }
   DBUG_VOID_RETURN;
 }
@@ -1614,6 +1763,11 @@ static void *worker_main(void *param)
     if (!connection)
       break;
     this_thread.event_count++;
+    /*
+      Waits are accounted in the group of the worker, which is not the group
+      of the connection if the event was stolen.
+    */
+    connection->worker_group= thread_group;
     handle_event(connection);
   }
 
@@ -1744,6 +1898,40 @@ int tp_get_idle_thread_count()
 }
 
 
+/**
+ Get statistics of a thread group for INFORMATION_SCHEMA.THREAD_POOL_GROUPS.
+
+ @param group_id - index of the group
+ @param stats - out: statistics of the group
+
+ @return false if there is no such group, true otherwise
+*/
+
+bool tp_get_group_stats(uint group_id, TP_GROUP_STATISTICS *stats)
+{
+  if (!threadpool_started || group_id >= group_count)
+    return false;
+
+  thread_group_t *group= &all_groups[group_id];
+
+  mysql_mutex_lock(&group->mutex);
+  stats->connections= group->connection_count;
+  stats->threads= group->thread_count;
+  stats->active_threads= group->active_thread_count;
+  stats->waiting_threads= group->waiting_thread_count;
+  stats->queue_length= group->queue.elements();
+  stats->high_prio_queue_length= group->high_prio_queue.elements();
+  stats->has_listener= (group->listener != NULL);
+  stats->is_stalled= group->stalled;
+  stats->stalls= group->stall_count;
+  stats->stolen_events= group->stolen_event_count;
+  stats->lost_events= group->lost_event_count;
+  mysql_mutex_unlock(&group->mutex);
+
+  return true;
+}
+
+
 /* Report threadpool problems */
 
 /** 
@@ -761,3 +761,13 @@ int tp_get_idle_thread_count()
   return 0;
 }
 
+
+
+/**
+ Windows implementation does not use thread groups, thus
+ INFORMATION_SCHEMA.THREAD_POOL_GROUPS is always empty.
+*/
+bool tp_get_group_stats(uint group_id, TP_GROUP_STATISTICS *stats)
+{
+  return false;
+}
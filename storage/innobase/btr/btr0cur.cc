@@ -1171,6 +1171,98 @@ exit_loop:
 	}
 }
 
+/**********************************************************************//**
+Positions a cursor on the last user record of the rightmost leaf page of
+an index, using the page remembered by btr_cur_store_append_hint() instead
+of descending the tree. The page is x-latched optimistically: the hint is
+rejected if the page was freed, evicted, reorganized or split since it was
+stored. Used for appending records in ascending key order.
+@return true if the cursor was positioned and the page x-latched in mtr;
+false if the caller must search the tree */
+UNIV_INTERN
+bool
+btr_cur_open_at_append_hint(
+/*========================*/
+	dict_index_t*		index,	/*!< in: index */
+	btr_append_hint_t*	hint,	/*!< in/out: append hint; reset if
+					it is no longer valid */
+	btr_cur_t*		cursor,	/*!< out: cursor */
+	mtr_t*			mtr)	/*!< in/out: mini-transaction */
+{
+	buf_block_t*	block = hint->block;
+	const page_t*	page;
+
+	ut_ad(!dict_index_is_ibuf(index));
+
+	if (block == NULL) {
+		return(false);
+	}
+
+	/* Freeing or evicting the page, as well as reorganizing it,
+	increments the modify clock.  A buffer pool resize may have
+	freed the block descriptor itself. */
+	if (buf_pool_is_obsolete(hint->withdraw_clock)
+	    || !buf_page_optimistic_get(RW_X_LATCH, block, hint->modify_clock,
+					__FILE__, __LINE__, mtr)) {
+		hint->block = NULL;
+		return(false);
+	}
+
+	page = buf_block_get_frame(block);
+
+	/* A split of the page does not move its existing records,
+	but it makes the page lose its place as the rightmost leaf. */
+	if (buf_block_get_space(block) != dict_index_get_space(index)
+	    || btr_page_get_index_id(page) != index->id
+	    || !page_is_leaf(page)
+	    || btr_page_get_next(page, mtr) != FIL_NULL) {
+
+		mtr_memo_release(mtr, block, MTR_MEMO_PAGE_X_FIX);
+		hint->block = NULL;
+		return(false);
+	}
+
+	buf_block_dbg_add_level(block, SYNC_TREE_NODE);
+
+	page_cur_position(page_rec_get_prev_const(page_get_supremum_rec(page)),
+			  block, btr_cur_get_page_cur(cursor));
+
+	cursor->index = index;
+	cursor->flag = BTR_CUR_BINARY;
+
+	return(true);
+}
+
+/**********************************************************************//**
+Remembers the page of a record that was just inserted for the next call
+of btr_cur_open_at_append_hint(). The hint is only stored if the record
+is the last user record of the rightmost leaf page, and reset otherwise. */
+UNIV_INTERN
+void
+btr_cur_store_append_hint(
+/*======================*/
+	btr_append_hint_t*	hint,	/*!< out: append hint */
+	buf_block_t*		block,	/*!< in: x-latched leaf page */
+	const rec_t*		rec,	/*!< in: record on block */
+	mtr_t*			mtr)	/*!< in: mini-transaction */
+{
+	const page_t*	page = buf_block_get_frame(block);
+
+	ut_ad(page_align(rec) == page);
+	ut_ad(mtr_memo_contains(mtr, block, MTR_MEMO_PAGE_X_FIX));
+
+	if (page_is_leaf(page)
+	    && btr_page_get_next(page, mtr) == FIL_NULL
+	    && page_rec_is_supremum(page_rec_get_next_const(rec))) {
+
+		hint->block = block;
+		hint->modify_clock = buf_block_get_modify_clock(block);
+		hint->withdraw_clock = buf_withdraw_clock;
+	} else {
+		hint->block = NULL;
+	}
+}
+
 /*==================== B-TREE INSERT =========================*/
 
 /*************************************************************//**
@@ -173,6 +173,7 @@ btr_pcur_store_position(
 
 	cursor->block_when_stored = block;
 	cursor->modify_clock = buf_block_get_modify_clock(block);
+	cursor->withdraw_clock = buf_withdraw_clock;
 }
 
 /**************************************************************//**
@@ -271,10 +272,13 @@ btr_pcur_restore_position_func(
 	    || UNIV_LIKELY(latch_mode == BTR_MODIFY_LEAF)) {
 		/* Try optimistic restoration. */
 
-		if (buf_page_optimistic_get(latch_mode,
-					    cursor->block_when_stored,
-					    cursor->modify_clock,
-					    file, line, mtr)) {
+		/* The block may have been freed by a buffer pool
+		resize since the position was stored. */
+		if (!buf_pool_is_obsolete(cursor->withdraw_clock)
+		    && buf_page_optimistic_get(latch_mode,
+					       cursor->block_when_stored,
+					       cursor->modify_clock,
+					       file, line, mtr)) {
 			cursor->pos_state = BTR_PCUR_IS_POSITIONED;
 			cursor->latch_mode = latch_mode;
 
@@ -366,6 +370,7 @@ btr_pcur_restore_position_func(
 			cursor->modify_clock =
 				buf_block_get_modify_clock(
 					cursor->block_when_stored);
+			cursor->withdraw_clock = buf_withdraw_clock;
 			cursor->old_stored = BTR_PCUR_OLD_STORED;
 
 			mem_heap_free(heap);
@@ -193,6 +193,17 @@ btr_search_sys_create(
 	btr_search_sys->hash_tables = (hash_table_t **)
 		mem_alloc(sizeof(hash_table_t *) * btr_search_index_num);
 
+	btr_search_sys->versions = (btr_search_version_t*)
+		ut_malloc(sizeof(btr_search_version_t) * btr_search_index_num);
+
+	btr_search_sys->readers = (btr_search_reader_t*)
+		ut_malloc(sizeof(btr_search_reader_t)
+			  * BTR_SEARCH_N_READER_SLOTS);
+
+	for (i = 0; i < BTR_SEARCH_N_READER_SLOTS; i++) {
+		btr_search_sys->readers[i].n_readers = 0;
+	}
+
 	for (i = 0; i < btr_search_index_num; i++) {
 
 		rw_lock_create(btr_search_latch_key,
@@ -201,6 +212,8 @@ btr_search_sys_create(
 		btr_search_sys->hash_tables[i]
 			= ha_create(hash_size, 0, MEM_HEAP_FOR_BTR_SEARCH, 0);
 
+		btr_search_sys->versions[i].version = 0;
+
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 		btr_search_sys->hash_tables[i]->adaptive = TRUE;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
@@ -231,6 +244,10 @@ btr_search_sys_free(void)
 
 	mem_free(btr_search_sys->hash_tables);
 
+	ut_free(btr_search_sys->versions);
+
+	ut_free(btr_search_sys->readers);
+
 	mem_free(btr_search_sys);
 	btr_search_sys = NULL;
 }
@@ -259,7 +276,32 @@ btr_search_disable_ref_count(
 }
 
 /********************************************************************//**
-Disable the adaptive hash search system and empty the index. */
+Waits until the lookups that search the adaptive hash index without its
+latch, and that may have started before btr_search_enabled was reset,
+have finished. */
+static
+void
+btr_search_wait_for_readers(void)
+/*=============================*/
+{
+	ut_ad(!btr_search_enabled);
+
+	for (ulint i = 0; i < BTR_SEARCH_N_READER_SLOTS; i++) {
+		/* The atomic read is a full memory barrier: lookups
+		that register themselves from now on will see
+		btr_search_enabled == FALSE. */
+		while (os_atomic_increment_ulint(
+			       &btr_search_sys->readers[i].n_readers, 0)) {
+			os_thread_yield();
+		}
+	}
+}
+
+/********************************************************************//**
+Disable the adaptive hash search system and empty the index. The memory
+of the hash nodes is not freed before the lookups that do not hold the
+latch have finished, so buf_pool_resize() may also free the buffer pool
+chunks once this has returned. */
 UNIV_INTERN
 void
 btr_search_disable(void)
@@ -273,6 +315,8 @@ btr_search_disable(void)
 
 	btr_search_enabled = FALSE;
 
+	btr_search_wait_for_readers();
+
 	/* Clear the index->search_info->ref_count of every index in
 	the data dictionary cache. */
 	for (table = UT_LIST_GET_FIRST(dict_sys->table_LRU); table;
@@ -302,12 +346,19 @@ btr_search_disable(void)
 }
 
 /********************************************************************//**
-Enable the adaptive hash search system. */
+Enable the adaptive hash search system, unless the buffer pool is
+being resized. */
 UNIV_INTERN
 void
 btr_search_enable(void)
 /*====================*/
 {
+	if (srv_buf_pool_old_size != srv_buf_pool_size) {
+		/* buf_pool_resize() enables the adaptive hash index
+		again when it has finished. */
+		return;
+	}
+
 	btr_search_x_lock_all();
 
 	btr_search_enabled = TRUE;
@@ -702,11 +753,11 @@ btr_search_info_update_slow(
 		btr_search_n_hash_fail++;
 #endif /* UNIV_SEARCH_PERF_STAT */
 
-		rw_lock_x_lock(btr_search_get_latch(cursor->index));
+		btr_search_x_lock(cursor->index);
 
 		btr_search_update_hash_ref(info, block, cursor);
 
-		rw_lock_x_unlock(btr_search_get_latch(cursor->index));
+		btr_search_x_unlock(cursor->index);
 	}
 
 	if (build_index) {
@@ -883,6 +934,154 @@ exit_func:
 	return(success);
 }
 
+/******************************************************************//**
+Registers a lookup that searches the adaptive hash index without the
+latch, see btr_search_wait_for_readers().
+@return the counter to pass to btr_search_reader_exit() */
+UNIV_INLINE
+btr_search_reader_t*
+btr_search_reader_enter(void)
+/*=========================*/
+{
+	btr_search_reader_t*	reader;
+
+	reader = &btr_search_sys->readers[
+		ut_hash_ulint(os_thread_pf(os_thread_get_curr_id()),
+			      BTR_SEARCH_N_READER_SLOTS)];
+
+	/* This is a full memory barrier: btr_search_enabled is read
+	after the lookup has been registered. */
+	os_atomic_increment_ulint(&reader->n_readers, 1);
+
+	return(reader);
+}
+
+/******************************************************************//**
+Unregisters a lookup registered with btr_search_reader_enter(). */
+UNIV_INLINE
+void
+btr_search_reader_exit(
+/*===================*/
+	btr_search_reader_t*	reader)	/*!< in: counter of the lookup */
+{
+	os_atomic_decrement_ulint(&reader->n_readers, 1);
+}
+
+/******************************************************************//**
+Looks up a record in the adaptive hash index without acquiring the
+partition latch, and latches the page of the record. The hash chain is
+read while the hash table may be modified concurrently: the result is
+valid only if the partition version was even and did not change during
+the lookup. Because pages are removed from the hash index before they
+are freed or evicted, the block of the record is then a file page, which
+is buffer-fixed before its state can change. The version is checked
+once more after the page latch has been acquired, so that the record
+was not moved or deleted meanwhile.
+@return TRUE if the lookup was validated, FALSE if a concurrent
+modification of the hash table interfered and the caller should retry
+holding the latch */
+static
+ibool
+btr_search_guess_on_hash_nolatch(
+/*=============================*/
+	const dict_index_t*	index,	/*!< in: index */
+	ulint			fold,	/*!< in: folded value of the key */
+	ulint			latch_mode,/*!< in: BTR_SEARCH_LEAF, ... */
+	const rec_t**		rec,	/*!< out: record found, or NULL */
+	buf_block_t**		block,	/*!< out: block of the record,
+					latched in latch_mode in mtr */
+	mtr_t*			mtr)	/*!< in/out: mtr */
+{
+	const volatile ha_node_t*	node;
+	const rec_t*			data	= NULL;
+	buf_block_t*			found;
+	ulint				version;
+	ibool				success;
+
+	version = btr_search_get_version(index);
+
+	if (UNIV_UNLIKELY(version & 1)) {
+		/* The hash table is being modified. */
+		return(FALSE);
+	}
+
+	os_rmb;
+
+	*rec = NULL;
+
+	if (UNIV_UNLIKELY(!btr_search_enabled)) {
+		/* The hash tables are empty. */
+		return(btr_search_get_version(index) == version);
+	}
+
+	node = ha_chain_get_first(btr_search_get_hash_table(index), fold);
+
+	while (node) {
+		ulint				node_fold	= node->fold;
+		const rec_t*			node_data	= node->data;
+		const volatile ha_node_t*	next		= node->next;
+
+		os_rmb;
+
+		/* Do not follow the next pointer unless the node was
+		consistent. The memory of freed nodes stays mapped, because
+		the hash table heap blocks are returned to the buffer pool,
+		and btr_search_disable() waits for this lookup to finish
+		before the blocks may be withdrawn from it. */
+		if (UNIV_UNLIKELY(btr_search_get_version(index) != version)) {
+			return(FALSE);
+		}
+
+		if (node_fold == fold) {
+			data = node_data;
+			break;
+		}
+
+		node = next;
+	}
+
+	if (UNIV_UNLIKELY(!data)) {
+		return(TRUE);
+	}
+
+	found = buf_block_align(data);
+
+	mutex_enter(&found->mutex);
+
+	if (UNIV_UNLIKELY(buf_block_get_state(found) != BUF_BLOCK_FILE_PAGE)
+	    || UNIV_UNLIKELY(btr_search_get_version(index) != version)) {
+		mutex_exit(&found->mutex);
+		return(FALSE);
+	}
+
+	/* Keep the block from being evicted until the page latch has
+	been acquired. */
+	buf_block_buf_fix_inc(found, __FILE__, __LINE__);
+
+	mutex_exit(&found->mutex);
+
+	success = buf_page_get_known_nowait(latch_mode, found, BUF_MAKE_YOUNG,
+					    __FILE__, __LINE__, mtr);
+
+	buf_block_buf_fix_dec(found);
+
+	if (UNIV_UNLIKELY(!success)) {
+		return(FALSE);
+	}
+
+	os_rmb;
+
+	if (UNIV_UNLIKELY(btr_search_get_version(index) != version)) {
+		btr_leaf_page_release(found, latch_mode, mtr);
+		return(FALSE);
+	}
+
+	*rec = data;
+	*block = found;
+
+	return(TRUE);
+}
+
 /******************************************************************//**
 Tries to guess the right search position based on the hash search info
 of the index. Note that if mode is PAGE_CUR_LE, which is used in inserts,
@@ -951,6 +1150,31 @@ btr_search_guess_on_hash(
 	cursor->flag = BTR_CUR_HASH;
 
 	if (UNIV_LIKELY(!has_search_latch)) {
+		btr_search_reader_t*	reader;
+		ibool			validated;
+
+		reader = btr_search_reader_enter();
+
+		validated = btr_search_guess_on_hash_nolatch(
+			index, fold, latch_mode, &rec, &block, mtr);
+
+		btr_search_reader_exit(reader);
+
+		if (UNIV_LIKELY(validated)) {
+
+			if (UNIV_UNLIKELY(!rec)) {
+				goto failure;
+			}
+
+			buf_block_dbg_add_level(block,
+						SYNC_TREE_NODE_FROM_HASH);
+
+			goto block_latched;
+		}
+
+		/* The hash table was being modified: search it while
+		holding the latch. */
+
 		rw_lock_s_lock(btr_search_get_latch(index));
 
 		if (UNIV_UNLIKELY(!btr_search_enabled)) {
@@ -985,6 +1209,7 @@ btr_search_guess_on_hash(
 		buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
 	}
 
+block_latched:
 	if (UNIV_UNLIKELY(buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE)) {
 		ut_ad(buf_block_get_state(block) == BUF_BLOCK_REMOVE_HASH);
 
@@ -1239,7 +1464,7 @@ next_rec:
 		mem_heap_free(heap);
 	}
 
-	rw_lock_x_lock(btr_search_get_latch(index));
+	btr_search_x_lock(index);
 
 	if (UNIV_UNLIKELY(!block->index)) {
 		/* Someone else has meanwhile dropped the hash index */
@@ -1255,7 +1480,7 @@ next_rec:
 		/* Someone else has meanwhile built a new hash index on the
 		page, with different parameters */
 
-		rw_lock_x_unlock(btr_search_get_latch(index));
+		btr_search_x_unlock(index);
 
 		mem_free(folds);
 		goto retry;
@@ -1286,14 +1511,14 @@ cleanup:
 			"InnoDB: the hash index to a page of %s,"
 			" still %lu hash nodes remain.\n",
 			index->name, (ulong) block->n_pointers);
-		rw_lock_x_unlock(btr_search_get_latch(index));
+		btr_search_x_unlock(index);
 
 		ut_ad(btr_search_validate());
 	} else {
-		rw_lock_x_unlock(btr_search_get_latch(index));
+		btr_search_x_unlock(index);
 	}
 #else /* UNIV_AHI_DEBUG || UNIV_DEBUG */
-	rw_lock_x_unlock(btr_search_get_latch(index));
+	btr_search_x_unlock(index);
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 
 	mem_free(folds);
@@ -1301,7 +1526,9 @@ cleanup:
 
 /********************************************************************//**
 Drops a possible page hash index when a page is evicted from the buffer pool
-or freed in a file segment. */
+or freed in a file segment. If the page is in the buffer pool, also
+increments its modify clock, so that optimistic latching of the freed page,
+e.g. by btr_cur_open_at_append_hint(), fails. */
 UNIV_INTERN
 void
 btr_search_drop_page_hash_when_freed(
@@ -1326,6 +1553,13 @@ btr_search_drop_page_hash_when_freed(
 				 BUF_PEEK_IF_IN_POOL, __FILE__, __LINE__,
 				 &mtr);
 
+	if (block) {
+		/* Not all pages are freed by btr_page_free(): the
+		file segments of a dropped or truncated index are
+		freed by fseg_free_step() without latching them. */
+		buf_block_modify_clock_inc(block);
+	}
+
 	if (block && block->index) {
 
 		buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
@@ -1491,7 +1725,7 @@ btr_search_build_page_hash_index(
 
 	btr_search_check_free_space_in_heap(index);
 
-	rw_lock_x_lock(btr_search_get_latch(index));
+	btr_search_x_lock(index);
 
 	if (UNIV_UNLIKELY(!btr_search_enabled)) {
 		goto exit_func;
@@ -1527,7 +1761,7 @@ btr_search_build_page_hash_index(
 	MONITOR_INC(MONITOR_ADAPTIVE_HASH_PAGE_ADDED);
 	MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_ROW_ADDED, n_cached);
 exit_func:
-	rw_lock_x_unlock(btr_search_get_latch(index));
+	btr_search_x_unlock(index);
 
 	mem_free(folds);
 	mem_free(recs);
@@ -1650,7 +1884,7 @@ btr_search_update_hash_on_delete(
 		mem_heap_free(heap);
 	}
 
-	rw_lock_x_lock(btr_search_get_latch(cursor->index));
+	btr_search_x_lock(cursor->index);
 
 	if (block->index) {
 		ut_a(block->index == index);
@@ -1663,7 +1897,7 @@ btr_search_update_hash_on_delete(
 		}
 	}
 
-	rw_lock_x_unlock(btr_search_get_latch(cursor->index));
+	btr_search_x_unlock(cursor->index);
 }
 
 /********************************************************************//**
@@ -1700,7 +1934,7 @@ btr_search_update_hash_node_on_insert(
 	ut_a(cursor->index == index);
 	ut_a(!dict_index_is_ibuf(index));
 
-	rw_lock_x_lock(btr_search_get_latch(cursor->index));
+	btr_search_x_lock(cursor->index);
 
 	if (!block->index) {
 
@@ -1723,9 +1957,9 @@ btr_search_update_hash_node_on_insert(
 		}
 
 func_exit:
-		rw_lock_x_unlock(btr_search_get_latch(cursor->index));
+		btr_search_x_unlock(cursor->index);
 	} else {
-		rw_lock_x_unlock(btr_search_get_latch(cursor->index));
+		btr_search_x_unlock(cursor->index);
 
 		btr_search_update_hash_on_insert(cursor);
 	}
@@ -1807,7 +2041,7 @@ btr_search_update_hash_on_insert(
 	} else {
 		if (left_side) {
 
-			rw_lock_x_lock(btr_search_get_latch(index));
+			btr_search_x_lock(index);
 
 			locked = TRUE;
 
@@ -1825,7 +2059,7 @@ btr_search_update_hash_on_insert(
 
 		if (!locked) {
 
-			rw_lock_x_lock(btr_search_get_latch(index));
+			btr_search_x_lock(index);
 
 			locked = TRUE;
 
@@ -1847,7 +2081,7 @@ check_next_rec:
 		if (!left_side) {
 
 			if (!locked) {
-				rw_lock_x_lock(btr_search_get_latch(index));
+				btr_search_x_lock(index);
 
 				locked = TRUE;
 
@@ -1866,7 +2100,7 @@ check_next_rec:
 
 		if (!locked) {
 
-			rw_lock_x_lock(btr_search_get_latch(index));
+			btr_search_x_lock(index);
 
 			locked = TRUE;
 
@@ -1893,7 +2127,7 @@ function_exit:
 		mem_heap_free(heap);
 	}
 	if (locked) {
-		rw_lock_x_unlock(btr_search_get_latch(index));
+		btr_search_x_unlock(index);
 	}
 }
 
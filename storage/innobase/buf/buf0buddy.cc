@@ -324,6 +324,19 @@ buf_buddy_alloc_zip(
 
 	buf = UT_LIST_GET_FIRST(buf_pool->zip_free[i]);
 
+	if (buf_pool->curr_size < buf_pool->old_size
+	    && UT_LIST_GET_LEN(buf_pool->withdraw)
+	    < buf_pool->withdraw_target) {
+
+		/* Do not hand out memory that buf_pool_resize()
+		is about to withdraw. */
+		while (buf != NULL
+		       && buf_frame_will_withdrawn(
+			       buf_pool, reinterpret_cast<byte*>(buf))) {
+			buf = UT_LIST_GET_NEXT(list, buf);
+		}
+	}
+
 	if (buf) {
 		buf_buddy_remove_from_free(buf_pool, buf, i);
 	} else if (i + 1 < BUF_BUDDY_SIZES) {
@@ -683,7 +696,8 @@ recombine:
 	/* Do not recombine blocks if there are few free blocks.
 	We may waste up to 15360*max_len bytes to free blocks
 	(1024 + 2048 + 4096 + 8192 = 15360) */
-	if (UT_LIST_GET_LEN(buf_pool->zip_free[i]) < 16) {
+	if (UT_LIST_GET_LEN(buf_pool->zip_free[i]) < 16
+	    && buf_pool->curr_size >= buf_pool->old_size) {
 		goto func_exit;
 	}
 
@@ -740,3 +754,122 @@ func_exit:
 			      i);
 	mutex_exit(&buf_pool->zip_free_mutex);
 }
+
+/**********************************************************************//**
+Try to reallocate a block, so that the memory it occupies can be
+withdrawn from the buffer pool.  The caller must hold
+buf_pool->LRU_list_mutex and must not hold buf_pool->zip_mutex or
+any block->mutex.
+@return	true if a destination block could be allocated, false if
+buf_pool->free was exhausted */
+UNIV_INTERN
+bool
+buf_buddy_realloc(
+/*==============*/
+	buf_pool_t*	buf_pool,	/*!< in/out: buffer pool instance */
+	void*		buf,		/*!< in: block to be reallocated,
+					must be pointed to by the
+					buffer pool */
+	ulint		size)		/*!< in: block size,
+					up to UNIV_PAGE_SIZE */
+{
+	buf_block_t*	block	= NULL;
+	ulint		i	= buf_buddy_get_slot(size);
+	bool		relocated;
+
+	ut_ad(mutex_own(&buf_pool->LRU_list_mutex));
+	ut_ad(!mutex_own(&buf_pool->zip_mutex));
+	ut_ad(i <= BUF_BUDDY_SIZES);
+	ut_ad(i >= buf_buddy_get_slot(UNIV_ZIP_SIZE_MIN));
+
+	if (i < BUF_BUDDY_SIZES) {
+		/* Try to allocate from the buddy system. */
+		mutex_enter(&buf_pool->zip_free_mutex);
+		block = (buf_block_t*) buf_buddy_alloc_zip(buf_pool, i);
+
+		if (block == NULL) {
+			mutex_exit(&buf_pool->zip_free_mutex);
+		}
+	}
+
+	if (block == NULL) {
+		/* Try allocating from the buf_pool->free list. */
+		block = buf_LRU_get_free_only(buf_pool);
+
+		if (block == NULL) {
+			return(false);
+		}
+
+		buf_buddy_block_register(block);
+
+		mutex_enter(&buf_pool->zip_free_mutex);
+		block = (buf_block_t*) buf_buddy_alloc_from(
+			buf_pool, block->frame, i, BUF_BUDDY_SIZES);
+	}
+
+	buf_pool->buddy_stat[i].used++;
+
+	relocated = buf_buddy_relocate(buf_pool, buf, block, i);
+
+	mutex_exit(&buf_pool->zip_free_mutex);
+
+	/* Free whichever of the two blocks is not in use now. */
+	buf_buddy_free_low(buf_pool, relocated ? buf : block, i);
+
+	return(true);
+}
+
+/**********************************************************************//**
+Recombine the free blocks of buf_pool->zip_free[] that are located in
+the chunks being withdrawn, so that their page frames can be returned
+to the buffer pool.  The caller must hold buf_pool->LRU_list_mutex. */
+UNIV_INTERN
+void
+buf_buddy_condense_free(
+/*====================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	ut_ad(mutex_own(&buf_pool->LRU_list_mutex));
+	ut_ad(buf_pool->curr_size < buf_pool->old_size);
+
+	for (ulint i = buf_buddy_get_slot(UNIV_ZIP_SIZE_MIN);
+	     i < BUF_BUDDY_SIZES; i++) {
+		buf_buddy_free_t*	buf;
+rescan:
+		mutex_enter(&buf_pool->zip_free_mutex);
+
+		for (buf = UT_LIST_GET_FIRST(buf_pool->zip_free[i]);
+		     buf != NULL;
+		     buf = UT_LIST_GET_NEXT(list, buf)) {
+
+			buf_buddy_free_t*	buddy;
+
+			if (!buf_frame_will_withdrawn(
+				    buf_pool, reinterpret_cast<byte*>(buf))) {
+				continue;
+			}
+
+			buddy = reinterpret_cast<buf_buddy_free_t*>(
+				buf_buddy_get(reinterpret_cast<byte*>(buf),
+					      BUF_BUDDY_LOW << i));
+
+			if (buf_buddy_is_free(buddy, i)
+			    != BUF_BUDDY_STATE_FREE) {
+				continue;
+			}
+
+			/* Let buf_buddy_free_low() recombine the pair;
+			the merged block will be examined at i + 1. */
+			buf_buddy_remove_from_free(buf_pool, buf, i);
+			buf_pool->buddy_stat[i].used++;
+
+			mutex_exit(&buf_pool->zip_free_mutex);
+
+			buf_buddy_free_low(buf_pool, buf, i);
+
+			goto rescan;
+		}
+
+		mutex_exit(&buf_pool->zip_free_mutex);
+	}
+}
@@ -46,6 +46,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "ibuf0ibuf.h"
 #include "trx0undo.h"
 #include "log0log.h"
+#include "buf0dump.h"
 #endif /* !UNIV_HOTBACKUP */
 #include "srv0srv.h"
 #include "dict0dict.h"
@@ -62,6 +63,7 @@ Created 11/5/1995 Heikki Tuuri
 
 /* prototypes for new functions added to ha_innodb.cc */
 trx_t* innobase_get_trx();
+void innodb_set_buf_pool_size(ulint buf_pool_size);
 
 static inline
 void
@@ -140,15 +142,18 @@ The buffer frames have to be aligned so that the start memory
 address of a frame is divisible by the universal page size, which
 is a power of two.
 
-We intend to make the buffer buf_pool size on-line reconfigurable,
-that is, the buf_pool size can be changed without closing the database.
-Then the database administarator may adjust it to be bigger
-at night, for example. The control block array must
-contain enough control blocks for the maximum buffer buf_pool size
-which is used in the particular database.
-If the buf_pool size is cut, we exploit the virtual memory mechanism of
-the OS, and just refrain from using frames at high addresses. Then the OS
-can swap them to disk.
+The buf_pool size is on-line reconfigurable, that is, the buf_pool
+size can be changed without closing the database.  Each buffer pool
+instance consists of chunks of innodb_buffer_pool_chunk_size bytes,
+each with its own control block array.  buf_pool_resize() grows an
+instance by allocating new chunks.  When the size is cut, the blocks
+of the chunks at the end of buf_pool->chunks[] are first collected
+to buf_pool->withdraw: free blocks are taken from the free list, and
+the pages that occupy the other blocks are either evicted or relocated
+to blocks in the remaining chunks.  After that, the withdrawn chunks
+are freed while holding all the buf_pool mutexes.  Any block pointers
+that were obtained before a chunk was withdrawn are invalidated by
+incrementing buf_withdraw_clock, see buf_pool_is_obsolete().
 
 The control blocks containing file pages are put to a hash table
 according to the file address of the page.
@@ -276,6 +281,14 @@ static const ulint BUF_PAGE_READ_MAX_RETRIES = 100;
 /** The buffer pools of the database */
 UNIV_INTERN buf_pool_t*	buf_pool_ptr;
 
+/** true when withdrawing blocks from the chunks that a buffer pool
+resize is going to free */
+UNIV_INTERN volatile bool	buf_pool_withdrawing;
+
+/** incremented every time blocks have been withdrawn from the buffer
+pool, so that pointers to them cached before can be recognized */
+UNIV_INTERN volatile ulint	buf_withdraw_clock;
+
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
 static ulint	buf_dbg_counter	= 0; /*!< This is used to insert validation
 					operations in execution in the
@@ -347,8 +360,14 @@ buf_pool_get_oldest_modification(void)
 	lsn_t		oldest_lsn = 0;
 
 	/* When we traverse all the flush lists we don't want another
-	thread to add a dirty page to any flush list. */
-	if (srv_buf_pool_instances > 1)
+	thread to add a dirty page to any flush list. With
+	srv_log_concurrent_mtr_commit, pages are added without
+	log_flush_order_mutex and log_buf_pool_get_oldest_modification()
+	accounts for them instead. */
+	const bool	order_mutex = srv_buf_pool_instances > 1
+		&& !srv_log_concurrent_mtr_commit;
+
+	if (order_mutex)
 	log_flush_order_mutex_enter();
 
 	for (i = 0; i < srv_buf_pool_instances; i++) {
@@ -372,7 +391,7 @@ buf_pool_get_oldest_modification(void)
 		}
 	}
 
-	if (srv_buf_pool_instances > 1)
+	if (order_mutex)
 	log_flush_order_mutex_exit();
 
 	/* The returned answer may be out of date: the flush_list can
@@ -1086,6 +1105,7 @@ buf_block_init(
 	block->page.in_free_list = FALSE;
 	block->page.in_LRU_list = FALSE;
 	block->in_unzip_LRU_list = FALSE;
+	block->in_withdraw_list = FALSE;
 #endif /* UNIV_DEBUG */
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 	block->n_pointers = 0;
@@ -1224,6 +1244,27 @@ buf_chunk_init(
 	return(chunk);
 }
 
+/********************************************************************//**
+Frees a chunk of buffer frames allocated by buf_chunk_init(). */
+static
+void
+buf_chunk_free(
+/*===========*/
+	buf_chunk_t*	chunk)	/*!< in/out: chunk of buffers */
+{
+	buf_block_t*	block = chunk->blocks;
+
+	for (ulint i = chunk->size; i--; block++) {
+		mutex_free(&block->mutex);
+		rw_lock_free(&block->lock);
+#ifdef UNIV_SYNC_DEBUG
+		rw_lock_free(&block->debug_latch);
+#endif /* UNIV_SYNC_DEBUG */
+	}
+
+	os_mem_free_large(chunk->mem, chunk->mem_size);
+}
+
 #ifdef UNIV_DEBUG
 /*********************************************************************//**
 Finds a block in the given buffer chunk that points to a
@@ -1385,23 +1426,39 @@ buf_pool_init_instance(
 		     &buf_pool->flush_state_mutex, SYNC_BUF_FLUSH_STATE);
 
 	if (buf_pool_size > 0) {
-		buf_pool->n_chunks = 1;
+		buf_pool->n_chunks = buf_pool_size / srv_buf_pool_chunk_unit;
+		ut_a(buf_pool->n_chunks > 0);
 
-		buf_pool->chunks = chunk =
-			(buf_chunk_t*) mem_zalloc(sizeof *chunk);
+		/* The array is terminated by a zero-filled element,
+		see buf_block_align_instance() */
+		buf_pool->chunks = chunk = static_cast<buf_chunk_t*>(
+			mem_zalloc((buf_pool->n_chunks + 1) * sizeof *chunk));
+		buf_pool->chunks_old = NULL;
 
 		UT_LIST_INIT(buf_pool->free);
+		UT_LIST_INIT(buf_pool->withdraw);
+		buf_pool->withdraw_target = 0;
 
-		if (!buf_chunk_init(buf_pool, chunk, buf_pool_size)) {
-			mem_free(chunk);
-			mem_free(buf_pool);
+		buf_pool->curr_size = 0;
 
-			return(DB_ERROR);
-		}
+		do {
+			if (!buf_chunk_init(buf_pool, chunk,
+					    srv_buf_pool_chunk_unit)) {
+				while (--chunk >= buf_pool->chunks) {
+					buf_chunk_free(chunk);
+				}
+
+				mem_free(buf_pool->chunks);
+
+				return(DB_ERROR);
+			}
+
+			buf_pool->curr_size += chunk->size;
+		} while (++chunk < buf_pool->chunks + buf_pool->n_chunks);
 
 		buf_pool->instance_no = instance_no;
-		buf_pool->old_pool_size = buf_pool_size;
-		buf_pool->curr_size = chunk->size;
+		buf_pool->n_chunks_new = buf_pool->n_chunks;
+		buf_pool->old_size = buf_pool->curr_size;
 		buf_pool->read_ahead_area
 			= ut_min(64, ut_2_power_up(buf_pool->curr_size / 32));
 		buf_pool->curr_pool_size = buf_pool->curr_size * UNIV_PAGE_SIZE;
@@ -1493,18 +1550,15 @@ buf_pool_free_instance(
 	chunk = chunks + buf_pool->n_chunks;
 
 	while (--chunk >= chunks) {
-		buf_block_t* block = chunk->blocks;
-		for (i = 0; i < chunk->size; i++, block++) {
-			mutex_free(&block->mutex);
-			rw_lock_free(&block->lock);
-#ifdef UNIV_SYNC_DEBUG
-			rw_lock_free(&block->debug_latch);
-#endif
-		}
-		os_mem_free_large(chunk->mem, chunk->mem_size);
+		buf_chunk_free(chunk);
 	}
 
 	mem_free(buf_pool->chunks);
+
+	if (buf_pool->chunks_old != NULL) {
+		mem_free(buf_pool->chunks_old);
+	}
+
 	ha_clear(buf_pool->page_hash);
 	hash_table_free(buf_pool->page_hash);
 	hash_table_free(buf_pool->zip_hash);
@@ -1650,7 +1704,9 @@ buf_relocate(
 /*=========*/
 	buf_page_t*	bpage,	/*!< in/out: control block being relocated;
 				buf_page_get_state(bpage) must be
-				BUF_BLOCK_ZIP_DIRTY or BUF_BLOCK_ZIP_PAGE */
+				BUF_BLOCK_ZIP_DIRTY or BUF_BLOCK_ZIP_PAGE,
+				or BUF_BLOCK_FILE_PAGE when the buffer
+				pool is being shrunk */
 	buf_page_t*	dpage)	/*!< in/out: destination control block */
 {
 	buf_page_t*	b;
@@ -1678,10 +1734,13 @@ buf_relocate(
 	case BUF_BLOCK_POOL_WATCH:
 	case BUF_BLOCK_NOT_USED:
 	case BUF_BLOCK_READY_FOR_USE:
-	case BUF_BLOCK_FILE_PAGE:
 	case BUF_BLOCK_MEMORY:
 	case BUF_BLOCK_REMOVE_HASH:
 		ut_error;
+	case BUF_BLOCK_FILE_PAGE:
+		/* buf_page_realloc() */
+		ut_ad(buf_pool_withdrawing);
+		break;
 	case BUF_BLOCK_ZIP_DIRTY:
 	case BUF_BLOCK_ZIP_PAGE:
 		break;
@@ -1728,6 +1787,854 @@ buf_relocate(
 	HASH_INSERT(buf_page_t, hash, buf_pool->page_hash, fold, dpage);
 }
 
+/********************************************************************//**
+Determines if a block is in one of the chunks that the ongoing buffer
+pool resize is going to free.  The caller must hold one of the buffer
+pool mutexes that the resize acquires before it frees chunks.
+@return	true if the block will be withdrawn */
+UNIV_INTERN
+bool
+buf_block_will_withdrawn(
+/*=====================*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	const buf_block_t*	block)		/*!< in: block */
+{
+	const buf_chunk_t*	chunk;
+	const buf_chunk_t*	echunk;
+
+	ut_ad(buf_pool->curr_size < buf_pool->old_size);
+
+	chunk = buf_pool->chunks + buf_pool->n_chunks_new;
+	echunk = buf_pool->chunks + buf_pool->n_chunks;
+
+	for (; chunk < echunk; chunk++) {
+		if (block >= chunk->blocks
+		    && block < chunk->blocks + chunk->size) {
+
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/********************************************************************//**
+Determines if a frame is in one of the chunks that the ongoing buffer
+pool resize is going to free.  The caller must hold one of the buffer
+pool mutexes that the resize acquires before it frees chunks.
+@return	true if the frame will be withdrawn */
+UNIV_INTERN
+bool
+buf_frame_will_withdrawn(
+/*=====================*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	const byte*		ptr)		/*!< in: pointer to a frame */
+{
+	const buf_chunk_t*	chunk;
+	const buf_chunk_t*	echunk;
+
+	ut_ad(buf_pool->curr_size < buf_pool->old_size);
+
+	chunk = buf_pool->chunks + buf_pool->n_chunks_new;
+	echunk = buf_pool->chunks + buf_pool->n_chunks;
+
+	for (; chunk < echunk; chunk++) {
+		if (ptr >= chunk->blocks->frame
+		    && ptr < (chunk->blocks + chunk->size - 1)->frame
+		    + UNIV_PAGE_SIZE) {
+
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/********************************************************************//**
+Sets the global variable that feeds MySQL's
+innodb_buffer_pool_resize_status to the specified string, and writes it
+to the error log.  The format and the following parameters are the same
+as the ones used for printf(3). */
+static MY_ATTRIBUTE((nonnull, format(printf, 1, 2)))
+void
+buf_resize_status(
+/*==============*/
+	const char*	fmt,	/*!< in: format */
+	...)			/*!< in: extra parameters according to fmt */
+{
+	va_list	ap;
+
+	va_start(ap, fmt);
+
+	ut_vsnprintf(
+		export_vars.innodb_buffer_pool_resize_status,
+		sizeof(export_vars.innodb_buffer_pool_resize_status),
+		fmt, ap);
+
+	va_end(ap);
+
+	ib_logf(IB_LOG_LEVEL_INFO, "%s",
+		export_vars.innodb_buffer_pool_resize_status);
+}
+
+/********************************************************************//**
+Relocates a file page to a block that is not going to be withdrawn, and
+frees the block that the page occupied.  The caller must hold
+buf_pool->LRU_list_mutex.
+@return	false if buf_pool->free was exhausted */
+static
+bool
+buf_page_realloc(
+/*=============*/
+	buf_pool_t*	buf_pool,	/*!< in/out: buffer pool instance */
+	buf_block_t*	block)		/*!< in/out: block to relocate */
+{
+	buf_block_t*	new_block;
+	ulint		fold;
+	prio_rw_lock_t*	hash_lock;
+
+	ut_ad(mutex_own(&buf_pool->LRU_list_mutex));
+	ut_ad(buf_pool_withdrawing);
+	ut_ad(buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE);
+
+	new_block = buf_LRU_get_free_only(buf_pool);
+
+	if (new_block == NULL) {
+		return(false);
+	}
+
+	fold = buf_page_address_fold(block->page.space, block->page.offset);
+	hash_lock = buf_page_hash_lock_get(buf_pool, fold);
+
+	rw_lock_x_lock(hash_lock);
+	mutex_enter(&block->mutex);
+
+	if (!buf_page_can_relocate(&block->page) || block->index != NULL) {
+
+		rw_lock_x_unlock(hash_lock);
+		mutex_exit(&block->mutex);
+
+		mutex_enter(&new_block->mutex);
+		buf_LRU_block_free_non_file_page(new_block);
+		mutex_exit(&new_block->mutex);
+
+		return(true);
+	}
+
+	mutex_enter(&new_block->mutex);
+
+	memcpy(new_block->frame, block->frame, UNIV_PAGE_SIZE);
+
+	/* This copies block->page to new_block->page, and replaces
+	block with new_block in the LRU list and in the page_hash. */
+	buf_relocate(&block->page, &new_block->page);
+
+	/* relocate the unzip_LRU list */
+	if (block->page.zip.data != NULL) {
+		buf_block_t*	prev_block;
+
+		ut_ad(block->in_unzip_LRU_list);
+		ut_d(new_block->in_unzip_LRU_list = TRUE);
+
+		prev_block = UT_LIST_GET_PREV(unzip_LRU, block);
+		UT_LIST_REMOVE(unzip_LRU, buf_pool->unzip_LRU, block);
+		ut_d(block->in_unzip_LRU_list = FALSE);
+
+		if (prev_block != NULL) {
+			UT_LIST_INSERT_AFTER(unzip_LRU, buf_pool->unzip_LRU,
+					     prev_block, new_block);
+		} else {
+			UT_LIST_ADD_FIRST(unzip_LRU, buf_pool->unzip_LRU,
+					  new_block);
+		}
+
+		/* The compressed page now belongs to new_block. */
+		block->page.zip.data = NULL;
+		page_zip_set_size(&block->page.zip, 0);
+	} else {
+		ut_ad(!block->in_unzip_LRU_list);
+		ut_d(new_block->in_unzip_LRU_list = FALSE);
+	}
+
+	/* relocate buf_pool->flush_list */
+	if (block->page.oldest_modification) {
+		buf_flush_relocate_on_flush_list(
+			&block->page, &new_block->page);
+	}
+
+	ut_ad(block->index == NULL);
+	new_block->index = NULL;
+	new_block->n_hash_helps = 0;
+	new_block->n_fields = 1;
+	new_block->left_side = TRUE;
+	new_block->lock_hash_val = block->lock_hash_val;
+	new_block->check_index_page_at_flush
+		= block->check_index_page_at_flush;
+
+	/* Make any optimistic access to the old block fail. */
+	buf_block_modify_clock_inc(block);
+	memset(block->frame + FIL_PAGE_OFFSET, 0xff, 4);
+	memset(block->frame + FIL_PAGE_ARCH_LOG_NO_OR_SPACE_ID, 0xff, 4);
+	buf_block_set_state(block, BUF_BLOCK_REMOVE_HASH);
+
+	rw_lock_x_unlock(hash_lock);
+	mutex_exit(&new_block->mutex);
+
+	/* free the old block */
+	buf_block_set_state(block, BUF_BLOCK_MEMORY);
+	buf_LRU_block_free_non_file_page(block);
+
+	mutex_exit(&block->mutex);
+
+	return(true);
+}
+
+/********************************************************************//**
+Collects the blocks of the chunks to be freed to buf_pool->withdraw.
+Free blocks are taken from the free list, and the pages that occupy
+the other blocks are evicted or relocated.
+@return	true if the blocks could not be withdrawn yet and the caller
+should retry later */
+static
+bool
+buf_pool_withdraw_blocks(
+/*=====================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	buf_block_t*		block;
+	const buf_chunk_t*	chunk;
+	const buf_chunk_t*	echunk;
+	ulint			loop_count = 0;
+	const ulint		i = buf_pool->instance_no;
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"buffer pool %lu : start to withdraw the last %lu blocks.",
+		(ulong) i, (ulong) buf_pool->withdraw_target);
+
+	/* Minimize the buf_pool->zip_free[] lists */
+	mutex_enter(&buf_pool->LRU_list_mutex);
+	buf_buddy_condense_free(buf_pool);
+	mutex_exit(&buf_pool->LRU_list_mutex);
+
+	while (UT_LIST_GET_LEN(buf_pool->withdraw)
+	       < buf_pool->withdraw_target) {
+
+		ulint	count1 = 0;
+		ulint	count2 = 0;
+
+		/* Try to withdraw from the free list */
+		mutex_enter(&buf_pool->free_list_mutex);
+
+		block = reinterpret_cast<buf_block_t*>(
+			UT_LIST_GET_FIRST(buf_pool->free));
+
+		while (block != NULL
+		       && UT_LIST_GET_LEN(buf_pool->withdraw)
+		       < buf_pool->withdraw_target) {
+
+			buf_block_t*	next_block;
+
+			ut_ad(block->page.in_free_list);
+			ut_ad(!block->page.in_flush_list);
+			ut_ad(!block->page.in_LRU_list);
+			ut_a(!buf_page_in_file(&block->page));
+
+			next_block = reinterpret_cast<buf_block_t*>(
+				UT_LIST_GET_NEXT(list, &block->page));
+
+			if (buf_block_will_withdrawn(buf_pool, block)) {
+				UT_LIST_REMOVE(list, buf_pool->free,
+					       &block->page);
+				UT_LIST_ADD_LAST(list, buf_pool->withdraw,
+						 &block->page);
+				ut_d(block->page.in_free_list = FALSE);
+				ut_d(block->in_withdraw_list = TRUE);
+				count1++;
+			}
+
+			block = next_block;
+		}
+
+		mutex_exit(&buf_pool->free_list_mutex);
+
+		/* Evict pages from the tail of the LRU list, so that
+		blocks can be withdrawn or used for relocation. */
+		if (UT_LIST_GET_LEN(buf_pool->withdraw)
+		    < buf_pool->withdraw_target) {
+
+			buf_flush_LRU_and_wait(
+				buf_pool,
+				ut_max(buf_pool->withdraw_target
+				       - UT_LIST_GET_LEN(buf_pool->withdraw),
+				       static_cast<ulint>(srv_LRU_scan_depth)));
+		}
+
+		/* Relocate the pages and the compressed pages that
+		are in the area to be withdrawn. */
+		mutex_enter(&buf_pool->LRU_list_mutex);
+
+		buf_page_t*	bpage = UT_LIST_GET_FIRST(buf_pool->LRU);
+
+		while (bpage != NULL) {
+			ib_mutex_t*	block_mutex;
+			buf_page_t*	next_bpage;
+			void*		zip_data;
+			ulint		zip_size;
+			bool		file_page;
+			bool		can_relocate;
+
+			block_mutex = buf_page_get_mutex(bpage);
+			mutex_enter(block_mutex);
+
+			next_bpage = UT_LIST_GET_NEXT(LRU, bpage);
+			zip_data = bpage->zip.data;
+			zip_size = page_zip_get_size(&bpage->zip);
+			file_page = buf_page_get_state(bpage)
+				== BUF_BLOCK_FILE_PAGE;
+			can_relocate = buf_page_can_relocate(bpage);
+
+			mutex_exit(block_mutex);
+
+			if (zip_data != NULL && can_relocate
+			    && buf_frame_will_withdrawn(
+				    buf_pool,
+				    static_cast<const byte*>(zip_data))) {
+
+				if (!buf_buddy_realloc(buf_pool, zip_data,
+						       zip_size)) {
+					/* The free list was exhausted */
+					break;
+				}
+
+				count2++;
+			}
+
+			if (file_page && can_relocate
+			    && buf_block_will_withdrawn(
+				    buf_pool,
+				    reinterpret_cast<buf_block_t*>(bpage))) {
+
+				if (!buf_page_realloc(
+					    buf_pool,
+					    reinterpret_cast<buf_block_t*>(
+						    bpage))) {
+					/* The free list was exhausted */
+					break;
+				}
+
+				count2++;
+			}
+
+			/* Pages that are in use are left for the
+			next round. */
+			bpage = next_bpage;
+		}
+
+		mutex_exit(&buf_pool->LRU_list_mutex);
+
+		buf_resize_status(
+			"buffer pool %lu : withdrawing blocks. (%lu/%lu)",
+			(ulong) i,
+			(ulong) UT_LIST_GET_LEN(buf_pool->withdraw),
+			(ulong) buf_pool->withdraw_target);
+
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"buffer pool %lu : withdrew %lu blocks from free"
+			" list. Tried to relocate %lu pages (%lu/%lu).",
+			(ulong) i, (ulong) count1, (ulong) count2,
+			(ulong) UT_LIST_GET_LEN(buf_pool->withdraw),
+			(ulong) buf_pool->withdraw_target);
+
+		if (++loop_count >= 10) {
+			/* Give up for now; buf_pool_resize() will
+			retry after a while. */
+			ib_logf(IB_LOG_LEVEL_INFO,
+				"buffer pool %lu : will retry to withdraw"
+				" later.", (ulong) i);
+
+			return(true);
+		}
+	}
+
+	/* Confirm that all the blocks of the area were withdrawn */
+	chunk = buf_pool->chunks + buf_pool->n_chunks_new;
+	echunk = buf_pool->chunks + buf_pool->n_chunks;
+
+	for (; chunk < echunk; chunk++) {
+		block = chunk->blocks;
+
+		for (ulint j = chunk->size; j--; block++) {
+			ut_a(buf_block_get_state(block) == BUF_BLOCK_NOT_USED);
+			ut_ad(block->in_withdraw_list);
+		}
+	}
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"buffer pool %lu : withdrawn target %lu blocks.",
+		(ulong) i, (ulong) UT_LIST_GET_LEN(buf_pool->withdraw));
+
+	/* Invalidate the block pointers that were cached before
+	the blocks were withdrawn. */
+	++buf_withdraw_clock;
+	os_wmb;
+
+	return(false);
+}
+
+/********************************************************************//**
+Returns the blocks collected to buf_pool->withdraw to the free list,
+when the resize is aborted. */
+static
+void
+buf_pool_withdraw_cancel(
+/*=====================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	buf_page_t*	bpage;
+
+	mutex_enter(&buf_pool->LRU_list_mutex);
+	mutex_enter(&buf_pool->free_list_mutex);
+
+	while ((bpage = UT_LIST_GET_FIRST(buf_pool->withdraw)) != NULL) {
+		ut_ad(reinterpret_cast<buf_block_t*>(bpage)
+		      ->in_withdraw_list);
+		ut_d(reinterpret_cast<buf_block_t*>(bpage)
+		     ->in_withdraw_list = FALSE);
+
+		UT_LIST_REMOVE(list, buf_pool->withdraw, bpage);
+		UT_LIST_ADD_LAST(list, buf_pool->free, bpage);
+		ut_d(bpage->in_free_list = TRUE);
+	}
+
+	buf_pool->withdraw_target = 0;
+	buf_pool->curr_size = buf_pool->old_size;
+	buf_pool->n_chunks_new = buf_pool->n_chunks;
+
+	mutex_exit(&buf_pool->free_list_mutex);
+	mutex_exit(&buf_pool->LRU_list_mutex);
+}
+
+/********************************************************************//**
+Rebuilds buf_pool->page_hash and buf_pool->zip_hash for the current
+buffer pool size.  The caller must hold all the latches of the buffer
+pool instance. */
+static
+void
+buf_pool_resize_hash(
+/*=================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	hash_cell_t*	old_array;
+	ulint		n_old_cells;
+	hash_table_t*	new_zip_hash;
+
+	ut_ad(mutex_own(&buf_pool->LRU_list_mutex));
+	ut_ad(mutex_own(&buf_pool->zip_hash_mutex));
+
+	/* The page_hash keeps its rw-locks, see hash_resize_aligned() */
+	old_array = hash_resize_aligned(
+		buf_pool->page_hash, 2 * buf_pool->curr_size, &n_old_cells);
+
+	for (ulint i = 0; i < n_old_cells; i++) {
+		buf_page_t*	bpage;
+
+		bpage = static_cast<buf_page_t*>(old_array[i].node);
+
+		while (bpage != NULL) {
+			buf_page_t*	next = bpage->hash;
+			ulint		fold = buf_page_address_fold(
+				bpage->space, bpage->offset);
+
+			HASH_INSERT(buf_page_t, hash, buf_pool->page_hash,
+				    fold, bpage);
+
+			bpage = next;
+		}
+	}
+
+	ut_free(old_array);
+
+	new_zip_hash = hash_create(2 * buf_pool->curr_size);
+
+	for (ulint i = 0; i < hash_get_n_cells(buf_pool->zip_hash); i++) {
+		buf_page_t*	bpage;
+
+		bpage = static_cast<buf_page_t*>(
+			HASH_GET_FIRST(buf_pool->zip_hash, i));
+
+		while (bpage != NULL) {
+			buf_page_t*	next = static_cast<buf_page_t*>(
+				HASH_GET_NEXT(hash, bpage));
+			ulint		fold = BUF_POOL_ZIP_FOLD_BPAGE(bpage);
+
+			HASH_INSERT(buf_page_t, hash, new_zip_hash,
+				    fold, bpage);
+
+			bpage = next;
+		}
+	}
+
+	hash_table_free(buf_pool->zip_hash);
+	buf_pool->zip_hash = new_zip_hash;
+}
+
+/********************************************************************//**
+Resizes the buffer pool instances to srv_buf_pool_size. */
+static
+void
+buf_pool_resize(void)
+/*=================*/
+{
+	buf_pool_t*	buf_pool;
+	ulint		new_instance_size;
+	bool		ahi_was_enabled = false;
+	bool		warning = false;
+	ib_time_t	withdraw_started;
+	ulint		message_interval = 60;
+	ulint		retry_interval = 1;
+	bool		should_retry_withdraw;
+	char		now[32];
+
+	new_instance_size = srv_buf_pool_size / srv_buf_pool_instances
+		/ UNIV_PAGE_SIZE;
+
+	buf_resize_status("Resizing buffer pool from %lu to %lu"
+			  " (unit=%lu).",
+			  (ulong) srv_buf_pool_old_size,
+			  (ulong) srv_buf_pool_size,
+			  (ulong) srv_buf_pool_chunk_unit);
+
+	/* Set the new size of every instance */
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_pool = buf_pool_from_array(i);
+
+		mutex_enter(&buf_pool->LRU_list_mutex);
+		mutex_enter(&buf_pool->free_list_mutex);
+
+		ut_ad(buf_pool->curr_size == buf_pool->old_size);
+		ut_ad(buf_pool->n_chunks_new == buf_pool->n_chunks);
+		ut_ad(UT_LIST_GET_LEN(buf_pool->withdraw) == 0);
+		ut_ad(buf_pool->flush_rbt == NULL);
+
+		buf_pool->curr_size = new_instance_size;
+
+		buf_pool->n_chunks_new = new_instance_size * UNIV_PAGE_SIZE
+			/ srv_buf_pool_chunk_unit;
+
+		mutex_exit(&buf_pool->free_list_mutex);
+		mutex_exit(&buf_pool->LRU_list_mutex);
+	}
+
+	/* The adaptive hash index points to the blocks to be withdrawn
+	or relocated; disable it for the duration of the resize.
+	btr_search_disable() returns only after the lookups that search
+	it without the latch have finished, so none of them can touch
+	the chunks after they have been withdrawn and freed below. */
+	if (btr_search_enabled) {
+		buf_resize_status("Disabling adaptive hash index.");
+
+		btr_search_disable();
+		ahi_was_enabled = true;
+	}
+
+	/* Set the withdraw targets */
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		const buf_chunk_t*	chunk;
+		const buf_chunk_t*	echunk;
+		ulint			withdraw_target = 0;
+
+		buf_pool = buf_pool_from_array(i);
+
+		if (buf_pool->curr_size >= buf_pool->old_size) {
+			continue;
+		}
+
+		chunk = buf_pool->chunks + buf_pool->n_chunks_new;
+		echunk = buf_pool->chunks + buf_pool->n_chunks;
+
+		for (; chunk < echunk; chunk++) {
+			withdraw_target += chunk->size;
+		}
+
+		mutex_enter(&buf_pool->free_list_mutex);
+		buf_pool->withdraw_target = withdraw_target;
+		mutex_exit(&buf_pool->free_list_mutex);
+
+		buf_pool_withdrawing = true;
+	}
+
+	if (buf_pool_withdrawing) {
+		buf_resize_status("Withdrawing blocks to be shrunken.");
+
+		/* Reading pages in would only fight the withdrawal */
+		buf_load_abort();
+	}
+
+	withdraw_started = ut_time();
+
+withdraw_retry:
+	should_retry_withdraw = false;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_pool = buf_pool_from_array(i);
+
+		if (buf_pool->curr_size < buf_pool->old_size
+		    && buf_pool_withdraw_blocks(buf_pool)) {
+
+			should_retry_withdraw = true;
+		}
+	}
+
+	if (srv_shutdown_state != SRV_SHUTDOWN_NONE) {
+		/* Abort the resize for the shutdown. */
+		for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+			buf_pool_withdraw_cancel(buf_pool_from_array(i));
+		}
+
+		buf_pool_withdrawing = false;
+
+		return;
+	}
+
+	if (should_retry_withdraw) {
+		if (ut_difftime(ut_time(), withdraw_started)
+		    >= message_interval) {
+
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"Still withdrawing blocks from the buffer"
+				" pool. Pages that stay latched or buffer"
+				" fixed, for example by long running"
+				" transactions, cannot be relocated.");
+
+			message_interval = ut_min(message_interval * 2, 1800);
+			withdraw_started = ut_time();
+		}
+
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Will retry to withdraw %lu seconds later.",
+			(ulong) retry_interval);
+
+		os_thread_sleep(retry_interval * 1000000);
+
+		retry_interval = ut_min(retry_interval * 2, 10);
+
+		goto withdraw_retry;
+	}
+
+	buf_pool_withdrawing = false;
+
+	buf_resize_status("Latching whole of buffer pool.");
+
+	/* Acquire all the latches, level by level across instances.
+	The btr_search latches exclude buf_pool_clear_hash_index(). */
+	btr_search_x_lock_all();
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		mutex_enter(&buf_pool_from_array(i)->LRU_list_mutex);
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		hash_lock_x_all(buf_pool_from_array(i)->page_hash);
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		mutex_enter(&buf_pool_from_array(i)->free_list_mutex);
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		mutex_enter(&buf_pool_from_array(i)->zip_free_mutex);
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		mutex_enter(&buf_pool_from_array(i)->zip_hash_mutex);
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_chunk_t*	chunk;
+		buf_chunk_t*	echunk;
+		buf_chunk_t*	new_chunks;
+		ulint		n_chunks;
+
+		buf_pool = buf_pool_from_array(i);
+
+		if (buf_pool->n_chunks_new == buf_pool->n_chunks) {
+			continue;
+		}
+
+		buf_resize_status("buffer pool %lu : resizing with chunks"
+				  " %lu to %lu.", (ulong) i,
+				  (ulong) buf_pool->n_chunks,
+				  (ulong) buf_pool->n_chunks_new);
+
+		/* The previous array may still be read by
+		buf_block_align(), which is why it is only freed now. */
+		if (buf_pool->chunks_old != NULL) {
+			mem_free(buf_pool->chunks_old);
+		}
+
+		new_chunks = static_cast<buf_chunk_t*>(
+			mem_zalloc((buf_pool->n_chunks_new + 1)
+				   * sizeof *new_chunks));
+
+		n_chunks = ut_min(buf_pool->n_chunks, buf_pool->n_chunks_new);
+
+		memcpy(new_chunks, buf_pool->chunks,
+		       n_chunks * sizeof *new_chunks);
+
+		/* Allocate the new chunks, if growing */
+		for (chunk = new_chunks + n_chunks,
+		     echunk = new_chunks + buf_pool->n_chunks_new;
+		     chunk < echunk; chunk++, n_chunks++) {
+
+			if (!buf_chunk_init(buf_pool, chunk,
+					    srv_buf_pool_chunk_unit)) {
+
+				ib_logf(IB_LOG_LEVEL_ERROR,
+					"buffer pool %lu : failed to allocate"
+					" new memory.", (ulong) i);
+
+				memset(chunk, 0, sizeof *chunk);
+				warning = true;
+				break;
+			}
+		}
+
+		/* Publish the new array */
+		os_wmb;
+		buf_pool->chunks_old = buf_pool->chunks;
+		buf_pool->chunks = new_chunks;
+
+		/* Free the withdrawn chunks, if shrinking */
+		for (chunk = buf_pool->chunks_old + buf_pool->n_chunks_new,
+		     echunk = buf_pool->chunks_old + buf_pool->n_chunks;
+		     chunk < echunk; chunk++) {
+
+			buf_chunk_free(chunk);
+		}
+
+		UT_LIST_INIT(buf_pool->withdraw);
+		buf_pool->withdraw_target = 0;
+
+		buf_pool->n_chunks = n_chunks;
+		buf_pool->n_chunks_new = n_chunks;
+
+		buf_pool->curr_size = 0;
+
+		for (chunk = buf_pool->chunks;
+		     chunk < buf_pool->chunks + n_chunks; chunk++) {
+
+			buf_pool->curr_size += chunk->size;
+		}
+
+		buf_pool->old_size = buf_pool->curr_size;
+		buf_pool->read_ahead_area
+			= ut_min(64, ut_2_power_up(buf_pool->curr_size / 32));
+		buf_pool->curr_pool_size = buf_pool->curr_size * UNIV_PAGE_SIZE;
+
+		/* Keep the hash tables proportional to the pool size */
+		if (hash_get_n_cells(buf_pool->page_hash)
+		    < buf_pool->curr_size
+		    || hash_get_n_cells(buf_pool->page_hash)
+		    > 4 * buf_pool->curr_size) {
+
+			buf_pool_resize_hash(buf_pool);
+		}
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_pool = buf_pool_from_array(i);
+
+		mutex_exit(&buf_pool->zip_hash_mutex);
+		mutex_exit(&buf_pool->zip_free_mutex);
+		mutex_exit(&buf_pool->free_list_mutex);
+		hash_unlock_x_all(buf_pool->page_hash);
+		mutex_exit(&buf_pool->LRU_list_mutex);
+	}
+
+	btr_search_x_unlock_all();
+
+	if (warning) {
+		ulint	size = 0;
+
+		/* Reflect the memory that could be allocated */
+		for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+			size += buf_pool_from_array(i)->n_chunks
+				* srv_buf_pool_chunk_unit;
+		}
+
+		srv_buf_pool_size = size;
+	}
+
+	buf_pool_set_sizes();
+
+	/* Update innodb_buffer_pool_size and the limits that are
+	proportional to it */
+	innodb_set_buf_pool_size(srv_buf_pool_size);
+
+	if (ahi_was_enabled) {
+		buf_resize_status("Re-enabling adaptive hash index.");
+		btr_search_enable();
+	}
+
+	ut_sprintf_timestamp(now);
+
+	if (warning) {
+		buf_resize_status("Resizing buffer pool failed,"
+				  " finished resizing at %s.", now);
+	} else {
+		buf_resize_status("Completed resizing buffer pool at %s.",
+				  now);
+	}
+
+#if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
+	ut_a(buf_validate());
+#endif /* UNIV_DEBUG || UNIV_BUF_DEBUG */
+}
+
+/********************************************************************//**
+This is the thread for resizing the buffer pool.  It waits for an event
+and when it is woken up, grows or shrinks the buffer pool to
+srv_buf_pool_size.
+@return	this function does not return, it calls os_thread_exit() */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_resize_thread)(
+/*==============================*/
+	void*	arg MY_ATTRIBUTE((unused)))	/*!< in: a dummy parameter
+						required by os_thread_create */
+{
+	ut_ad(!srv_read_only_mode);
+
+	srv_buf_resize_thread_active = TRUE;
+
+	while (srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+
+		os_event_wait(srv_buf_resize_event);
+		os_event_reset(srv_buf_resize_event);
+
+		if (srv_shutdown_state != SRV_SHUTDOWN_NONE) {
+			break;
+		}
+
+		if (srv_buf_pool_old_size == srv_buf_pool_size) {
+			buf_resize_status("Size did not change (old size ="
+					  " new size = %lu). Nothing to do.",
+					  (ulong) srv_buf_pool_size);
+			continue;
+		}
+
+		buf_pool_resize();
+	}
+
+	srv_buf_resize_thread_active = FALSE;
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /********************************************************************//**
 Determine if a block is a sentinel for a buffer pool watch.
 @return	TRUE if a sentinel for a buffer pool watch, FALSE if not */
@@ -2423,13 +3330,23 @@ buf_block_align_instance(
 	const byte*	ptr)		/*!< in: pointer to a frame */
 {
 	buf_chunk_t*	chunk;
-	ulint		i;
 
-	/* TODO: protect buf_pool->chunks with a mutex (it will
-	currently remain constant after buf_pool_init()) */
-	for (chunk = buf_pool->chunks, i = buf_pool->n_chunks; i--; chunk++) {
+	/* buf_pool_resize() replaces buf_pool->chunks without
+	waiting for the readers of the old array, which remains
+	allocated until the next resize.  Walk one snapshot of the
+	array up to its zero-filled terminator, and do not
+	dereference the descriptors of chunks that may have been
+	freed meanwhile. */
+	for (chunk = buf_pool->chunks; chunk->blocks != NULL; chunk++) {
 		ulint	offs;
 
+		if (ptr < chunk->mem
+		    || ptr >= static_cast<const byte*>(chunk->mem)
+		    + chunk->mem_size) {
+
+			continue;
+		}
+
 		if (UNIV_UNLIKELY(ptr < chunk->blocks->frame)) {
 
 			continue;
@@ -2540,12 +3457,10 @@ buf_pointer_is_block_field_instance(
 	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
 	const void*	ptr)		/*!< in: pointer not dereferenced */
 {
-	const buf_chunk_t*		chunk	= buf_pool->chunks;
-	const buf_chunk_t* const	echunk	= chunk + buf_pool->n_chunks;
+	const buf_chunk_t*	chunk	= buf_pool->chunks;
 
-	/* TODO: protect buf_pool->chunks with a mutex (it will
-	currently remain constant after buf_pool_init()) */
-	while (chunk < echunk) {
+	/* See the comment in buf_block_align_instance() */
+	while (chunk->blocks != NULL) {
 		if (ptr >= (void*) chunk->blocks
 		    && ptr < (void*) (chunk->blocks + chunk->size)) {
 
@@ -4940,10 +5855,10 @@ buf_pool_validate_instance(
 
 	mutex_exit(&buf_pool->zip_mutex);
 
-	if (n_lru + n_free > buf_pool->curr_size + n_zip) {
+	if (n_lru + n_free > buf_pool->old_size + n_zip) {
 		fprintf(stderr, "n LRU %lu, n free %lu, pool %lu zip %lu\n",
 			(ulong) n_lru, (ulong) n_free,
-			(ulong) buf_pool->curr_size, (ulong) n_zip);
+			(ulong) buf_pool->old_size, (ulong) n_zip);
 		ut_error;
 	}
 
@@ -4951,9 +5866,12 @@ buf_pool_validate_instance(
 
 	mutex_exit(&buf_pool->LRU_list_mutex);
 
-	if (UT_LIST_GET_LEN(buf_pool->free) != n_free) {
-		fprintf(stderr, "Free list len %lu, free blocks %lu\n",
+	if (UT_LIST_GET_LEN(buf_pool->free)
+	    + UT_LIST_GET_LEN(buf_pool->withdraw) != n_free) {
+		fprintf(stderr, "Free list len %lu, withdraw list len %lu,"
+			" free blocks %lu\n",
 			(ulong) UT_LIST_GET_LEN(buf_pool->free),
+			(ulong) UT_LIST_GET_LEN(buf_pool->withdraw),
 			(ulong) n_free);
 		ut_error;
 	}
@@ -31,6 +31,7 @@ Created 2011/12/19
 
 #include "buf0buf.h"
 #include "buf0checksum.h"
+#include "buf0flu.h"
 #include "srv0start.h"
 #include "srv0srv.h"
 #include "page0zip.h"
@@ -49,6 +50,23 @@ UNIV_INTERN buf_dblwr_t*	buf_dblwr = NULL;
 /** Set to TRUE when the doublewrite buffer is being created */
 UNIV_INTERN ibool	buf_dblwr_being_created = FALSE;
 
+/** Parallel doublewrite buffers, or NULL if innodb_parallel_doublewrite
+is off. For each buffer pool instance i, element 2 * i buffers the flush
+list writes and element 2 * i + 1 the LRU and single page writes. */
+UNIV_INTERN buf_dblwr_t*	buf_dblwr_parallel = NULL;
+
+/** Number of pages in one parallel doublewrite buffer: like the
+doublewrite buffer in the system tablespace, it consists of two blocks */
+#define BUF_DBLWR_PARALLEL_SIZE		(2 * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
+
+/** Number of pages in a parallel doublewrite file: one doublewrite
+buffer for flush list and one for LRU list flushing */
+#define BUF_DBLWR_PARALLEL_FILE_SIZE	(2 * BUF_DBLWR_PARALLEL_SIZE)
+
+/** Pages read from the parallel doublewrite files for crash recovery,
+freed by buf_dblwr_create_parallel() */
+static byte*	buf_dblwr_parallel_recv_buf_unaligned = NULL;
+
 /****************************************************************//**
 Determines if a page number is located inside the doublewrite buffer.
 @return TRUE if the location is inside the two blocks of the
@@ -120,19 +138,20 @@ buf_dblwr_sync_datafiles()
 }
 
 /****************************************************************//**
-Creates or initialializes the doublewrite buffer at a database start. */
+Initializes the memory structure of a doublewrite buffer. */
 static
 void
-buf_dblwr_init(
-/*===========*/
-	byte*	doublewrite)	/*!< in: pointer to the doublewrite buf
-				header on trx sys page */
+buf_dblwr_init_low(
+/*===============*/
+	buf_dblwr_t*	dblwr,	/*!< out: zero-filled doublewrite
+				buffer to initialize */
+	ulint		block1,	/*!< in: page number of the first
+				doublewrite block */
+	ulint		block2)	/*!< in: page number of the second
+				doublewrite block */
 {
 	ulint	buf_size;
 
-	buf_dblwr = static_cast<buf_dblwr_t*>(
-		mem_zalloc(sizeof(buf_dblwr_t)));
-
 	/* There are two blocks of same size in the doublewrite
 	buffer. */
 	buf_size = 2 * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
@@ -143,33 +162,386 @@ buf_dblwr_init(
 	     && srv_doublewrite_batch_size < buf_size);
 
 	mutex_create(buf_dblwr_mutex_key,
-		     &buf_dblwr->mutex, SYNC_DOUBLEWRITE);
+		     &dblwr->mutex, SYNC_DOUBLEWRITE);
 
-	buf_dblwr->b_event = os_event_create();
-	buf_dblwr->s_event = os_event_create();
-	buf_dblwr->first_free = 0;
-	buf_dblwr->s_reserved = 0;
-	buf_dblwr->b_reserved = 0;
+	dblwr->b_event = os_event_create();
+	dblwr->s_event = os_event_create();
+	dblwr->first_free = 0;
+	dblwr->s_reserved = 0;
+	dblwr->b_reserved = 0;
 
-	buf_dblwr->block1 = mach_read_from_4(
-		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1);
-	buf_dblwr->block2 = mach_read_from_4(
-		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK2);
+	dblwr->block1 = block1;
+	dblwr->block2 = block2;
 
-	buf_dblwr->in_use = static_cast<bool*>(
+	dblwr->in_use = static_cast<bool*>(
 		mem_zalloc(buf_size * sizeof(bool)));
 
-	buf_dblwr->write_buf_unaligned = static_cast<byte*>(
+	dblwr->write_buf_unaligned = static_cast<byte*>(
 		ut_malloc((1 + buf_size) * UNIV_PAGE_SIZE));
 
-	buf_dblwr->write_buf = static_cast<byte*>(
-		ut_align(buf_dblwr->write_buf_unaligned,
+	dblwr->write_buf = static_cast<byte*>(
+		ut_align(dblwr->write_buf_unaligned,
 			 UNIV_PAGE_SIZE));
 
-	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
+	dblwr->buf_block_arr = static_cast<buf_page_t**>(
 		mem_zalloc(buf_size * sizeof(void*)));
 }
 
+/****************************************************************//**
+Frees the memory structure of a doublewrite buffer, but not the
+buf_dblwr_t object itself. */
+static
+void
+buf_dblwr_free_low(
+/*===============*/
+	buf_dblwr_t*	dblwr)	/*!< in/out: doublewrite buffer */
+{
+	ut_ad(dblwr->s_reserved == 0);
+	ut_ad(dblwr->b_reserved == 0);
+
+	os_event_free(dblwr->b_event);
+	os_event_free(dblwr->s_event);
+	ut_free(dblwr->write_buf_unaligned);
+	dblwr->write_buf_unaligned = NULL;
+
+	mem_free(dblwr->buf_block_arr);
+	dblwr->buf_block_arr = NULL;
+
+	mem_free(dblwr->in_use);
+	dblwr->in_use = NULL;
+
+	if (dblwr->file_name != NULL) {
+		mem_free(dblwr->file_name);
+		dblwr->file_name = NULL;
+	}
+
+	mutex_free(&dblwr->mutex);
+}
+
+/****************************************************************//**
+Creates or initialializes the doublewrite buffer at a database start. */
+static
+void
+buf_dblwr_init(
+/*===========*/
+	byte*	doublewrite)	/*!< in: pointer to the doublewrite buf
+				header on trx sys page */
+{
+	buf_dblwr = static_cast<buf_dblwr_t*>(
+		mem_zalloc(sizeof(buf_dblwr_t)));
+
+	buf_dblwr_init_low(
+		buf_dblwr,
+		mach_read_from_4(doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1),
+		mach_read_from_4(doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK2));
+}
+
+/****************************************************************//**
+Returns the doublewrite buffer that buffers the writes of a page.
+@return	doublewrite buffer */
+UNIV_INLINE
+buf_dblwr_t*
+buf_dblwr_get_for_page(
+/*===================*/
+	const buf_page_t*	bpage,		/*!< in: page to write */
+	buf_flush_t		flush_type)	/*!< in: flush type */
+{
+	if (buf_dblwr_parallel == NULL) {
+
+		return(buf_dblwr);
+	}
+
+	return(&buf_dblwr_parallel[2 * bpage->buf_pool_index
+				   + (flush_type != BUF_FLUSH_LIST)]);
+}
+
+/********************************************************************//**
+Writes pages to the blocks of a doublewrite buffer on disk. The write is
+synchronous. */
+static
+void
+buf_dblwr_write_to_disk(
+/*====================*/
+	const buf_dblwr_t*	dblwr,	/*!< in: doublewrite buffer */
+	ulint			page_no,/*!< in: page number within the
+					system tablespace or the parallel
+					doublewrite file */
+	void*			buf,	/*!< in: pages to write */
+	ulint			len)	/*!< in: number of bytes to write */
+{
+	if (dblwr->file_name == NULL) {
+		fil_io(OS_FILE_WRITE, true, TRX_SYS_SPACE, 0,
+		       page_no, 0, len, buf, NULL);
+	} else {
+		ut_a(os_file_write(dblwr->file_name, dblwr->file, buf,
+				   (os_offset_t) page_no * UNIV_PAGE_SIZE,
+				   len));
+	}
+}
+
+/********************************************************************//**
+Flushes the blocks of a doublewrite buffer to disk. */
+static
+void
+buf_dblwr_flush_to_disk(
+/*====================*/
+	const buf_dblwr_t*	dblwr)	/*!< in: doublewrite buffer */
+{
+	if (dblwr->file_name == NULL) {
+		fil_flush(TRX_SYS_SPACE);
+	} else {
+		ut_a(os_file_flush(dblwr->file));
+	}
+}
+
+/****************************************************************//**
+Builds the name of a parallel doublewrite file. */
+static
+void
+buf_dblwr_parallel_file_name(
+/*=========================*/
+	char*	name,	/*!< out: file name, OS_FILE_MAX_PATH bytes */
+	ulint	i)	/*!< in: buffer pool instance number */
+{
+	ulint	dirnamelen = strlen(srv_parallel_doublewrite_path);
+
+	ut_a(dirnamelen < OS_FILE_MAX_PATH - 30);
+
+	memcpy(name, srv_parallel_doublewrite_path, dirnamelen);
+
+	/* Add a path separator if needed. */
+	if (dirnamelen && name[dirnamelen - 1] != SRV_PATH_SEPARATOR) {
+		name[dirnamelen++] = SRV_PATH_SEPARATOR;
+	}
+
+	sprintf(name + dirnamelen, BUF_DBLWR_PARALLEL_FILE_NAME "%lu",
+		(ulong) i);
+}
+
+/****************************************************************//**
+Checks if a parallel doublewrite file exists.
+@return true if the file exists */
+static
+bool
+buf_dblwr_parallel_file_exists(
+/*===========================*/
+	const char*	name)	/*!< in: file name */
+{
+	ibool		exists;
+	os_file_type_t	type;
+
+	return(os_file_status(name, &exists, &type) && exists);
+}
+
+/****************************************************************//**
+Reads the pages of the parallel doublewrite files left by the previous
+server run into memory, for restoring half-written data pages in crash
+recovery. The files are read whether or not innodb_parallel_doublewrite
+is set, so that the setting can be changed across a crash. */
+static
+void
+buf_dblwr_parallel_load_pages(void)
+/*===============================*/
+{
+	char		name[OS_FILE_MAX_PATH];
+	ulint		n_files;
+	byte*		buf;
+	recv_dblwr_t&	recv_dblwr = recv_sys->dblwr;
+
+	for (n_files = 0; ; n_files++) {
+		buf_dblwr_parallel_file_name(name, n_files);
+
+		if (!buf_dblwr_parallel_file_exists(name)) {
+			break;
+		}
+	}
+
+	if (n_files == 0) {
+
+		return;
+	}
+
+	ut_a(buf_dblwr_parallel_recv_buf_unaligned == NULL);
+
+	buf_dblwr_parallel_recv_buf_unaligned = static_cast<byte*>(
+		ut_malloc((1 + n_files * BUF_DBLWR_PARALLEL_FILE_SIZE)
+			  * UNIV_PAGE_SIZE));
+
+	buf = static_cast<byte*>(
+		ut_align(buf_dblwr_parallel_recv_buf_unaligned,
+			 UNIV_PAGE_SIZE));
+
+	for (ulint i = 0; i < n_files; i++) {
+		os_file_t	file;
+		ibool		success;
+		const ulint	file_bytes = BUF_DBLWR_PARALLEL_FILE_SIZE
+			* UNIV_PAGE_SIZE;
+
+		buf_dblwr_parallel_file_name(name, i);
+
+		file = os_file_create_simple_no_error_handling(
+			innodb_file_data_key, name, OS_FILE_OPEN,
+			OS_FILE_READ_ONLY, &success);
+
+		if (!success) {
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"Cannot open the parallel doublewrite "
+				"file %s", name);
+			continue;
+		}
+
+		if (os_file_get_size(file) != file_bytes
+		    || !os_file_read(file, buf, 0, file_bytes)) {
+
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"Cannot read the parallel doublewrite "
+				"file %s", name);
+
+			os_file_close(file);
+			continue;
+		}
+
+		os_file_close(file);
+
+		for (ulint j = 0; j < BUF_DBLWR_PARALLEL_FILE_SIZE; j++) {
+
+			/* The files are zero-filled at creation */
+			if (!buf_page_is_zeroes(buf, 0)) {
+
+				recv_dblwr.add(buf);
+			}
+
+			buf += UNIV_PAGE_SIZE;
+		}
+	}
+}
+
+/****************************************************************//**
+Creates the parallel doublewrite files, one for each buffer pool instance,
+if innodb_parallel_doublewrite is set. Parallel doublewrite files that are
+not used any more are deleted. Must be called after crash recovery has
+restored the pages from the parallel doublewrite files.
+@return DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+buf_dblwr_create_parallel(void)
+/*===========================*/
+{
+	char	name[OS_FILE_MAX_PATH];
+	ulint	n_files;
+
+	ut_ad(buf_dblwr_parallel == NULL);
+
+	/* The pages read from the parallel doublewrite files are
+	not needed any more */
+	if (buf_dblwr_parallel_recv_buf_unaligned != NULL) {
+		ut_free(buf_dblwr_parallel_recv_buf_unaligned);
+		buf_dblwr_parallel_recv_buf_unaligned = NULL;
+	}
+
+	if (srv_read_only_mode) {
+
+		return(DB_SUCCESS);
+	}
+
+	n_files = srv_use_doublewrite_buf && srv_parallel_doublewrite
+		? srv_buf_pool_instances : 0;
+
+	for (ulint i = n_files; ; i++) {
+		buf_dblwr_parallel_file_name(name, i);
+
+		if (!buf_dblwr_parallel_file_exists(name)) {
+			break;
+		}
+
+		os_file_delete_if_exists(innodb_file_data_key, name);
+	}
+
+	if (n_files == 0) {
+
+		return(DB_SUCCESS);
+	}
+
+	ut_a(buf_dblwr != NULL);
+
+	/* Crash recovery may have posted batches to the doublewrite
+	buffer in the system tablespace; they must have completed
+	before the pages are written through the parallel
+	doublewrite buffers. The flush list batches of recovery
+	have already been waited for. */
+	buf_flush_wait_LRU_batch_end();
+
+	ut_ad(buf_dblwr->first_free == 0);
+	ut_ad(buf_dblwr->b_reserved == 0);
+	ut_ad(buf_dblwr->s_reserved == 0);
+
+	buf_dblwr_t*	dblwr = static_cast<buf_dblwr_t*>(
+		mem_zalloc(2 * n_files * sizeof(buf_dblwr_t)));
+
+	for (ulint i = 0; i < n_files; i++) {
+		os_file_t	file;
+		ibool		success;
+
+		buf_dblwr_parallel_file_name(name, i);
+
+		/* The pages of the previous server run have already
+		been processed, overwrite the file. */
+		file = os_file_create(
+			innodb_file_data_key, name,
+			OS_FILE_OVERWRITE | OS_FILE_ON_ERROR_NO_EXIT,
+			OS_FILE_NORMAL, OS_DATA_FILE, &success);
+
+		if (success) {
+			success = os_file_set_size(
+				name, file,
+				(os_offset_t) BUF_DBLWR_PARALLEL_FILE_SIZE
+				* UNIV_PAGE_SIZE);
+
+			if (!success) {
+				os_file_close(file);
+			}
+		}
+
+		if (!success) {
+			ib_logf(IB_LOG_LEVEL_ERROR,
+				"Cannot create the parallel doublewrite "
+				"file %s", name);
+
+			for (ulint j = 0; j < 2 * i; j++) {
+				if (j % 2 == 0) {
+					os_file_close(dblwr[j].file);
+				}
+
+				buf_dblwr_free_low(&dblwr[j]);
+			}
+
+			mem_free(dblwr);
+
+			return(DB_ERROR);
+		}
+
+		for (ulint j = 0; j < 2; j++) {
+			buf_dblwr_t*	part = &dblwr[2 * i + j];
+			ulint		block1 = j * BUF_DBLWR_PARALLEL_SIZE;
+
+			buf_dblwr_init_low(
+				part, block1,
+				block1 + TRX_SYS_DOUBLEWRITE_BLOCK_SIZE);
+
+			part->file_name = mem_strdup(name);
+			part->file = file;
+		}
+	}
+
+	buf_dblwr_parallel = dblwr;
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Using %lu parallel doublewrite files in %s",
+		(ulong) n_files, srv_parallel_doublewrite_path);
+
+	return(DB_SUCCESS);
+}
+
 /****************************************************************//**
 Creates the doublewrite buffer to a new InnoDB installation. The header of the
 doublewrite buffer is placed on the trx system header page. */
@@ -466,6 +838,10 @@ buf_dblwr_init_or_load_pages(
 
 leave_func:
 	ut_free(unaligned_read_buf);
+
+	if (load_corrupt_pages) {
+		buf_dblwr_parallel_load_pages();
+	}
 }
 
 /****************************************************************//**
@@ -605,21 +981,26 @@ buf_dblwr_free(void)
 {
 	/* Free the double write data structures. */
 	ut_a(buf_dblwr != NULL);
-	ut_ad(buf_dblwr->s_reserved == 0);
-	ut_ad(buf_dblwr->b_reserved == 0);
 
-	os_event_free(buf_dblwr->b_event);
-	os_event_free(buf_dblwr->s_event);
-	ut_free(buf_dblwr->write_buf_unaligned);
-	buf_dblwr->write_buf_unaligned = NULL;
+	if (buf_dblwr_parallel != NULL) {
+		for (ulint i = 0; i < 2 * srv_buf_pool_instances; i++) {
+			if (i % 2 == 0) {
+				os_file_close(buf_dblwr_parallel[i].file);
+			}
+
+			buf_dblwr_free_low(&buf_dblwr_parallel[i]);
+		}
 
-	mem_free(buf_dblwr->buf_block_arr);
-	buf_dblwr->buf_block_arr = NULL;
+		mem_free(buf_dblwr_parallel);
+		buf_dblwr_parallel = NULL;
+	}
 
-	mem_free(buf_dblwr->in_use);
-	buf_dblwr->in_use = NULL;
+	if (buf_dblwr_parallel_recv_buf_unaligned != NULL) {
+		ut_free(buf_dblwr_parallel_recv_buf_unaligned);
+		buf_dblwr_parallel_recv_buf_unaligned = NULL;
+	}
 
-	mutex_free(&buf_dblwr->mutex);
+	buf_dblwr_free_low(buf_dblwr);
 	mem_free(buf_dblwr);
 	buf_dblwr = NULL;
 }
@@ -633,46 +1014,50 @@ buf_dblwr_update(
 	const buf_page_t*	bpage,	/*!< in: buffer block descriptor */
 	buf_flush_t		flush_type)/*!< in: flush type */
 {
+	buf_dblwr_t*	dblwr;
+
 	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
 		return;
 	}
 
+	dblwr = buf_dblwr_get_for_page(bpage, flush_type);
+
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
-		mutex_enter(&buf_dblwr->mutex);
+		mutex_enter(&dblwr->mutex);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+		ut_ad(dblwr->batch_running);
+		ut_ad(dblwr->b_reserved > 0);
+		ut_ad(dblwr->b_reserved <= dblwr->first_free);
 
-		buf_dblwr->b_reserved--;
+		dblwr->b_reserved--;
 
-		if (buf_dblwr->b_reserved == 0) {
-			mutex_exit(&buf_dblwr->mutex);
+		if (dblwr->b_reserved == 0) {
+			mutex_exit(&dblwr->mutex);
 			/* This will finish the batch. Sync data files
 			to the disk. */
 			fil_flush_file_spaces(FIL_TABLESPACE);
-			mutex_enter(&buf_dblwr->mutex);
+			mutex_enter(&dblwr->mutex);
 
 			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
+			dblwr->first_free = 0;
+			dblwr->batch_running = false;
+			os_event_set(dblwr->b_event);
 		}
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&dblwr->mutex);
 		break;
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
 			const ulint size = 2 * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
 			ulint i;
-			mutex_enter(&buf_dblwr->mutex);
+			mutex_enter(&dblwr->mutex);
 			for (i = srv_doublewrite_batch_size; i < size; ++i) {
-				if (buf_dblwr->buf_block_arr[i] == bpage) {
-					buf_dblwr->s_reserved--;
-					buf_dblwr->buf_block_arr[i] = NULL;
-					buf_dblwr->in_use[i] = false;
+				if (dblwr->buf_block_arr[i] == bpage) {
+					dblwr->s_reserved--;
+					dblwr->buf_block_arr[i] = NULL;
+					dblwr->in_use[i] = false;
 					break;
 				}
 			}
@@ -681,8 +1066,8 @@ buf_dblwr_update(
 			reserved block. */
 			ut_a(i < size);
 		}
-		os_event_set(buf_dblwr->s_event);
-		mutex_exit(&buf_dblwr->mutex);
+		os_event_set(dblwr->s_event);
+		mutex_exit(&dblwr->mutex);
 		break;
 	case BUF_FLUSH_N_TYPES:
 		ut_error;
@@ -815,73 +1200,65 @@ buf_dblwr_write_block_to_datafile(
 }
 
 /********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
-UNIV_INTERN
+Flushes possible buffered writes from a doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. */
+static
 void
-buf_dblwr_flush_buffered_writes(void)
-/*=================================*/
+buf_dblwr_flush_buffered_writes_low(
+/*================================*/
+	buf_dblwr_t*	dblwr)	/*!< in/out: doublewrite buffer */
 {
 	byte*		write_buf;
 	ulint		first_free;
 	ulint		len;
 
-	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
-		/* Sync the writes to the disk. */
-		buf_dblwr_sync_datafiles();
-		return;
-	}
-
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&dblwr->mutex);
 
 	/* Write first to doublewrite buffer blocks. We use synchronous
 	aio and thus know that file write has been completed when the
 	control returns. */
 
-	if (buf_dblwr->first_free == 0) {
+	if (dblwr->first_free == 0) {
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&dblwr->mutex);
 
 		return;
 	}
 
-	if (buf_dblwr->batch_running) {
+	if (dblwr->batch_running) {
 		/* Another thread is running the batch right now. Wait
 		for it to finish. */
-		ib_int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		ib_int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(dblwr->b_event, sig_count);
 		goto try_again;
 	}
 
-	ut_a(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
+	ut_a(!dblwr->batch_running);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
 
 	/* Disallow anyone else to post to doublewrite buffer or to
 	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
+	dblwr->batch_running = true;
+	first_free = dblwr->first_free;
 
 	/* Now safe to release the mutex. Note that though no other
 	thread is allowed to post to the doublewrite batch flushing
 	but any threads working on single page flushes are allowed
 	to proceed. */
-	mutex_exit(&buf_dblwr->mutex);
+	mutex_exit(&dblwr->mutex);
 
-	write_buf = buf_dblwr->write_buf;
+	write_buf = dblwr->write_buf;
 
 	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
+	     i < dblwr->first_free;
 	     len2 += UNIV_PAGE_SIZE, i++) {
 
 		const buf_block_t*	block;
 
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
+		block = (buf_block_t*) dblwr->buf_block_arr[i];
 
 		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
 		    || block->page.zip.data) {
@@ -901,55 +1278,51 @@ try_again:
 
 	/* Write out the first block of the doublewrite buffer */
 	len = ut_min(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-		     buf_dblwr->first_free) * UNIV_PAGE_SIZE;
+		     dblwr->first_free) * UNIV_PAGE_SIZE;
 
-	fil_io(OS_FILE_WRITE, true, TRX_SYS_SPACE, 0,
-	       buf_dblwr->block1, 0, len,
-	       (void*) write_buf, NULL);
+	buf_dblwr_write_to_disk(dblwr, dblwr->block1, write_buf, len);
 
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+	if (dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
 		/* No unwritten pages in the second block. */
 		goto flush;
 	}
 
 	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
+	len = (dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
 	       * UNIV_PAGE_SIZE;
 
-	write_buf = buf_dblwr->write_buf
+	write_buf = dblwr->write_buf
 		    + TRX_SYS_DOUBLEWRITE_BLOCK_SIZE * UNIV_PAGE_SIZE;
 
-	fil_io(OS_FILE_WRITE, true, TRX_SYS_SPACE, 0,
-	       buf_dblwr->block2, 0, len,
-	       (void*) write_buf, NULL);
+	buf_dblwr_write_to_disk(dblwr, dblwr->block2, write_buf, len);
 
 flush:
 	/* increment the doublewrite flushed pages counter */
-	srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
+	srv_stats.dblwr_pages_written.add(dblwr->first_free);
 	srv_stats.dblwr_writes.inc();
 
 	/* Now flush the doublewrite buffer data to disk */
-	fil_flush(TRX_SYS_SPACE);
+	buf_dblwr_flush_to_disk(dblwr);
 
 	/* We know that the writes have been flushed to disk now
 	and in recovery we will find them in the doublewrite buffer
 	blocks. Next do the writes to the intended positions. */
 
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
+	/* Up to this point first_free and dblwr->first_free are
+	same because we have set the dblwr->batch_running flag
 	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
+	can't safely access dblwr->first_free in the loop below.
 	This is so because it is possible that after we are done with
 	the last iteration and before we terminate the loop, the batch
 	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
+	a new batch setting dblwr->first_free to a higher value.
+	If this happens and we are using dblwr->first_free in the
 	loop termination condition then we'll end up dispatching
 	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
+	ut_ad(first_free == dblwr->first_free);
 	for (ulint i = 0; i < first_free; i++) {
 		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+			dblwr->buf_block_arr[i], false);
 	}
 
 	/* Wake possible simulated aio thread to actually post the
@@ -959,6 +1332,58 @@ flush:
 	os_aio_simulated_wake_handler_threads();
 }
 
+/********************************************************************//**
+Flushes possible buffered writes from the doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. It is very
+important to call this function after a batch of writes has been posted,
+and also when we may have to wait for a page latch! Otherwise a deadlock
+of threads can occur. */
+UNIV_INTERN
+void
+buf_dblwr_flush_buffered_writes(void)
+/*=================================*/
+{
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		return;
+	}
+
+	if (buf_dblwr_parallel == NULL) {
+		buf_dblwr_flush_buffered_writes_low(buf_dblwr);
+		return;
+	}
+
+	for (ulint i = 0; i < 2 * srv_buf_pool_instances; i++) {
+		buf_dblwr_flush_buffered_writes_low(&buf_dblwr_parallel[i]);
+	}
+}
+
+/********************************************************************//**
+Flushes possible buffered writes of one buffer pool instance and flush type
+from the parallel doublewrite buffer to disk. Does nothing if
+innodb_parallel_doublewrite is off: the batch of the doublewrite buffer in
+the system tablespace is then shared by all instances and flushed by
+buf_dblwr_flush_buffered_writes(). */
+UNIV_INTERN
+void
+buf_dblwr_flush_instance_batch(
+/*===========================*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	buf_flush_t		flush_type)	/*!< in: BUF_FLUSH_LRU or
+						BUF_FLUSH_LIST */
+{
+	ut_ad(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
+
+	if (!srv_use_doublewrite_buf || buf_dblwr_parallel == NULL) {
+		return;
+	}
+
+	buf_dblwr_flush_buffered_writes_low(
+		&buf_dblwr_parallel[2 * buf_pool_index(buf_pool)
+				    + (flush_type != BUF_FLUSH_LIST)]);
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -969,17 +1394,20 @@ buf_dblwr_add_to_batch(
 /*====================*/
 	buf_page_t*	bpage)	/*!< in: buffer block to write */
 {
-	ulint	zip_size;
+	ulint		zip_size;
+	buf_dblwr_t*	dblwr;
 
 	ut_a(buf_page_in_file(bpage));
 	ut_ad(!mutex_own(&buf_pool_from_bpage(bpage)->LRU_list_mutex));
 
+	dblwr = buf_dblwr_get_for_page(bpage, buf_page_get_flush_type(bpage));
+
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&dblwr->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	ut_a(dblwr->first_free <= srv_doublewrite_batch_size);
 
-	if (buf_dblwr->batch_running) {
+	if (dblwr->batch_running) {
 
 		/* This not nearly as bad as it looks. There is only
 		page_cleaner thread which does background flushing
@@ -987,17 +1415,17 @@ try_again:
 		point. The only exception is when a user thread is
 		forced to do a flush batch because of a sync
 		checkpoint. */
-		ib_int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		ib_int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(dblwr->b_event, sig_count);
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&(dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes_low(dblwr);
 
 		goto try_again;
 	}
@@ -1007,40 +1435,40 @@ try_again:
 	if (zip_size) {
 		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
 		/* Copy the compressed page and clear the rest. */
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
+		memcpy(dblwr->write_buf
+		       + UNIV_PAGE_SIZE * dblwr->first_free,
 		       bpage->zip.data, zip_size);
-		memset(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free
+		memset(dblwr->write_buf
+		       + UNIV_PAGE_SIZE * dblwr->first_free
 		       + zip_size, 0, UNIV_PAGE_SIZE - zip_size);
 	} else {
 		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
 		UNIV_MEM_ASSERT_RW(((buf_block_t*) bpage)->frame,
 				   UNIV_PAGE_SIZE);
 
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
+		memcpy(dblwr->write_buf
+		       + UNIV_PAGE_SIZE * dblwr->first_free,
 		       ((buf_block_t*) bpage)->frame, UNIV_PAGE_SIZE);
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	dblwr->buf_block_arr[dblwr->first_free] = bpage;
 
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
+	dblwr->first_free++;
+	dblwr->b_reserved++;
 
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	ut_ad(!dblwr->batch_running);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
+	ut_ad(dblwr->b_reserved <= srv_doublewrite_batch_size);
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&(dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes_low(dblwr);
 
 		return;
 	}
 
-	mutex_exit(&(buf_dblwr->mutex));
+	mutex_exit(&(dblwr->mutex));
 }
 
 /********************************************************************//**
@@ -1063,11 +1491,14 @@ buf_dblwr_write_single_page(
 	ulint		zip_size;
 	ulint		offset;
 	ulint		i;
+	buf_dblwr_t*	dblwr;
 
 	ut_a(buf_page_in_file(bpage));
 	ut_a(srv_use_doublewrite_buf);
 	ut_a(buf_dblwr != NULL);
 
+	dblwr = buf_dblwr_get_for_page(bpage, BUF_FLUSH_SINGLE_PAGE);
+
 	/* total number of slots available for single page flushes
 	starts from srv_doublewrite_batch_size to the end of the
 	buffer. */
@@ -1090,43 +1521,43 @@ buf_dblwr_write_single_page(
 	}
 
 retry:
-	mutex_enter(&buf_dblwr->mutex);
-	if (buf_dblwr->s_reserved == n_slots) {
+	mutex_enter(&dblwr->mutex);
+	if (dblwr->s_reserved == n_slots) {
 
 		/* All slots are reserved. */
 		ib_int64_t	sig_count =
-			os_event_reset(buf_dblwr->s_event);
-		mutex_exit(&buf_dblwr->mutex);
-		os_event_wait_low(buf_dblwr->s_event, sig_count);
+			os_event_reset(dblwr->s_event);
+		mutex_exit(&dblwr->mutex);
+		os_event_wait_low(dblwr->s_event, sig_count);
 
 		goto retry;
 	}
 
 	for (i = srv_doublewrite_batch_size; i < size; ++i) {
 
-		if (!buf_dblwr->in_use[i]) {
+		if (!dblwr->in_use[i]) {
 			break;
 		}
 	}
 
 	/* We are guaranteed to find a slot. */
 	ut_a(i < size);
-	buf_dblwr->in_use[i] = true;
-	buf_dblwr->s_reserved++;
-	buf_dblwr->buf_block_arr[i] = bpage;
+	dblwr->in_use[i] = true;
+	dblwr->s_reserved++;
+	dblwr->buf_block_arr[i] = bpage;
 
 	/* increment the doublewrite flushed pages counter */
 	srv_stats.dblwr_pages_written.inc();
 	srv_stats.dblwr_writes.inc();
 
-	mutex_exit(&buf_dblwr->mutex);
+	mutex_exit(&dblwr->mutex);
 
 	/* Lets see if we are going to write in the first or second
 	block of the doublewrite buffer. */
 	if (i < TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
-		offset = buf_dblwr->block1 + i;
+		offset = dblwr->block1 + i;
 	} else {
-		offset = buf_dblwr->block2 + i
+		offset = dblwr->block2 + i
 			 - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
 	}
 
@@ -1143,26 +1574,25 @@ retry:
 
 	zip_size = buf_page_get_zip_size(bpage);
 	if (zip_size) {
-		memcpy(buf_dblwr->write_buf + UNIV_PAGE_SIZE * i,
+		memcpy(dblwr->write_buf + UNIV_PAGE_SIZE * i,
 		       bpage->zip.data, zip_size);
-		memset(buf_dblwr->write_buf + UNIV_PAGE_SIZE * i
+		memset(dblwr->write_buf + UNIV_PAGE_SIZE * i
 		       + zip_size, 0, UNIV_PAGE_SIZE - zip_size);
 
-		fil_io(OS_FILE_WRITE, true, TRX_SYS_SPACE, 0,
-		       offset, 0, UNIV_PAGE_SIZE,
-		       (void*) (buf_dblwr->write_buf
-				+ UNIV_PAGE_SIZE * i), NULL);
+		buf_dblwr_write_to_disk(
+			dblwr, offset,
+			dblwr->write_buf + UNIV_PAGE_SIZE * i,
+			UNIV_PAGE_SIZE);
 	} else {
 		/* It is a regular page. Write it directly to the
 		doublewrite buffer */
-		fil_io(OS_FILE_WRITE, true, TRX_SYS_SPACE, 0,
-		       offset, 0, UNIV_PAGE_SIZE,
-		       (void*) ((buf_block_t*) bpage)->frame,
-		       NULL);
+		buf_dblwr_write_to_disk(
+			dblwr, offset,
+			((buf_block_t*) bpage)->frame, UNIV_PAGE_SIZE);
 	}
 
 	/* Now flush the doublewrite buffer data to disk */
-	fil_flush(TRX_SYS_SPACE);
+	buf_dblwr_flush_to_disk(dblwr);
 
 	/* We know that the write has been flushed to disk now
 	and during recovery we will find it in the doublewrite buffer
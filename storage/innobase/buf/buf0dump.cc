@@ -565,6 +565,9 @@ buf_load()
 		}
 	}
 
+	/* Post the last batch of reads */
+	os_aio_simulated_wake_handler_threads();
+
 	ut_free(dump);
 
 	ut_sprintf_timestamp(now);
@@ -62,13 +62,89 @@ UNIV_INTERN ibool buf_page_cleaner_is_active = FALSE;
 /** Flag indicating if the lru_manager is in active state. */
 UNIV_INTERN bool buf_lru_manager_is_active = false;
 
+/** Number of page cleaner and LRU manager worker threads that are
+running. */
+UNIV_INTERN ulint buf_page_cleaner_n_workers_active = 0;
+
 #ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_thread_key;
 UNIV_INTERN mysql_pfs_key_t buf_lru_manager_thread_key;
+UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_worker_thread_key;
+UNIV_INTERN mysql_pfs_key_t buf_lru_manager_worker_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
+#ifdef UNIV_PFS_MUTEX
+UNIV_INTERN mysql_pfs_key_t page_cleaner_mutex_key;
+#endif /* UNIV_PFS_MUTEX */
+
 /* @} */
 
+/** A page cleaner slot: the buffer pool instances i for which
+i % srv_n_page_cleaners is the slot number. Slot 0 is flushed by the
+page_cleaner and lru_manager threads themselves. Each of the other slots
+has a page cleaner worker thread for its flush lists and an LRU manager
+worker thread for its LRU lists, so that an LRU batch never waits for a
+long flush list batch of the same slot. */
+struct page_cleaner_slot_t {
+	ulint		id;		/*!< slot number */
+	bool		flush_list_active;
+					/*!< true if a page cleaner worker
+					thread serves this slot */
+	bool		lru_active;	/*!< true if an LRU manager worker
+					thread serves this slot */
+	bool		flush_list_requested;
+					/*!< true if the worker should flush
+					the flush lists of the slot */
+	bool		lru_requested;	/*!< true if the worker should
+					flush the LRU list tails of the
+					slot */
+	bool		flush_list_success;
+					/*!< result of the last flush list
+					batch of the slot */
+	ulint		n_flushed_list;	/*!< pages flushed by the last
+					flush list batch of the slot */
+	ulint		n_flushed_lru;	/*!< pages flushed by the last LRU
+					batch of the slot */
+	buf_flush_cleaner_stats_t stats;/*!< cumulative statistics */
+};
+
+/** The page cleaner slots, protected by mutex */
+struct page_cleaner_t {
+	ib_mutex_t		mutex;	/*!< mutex protecting the requests,
+					the results and the statistics */
+	os_event_t		flush_list_requested;
+					/*!< set when flush list batches
+					are requested from the page
+					cleaner worker threads */
+	os_event_t		lru_requested;
+					/*!< set when LRU batches are
+					requested from the LRU manager
+					worker threads */
+	os_event_t		flush_list_finished;
+					/*!< set when the last requested
+					flush list batch has completed */
+	os_event_t		lru_finished;
+					/*!< set when the last requested
+					LRU batch has completed */
+	ulint			n_slots;/*!< srv_n_page_cleaners */
+	page_cleaner_slot_t*	slots;	/*!< the slots */
+	ulint			flush_list_min_n;
+					/*!< requested minimum number of
+					pages to flush from each instance */
+	lsn_t			flush_list_lsn_limit;
+					/*!< requested flush list lsn
+					limit */
+	ulint			n_flush_list_pending;
+					/*!< number of slots still running
+					the requested flush list batch */
+	ulint			n_lru_pending;
+					/*!< number of slots still running
+					the requested LRU batch */
+};
+
+/** The page cleaner slots, NULL if not created */
+static page_cleaner_t*	page_cleaner = NULL;
+
 /** Handled page counters for a single flush */
 struct flush_counters_t {
 	ulint	flushed;	/*!< number of dirty pages flushed */
@@ -356,12 +432,13 @@ buf_flush_insert_into_flush_list(
 	buf_block_t*	block,		/*!< in/out: block which is modified */
 	lsn_t		lsn)		/*!< in: oldest modification */
 {
-	ut_ad(log_flush_order_mutex_own());
+	ut_ad(srv_log_concurrent_mtr_commit || log_flush_order_mutex_own());
 	ut_ad(mutex_own(&block->mutex));
 
 	buf_flush_list_mutex_enter(buf_pool);
 
-	ut_ad((UT_LIST_GET_FIRST(buf_pool->flush_list) == NULL)
+	ut_ad(srv_log_concurrent_mtr_commit
+	      || (UT_LIST_GET_FIRST(buf_pool->flush_list) == NULL)
 	      || (UT_LIST_GET_FIRST(buf_pool->flush_list)->oldest_modification
 		  <= lsn));
 
@@ -378,7 +455,31 @@ buf_flush_insert_into_flush_list(
 
 	ut_d(block->page.in_flush_list = TRUE);
 	block->page.oldest_modification = lsn;
-	UT_LIST_ADD_FIRST(list, buf_pool->flush_list, &block->page);
+
+	if (srv_log_concurrent_mtr_commit) {
+		buf_page_t*	prev_b	= NULL;
+
+		/* Without log_flush_order_mutex, mini-transactions with a
+		later lsn may have inserted their pages first. There can
+		only be a few of them, all near the head of the list. */
+		for (buf_page_t* b = UT_LIST_GET_FIRST(buf_pool->flush_list);
+		     b != NULL && b->oldest_modification > lsn;
+		     b = UT_LIST_GET_NEXT(list, b)) {
+			ut_ad(b->in_flush_list);
+			prev_b = b;
+		}
+
+		if (prev_b == NULL) {
+			UT_LIST_ADD_FIRST(list, buf_pool->flush_list,
+					  &block->page);
+		} else {
+			UT_LIST_INSERT_AFTER(list, buf_pool->flush_list,
+					     prev_b, &block->page);
+		}
+	} else {
+		UT_LIST_ADD_FIRST(list, buf_pool->flush_list, &block->page);
+	}
+
 	incr_flush_list_size_in_bytes(block, buf_pool);
 
 #ifdef UNIV_DEBUG_VALGRIND
@@ -414,7 +515,7 @@ buf_flush_insert_sorted_into_flush_list(
 	buf_page_t*	prev_b;
 	buf_page_t*	b;
 
-	ut_ad(log_flush_order_mutex_own());
+	ut_ad(srv_log_concurrent_mtr_commit || log_flush_order_mutex_own());
 	ut_ad(mutex_own(&block->mutex));
 	ut_ad(buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE);
 
@@ -1074,8 +1175,15 @@ buf_flush_page(
 		    && !rw_lock_s_lock_gen_nowait(rw_lock, BUF_IO_WRITE)) {
 			/* avoiding deadlock possibility involves doublewrite
 			buffer, should flush it, because it might hold the
-			another block->lock. */
-			buf_dblwr_flush_buffered_writes();
+			another block->lock. With the parallel doublewrite
+			buffer, only the batch of this instance holds the
+			pages that this thread has posted. */
+			if (buf_dblwr_parallel != NULL) {
+				buf_dblwr_flush_instance_batch(
+					buf_pool, flush_type);
+			} else {
+				buf_dblwr_flush_buffered_writes();
+			}
 
 			rw_lock_s_lock_gen(rw_lock, BUF_IO_WRITE);
                 }
@@ -1823,7 +1931,11 @@ buf_flush_common(
 	buf_flush_t	flush_type,	/*!< in: type of flush */
 	ulint		page_count)	/*!< in: number of pages flushed */
 {
-	if (page_count) {
+	/* With the parallel doublewrite buffer, each instance batch was
+	flushed by buf_dblwr_flush_instance_batch() before buf_flush_end().
+	Flushing all of them here would wait for the batches of the other
+	page cleaners. */
+	if (page_count && buf_dblwr_parallel == NULL) {
 		buf_dblwr_flush_buffered_writes();
 	}
 
@@ -1958,6 +2070,8 @@ buf_flush_LRU(
 
 	buf_flush_batch(buf_pool, BUF_FLUSH_LRU, min_n, 0, limited_scan, n);
 
+	buf_dblwr_flush_instance_batch(buf_pool, BUF_FLUSH_LRU);
+
 	buf_flush_end(buf_pool, BUF_FLUSH_LRU);
 
 	buf_flush_common(BUF_FLUSH_LRU, n->flushed);
@@ -1966,56 +2080,52 @@ buf_flush_LRU(
 }
 
 /*******************************************************************//**
-This utility flushes dirty blocks from the end of the flush list of
-all buffer pool instances.
+Flushes dirty blocks from the end of the flush list of the buffer pool
+instances of one page cleaner slot, i.e., the instances i for which
+i % n_slots == slot_no.
 NOTE: The calling thread is not allowed to own any latches on pages!
 @return true if a batch was queued successfully for each buffer pool
-instance. false if another batch of same type was already running in
-at least one of the buffer pool instance */
-UNIV_INTERN
+instance of the slot. false if another batch of same type was already
+running in at least one of them */
+static
 bool
-buf_flush_list(
-/*===========*/
+buf_flush_list_low(
+/*===============*/
 	ulint		min_n,		/*!< in: wished minimum mumber of blocks
-					flushed (it is not guaranteed that the
-					actual number is that big, though) */
+					flushed from each instance, or
+					ULINT_MAX */
 	lsn_t		lsn_limit,	/*!< in the case BUF_FLUSH_LIST all
 					blocks whose oldest_modification is
 					smaller than this should be flushed
 					(if their number does not exceed
 					min_n), otherwise ignored */
+	ulint		slot_no,	/*!< in: page cleaner slot */
+	ulint		n_slots,	/*!< in: number of page cleaner
+					slots */
 	ulint*		n_processed)	/*!< out: the number of pages
 					which were processed is passed
 					back to caller. Ignored if NULL */
-
 {
 	ulint		i;
 
 	ulint		requested_pages[MAX_BUFFER_POOLS];
 	bool		active_instance[MAX_BUFFER_POOLS];
-	ulint		remaining_instances = srv_buf_pool_instances;
+	ulint		remaining_instances = 0;
 	bool		timeout = false;
 	ulint		flush_start_time = 0;
 
-	for (i = 0; i < srv_buf_pool_instances; i++) {
+	for (i = slot_no; i < srv_buf_pool_instances; i += n_slots) {
 		requested_pages[i] = 0;
 		active_instance[i] = true;
+		remaining_instances++;
 	}
 
 	if (n_processed) {
 		*n_processed = 0;
 	}
 
-	if (min_n != ULINT_MAX) {
-		/* Ensure that flushing is spread evenly amongst the
-		buffer pool instances. When min_n is ULINT_MAX
-		we need to flush everything up to the lsn limit
-		so no limit here. */
-		min_n = (min_n + srv_buf_pool_instances - 1)
-			 / srv_buf_pool_instances;
-		if (lsn_limit != LSN_MAX) {
-			flush_start_time = ut_time_ms();
-		}
+	if (min_n != ULINT_MAX && lsn_limit != LSN_MAX) {
+		flush_start_time = ut_time_ms();
 	}
 
 	/* Flush to lsn_limit in all buffer pool instances */
@@ -2023,7 +2133,7 @@ buf_flush_list(
 
 		ulint flush_common_batch = 0;
 
-		for (i = 0; i < srv_buf_pool_instances; i++) {
+		for (i = slot_no; i < srv_buf_pool_instances; i += n_slots) {
 
 			if (flush_start_time
 			    && (ut_time_ms() - flush_start_time
@@ -2055,6 +2165,9 @@ buf_flush_list(
 						chunk_size, lsn_limit, false,
 						&n);
 
+				buf_dblwr_flush_instance_batch(
+					buf_pool, BUF_FLUSH_LIST);
+
 				buf_flush_end(buf_pool, BUF_FLUSH_LIST);
 
 				flush_common_batch += n.flushed;
@@ -2087,7 +2200,7 @@ buf_flush_list(
 
 	/* If we haven't flushed all the instances due to timeout or a repeat
 	failure to start a flush, return failure */
-	for (i = 0; i < srv_buf_pool_instances; i++) {
+	for (i = slot_no; i < srv_buf_pool_instances; i += n_slots) {
 		if (active_instance[i]) {
 			return(false);
 		}
@@ -2096,6 +2209,42 @@ buf_flush_list(
 	return(true);
 }
 
+/*******************************************************************//**
+This utility flushes dirty blocks from the end of the flush list of
+all buffer pool instances.
+NOTE: The calling thread is not allowed to own any latches on pages!
+@return true if a batch was queued successfully for each buffer pool
+instance. false if another batch of same type was already running in
+at least one of the buffer pool instance */
+UNIV_INTERN
+bool
+buf_flush_list(
+/*===========*/
+	ulint		min_n,		/*!< in: wished minimum mumber of blocks
+					flushed (it is not guaranteed that the
+					actual number is that big, though) */
+	lsn_t		lsn_limit,	/*!< in the case BUF_FLUSH_LIST all
+					blocks whose oldest_modification is
+					smaller than this should be flushed
+					(if their number does not exceed
+					min_n), otherwise ignored */
+	ulint*		n_processed)	/*!< out: the number of pages
+					which were processed is passed
+					back to caller. Ignored if NULL */
+
+{
+	if (min_n != ULINT_MAX) {
+		/* Ensure that flushing is spread evenly amongst the
+		buffer pool instances. When min_n is ULINT_MAX
+		we need to flush everything up to the lsn limit
+		so no limit here. */
+		min_n = (min_n + srv_buf_pool_instances - 1)
+			 / srv_buf_pool_instances;
+	}
+
+	return(buf_flush_list_low(min_n, lsn_limit, 0, 1, n_processed));
+}
+
 /******************************************************************//**
 This function picks up a single dirty page from the tail of the LRU
 list, flushes it, removes it from page_hash and LRU list and puts
@@ -2201,16 +2350,15 @@ buf_flush_single_page_from_LRU(
 }
 
 /*********************************************************************//**
-Clears up tail of the LRU lists:
-* Put replaceable pages at the tail of LRU to the free list
-* Flush dirty pages at the tail of LRU to the disk
-The depth to which we scan each buffer pool is controlled by dynamic
-config parameter innodb_LRU_scan_depth.
+Clears up tail of the LRU lists of the buffer pool instances of one page
+cleaner slot, i.e., the instances i for which i % n_slots == slot_no.
 @return number of pages flushed */
-UNIV_INTERN
+static
 ulint
-buf_flush_LRU_tail(void)
-/*====================*/
+buf_flush_LRU_tail_low(
+/*===================*/
+	ulint	slot_no,	/*!< in: page cleaner slot */
+	ulint	n_slots)	/*!< in: number of page cleaner slots */
 {
 	ulint	total_flushed = 0;
 	ulint	start_time = ut_time_ms();
@@ -2219,12 +2367,12 @@ buf_flush_LRU_tail(void)
 	bool	active_instance[MAX_BUFFER_POOLS];
 	bool	limited_scan[MAX_BUFFER_POOLS];
 	ulint	previous_evicted[MAX_BUFFER_POOLS];
-	ulint	remaining_instances = srv_buf_pool_instances;
+	ulint	remaining_instances = 0;
 	ulint	lru_chunk_size = srv_cleaner_lru_chunk_size;
 	ulint	free_list_lwm = srv_LRU_scan_depth / 100
 		* srv_cleaner_free_list_lwm;
 
-	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+	for (ulint i = slot_no; i < srv_buf_pool_instances; i += n_slots) {
 
 		const buf_pool_t* buf_pool = buf_pool_from_array(i);
 
@@ -2234,6 +2382,7 @@ buf_flush_LRU_tail(void)
 		active_instance[i] = true;
 		limited_scan[i] = true;
 		previous_evicted[i] = 0;
+		remaining_instances++;
 	}
 
 	while (remaining_instances) {
@@ -2243,7 +2392,8 @@ buf_flush_LRU_tail(void)
 			break;
 		}
 
-		for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		for (ulint i = slot_no; i < srv_buf_pool_instances;
+		     i += n_slots) {
 
 			if (!active_instance[i]) {
 				continue;
@@ -2313,6 +2463,47 @@ buf_flush_LRU_tail(void)
 	return(total_flushed);
 }
 
+/*********************************************************************//**
+Clears up tail of the LRU lists:
+* Put replaceable pages at the tail of LRU to the free list
+* Flush dirty pages at the tail of LRU to the disk
+The depth to which we scan each buffer pool is controlled by dynamic
+config parameter innodb_LRU_scan_depth.
+@return number of pages flushed */
+UNIV_INTERN
+ulint
+buf_flush_LRU_tail(void)
+/*====================*/
+{
+	return(buf_flush_LRU_tail_low(0, 1));
+}
+
+/*********************************************************************//**
+Flushes and evicts blocks from the tail of the LRU list of one buffer
+pool instance and waits for the batch to end.  This is used for freeing
+the blocks of the chunks that buf_pool_resize() is withdrawing.
+NOTE: The calling thread is not allowed to own any latches on pages! */
+UNIV_INTERN
+void
+buf_flush_LRU_and_wait(
+/*===================*/
+	buf_pool_t*	buf_pool,	/*!< in/out: buffer pool instance */
+	ulint		min_n)		/*!< in: wished minimum number of
+					blocks flushed or evicted */
+{
+	flush_counters_t	n;
+
+	if (buf_flush_LRU(buf_pool, min_n, false, &n) && n.flushed) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_LRU_BATCH_TOTAL_PAGE,
+			MONITOR_LRU_BATCH_COUNT,
+			MONITOR_LRU_BATCH_PAGES,
+			n.flushed);
+	}
+
+	buf_flush_wait_batch_end(buf_pool, BUF_FLUSH_LRU);
+}
+
 /*********************************************************************//**
 Wait for any possible LRU flushes that are in progress to end. */
 UNIV_INTERN
@@ -2338,6 +2529,209 @@ buf_flush_wait_LRU_batch_end(void)
 	}
 }
 
+/*********************************************************************//**
+Runs the requested flush list batch for one page cleaner slot and updates
+the statistics of the slot. */
+static
+void
+page_cleaner_slot_flush_list(
+/*=========================*/
+	page_cleaner_slot_t*	slot)	/*!< in/out: page cleaner slot */
+{
+	ulint	start_time = ut_time_ms();
+	ulint	n_flushed;
+	bool	success;
+
+	success = buf_flush_list_low(page_cleaner->flush_list_min_n,
+				     page_cleaner->flush_list_lsn_limit,
+				     slot->id, page_cleaner->n_slots,
+				     &n_flushed);
+
+	mutex_enter(&page_cleaner->mutex);
+
+	slot->flush_list_success = success;
+	slot->n_flushed_list = n_flushed;
+	slot->stats.flush_list_batches++;
+	slot->stats.flush_list_pages += n_flushed;
+	slot->stats.flush_list_time += ut_time_ms() - start_time;
+
+	mutex_exit(&page_cleaner->mutex);
+}
+
+/*********************************************************************//**
+Runs an LRU tail batch for one page cleaner slot and updates the
+statistics of the slot. */
+static
+void
+page_cleaner_slot_flush_LRU(
+/*========================*/
+	page_cleaner_slot_t*	slot)	/*!< in/out: page cleaner slot */
+{
+	ulint	start_time = ut_time_ms();
+	ulint	n_flushed;
+
+	n_flushed = buf_flush_LRU_tail_low(slot->id, page_cleaner->n_slots);
+
+	mutex_enter(&page_cleaner->mutex);
+
+	slot->n_flushed_lru = n_flushed;
+	slot->stats.lru_batches++;
+	slot->stats.lru_pages += n_flushed;
+	slot->stats.lru_time += ut_time_ms() - start_time;
+
+	mutex_exit(&page_cleaner->mutex);
+}
+
+/*********************************************************************//**
+Flushes dirty blocks from the end of the flush lists of all buffer pool
+instances, like buf_flush_list(), with each page cleaner slot flushed by
+its worker thread, in parallel with slot 0 flushed by the calling thread.
+@return true if a batch was queued successfully for each buffer pool
+instance */
+static
+bool
+page_cleaner_flush_list(
+/*====================*/
+	ulint		min_n,		/*!< in: wished minimum mumber of blocks
+					flushed, or ULINT_MAX */
+	lsn_t		lsn_limit,	/*!< in: all blocks whose
+					oldest_modification is smaller than
+					this should be flushed (if their
+					number does not exceed min_n) */
+	ulint*		n_processed)	/*!< out: the number of pages
+					which were processed */
+{
+	bool		requested[SRV_MAX_N_PAGE_CLEANERS];
+	bool		success = true;
+	ib_int64_t	sig_count;
+
+	if (min_n != ULINT_MAX) {
+		/* Ensure that flushing is spread evenly amongst the
+		buffer pool instances */
+		min_n = (min_n + srv_buf_pool_instances - 1)
+			 / srv_buf_pool_instances;
+	}
+
+	mutex_enter(&page_cleaner->mutex);
+
+	page_cleaner->flush_list_min_n = min_n;
+	page_cleaner->flush_list_lsn_limit = lsn_limit;
+
+	sig_count = os_event_reset(page_cleaner->flush_list_finished);
+
+	for (ulint i = 1; i < page_cleaner->n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		requested[i] = slot->flush_list_active;
+
+		if (requested[i]) {
+			slot->flush_list_requested = true;
+			page_cleaner->n_flush_list_pending++;
+		}
+	}
+
+	mutex_exit(&page_cleaner->mutex);
+
+	os_event_set(page_cleaner->flush_list_requested);
+
+	page_cleaner_slot_flush_list(&page_cleaner->slots[0]);
+
+	/* Flush the slots whose worker has already exited */
+	for (ulint i = 1; i < page_cleaner->n_slots; i++) {
+		if (!requested[i]) {
+			page_cleaner_slot_flush_list(
+				&page_cleaner->slots[i]);
+		}
+	}
+
+	mutex_enter(&page_cleaner->mutex);
+
+	while (page_cleaner->n_flush_list_pending > 0) {
+		mutex_exit(&page_cleaner->mutex);
+
+		os_event_wait_low(page_cleaner->flush_list_finished,
+				  sig_count);
+		sig_count = os_event_reset(
+			page_cleaner->flush_list_finished);
+
+		mutex_enter(&page_cleaner->mutex);
+	}
+
+	*n_processed = 0;
+
+	for (ulint i = 0; i < page_cleaner->n_slots; i++) {
+		*n_processed += page_cleaner->slots[i].n_flushed_list;
+		success = success
+			  && page_cleaner->slots[i].flush_list_success;
+	}
+
+	mutex_exit(&page_cleaner->mutex);
+
+	return(success);
+}
+
+/*********************************************************************//**
+Clears up the tail of the LRU lists of all buffer pool instances, like
+buf_flush_LRU_tail(), with each page cleaner slot flushed by its worker
+thread, in parallel with slot 0 flushed by the calling thread.
+@return number of pages flushed */
+static
+ulint
+page_cleaner_flush_LRU_tail(void)
+/*=============================*/
+{
+	bool		requested[SRV_MAX_N_PAGE_CLEANERS];
+	ulint		n_flushed = 0;
+	ib_int64_t	sig_count;
+
+	mutex_enter(&page_cleaner->mutex);
+
+	sig_count = os_event_reset(page_cleaner->lru_finished);
+
+	for (ulint i = 1; i < page_cleaner->n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		requested[i] = slot->lru_active;
+
+		if (requested[i]) {
+			slot->lru_requested = true;
+			page_cleaner->n_lru_pending++;
+		}
+	}
+
+	mutex_exit(&page_cleaner->mutex);
+
+	os_event_set(page_cleaner->lru_requested);
+
+	page_cleaner_slot_flush_LRU(&page_cleaner->slots[0]);
+
+	/* Flush the slots whose worker has already exited */
+	for (ulint i = 1; i < page_cleaner->n_slots; i++) {
+		if (!requested[i]) {
+			page_cleaner_slot_flush_LRU(&page_cleaner->slots[i]);
+		}
+	}
+
+	mutex_enter(&page_cleaner->mutex);
+
+	while (page_cleaner->n_lru_pending > 0) {
+		mutex_exit(&page_cleaner->mutex);
+
+		os_event_wait_low(page_cleaner->lru_finished, sig_count);
+		sig_count = os_event_reset(page_cleaner->lru_finished);
+
+		mutex_enter(&page_cleaner->mutex);
+	}
+
+	for (ulint i = 0; i < page_cleaner->n_slots; i++) {
+		n_flushed += page_cleaner->slots[i].n_flushed_lru;
+	}
+
+	mutex_exit(&page_cleaner->mutex);
+
+	return(n_flushed);
+}
+
 /*********************************************************************//**
 Flush a batch of dirty pages from the flush list
 @return number of pages flushed, 0 if no page is flushed or if another
@@ -2353,7 +2747,7 @@ page_cleaner_do_flush_batch(
 {
 	ulint n_flushed;
 
-	buf_flush_list(n_to_flush, lsn_limit, &n_flushed);
+	page_cleaner_flush_list(n_to_flush, lsn_limit, &n_flushed);
 
 	return(n_flushed);
 }
@@ -2865,7 +3259,7 @@ DECLARE_THREAD(buf_flush_lru_manager_thread)(
 
 		next_loop_time = ut_time_ms() + lru_sleep_time;
 
-		lru_n_flushed = buf_flush_LRU_tail();
+		lru_n_flushed = page_cleaner_flush_LRU_tail();
 	}
 
 	buf_lru_manager_is_active = false;
@@ -2877,6 +3271,244 @@ DECLARE_THREAD(buf_flush_lru_manager_thread)(
 	OS_THREAD_DUMMY_RETURN;
 }
 
+/******************************************************************//**
+Runs the requested batches of one kind for a page cleaner slot until the
+shutdown. */
+static
+void
+page_cleaner_worker_loop(
+/*=====================*/
+	page_cleaner_slot_t*	slot,	/*!< in/out: page cleaner slot */
+	bool			lru)	/*!< in: true to run the LRU
+					batches, false to run the flush
+					list batches */
+{
+	bool*		requested;
+	os_event_t	event;
+
+	if (lru) {
+		requested = &slot->lru_requested;
+		event = page_cleaner->lru_requested;
+	} else {
+		requested = &slot->flush_list_requested;
+		event = page_cleaner->flush_list_requested;
+	}
+
+	os_thread_set_priority(os_thread_get_tid(),
+			       srv_sched_priority_cleaner);
+
+	mutex_enter(&page_cleaner->mutex);
+
+	for (;;) {
+		ib_int64_t	sig_count;
+
+		if (*requested) {
+			*requested = false;
+			mutex_exit(&page_cleaner->mutex);
+
+			if (lru) {
+				page_cleaner_slot_flush_LRU(slot);
+			} else {
+				page_cleaner_slot_flush_list(slot);
+			}
+
+			mutex_enter(&page_cleaner->mutex);
+
+			if (lru) {
+				if (--page_cleaner->n_lru_pending == 0) {
+					os_event_set(
+						page_cleaner->lru_finished);
+				}
+			} else if (--page_cleaner->n_flush_list_pending
+				   == 0) {
+				os_event_set(
+					page_cleaner->flush_list_finished);
+			}
+
+			continue;
+		}
+
+		/* The final flushes at shutdown are done by the
+		page_cleaner thread alone */
+		if (srv_shutdown_state >= SRV_SHUTDOWN_FLUSH_PHASE) {
+			break;
+		}
+
+		sig_count = os_event_reset(event);
+
+		mutex_exit(&page_cleaner->mutex);
+
+		os_event_wait_time_low(event, 1000000, sig_count);
+
+		mutex_enter(&page_cleaner->mutex);
+	}
+
+	if (lru) {
+		slot->lru_active = false;
+	} else {
+		slot->flush_list_active = false;
+	}
+
+	mutex_exit(&page_cleaner->mutex);
+
+	os_atomic_decrement_ulint(&buf_page_cleaner_n_workers_active, 1);
+}
+
+/******************************************************************//**
+Page cleaner worker thread, which flushes the flush lists of the buffer
+pool instances of one page cleaner slot when the page_cleaner thread
+requests it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg)		/*!< in: the page cleaner slot */
+{
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_page_cleaner_worker_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	page_cleaner_worker_loop(static_cast<page_cleaner_slot_t*>(arg),
+				 false);
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+LRU manager worker thread, which flushes the LRU list tails of the buffer
+pool instances of one page cleaner slot when the lru_manager thread
+requests it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_lru_manager_worker)(
+/*=========================================*/
+	void*	arg)		/*!< in: the page cleaner slot */
+{
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_lru_manager_worker_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	page_cleaner_worker_loop(static_cast<page_cleaner_slot_t*>(arg),
+				 true);
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+Creates the srv_n_page_cleaners page cleaner slots and starts a page
+cleaner worker thread and an LRU manager worker thread for each slot but
+the first, which the page_cleaner and lru_manager threads flush
+themselves. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void)
+/*=============================*/
+{
+	ut_ad(page_cleaner == NULL);
+	ut_a(srv_n_page_cleaners >= 1);
+	ut_a(srv_n_page_cleaners <= SRV_MAX_N_PAGE_CLEANERS);
+
+	page_cleaner = static_cast<page_cleaner_t*>(
+		mem_zalloc(sizeof *page_cleaner));
+
+	mutex_create(page_cleaner_mutex_key, &page_cleaner->mutex,
+		     SYNC_NO_ORDER_CHECK);
+
+	page_cleaner->flush_list_requested = os_event_create();
+	page_cleaner->lru_requested = os_event_create();
+	page_cleaner->flush_list_finished = os_event_create();
+	page_cleaner->lru_finished = os_event_create();
+
+	page_cleaner->n_slots = srv_n_page_cleaners;
+	page_cleaner->slots = static_cast<page_cleaner_slot_t*>(
+		mem_zalloc(page_cleaner->n_slots
+			   * sizeof *page_cleaner->slots));
+
+	for (ulint i = 0; i < page_cleaner->n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		slot->id = i;
+		slot->flush_list_success = true;
+
+		for (ulint j = i; j < srv_buf_pool_instances;
+		     j += page_cleaner->n_slots) {
+			slot->stats.n_instances++;
+		}
+	}
+
+	for (ulint i = 1; i < page_cleaner->n_slots; i++) {
+		page_cleaner->slots[i].flush_list_active = true;
+		page_cleaner->slots[i].lru_active = true;
+
+		os_atomic_increment_ulint(
+			&buf_page_cleaner_n_workers_active, 2);
+
+		os_thread_create(buf_flush_page_cleaner_worker,
+				 &page_cleaner->slots[i], NULL);
+		os_thread_create(buf_flush_lru_manager_worker,
+				 &page_cleaner->slots[i], NULL);
+	}
+}
+
+/******************************************************************//**
+Frees the page cleaner slots. The worker threads must have exited. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_free(void)
+/*=============================*/
+{
+	if (page_cleaner == NULL) {
+
+		return;
+	}
+
+	ut_a(buf_page_cleaner_n_workers_active == 0);
+
+	mutex_free(&page_cleaner->mutex);
+
+	os_event_free(page_cleaner->flush_list_requested);
+	os_event_free(page_cleaner->lru_requested);
+	os_event_free(page_cleaner->flush_list_finished);
+	os_event_free(page_cleaner->lru_finished);
+
+	mem_free(page_cleaner->slots);
+	mem_free(page_cleaner);
+
+	page_cleaner = NULL;
+}
+
+/******************************************************************//**
+Gets the statistics of a page cleaner slot.
+@return false if there is no such slot */
+UNIV_INTERN
+bool
+buf_flush_page_cleaner_get_stats(
+/*=============================*/
+	ulint				slot_no,/*!< in: slot number */
+	buf_flush_cleaner_stats_t*	stats)	/*!< out: statistics */
+{
+	if (page_cleaner == NULL || slot_no >= page_cleaner->n_slots) {
+
+		return(false);
+	}
+
+	mutex_enter(&page_cleaner->mutex);
+	*stats = page_cleaner->slots[slot_no].stats;
+	mutex_exit(&page_cleaner->mutex);
+
+	return(true);
+}
+
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
 
 /** Functor to validate the flush list. */
@@ -1196,9 +1196,7 @@ buf_LRU_get_free_only(
 
 	mutex_enter_last(&buf_pool->free_list_mutex);
 
-	block = (buf_block_t*) UT_LIST_GET_LAST(buf_pool->free);
-
-	if (block) {
+	while ((block = (buf_block_t*) UT_LIST_GET_LAST(buf_pool->free))) {
 
 		ut_ad(block->page.in_free_list);
 		ut_d(block->page.in_free_list = FALSE);
@@ -1206,6 +1204,20 @@ buf_LRU_get_free_only(
 		ut_ad(!block->page.in_LRU_list);
 		ut_a(!buf_page_in_file(&block->page));
 		UT_LIST_REMOVE(list, buf_pool->free, (&block->page));
+
+		if (buf_pool->curr_size < buf_pool->old_size
+		    && UT_LIST_GET_LEN(buf_pool->withdraw)
+		    < buf_pool->withdraw_target
+		    && buf_block_will_withdrawn(buf_pool, block)) {
+			/* The block is in a chunk that is being
+			removed by buf_pool_resize(): keep it away
+			from any new use. */
+			UT_LIST_ADD_LAST(list, buf_pool->withdraw,
+					 &block->page);
+			ut_d(block->in_withdraw_list = TRUE);
+			continue;
+		}
+
 		buf_block_set_state(block, BUF_BLOCK_READY_FOR_USE);
 
 		mutex_exit(&buf_pool->free_list_mutex);
@@ -1236,7 +1248,9 @@ buf_LRU_check_size_of_non_data_objects(
 /*===================================*/
 	const buf_pool_t*	buf_pool)	/*!< in: buffer pool instance */
 {
-	if (!recv_recovery_on && UT_LIST_GET_LEN(buf_pool->free)
+	if (!recv_recovery_on
+	    && buf_pool->curr_size == buf_pool->old_size
+	    && UT_LIST_GET_LEN(buf_pool->free)
 	    + UT_LIST_GET_LEN(buf_pool->LRU) < buf_pool->curr_size / 20) {
 		ut_print_timestamp(stderr);
 
@@ -1258,6 +1272,7 @@ buf_LRU_check_size_of_non_data_objects(
 		ut_error;
 
 	} else if (!recv_recovery_on
+		   && buf_pool->curr_size == buf_pool->old_size
 		   && (UT_LIST_GET_LEN(buf_pool->free)
 		       + UT_LIST_GET_LEN(buf_pool->LRU))
 		   < buf_pool->curr_size / 3) {
@@ -2276,8 +2291,19 @@ buf_LRU_block_free_non_file_page(
 
 	mutex_enter_first(&buf_pool->free_list_mutex);
 	buf_block_set_state(block, BUF_BLOCK_NOT_USED);
-	UT_LIST_ADD_FIRST(list, buf_pool->free, (&block->page));
-	ut_d(block->page.in_free_list = TRUE);
+
+	if (buf_pool->curr_size < buf_pool->old_size
+	    && UT_LIST_GET_LEN(buf_pool->withdraw)
+	    < buf_pool->withdraw_target
+	    && buf_block_will_withdrawn(buf_pool, block)) {
+		/* Collect the block for buf_pool_resize() */
+		UT_LIST_ADD_LAST(list, buf_pool->withdraw, &block->page);
+		ut_d(block->in_withdraw_list = TRUE);
+	} else {
+		UT_LIST_ADD_FIRST(list, buf_pool->free, (&block->page));
+		ut_d(block->page.in_free_list = TRUE);
+	}
+
 	mutex_exit(&buf_pool->free_list_mutex);
 
 	UNIV_MEM_ASSERT_AND_FREE(block->frame, UNIV_PAGE_SIZE);
@@ -662,6 +662,12 @@ dict_mem_index_free(
 
 	dict_index_zip_pad_mutex_destroy(index);
 
+#ifndef UNIV_HOTBACKUP
+	if (index->stat_hist != NULL) {
+		mem_heap_free(index->stat_hist->heap);
+	}
+#endif /* !UNIV_HOTBACKUP */
+
 	mem_heap_free(index->heap);
 }
 
@@ -32,11 +32,14 @@ Created Jan 06, 2010 Vasil Dimov
 #include "dict0dict.h" /* dict_table_get_first_index(), dict_fs2utf8() */
 #include "dict0mem.h" /* DICT_TABLE_MAGIC_N */
 #include "dict0stats.h"
+#include "data0data.h" /* dtuple_t */
 #include "data0type.h" /* dtype_t */
 #include "db0err.h" /* dberr_t */
 #include "page0page.h" /* page_align() */
 #include "pars0pars.h" /* pars_info_create() */
 #include "pars0types.h" /* pars_info_t */
+#include "os0sync.h" /* os_event_t */
+#include "os0thread.h" /* os_thread_create() */
 #include "que0que.h" /* que_eval_sql() */
 #include "rem0cmp.h" /* REC_MAX_N_FIELDS,cmp_rec_rec_with_match() */
 #include "row0sel.h" /* sel_node_t */
@@ -369,6 +372,7 @@ dict_index_t::indexes<> (newly created)
 dict_index_t::stat_n_diff_key_vals[] (only allocated, left uninitialized)
 dict_index_t::stat_n_sample_sizes[] (only allocated, left uninitialized)
 dict_index_t::stat_n_non_null_key_vals[] (only allocated, left uninitialized)
+dict_index_t::stat_hist (NULL)
 dict_index_t::magic_n
 The returned object should be freed with dict_stats_table_clone_free()
 when no longer needed.
@@ -493,6 +497,8 @@ dict_stats_table_clone_create(
 		idx->stat_n_non_null_key_vals = (ib_uint64_t*) mem_heap_alloc(
 			heap,
 			idx->n_uniq * sizeof(idx->stat_n_non_null_key_vals[0]));
+
+		idx->stat_hist = NULL;
 		ut_d(idx->magic_n = DICT_INDEX_MAGIC_N);
 	}
 
@@ -510,10 +516,173 @@ dict_stats_table_clone_free(
 /*========================*/
 	dict_table_t*	t)	/*!< in: dummy table object to free */
 {
+	for (dict_index_t* index = dict_table_get_first_index(t);
+	     index != NULL;
+	     index = dict_table_get_next_index(index)) {
+
+		if (index->stat_hist != NULL) {
+			mem_heap_free(index->stat_hist->heap);
+		}
+	}
+
 	dict_table_stats_latch_destroy(t);
 	mem_heap_free(t->heap);
 }
 
+/*********************************************************************//**
+Creates an object for the histograms of an index, with no buckets.
+@return histograms object, to be freed with mem_heap_free(hist->heap) */
+static
+dict_index_hist_t*
+dict_stats_hist_create(
+/*===================*/
+	ulint	n_prefixes)	/*!< in: number of key prefixes, n_uniq */
+{
+	mem_heap_t*		heap;
+	dict_index_hist_t*	hist;
+
+	heap = mem_heap_create(1024);
+
+	hist = static_cast<dict_index_hist_t*>(
+		mem_heap_alloc(heap, sizeof(*hist)));
+
+	hist->heap = heap;
+	hist->n_prefixes = n_prefixes;
+
+	hist->n_buckets = static_cast<ulint*>(
+		mem_heap_zalloc(heap, n_prefixes * sizeof(*hist->n_buckets)));
+
+	hist->buckets = static_cast<dict_hist_bucket_t**>(
+		mem_heap_zalloc(heap, n_prefixes * sizeof(*hist->buckets)));
+
+	return(hist);
+}
+
+/*********************************************************************//**
+Copies the first n_fields fields of a key prefix into a memory heap.
+@return the copy */
+static
+const dict_hist_field_t*
+dict_stats_hist_dup_fields(
+/*=======================*/
+	mem_heap_t*			heap,	/*!< in/out: memory heap */
+	const dict_hist_field_t*	fields,	/*!< in: fields to copy */
+	ulint				n_fields)/*!< in: number of fields */
+{
+	dict_hist_field_t*	dup;
+
+	dup = static_cast<dict_hist_field_t*>(
+		mem_heap_alloc(heap, n_fields * sizeof(*dup)));
+
+	for (ulint i = 0; i < n_fields; i++) {
+
+		dup[i].len = fields[i].len;
+
+		if (fields[i].len == UNIV_SQL_NULL) {
+			dup[i].data = NULL;
+		} else {
+			dup[i].data = static_cast<const byte*>(
+				mem_heap_dup(heap, fields[i].data,
+					     fields[i].len));
+		}
+	}
+
+	return(dup);
+}
+
+/*********************************************************************//**
+Compares the first n_fields fields of two key prefixes of an index.
+@return 1, 0, -1, if a is greater, equal, less than b, respectively */
+static
+int
+dict_stats_hist_cmp(
+/*================*/
+	const dict_index_t*		index,	/*!< in: index */
+	const dict_hist_field_t*	a,	/*!< in: key prefix */
+	const dict_hist_field_t*	b,	/*!< in: key prefix */
+	ulint				n_fields)/*!< in: number of fields
+						to compare */
+{
+	for (ulint i = 0; i < n_fields; i++) {
+		const dict_col_t*	col = dict_index_get_nth_col(index, i);
+		int			ret;
+
+		ret = cmp_data_data(col->mtype, col->prtype,
+				    a[i].data, a[i].len, b[i].data, b[i].len);
+
+		if (ret != 0) {
+			return(ret);
+		}
+	}
+
+	return(0);
+}
+
+/*********************************************************************//**
+Replaces the histograms of an index with a copy of those of another
+instance of the index. Histograms whose buckets were not all loaded
+from the persistent statistics storage are not copied. */
+static
+void
+dict_stats_hist_copy(
+/*=================*/
+	dict_index_t*		dst_idx,/*!< in/out: destination index */
+	const dict_index_t*	src_idx)/*!< in: source index */
+{
+	const dict_index_hist_t*	src = src_idx->stat_hist;
+	dict_index_hist_t*		dst = NULL;
+
+	if (dst_idx->stat_hist != NULL) {
+		mem_heap_free(dst_idx->stat_hist->heap);
+		dst_idx->stat_hist = NULL;
+	}
+
+	if (src == NULL) {
+		return;
+	}
+
+	ulint	n_prefixes = ut_min(ulint(dst_idx->n_uniq), src->n_prefixes);
+
+	for (ulint n = 1; n <= n_prefixes; n++) {
+
+		const dict_hist_bucket_t*	buckets = src->buckets[n - 1];
+		ulint				n_buckets;
+		ulint				i;
+
+		n_buckets = src->n_buckets[n - 1];
+
+		for (i = 0; i < n_buckets; i++) {
+			if (buckets[i].endpoint == NULL) {
+				break;
+			}
+		}
+
+		if (n_buckets == 0 || i < n_buckets) {
+			continue;
+		}
+
+		if (dst == NULL) {
+			dst = dict_stats_hist_create(dst_idx->n_uniq);
+		}
+
+		dict_hist_bucket_t*	copy;
+
+		copy = static_cast<dict_hist_bucket_t*>(
+			mem_heap_alloc(dst->heap, n_buckets * sizeof(*copy)));
+
+		for (i = 0; i < n_buckets; i++) {
+			copy[i] = buckets[i];
+			copy[i].endpoint = dict_stats_hist_dup_fields(
+				dst->heap, buckets[i].endpoint, n);
+		}
+
+		dst->buckets[n - 1] = copy;
+		dst->n_buckets[n - 1] = n_buckets;
+	}
+
+	dst_idx->stat_hist = dst;
+}
+
 /*********************************************************************//**
 Write all zeros (or 1 where it makes sense) into an index
 statistics members. The resulting stats correspond to an empty index.
@@ -538,6 +707,11 @@ dict_stats_empty_index(
 
 	index->stat_index_size = 1;
 	index->stat_n_leaf_pages = 1;
+
+	if (index->stat_hist != NULL) {
+		mem_heap_free(index->stat_hist->heap);
+		index->stat_hist = NULL;
+	}
 }
 
 /*********************************************************************//**
@@ -738,6 +912,8 @@ dict_stats_copy(
 		dst_idx->stat_index_size = src_idx->stat_index_size;
 
 		dst_idx->stat_n_leaf_pages = src_idx->stat_n_leaf_pages;
+
+		dict_stats_hist_copy(dst_idx, src_idx);
 	}
 
 	dst->stat_initialized = TRUE;
@@ -761,6 +937,7 @@ dict_index_t::stat_n_sample_sizes[]
 dict_index_t::stat_n_non_null_key_vals[]
 dict_index_t::stat_index_size
 dict_index_t::stat_n_leaf_pages
+dict_index_t::stat_hist
 The returned object should be freed with dict_stats_snapshot_free()
 when no longer needed.
 @return incomplete table object */
@@ -1878,159 +2055,696 @@ dict_stats_index_set_n_diff(
 	}
 }
 
+/* Key prefixes of the records sampled for the histograms of an index,
+each one with dict_index_get_n_unique(index) fields */
+typedef std::vector<const dict_hist_field_t*>	hist_sample_t;
+
+/** Orders the key prefixes of the sample on their first n_fields fields */
+struct hist_sample_less {
+	hist_sample_less(const dict_index_t* index, ulint n_fields)
+		: m_index(index), m_n_fields(n_fields) {}
+
+	bool operator()(
+		const dict_hist_field_t*	a,
+		const dict_hist_field_t*	b) const
+	{
+		return(dict_stats_hist_cmp(m_index, a, b, m_n_fields) < 0);
+	}
+
+	const dict_index_t*	m_index;
+	ulint			m_n_fields;
+};
+
 /*********************************************************************//**
-Calculates new statistics for a given index and saves them to the index
-members stat_n_diff_key_vals[], stat_n_sample_sizes[], stat_index_size and
-stat_n_leaf_pages. This function could be slow. */
+Prints a histogram bucket for the stat_description column of
+mysql.innodb_index_stats: the number of records equal to the endpoint,
+then the endpoint fields in hex, NULL for SQL NULL, for example
+"12:8000002a,NULL".
+@return true if the bucket fits in the buffer */
 static
-void
-dict_stats_analyze_index(
-/*=====================*/
-	dict_index_t*	index)	/*!< in/out: index to analyze */
+bool
+dict_stats_hist_print_bucket(
+/*=========================*/
+	const dict_hist_bucket_t*	bucket,	/*!< in: bucket */
+	ulint				n_fields,/*!< in: number of fields
+						in the endpoint */
+	char*				buf,	/*!< out: printed bucket */
+	ulint				size)	/*!< in: size of buf */
 {
-	ulint		root_level;
-	ulint		level;
-	bool		level_is_analyzed;
-	ulint		n_uniq;
-	ulint		n_prefix;
-	ib_uint64_t	total_recs;
-	ib_uint64_t	total_pages;
-	mtr_t		mtr;
-	ulint		size;
-	DBUG_ENTER("dict_stats_analyze_index");
+	static const char	hex[] = "0123456789abcdef";
+	ulint			len;
 
-	DBUG_PRINT("info", ("index: %s, online status: %d", index->name,
-			    dict_index_get_online_status(index)));
+	len = ut_snprintf(buf, size, UINT64PF ":", bucket->n_endpoint_rows);
 
-	DEBUG_PRINTF("  %s(index=%s)\n", __func__, index->name);
+	for (ulint i = 0; i < n_fields; i++) {
+		const dict_hist_field_t*	field = &bucket->endpoint[i];
+		ulint				field_len;
 
-	dict_stats_empty_index(index);
+		field_len = field->len == UNIV_SQL_NULL ? 4 : 2 * field->len;
 
-	mtr_start(&mtr);
+		if (len + (i > 0) + field_len >= size) {
+			return(false);
+		}
 
-	mtr_s_lock(dict_index_get_lock(index), &mtr);
+		if (i > 0) {
+			buf[len++] = ',';
+		}
 
-	size = btr_get_size(index, BTR_TOTAL_SIZE, &mtr);
+		if (field->len == UNIV_SQL_NULL) {
+			memcpy(buf + len, "NULL", 4);
+			len += 4;
+			continue;
+		}
 
-	if (size != ULINT_UNDEFINED) {
-		index->stat_index_size = size;
-		size = btr_get_size(index, BTR_N_LEAF_PAGES, &mtr);
+		for (ulint j = 0; j < field->len; j++) {
+			buf[len++] = hex[field->data[j] >> 4];
+			buf[len++] = hex[field->data[j] & 15];
+		}
 	}
 
-	/* Release the X locks on the root page taken by btr_get_size() */
-	mtr_commit(&mtr);
+	buf[len] = '\0';
 
-	switch (size) {
-	case ULINT_UNDEFINED:
-		dict_stats_assert_initialized_index(index);
-		DBUG_VOID_RETURN;
-	case 0:
-		/* The root node of the tree is a leaf */
-		size = 1;
+	return(true);
+}
+
+/*********************************************************************//**
+@return value of a lower case hex digit, or -1 if c is not one */
+static
+int
+dict_stats_hist_hex_digit(
+/*======================*/
+	char	c)	/*!< in: character */
+{
+	if (c >= '0' && c <= '9') {
+		return(c - '0');
+	} else if (c >= 'a' && c <= 'f') {
+		return(c - 'a' + 10);
 	}
 
-	index->stat_n_leaf_pages = size;
+	return(-1);
+}
 
-	mtr_start(&mtr);
+/*********************************************************************//**
+Parses a histogram bucket printed by dict_stats_hist_print_bucket() and
+sets the endpoint and n_endpoint_rows of the bucket from it.
+@return true on success, false if str is malformed */
+static
+bool
+dict_stats_hist_parse_bucket(
+/*=========================*/
+	const char*		str,	/*!< in: printed bucket, not
+					'\0'-terminated */
+	ulint			len,	/*!< in: length of str */
+	ulint			n_fields,/*!< in: number of fields
+					in the endpoint */
+	mem_heap_t*		heap,	/*!< in/out: memory heap for
+					the endpoint */
+	dict_hist_bucket_t*	bucket)	/*!< out: bucket */
+{
+	const char*		end = str + len;
+	const char*		p = str;
+	ib_uint64_t		n_endpoint_rows = 0;
+	dict_hist_field_t*	fields;
 
-	mtr_s_lock(dict_index_get_lock(index), &mtr);
+	if (p == end || *p < '0' || *p > '9') {
+		return(false);
+	}
 
-	root_level = btr_height_get(index, &mtr);
+	while (p < end && *p >= '0' && *p <= '9') {
+		n_endpoint_rows = n_endpoint_rows * 10 + (*p++ - '0');
+	}
 
-	n_uniq = dict_index_get_n_unique(index);
+	if (p == end || *p++ != ':') {
+		return(false);
+	}
 
-	/* If the tree has just one level (and one page) or if the user
-	has requested to sample too many pages then do full scan.
+	fields = static_cast<dict_hist_field_t*>(
+		mem_heap_alloc(heap, n_fields * sizeof(*fields)));
 
-	For each n-column prefix (for n=1..n_uniq) N_SAMPLE_PAGES(index)
-	will be sampled, so in total N_SAMPLE_PAGES(index) * n_uniq leaf
-	pages will be sampled. If that number is bigger than the total
-	number of leaf pages then do full scan of the leaf level instead
-	since it will be faster and will give better results. */
+	for (ulint i = 0; i < n_fields; i++) {
+		const char*	field_end;
 
-	if (root_level == 0
-	    || N_SAMPLE_PAGES(index) * n_uniq > index->stat_n_leaf_pages) {
+		if (i > 0 && (p == end || *p++ != ',')) {
+			return(false);
+		}
 
-		if (root_level == 0) {
-			DEBUG_PRINTF("  %s(): just one page, "
-				     "doing full scan\n", __func__);
-		} else {
-			DEBUG_PRINTF("  %s(): too many pages requested for "
-				     "sampling, doing full scan\n", __func__);
+		for (field_end = p;
+		     field_end < end && *field_end != ',';
+		     field_end++) {
 		}
 
-		/* do full scan of level 0; save results directly
-		into the index */
+		if (field_end - p == 4 && memcmp(p, "NULL", 4) == 0) {
+			fields[i].data = NULL;
+			fields[i].len = UNIV_SQL_NULL;
+			p = field_end;
+			continue;
+		}
 
-		dict_stats_analyze_index_level(index,
-					       0 /* leaf level */,
-					       index->stat_n_diff_key_vals,
-					       &total_recs,
-					       &total_pages,
-					       NULL /* boundaries not needed */,
-					       &mtr);
+		if ((field_end - p) % 2 != 0) {
+			return(false);
+		}
 
-		for (ulint i = 0; i < n_uniq; i++) {
-			index->stat_n_sample_sizes[i] = total_pages;
+		byte*	data;
+
+		fields[i].len = (field_end - p) / 2;
+		data = static_cast<byte*>(mem_heap_alloc(heap, fields[i].len));
+
+		for (ulint j = 0; j < fields[i].len; j++, p += 2) {
+			int	high = dict_stats_hist_hex_digit(p[0]);
+			int	low = dict_stats_hist_hex_digit(p[1]);
+
+			if (high < 0 || low < 0) {
+				return(false);
+			}
+
+			data[j] = static_cast<byte>((high << 4) | low);
 		}
 
-		mtr_commit(&mtr);
+		fields[i].data = data;
+	}
 
-		dict_stats_assert_initialized_index(index);
-		DBUG_VOID_RETURN;
+	if (p != end) {
+		return(false);
 	}
 
-	/* For each level that is being scanned in the btree, this contains the
-	number of different key values for all possible n-column prefixes. */
-	ib_uint64_t*		n_diff_on_level = new ib_uint64_t[n_uniq];
+	bucket->endpoint = fields;
+	bucket->n_endpoint_rows = n_endpoint_rows;
 
-	/* For each level that is being scanned in the btree, this contains the
-	index of the last record from each group of equal records (when
-	comparing only the first n columns, n=1..n_uniq). */
-	boundaries_t*		n_diff_boundaries = new boundaries_t[n_uniq];
+	return(true);
+}
 
-	/* For each n-column prefix this array contains the input data that is
-	used to calculate dict_index_t::stat_n_diff_key_vals[]. */
-	n_diff_data_t*		n_diff_data = new n_diff_data_t[n_uniq];
+/*********************************************************************//**
+Adds the key prefix of a record to the sample for the histograms of an
+index. Delete-marked records are skipped. */
+static
+void
+dict_stats_hist_sample_rec(
+/*=======================*/
+	dict_index_t*	index,		/*!< in: index */
+	const rec_t*	rec,		/*!< in: leaf page user record */
+	ulint**		offsets,	/*!< in/out: rec_get_offsets() */
+	mem_heap_t**	offsets_heap,	/*!< in/out: heap for offsets */
+	mem_heap_t*	heap,		/*!< in/out: heap for the sample */
+	hist_sample_t*	sample)		/*!< in/out: sample */
+{
+	ulint			n_uniq = dict_index_get_n_unique(index);
+	dict_hist_field_t*	fields;
 
-	/* total_recs is also used to estimate the number of pages on one
-	level below, so at the start we have 1 page (the root) */
-	total_recs = 1;
+	if (rec_get_deleted_flag(rec, dict_table_is_comp(index->table))) {
+		return;
+	}
 
-	/* Here we use the following optimization:
-	If we find that level L is the first one (searching from the
-	root) that contains at least D distinct keys when looking at
-	the first n_prefix columns, then:
-	if we look at the first n_prefix-1 columns then the first
-	level that contains D distinct keys will be either L or a
-	lower one.
-	So if we find that the first level containing D distinct
-	keys (on n_prefix columns) is L, we continue from L when
-	searching for D distinct keys on n_prefix-1 columns. */
-	level = root_level;
-	level_is_analyzed = false;
+	*offsets = rec_get_offsets(rec, index, *offsets, n_uniq, offsets_heap);
 
-	for (n_prefix = n_uniq; n_prefix >= 1; n_prefix--) {
+	fields = static_cast<dict_hist_field_t*>(
+		mem_heap_alloc(heap, n_uniq * sizeof(*fields)));
 
-		DEBUG_PRINTF("  %s(): searching level with >=%llu "
-			     "distinct records, n_prefix=%lu\n",
-			     __func__, N_DIFF_REQUIRED(index), n_prefix);
+	for (ulint i = 0; i < n_uniq; i++) {
+		const byte*	data;
+		ulint		len;
+
+		data = rec_get_nth_field(rec, *offsets, i, &len);
+
+		fields[i].len = len;
+		fields[i].data = len == UNIV_SQL_NULL
+			? NULL
+			: static_cast<const byte*>(mem_heap_dup(heap, data, len));
+	}
+
+	sample->push_back(fields);
+}
+
+/*********************************************************************//**
+Collects the key prefixes of the records of N_SAMPLE_PAGES(index) leaf
+pages of an index, picked by random dives. If the index does not have
+more leaf pages than that, all of them are read instead. */
+static
+void
+dict_stats_hist_sample(
+/*===================*/
+	dict_index_t*	index,	/*!< in: index */
+	mem_heap_t*	heap,	/*!< in/out: heap for the sample */
+	hist_sample_t*	sample)	/*!< out: sample */
+{
+	mtr_t		mtr;
+	mem_heap_t*	offsets_heap = NULL;
+	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*		offsets = offsets_;
+	rec_offs_init(offsets_);
+
+	if (index->stat_n_leaf_pages <= N_SAMPLE_PAGES(index)) {
+		btr_pcur_t	pcur;
 
-		/* Commit the mtr to release the tree S lock to allow
-		other threads to do some work too. */
-		mtr_commit(&mtr);
 		mtr_start(&mtr);
 		mtr_s_lock(dict_index_get_lock(index), &mtr);
-		if (root_level != btr_height_get(index, &mtr)) {
-			/* Just quit if the tree has changed beyond
-			recognition here. The old stats from previous
-			runs will remain in the values that we have
-			not calculated yet. Initially when the index
-			object is created the stats members are given
-			some sensible values so leaving them untouched
-			here even the first time will not cause us to
-			read uninitialized memory later. */
-			break;
+
+		btr_pcur_open_at_index_side(
+			true, index, BTR_SEARCH_LEAF | BTR_ALREADY_S_LATCHED,
+			&pcur, true, 0, &mtr);
+		btr_pcur_move_to_next_on_page(&pcur);
+
+		for (;
+		     btr_pcur_is_on_user_rec(&pcur);
+		     btr_pcur_move_to_next_user_rec(&pcur, &mtr)) {
+
+			dict_stats_hist_sample_rec(
+				index, btr_pcur_get_rec(&pcur),
+				&offsets, &offsets_heap, heap, sample);
+		}
+
+		btr_leaf_page_release(btr_pcur_get_block(&pcur),
+				      BTR_SEARCH_LEAF, &mtr);
+
+		btr_pcur_close(&pcur);
+
+		mtr_commit(&mtr);
+	} else {
+		for (ib_uint64_t i = 0; i < N_SAMPLE_PAGES(index); i++) {
+			btr_cur_t	cursor;
+			const page_t*	page;
+			const rec_t*	rec;
+
+			mtr_start(&mtr);
+
+			btr_cur_open_at_rnd_pos(index, BTR_SEARCH_LEAF,
+						&cursor, &mtr);
+
+			page = btr_cur_get_page(&cursor);
+
+			for (rec = page_rec_get_next_const(
+				     page_get_infimum_rec(page));
+			     !page_rec_is_supremum(rec);
+			     rec = page_rec_get_next_const(rec)) {
+
+				dict_stats_hist_sample_rec(
+					index, rec, &offsets, &offsets_heap,
+					heap, sample);
+			}
+
+			mtr_commit(&mtr);
+		}
+	}
+
+	if (offsets_heap != NULL) {
+		mem_heap_free(offsets_heap);
+	}
+}
+
+/*********************************************************************//**
+Builds equi-height histograms with up to srv_stats_histogram_buckets
+buckets on the key prefixes of an index, from a sample of its leaf pages.
+Each bucket is extended to all the sampled records that are equal to its
+endpoint, so that a value never spans two buckets. The counts are scaled
+from the sample to the stat_n_diff_key_vals[] of the index, which must
+have been calculated already. A histogram is built on the n-column prefix
+only if the endpoints of all of its buckets can be saved in
+mysql.innodb_index_stats, and then also on the shorter prefixes. */
+static
+void
+dict_stats_hist_build(
+/*==================*/
+	dict_index_t*	index)	/*!< in/out: index */
+{
+	ulint			n_uniq = dict_index_get_n_unique(index);
+	ulint			max_buckets = srv_stats_histogram_buckets;
+	mem_heap_t*		heap;
+	hist_sample_t		sample;
+	dict_index_hist_t*	hist = NULL;
+
+	ut_ad(index->stat_hist == NULL);
+
+	if (max_buckets == 0) {
+		return;
+	}
+
+	heap = mem_heap_create(UNIV_PAGE_SIZE);
+
+	dict_stats_hist_sample(index, heap, &sample);
+
+	ulint	n_sample = sample.size();
+
+	if (n_sample == 0) {
+		mem_heap_free(heap);
+		return;
+	}
+
+	std::sort(sample.begin(), sample.end(),
+		  hist_sample_less(index, n_uniq));
+
+	/* the number of records in the index per sampled record */
+	double	rows_factor = static_cast<double>(
+		ut_max(index->stat_n_diff_key_vals[n_uniq - 1],
+		       static_cast<ib_uint64_t>(n_sample))) / n_sample;
+
+	ulint	per_bucket = (n_sample + max_buckets - 1) / max_buckets;
+
+	for (ulint n = 1; n <= n_uniq; n++) {
+
+		/* the number of different key prefixes in the index
+		per different key prefix in the sample */
+		ulint	n_diff_sample = 1;
+
+		for (ulint i = 1; i < n_sample; i++) {
+			if (dict_stats_hist_cmp(index, sample[i - 1],
+						sample[i], n) != 0) {
+				n_diff_sample++;
+			}
+		}
+
+		double	diff_factor = ut_max(
+			1.0, static_cast<double>(
+				index->stat_n_diff_key_vals[n - 1])
+			/ n_diff_sample);
+
+		if (hist == NULL) {
+			hist = dict_stats_hist_create(n_uniq);
+		}
+
+		dict_hist_bucket_t*	buckets;
+		ulint			n_buckets = 0;
+		bool			fits = true;
+
+		buckets = static_cast<dict_hist_bucket_t*>(
+			mem_heap_alloc(hist->heap,
+				       max_buckets * sizeof(*buckets)));
+
+		for (ulint first = 0; first < n_sample && fits; ) {
+
+			ulint	last = ut_min(first + per_bucket, n_sample) - 1;
+
+			while (last + 1 < n_sample
+			       && dict_stats_hist_cmp(index, sample[last],
+						      sample[last + 1], n)
+			       == 0) {
+				last++;
+			}
+
+			ulint	n_distinct = 1;
+			ulint	n_endpoint = 1;
+
+			for (ulint i = first + 1; i <= last; i++) {
+				if (dict_stats_hist_cmp(index, sample[i - 1],
+							sample[i], n) != 0) {
+					n_distinct++;
+					n_endpoint = 1;
+				} else {
+					n_endpoint++;
+				}
+			}
+
+			ut_a(n_buckets < max_buckets);
+
+			dict_hist_bucket_t*	bucket = &buckets[n_buckets++];
+
+			bucket->endpoint = dict_stats_hist_dup_fields(
+				hist->heap, sample[last], n);
+
+			bucket->n_rows = static_cast<ib_uint64_t>(
+				(last - first + 1) * rows_factor + 0.5);
+
+			/* A value that was sampled only once is taken to
+			be as frequent as an average value */
+			bucket->n_endpoint_rows = static_cast<ib_uint64_t>(
+				n_endpoint > 1
+				? n_endpoint * rows_factor + 0.5
+				: ut_max(1.0, rows_factor / diff_factor));
+
+			bucket->n_distinct = ut_min(
+				bucket->n_rows,
+				static_cast<ib_uint64_t>(
+					n_distinct * diff_factor + 0.5));
+
+			char	buf[1024];
+
+			fits = dict_stats_hist_print_bucket(
+				bucket, n, buf, sizeof(buf));
+
+			first = last + 1;
+		}
+
+		if (!fits) {
+			/* longer prefixes will not fit either */
+			break;
+		}
+
+		hist->buckets[n - 1] = buckets;
+		hist->n_buckets[n - 1] = n_buckets;
+	}
+
+	if (hist != NULL && hist->n_buckets[0] == 0) {
+		mem_heap_free(hist->heap);
+		hist = NULL;
+	}
+
+	index->stat_hist = hist;
+
+	mem_heap_free(heap);
+}
+
+/*********************************************************************//**
+Estimates the number of records of an index that are equal to a search
+tuple, from the histogram on the key prefix that is as long as the tuple.
+@return approximate number of records, or UINT64_UNDEFINED if the index
+has no histogram on that key prefix */
+UNIV_INTERN
+ib_uint64_t
+dict_stats_hist_estimate(
+/*=====================*/
+	const dict_index_t*	index,	/*!< in: index */
+	const dtuple_t*		tuple)	/*!< in: search tuple */
+{
+	ulint		n_fields = dtuple_get_n_fields(tuple);
+	ib_uint64_t	n_rows = UINT64_UNDEFINED;
+
+	if (n_fields == 0) {
+		return(n_rows);
+	}
+
+	std::vector<dict_hist_field_t>	key(n_fields);
+
+	for (ulint i = 0; i < n_fields; i++) {
+		const dfield_t*	dfield = dtuple_get_nth_field(tuple, i);
+
+		key[i].len = dfield_get_len(dfield);
+		key[i].data = dfield_is_null(dfield)
+			? NULL
+			: static_cast<const byte*>(dfield_get_data(dfield));
+	}
+
+	dict_table_stats_lock(index->table, RW_S_LATCH);
+
+	const dict_index_hist_t*	hist = index->stat_hist;
+
+	if (hist != NULL
+	    && n_fields <= hist->n_prefixes
+	    && hist->n_buckets[n_fields - 1] > 0) {
+
+		const dict_hist_bucket_t*	buckets;
+		ulint				low = 0;
+		ulint				high;
+
+		buckets = hist->buckets[n_fields - 1];
+		high = hist->n_buckets[n_fields - 1];
+
+		/* find the first bucket whose endpoint is not less
+		than the key */
+		while (low < high) {
+			ulint	mid = (low + high) / 2;
+
+			if (dict_stats_hist_cmp(index, buckets[mid].endpoint,
+						&key[0], n_fields) < 0) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+
+		/* If the key is greater than all the endpoints, it was
+		not in the sample and we know nothing about it */
+		if (low < hist->n_buckets[n_fields - 1]) {
+			const dict_hist_bucket_t*	bucket = &buckets[low];
+
+			if (dict_stats_hist_cmp(index, bucket->endpoint,
+						&key[0], n_fields) == 0) {
+
+				n_rows = bucket->n_endpoint_rows;
+
+			} else if (bucket->n_distinct > 1
+				   && bucket->n_rows
+				   > bucket->n_endpoint_rows) {
+
+				n_rows = (bucket->n_rows
+					  - bucket->n_endpoint_rows)
+					/ (bucket->n_distinct - 1);
+			} else {
+				n_rows = 1;
+			}
+		}
+	}
+
+	dict_table_stats_unlock(index->table, RW_S_LATCH);
+
+	return(n_rows);
+}
+
+/*********************************************************************//**
+Calculates new statistics for a given index and saves them to the index
+members stat_n_diff_key_vals[], stat_n_sample_sizes[], stat_index_size,
+stat_n_leaf_pages and stat_hist. This function could be slow. */
+static
+void
+dict_stats_analyze_index(
+/*=====================*/
+	dict_index_t*	index)	/*!< in/out: index to analyze */
+{
+	ulint		root_level;
+	ulint		level;
+	bool		level_is_analyzed;
+	ulint		n_uniq;
+	ulint		n_prefix;
+	ib_uint64_t	total_recs;
+	ib_uint64_t	total_pages;
+	mtr_t		mtr;
+	ulint		size;
+	DBUG_ENTER("dict_stats_analyze_index");
+
+	DBUG_PRINT("info", ("index: %s, online status: %d", index->name,
+			    dict_index_get_online_status(index)));
+
+	DEBUG_PRINTF("  %s(index=%s)\n", __func__, index->name);
+
+	dict_stats_empty_index(index);
+
+	/* modifications made from now on will count for the next time */
+	index->stat_modified_counter = 0;
+
+	mtr_start(&mtr);
+
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	size = btr_get_size(index, BTR_TOTAL_SIZE, &mtr);
+
+	if (size != ULINT_UNDEFINED) {
+		index->stat_index_size = size;
+		size = btr_get_size(index, BTR_N_LEAF_PAGES, &mtr);
+	}
+
+	/* Release the X locks on the root page taken by btr_get_size() */
+	mtr_commit(&mtr);
+
+	switch (size) {
+	case ULINT_UNDEFINED:
+		dict_stats_assert_initialized_index(index);
+		DBUG_VOID_RETURN;
+	case 0:
+		/* The root node of the tree is a leaf */
+		size = 1;
+	}
+
+	index->stat_n_leaf_pages = size;
+
+	mtr_start(&mtr);
+
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	root_level = btr_height_get(index, &mtr);
+
+	n_uniq = dict_index_get_n_unique(index);
+
+	/* If the tree has just one level (and one page) or if the user
+	has requested to sample too many pages then do full scan.
+
+	For each n-column prefix (for n=1..n_uniq) N_SAMPLE_PAGES(index)
+	will be sampled, so in total N_SAMPLE_PAGES(index) * n_uniq leaf
+	pages will be sampled. If that number is bigger than the total
+	number of leaf pages then do full scan of the leaf level instead
+	since it will be faster and will give better results. */
+
+	if (root_level == 0
+	    || N_SAMPLE_PAGES(index) * n_uniq > index->stat_n_leaf_pages) {
+
+		if (root_level == 0) {
+			DEBUG_PRINTF("  %s(): just one page, "
+				     "doing full scan\n", __func__);
+		} else {
+			DEBUG_PRINTF("  %s(): too many pages requested for "
+				     "sampling, doing full scan\n", __func__);
+		}
+
+		/* do full scan of level 0; save results directly
+		into the index */
+
+		dict_stats_analyze_index_level(index,
+					       0 /* leaf level */,
+					       index->stat_n_diff_key_vals,
+					       &total_recs,
+					       &total_pages,
+					       NULL /* boundaries not needed */,
+					       &mtr);
+
+		for (ulint i = 0; i < n_uniq; i++) {
+			index->stat_n_sample_sizes[i] = total_pages;
+		}
+
+		mtr_commit(&mtr);
+
+		dict_stats_hist_build(index);
+
+		dict_stats_assert_initialized_index(index);
+		DBUG_VOID_RETURN;
+	}
+
+	/* For each level that is being scanned in the btree, this contains the
+	number of different key values for all possible n-column prefixes. */
+	ib_uint64_t*		n_diff_on_level = new ib_uint64_t[n_uniq];
+
+	/* For each level that is being scanned in the btree, this contains the
+	index of the last record from each group of equal records (when
+	comparing only the first n columns, n=1..n_uniq). */
+	boundaries_t*		n_diff_boundaries = new boundaries_t[n_uniq];
+
+	/* For each n-column prefix this array contains the input data that is
+	used to calculate dict_index_t::stat_n_diff_key_vals[]. */
+	n_diff_data_t*		n_diff_data = new n_diff_data_t[n_uniq];
+
+	/* total_recs is also used to estimate the number of pages on one
+	level below, so at the start we have 1 page (the root) */
+	total_recs = 1;
+
+	/* Here we use the following optimization:
+	If we find that level L is the first one (searching from the
+	root) that contains at least D distinct keys when looking at
+	the first n_prefix columns, then:
+	if we look at the first n_prefix-1 columns then the first
+	level that contains D distinct keys will be either L or a
+	lower one.
+	So if we find that the first level containing D distinct
+	keys (on n_prefix columns) is L, we continue from L when
+	searching for D distinct keys on n_prefix-1 columns. */
+	level = root_level;
+	level_is_analyzed = false;
+
+	for (n_prefix = n_uniq; n_prefix >= 1; n_prefix--) {
+
+		DEBUG_PRINTF("  %s(): searching level with >=%llu "
+			     "distinct records, n_prefix=%lu\n",
+			     __func__, N_DIFF_REQUIRED(index), n_prefix);
+
+		/* Commit the mtr to release the tree S lock to allow
+		other threads to do some work too. */
+		mtr_commit(&mtr);
+		mtr_start(&mtr);
+		mtr_s_lock(dict_index_get_lock(index), &mtr);
+		if (root_level != btr_height_get(index, &mtr)) {
+			/* Just quit if the tree has changed beyond
+			recognition here. The old stats from previous
+			runs will remain in the values that we have
+			not calculated yet. Initially when the index
+			object is created the stats members are given
+			some sensible values so leaving them untouched
+			here even the first time will not cause us to
+			read uninitialized memory later. */
+			break;
 		}
 
 		/* check whether we should pick the current level;
@@ -2167,6 +2881,8 @@ found_level:
 	due to tree being changed and so n_diff_data[] is set up. */
 	if (n_prefix == 0) {
 		dict_stats_index_set_n_diff(n_diff_data, index);
+
+		dict_stats_hist_build(index);
 	}
 
 	delete[] n_diff_data;
@@ -2175,6 +2891,141 @@ found_level:
 	DBUG_VOID_RETURN;
 }
 
+/** Indexes of a table that several threads analyze in parallel,
+see dict_stats_analyze_indexes() */
+struct analyze_wq_t {
+	dict_table_t*		table;	/*!< table of the indexes */
+	dict_index_t**		indexes;/*!< indexes to analyze */
+	ulint			n_indexes;/*!< number of indexes */
+	ulint			next;	/*!< indexes[next] is the next index
+					to analyze; incremented atomically */
+	ulint			n_running;/*!< number of threads besides the
+					caller that are still running;
+					decremented atomically */
+	os_event_t		done;	/*!< set when n_running drops to 0 */
+};
+
+/*********************************************************************//**
+Analyzes indexes from a work queue until none are left. After a
+shutdown is requested only the clustered index is analyzed, the other
+indexes are left with their empty stats. */
+static
+void
+dict_stats_analyze_wq_run(
+/*======================*/
+	analyze_wq_t*	wq)	/*!< in/out: work queue */
+{
+	for (;;) {
+		ulint		i = os_atomic_increment_ulint(&wq->next, 1) - 1;
+		dict_index_t*	index;
+
+		if (i >= wq->n_indexes) {
+			break;
+		}
+
+		index = wq->indexes[i];
+
+		if (dict_index_is_clust(index)
+		    || !(wq->table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
+			dict_stats_analyze_index(index);
+		}
+	}
+}
+
+/*********************************************************************//**
+A thread that helps dict_stats_analyze_indexes() analyze indexes.
+@return a dummy parameter */
+static
+os_thread_ret_t
+dict_stats_analyze_thread(
+/*======================*/
+	void*	arg)	/*!< in: analyze_wq_t work queue */
+{
+	analyze_wq_t*	wq = static_cast<analyze_wq_t*>(arg);
+
+	dict_stats_analyze_wq_run(wq);
+
+	if (os_atomic_decrement_ulint(&wq->n_running, 1) == 0) {
+		os_event_set(wq->done);
+	}
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Analyzes indexes of a table with dict_stats_analyze_index(), with up to
+srv_stats_analyze_threads threads at a time, one index per thread. The
+calling thread is one of them and returns when all of the indexes are
+done. The indexes do not share anything but the table stats latch, which
+the caller must own in X mode for the whole time. */
+static
+void
+dict_stats_analyze_indexes(
+/*=======================*/
+	dict_table_t*	table,		/*!< in: table */
+	dict_index_t**	indexes,	/*!< in/out: indexes to analyze */
+	ulint		n_indexes)	/*!< in: number of indexes */
+{
+	analyze_wq_t	wq;
+	ulint		n_threads;
+
+	n_threads = ut_min(ulint(srv_stats_analyze_threads), n_indexes);
+
+	wq.table = table;
+	wq.indexes = indexes;
+	wq.n_indexes = n_indexes;
+	wq.next = 0;
+	wq.n_running = 0;
+	wq.done = NULL;
+
+	if (n_threads > 1) {
+		wq.n_running = n_threads - 1;
+		wq.done = os_event_create();
+
+		for (ulint i = 1; i < n_threads; i++) {
+			os_thread_create(dict_stats_analyze_thread, &wq, NULL);
+		}
+	}
+
+	dict_stats_analyze_wq_run(&wq);
+
+	if (wq.done != NULL) {
+		os_event_wait(wq.done);
+		os_event_free(wq.done);
+	}
+}
+
+/*********************************************************************//**
+Estimates the number of pages dict_stats_analyze_index() read from an
+index it has just analyzed: the non-leaf pages it may have scanned plus
+the leaf pages it dived into for each n-column prefix and for the
+histograms.
+@return number of pages */
+static
+ulint
+dict_stats_analyze_index_cost(
+/*==========================*/
+	const dict_index_t*	index)	/*!< in: analyzed index */
+{
+	ulint		n_non_leaf_pages;
+	ib_uint64_t	n_sampled_pages;
+
+	n_non_leaf_pages = index->stat_index_size > index->stat_n_leaf_pages
+		? index->stat_index_size - index->stat_n_leaf_pages : 0;
+
+	n_sampled_pages = N_SAMPLE_PAGES(index)
+		* (dict_index_get_n_unique(index)
+		   + (srv_stats_histogram_buckets > 0 ? 1 : 0));
+
+	return(static_cast<ulint>(
+		ut_min(static_cast<ib_uint64_t>(index->stat_index_size),
+		       n_non_leaf_pages + n_sampled_pages)));
+}
+
 /*********************************************************************//**
 Calculates new estimates for table and index statistics. This function
 is relatively slow and is used to calculate persistent statistics that
@@ -2184,9 +3035,20 @@ static
 dberr_t
 dict_stats_update_persistent(
 /*=========================*/
-	dict_table_t*	table)		/*!< in/out: table */
+	dict_table_t*		table,		/*!< in/out: table */
+	bool			only_changed,	/*!< in: if true and the
+						table stats are initialized,
+						skip the secondary indexes
+						where less than 10% of the
+						table rows were modified since
+						they were last analyzed */
+	std::vector<index_id_t>*analyzed,	/*!< out: ids of the analyzed
+						indexes, or NULL */
+	ulint*			n_pages)	/*!< out: estimated number of
+						pages read, or NULL */
 {
 	dict_index_t*	index;
+	ib_uint64_t	n_rows;
 
 	DEBUG_PRINTF("%s(table=%s)\n", __func__, table->name);
 
@@ -2209,17 +3071,15 @@ dict_stats_update_persistent(
 
 	ut_ad(!dict_index_is_univ(index));
 
-	dict_stats_analyze_index(index);
-
-	ulint	n_unique = dict_index_get_n_unique(index);
-
-	table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
+	only_changed = only_changed && table->stat_initialized;
+	n_rows = table->stat_n_rows;
 
-	table->stat_clustered_index_size = index->stat_index_size;
+	/* collect the clustered index and the other indexes from the
+	table, if any, and analyze them */
 
-	/* analyze other indexes from the table, if any */
+	std::vector<dict_index_t*>	indexes;
 
-	table->stat_sum_of_other_index_sizes = 0;
+	indexes.push_back(index);
 
 	for (index = dict_table_get_next_index(index);
 	     index != NULL;
@@ -2231,18 +3091,59 @@ dict_stats_update_persistent(
 			continue;
 		}
 
-		dict_stats_empty_index(index);
-
 		if (dict_stats_should_ignore_index(index)) {
+			dict_stats_empty_index(index);
 			continue;
 		}
 
-		if (!(table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
-			dict_stats_analyze_index(index);
+		if (only_changed
+		    && index->stat_modified_counter <= n_rows / 10 /* 10% */) {
+			/* keep the current stats of the index */
+			continue;
 		}
 
-		table->stat_sum_of_other_index_sizes
-			+= index->stat_index_size;
+		dict_stats_empty_index(index);
+
+		indexes.push_back(index);
+	}
+
+	dict_stats_analyze_indexes(table, &indexes[0], indexes.size());
+
+	if (analyzed != NULL || n_pages != NULL) {
+		ulint	cost = 0;
+
+		for (ulint i = 0; i < indexes.size(); i++) {
+			if (analyzed != NULL) {
+				analyzed->push_back(indexes[i]->id);
+			}
+
+			cost += dict_stats_analyze_index_cost(indexes[i]);
+		}
+
+		if (n_pages != NULL) {
+			*n_pages = cost;
+		}
+	}
+
+	index = indexes[0];
+
+	ulint	n_unique = dict_index_get_n_unique(index);
+
+	table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
+
+	table->stat_clustered_index_size = index->stat_index_size;
+
+	table->stat_sum_of_other_index_sizes = 0;
+
+	for (index = dict_table_get_next_index(index);
+	     index != NULL;
+	     index = dict_table_get_next_index(index)) {
+
+		if (!(index->type & DICT_FTS)
+		    && !dict_stats_should_ignore_index(index)) {
+			table->stat_sum_of_other_index_sizes
+				+= index->stat_index_size;
+		}
 	}
 
 	table->stats_last_recalc = ut_time();
@@ -2360,6 +3261,144 @@ dict_stats_save_index_stat(
 	return(ret);
 }
 
+/** Delete the saved histograms of a table or of one of its indexes from
+the persistent statistics storage, see dict_stats_save_index_hist().
+@param[in]	table		table whose histograms to delete
+@param[in]	index_name	name of the index whose histograms to delete,
+or NULL to delete the histograms of every index of the table with a single
+statement
+@param[in,out]	trx		transaction, it is rolled back in the case
+of error, but not freed
+@return DB_SUCCESS or error code */
+static
+dberr_t
+dict_stats_delete_hist(
+	const dict_table_t*	table,
+	const char*		index_name,
+	trx_t*			trx)
+{
+	pars_info_t*	pinfo;
+	dberr_t		ret;
+	char		db_utf8[MAX_DB_UTF8_LEN];
+	char		table_utf8[MAX_TABLE_UTF8_LEN];
+
+	dict_fs2utf8(table->name, db_utf8, sizeof(db_utf8),
+		     table_utf8, sizeof(table_utf8));
+
+	pinfo = pars_info_create();
+	pars_info_add_str_literal(pinfo, "database_name", db_utf8);
+	pars_info_add_str_literal(pinfo, "table_name", table_utf8);
+	pars_info_add_str_literal(pinfo, "first_stat_name", "hist_pfx00_000");
+	pars_info_add_str_literal(pinfo, "last_stat_name", "hist_pfx99_999");
+
+	if (index_name != NULL) {
+		pars_info_add_str_literal(pinfo, "index_name", index_name);
+
+		ret = dict_stats_exec_sql(
+			pinfo,
+			"PROCEDURE INDEX_HIST_DELETE () IS\n"
+			"BEGIN\n"
+			"DELETE FROM \"" INDEX_STATS_NAME "\"\n"
+			"WHERE\n"
+			"database_name = :database_name AND\n"
+			"table_name = :table_name AND\n"
+			"index_name = :index_name AND\n"
+			"stat_name >= :first_stat_name AND\n"
+			"stat_name <= :last_stat_name;\n"
+			"END;", trx);
+	} else {
+		ret = dict_stats_exec_sql(
+			pinfo,
+			"PROCEDURE TABLE_HIST_DELETE () IS\n"
+			"BEGIN\n"
+			"DELETE FROM \"" INDEX_STATS_NAME "\"\n"
+			"WHERE\n"
+			"database_name = :database_name AND\n"
+			"table_name = :table_name AND\n"
+			"stat_name >= :first_stat_name AND\n"
+			"stat_name <= :last_stat_name;\n"
+			"END;", trx);
+	}
+
+	if (ret != DB_SUCCESS) {
+		char	buf[MAX_FULL_NAME_LEN];
+		ut_print_timestamp(stderr);
+		fprintf(stderr,
+			" InnoDB: Cannot delete index histograms for table "
+			"%s: %s\n",
+			ut_format_name(table->name, TRUE, buf, sizeof(buf)),
+			ut_strerr(ret));
+	}
+
+	return(ret);
+}
+
+/** Save the histograms of an index into the persistent statistics
+storage. The histograms that were saved before must have been deleted
+with dict_stats_delete_hist(). There is a row for each bucket, with stat_name "hist_pfxNN_BBB" for the bucket number BBB
+on the NN-column prefix, the number of records in the bucket in
+stat_value, the number of different key prefixes in it in sample_size
+and the rest of it in stat_description,
+see dict_stats_hist_print_bucket().
+@param[in]	index		index whose histograms to save
+@param[in]	last_update	timestamp of the stats
+@param[in,out]	trx		transaction, it is rolled back in the case
+of error, but not freed
+@return DB_SUCCESS or error code */
+static
+dberr_t
+dict_stats_save_index_hist(
+	dict_index_t*	index,
+	lint		last_update,
+	trx_t*		trx)
+{
+	dberr_t	ret = DB_SUCCESS;
+
+	const dict_index_hist_t*	hist = index->stat_hist;
+
+	for (ulint n = 1;
+	     ret == DB_SUCCESS && hist != NULL && n <= hist->n_prefixes;
+	     n++) {
+
+		for (ulint i = 0; i < hist->n_buckets[n - 1]; i++) {
+
+			const dict_hist_bucket_t*	bucket;
+			/* large enough for any two ulint values, so
+			that the compiler can see nothing is truncated */
+			char				stat_name[
+				sizeof("hist_pfx_") + 2 * 20];
+			char				stat_description[1024];
+
+			bucket = &hist->buckets[n - 1][i];
+
+			/* dict_stats_fetch_index_stats_step() parses
+			two and three digits */
+			ut_ad(n <= 99);
+			ut_ad(i < DICT_STATS_HIST_MAX_BUCKETS);
+
+			ut_snprintf(stat_name, sizeof(stat_name),
+				    "hist_pfx%02lu_%03lu", n, i);
+
+			ut_a(dict_stats_hist_print_bucket(
+				     bucket, n, stat_description,
+				     sizeof(stat_description)));
+
+			ib_uint64_t	n_distinct = bucket->n_distinct;
+
+			ret = dict_stats_save_index_stat(
+				index, last_update, stat_name,
+				bucket->n_rows, &n_distinct,
+				stat_description, trx);
+
+			if (ret != DB_SUCCESS) {
+				break;
+			}
+		}
+	}
+
+	return(ret);
+}
+
 /** Save the table's statistics into the persistent statistics storage.
 @param[in] table_orig	table whose stats to save
 @param[in] only_for_index if this is non-NULL, then stats for indexes
@@ -2470,6 +3509,16 @@ dict_stats_save(
 
 	index_map_t::const_iterator	it;
 
+	/* The histograms of all indexes are deleted with a single
+	statement, which locks the rows in the order of the PK as well. */
+	if (only_for_index == NULL) {
+		ret = dict_stats_delete_hist(table, NULL, trx);
+
+		if (ret != DB_SUCCESS) {
+			goto end;
+		}
+	}
+
 	for (it = indexes.begin(); it != indexes.end(); ++it) {
 
 		index = it->second;
@@ -2484,6 +3533,20 @@ dict_stats_save(
 
 		ut_ad(!dict_index_is_univ(index));
 
+		if (only_for_index != NULL) {
+			ret = dict_stats_delete_hist(table, index->name, trx);
+
+			if (ret != DB_SUCCESS) {
+				goto end;
+			}
+		}
+
+		ret = dict_stats_save_index_hist(index, now, trx);
+
+		if (ret != DB_SUCCESS) {
+			goto end;
+		}
+
 		for (ulint i = 0; i < index->n_uniq; i++) {
 
 			char	stat_name[16];
@@ -2674,10 +3737,13 @@ dict_stats_fetch_index_stats_step(
 	ulint		stat_name_len = ULINT_UNDEFINED;
 	ib_uint64_t	stat_value = UINT64_UNDEFINED;
 	ib_uint64_t	sample_size = UINT64_UNDEFINED;
+	const char*	stat_description = NULL;
+	ulint		stat_description_len = ULINT_UNDEFINED;
 	int		i;
 
-	/* this should loop exactly 4 times - for the columns that
-	were selected: index_name,stat_name,stat_value,sample_size */
+	/* this should loop exactly 5 times - for the columns that
+	were selected: index_name,stat_name,stat_value,sample_size,
+	stat_description */
 	for (cnode = static_cast<que_common_t*>(node->select_list), i = 0;
 	     cnode != NULL;
 	     cnode = static_cast<que_common_t*>(que_node_get_next(cnode)),
@@ -2766,21 +3832,35 @@ dict_stats_fetch_index_stats_step(
 
 			break;
 
+		case 4: /* mysql.innodb_index_stats.stat_description */
+
+			ut_a(dtype_get_mtype(type) == DATA_VARMYSQL);
+
+			ut_a(index != NULL);
+			ut_a(stat_name != NULL);
+
+			stat_description = (const char*) data;
+			stat_description_len = len;
+
+			break;
+
 		default:
 
 			/* someone changed
-			SELECT index_name,stat_name,stat_value,sample_size
+			SELECT index_name,stat_name,stat_value,sample_size,
+			stat_description
 			to select more columns from innodb_index_stats without
 			adjusting here */
 			ut_error;
 		}
 	}
 
-	/* if i < 4 this means someone changed the
-	SELECT index_name,stat_name,stat_value,sample_size
+	/* if i < 5 this means someone changed the
+	SELECT index_name,stat_name,stat_value,sample_size,stat_description
 	to select less columns from innodb_index_stats without adjusting here;
-	if i > 4 we would have ut_error'ed earlier */
-	ut_a(i == 4 /* index_name,stat_name,stat_value,sample_size */);
+	if i > 5 we would have ut_error'ed earlier */
+	ut_a(i == 5 /* index_name,stat_name,stat_value,sample_size,
+		    stat_description */);
 
 	ut_a(index != NULL);
 	ut_a(stat_name != NULL);
@@ -2790,6 +3870,8 @@ dict_stats_fetch_index_stats_step(
 
 #define PFX	"n_diff_pfx"
 #define PFX_LEN	10
+#define HIST_PFX	"hist_pfx"
+#define HIST_PFX_LEN	8
 
 	if (stat_name_len == 4 /* strlen("size") */
 	    && strncasecmp("size", stat_name, stat_name_len) == 0) {
@@ -2888,6 +3970,95 @@ dict_stats_fetch_index_stats_step(
 		index->stat_n_non_null_key_vals[n_pfx - 1] = 0;
 
 		arg->stats_were_modified = true;
+	} else if (stat_name_len > HIST_PFX_LEN
+		   /* e.g. stat_name=="hist_pfx01_000" */
+		   && strncasecmp(HIST_PFX, stat_name, HIST_PFX_LEN) == 0) {
+
+		const char*		num_ptr = stat_name + HIST_PFX_LEN;
+		ulint			n_pfx = 0;
+		ulint			n_bucket = 0;
+		dict_index_hist_t*	hist;
+		dict_hist_bucket_t*	bucket;
+
+		/* stat_name should have 2 digits for the prefix and
+		3 digits for the bucket appended to HIST_PFX */
+		bool	malformed = stat_name_len != HIST_PFX_LEN + 6
+			|| num_ptr[2] != '_';
+
+		for (ulint j = 0; !malformed && j < 6; j++) {
+			if (j == 2) {
+				continue;
+			} else if (num_ptr[j] < '0' || num_ptr[j] > '9') {
+				malformed = true;
+			} else if (j < 2) {
+				n_pfx = n_pfx * 10 + (num_ptr[j] - '0');
+			} else {
+				n_bucket = n_bucket * 10 + (num_ptr[j] - '0');
+			}
+		}
+
+		if (!malformed
+		    && (n_pfx == 0 || n_pfx > index->n_uniq
+			|| n_bucket >= DICT_STATS_HIST_MAX_BUCKETS
+			|| stat_description_len == UNIV_SQL_NULL)) {
+			malformed = true;
+		}
+
+		if (!malformed) {
+			if (index->stat_hist == NULL) {
+				index->stat_hist = dict_stats_hist_create(
+					index->n_uniq);
+			}
+
+			hist = index->stat_hist;
+
+			if (hist->buckets[n_pfx - 1] == NULL) {
+				hist->buckets[n_pfx - 1] =
+					static_cast<dict_hist_bucket_t*>(
+					mem_heap_zalloc(
+						hist->heap,
+						DICT_STATS_HIST_MAX_BUCKETS
+						* sizeof(*bucket)));
+			}
+
+			bucket = &hist->buckets[n_pfx - 1][n_bucket];
+
+			malformed = !dict_stats_hist_parse_bucket(
+				stat_description, stat_description_len,
+				n_pfx, hist->heap, bucket);
+		}
+
+		if (malformed) {
+			char	db_utf8[MAX_DB_UTF8_LEN];
+			char	table_utf8[MAX_TABLE_UTF8_LEN];
+
+			dict_fs2utf8(table->name, db_utf8, sizeof(db_utf8),
+				     table_utf8, sizeof(table_utf8));
+
+			ut_print_timestamp(stderr);
+			fprintf(stderr,
+				" InnoDB: Ignoring strange row from "
+				"%s WHERE "
+				"database_name = '%s' AND "
+				"table_name = '%s' AND "
+				"index_name = '%s' AND "
+				"stat_name = '%.*s'; because it is not "
+				"a valid histogram bucket\n",
+				INDEX_STATS_NAME_PRINT,
+				db_utf8,
+				table_utf8,
+				index->name,
+				(int) stat_name_len,
+				stat_name);
+			return(TRUE);
+		}
+
+		bucket->n_rows = stat_value;
+		bucket->n_distinct = sample_size != UINT64_UNDEFINED
+			? sample_size : 1;
+
+		hist->n_buckets[n_pfx - 1] = ut_max(
+			hist->n_buckets[n_pfx - 1], n_bucket + 1);
 	} else {
 		/* silently ignore rows with unknown stat_name, the
 		user may have developed her own stats */
@@ -2977,7 +4148,8 @@ dict_stats_fetch_from_ps(
 			   "  index_name,\n"
 			   "  stat_name,\n"
 			   "  stat_value,\n"
-			   "  sample_size\n"
+			   "  sample_size,\n"
+			   "  stat_description\n"
 			   "  FROM \"" INDEX_STATS_NAME "\"\n"
 			   "  WHERE\n"
 			   "  database_name = :database_name AND\n"
@@ -3127,7 +4299,8 @@ dict_stats_update(
 
 			dberr_t	err;
 
-			err = dict_stats_update_persistent(table);
+			err = dict_stats_update_persistent(
+				table, false, NULL, NULL);
 
 			if (err != DB_SUCCESS) {
 				return(err);
@@ -3299,6 +4472,53 @@ transient:
 	return(DB_SUCCESS);
 }
 
+/*********************************************************************//**
+Recalculates the persistent statistics of a table for the background
+stats thread. Unlike dict_stats_update(DICT_STATS_RECALC_PERSISTENT) this
+analyzes and saves only the clustered index and the secondary indexes
+where more than 10% of the table rows were modified since they were last
+analyzed; the stats of the other indexes are kept.
+@return DB_* error code or DB_SUCCESS */
+UNIV_INTERN
+dberr_t
+dict_stats_update_incremental(
+/*==========================*/
+	dict_table_t*	table,	/*!< in/out: table */
+	ulint*		n_pages)/*!< out: estimated number of pages
+				that were read */
+{
+	std::vector<index_id_t>	analyzed;
+	dberr_t			err;
+
+	ut_ad(!mutex_own(&dict_sys->mutex));
+	ut_ad(!srv_read_only_mode);
+
+	*n_pages = 0;
+
+	if (table->ibd_file_missing
+	    || srv_force_recovery >= SRV_FORCE_NO_IBUF_MERGE
+	    || !dict_stats_persistent_storage_check(false)) {
+
+		/* dict_stats_update() reports the problem and falls
+		back to transient stats if needed */
+		return(dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT));
+	}
+
+	/* InnoDB internal tables (e.g. SYS_TABLES) cannot have
+	persistent stats enabled */
+	ut_a(strchr(table->name, '/') != NULL);
+
+	err = dict_stats_update_persistent(table, true, &analyzed, n_pages);
+
+	/* Save the stats of each analyzed index. The table stats are
+	saved along with every one of them. */
+	for (ulint i = 0; err == DB_SUCCESS && i < analyzed.size(); i++) {
+		err = dict_stats_save(table, &analyzed[i]);
+	}
+
+	return(err);
+}
+
 /*********************************************************************//**
 Removes the information for a particular index's stats from the persistent
 storage if it exists and if there is data stored for this index.
@@ -25,6 +25,7 @@ Created Apr 25, 2012 Vasil Dimov
 
 #include "row0mysql.h"
 #include "srv0start.h"
+#include "dict0priv.h"
 #include "dict0stats.h"
 #include "dict0stats_bg.h"
 
@@ -32,6 +33,8 @@ Created Apr 25, 2012 Vasil Dimov
 # include "dict0stats_bg.ic"
 #endif
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 /** Minimum time interval between stats recalc for a given table */
@@ -59,6 +62,21 @@ static recalc_pool_t		recalc_pool;
 
 typedef recalc_pool_t::iterator	recalc_pool_iterator_t;
 
+/** The tables taken from "recalc_pool" in one round of the background
+stats thread, the one to process next at the back. Only accessed by
+that thread. */
+static recalc_pool_t		recalc_batch;
+
+/** A table of the recalc pool and the number of statements that used it
+since its stats were last recalculated in the background */
+typedef std::pair<ulint, table_id_t>	recalc_pool_entry_t;
+
+/** The background stats thread does not start another recalc before
+this time (in microseconds, see ut_time_us()), to keep the number of
+pages it reads per second under srv_stats_auto_recalc_pages_per_sec.
+Only accessed by that thread. */
+static ib_uint64_t		recalc_not_before = 0;
+
 /*****************************************************************//**
 Initialize the recalc pool, called once during thread initialization. */
 static
@@ -82,6 +100,7 @@ dict_stats_recalc_pool_deinit()
 	ut_ad(!srv_read_only_mode);
 
 	recalc_pool.clear();
+	recalc_batch.clear();
 }
 
 /*****************************************************************//**
@@ -119,32 +138,88 @@ dict_stats_recalc_pool_add(
 }
 
 /*****************************************************************//**
-Get a table from the auto recalc pool. The returned table id is removed
-from the pool.
-@return true if the pool was non-empty and "id" was set, false otherwise */
+Compare two entries of the recalc pool by the number of statements that
+used their tables, for std::stable_sort().
+@return true if e1 was used by more statements than e2 */
 static
 bool
-dict_stats_recalc_pool_get(
-/*=======================*/
-	table_id_t*	id)	/*!< out: table id, or unmodified if list is
-				empty */
+dict_stats_recalc_pool_entry_cmp(
+/*=============================*/
+	const recalc_pool_entry_t&	e1,	/*!< in: entry */
+	const recalc_pool_entry_t&	e2)	/*!< in: entry */
+{
+	return(e1.first > e2.first);
+}
+
+/*****************************************************************//**
+Move the tables whose stats may be recalculated now from the auto recalc
+pool to recalc_batch, in one pass over the pool. The tables that were
+used by the most statements since their stats were last recalculated in
+the background are processed first, and the tables whose stats were
+recalculated less than MIN_RECALC_INTERVAL seconds ago are left in the
+pool. Tables that are not in the dictionary cache count as unused.
+@return true if recalc_batch is not empty */
+static
+bool
+dict_stats_recalc_pool_get_batch()
+/*==============================*/
 {
+	std::vector<recalc_pool_entry_t>	entries;
+	ib_time_t				now = ut_time();
+
 	ut_ad(!srv_read_only_mode);
+	ut_ad(recalc_batch.empty());
+
+	mutex_enter(&dict_sys->mutex);
 
 	mutex_enter(&recalc_pool_mutex);
 
-	if (recalc_pool.empty()) {
-		mutex_exit(&recalc_pool_mutex);
-		return(false);
-	}
+	recalc_pool_iterator_t	keep = recalc_pool.begin();
 
-	*id = recalc_pool[0];
+	for (recalc_pool_iterator_t iter = recalc_pool.begin();
+	     iter != recalc_pool.end();
+	     ++iter) {
+
+		const dict_table_t*	table;
+		ulint			n_queries = 0;
 
-	recalc_pool.erase(recalc_pool.begin());
+		table = dict_table_check_if_in_cache_on_id_low(*iter);
+
+		if (table != NULL) {
+
+			if (ut_difftime(now, table->stats_last_recalc)
+			    < MIN_RECALC_INTERVAL) {
+
+				*keep++ = *iter;
+				continue;
+			}
+
+			n_queries = table->stats_n_queries;
+		}
+
+		entries.push_back(recalc_pool_entry_t(n_queries, *iter));
+	}
+
+	recalc_pool.erase(keep, recalc_pool.end());
 
 	mutex_exit(&recalc_pool_mutex);
 
-	return(true);
+	mutex_exit(&dict_sys->mutex);
+
+	/* Among the tables used by as many statements, the one that was
+	added to the pool first is processed first */
+	std::stable_sort(entries.begin(), entries.end(),
+			 dict_stats_recalc_pool_entry_cmp);
+
+	for (std::vector<recalc_pool_entry_t>::reverse_iterator it
+		     = entries.rbegin();
+	     it != entries.rend();
+	     ++it) {
+
+		recalc_batch.push_back(it->second);
+	}
+
+	return(!recalc_batch.empty());
 }
 
 /*****************************************************************//**
@@ -213,8 +288,9 @@ dict_stats_thread_init()
 
 	/* The recalc_pool_mutex is acquired from:
 	1) the background stats gathering thread before any other latch
-	   and released without latching anything else in between (thus
-	   any level would do here)
+	   or after dict_sys->mutex (SYNC_DICT) and released without
+	   latching anything else in between (thus a level <SYNC_DICT
+	   would do)
 	2) from row_update_statistics_if_needed()
 	   and released without latching anything else in between. We know
 	   that dict_sys->mutex (SYNC_DICT) is not acquired when
@@ -251,24 +327,30 @@ dict_stats_thread_deinit()
 }
 
 /*****************************************************************//**
-Get the first table that has been added for auto recalc and eventually
-update its stats. */
+Get the next table that has been added for auto recalc and eventually
+update the stats of its modified indexes. The pool is scanned once for
+all the tables that may be recalculated now, which are then processed
+one per call.
+@return true if a table was taken from the pool, false if there was
+no table whose stats may be recalculated now */
 static
-void
+bool
 dict_stats_process_entry_from_recalc_pool()
 /*=======================================*/
 {
 	table_id_t	table_id;
+	dict_table_t*	table;
 
 	ut_ad(!srv_read_only_mode);
 
-	/* pop the first table from the auto recalc pool */
-	if (!dict_stats_recalc_pool_get(&table_id)) {
+	if (recalc_batch.empty() && !dict_stats_recalc_pool_get_batch()) {
 		/* no tables for auto recalc */
-		return;
+		return(false);
 	}
 
-	dict_table_t*	table;
+	/* pop the most used table of this round */
+	table_id = recalc_batch.back();
+	recalc_batch.pop_back();
 
 	mutex_enter(&dict_sys->mutex);
 
@@ -278,14 +360,14 @@ dict_stats_process_entry_from_recalc_pool()
 		/* table does not exist, must have been DROPped
 		after its id was enqueued */
 		mutex_exit(&dict_sys->mutex);
-		return;
+		return(true);
 	}
 
 	/* Check whether table is corrupted */
 	if (table->corrupted) {
 		dict_table_close(table, TRUE, FALSE);
 		mutex_exit(&dict_sys->mutex);
-		return;
+		return(true);
 	}
 
 	table->stats_bg_flag = BG_STAT_IN_PROGRESS;
@@ -297,7 +379,8 @@ dict_stats_process_entry_from_recalc_pool()
 	on a system with lots of small tables, this could become hot. If we
 	find out that this is a problem, then the check below could eventually
 	be replaced with something else, though a time interval is the natural
-	approach. */
+	approach. dict_stats_recalc_pool_get_batch() already skipped the table
+	if it was in the cache, but it may have just been loaded. */
 
 	if (ut_difftime(ut_time(), table->stats_last_recalc)
 	    < MIN_RECALC_INTERVAL) {
@@ -309,8 +392,17 @@ dict_stats_process_entry_from_recalc_pool()
 		dict_stats_recalc_pool_add(table);
 
 	} else {
+		ulint	n_pages;
+
+		table->stats_n_queries = 0;
 
-		dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT);
+		dict_stats_update_incremental(table, &n_pages);
+
+		if (srv_stats_auto_recalc_pages_per_sec > 0) {
+			recalc_not_before = ut_time_us(NULL)
+				+ static_cast<ib_uint64_t>(n_pages) * 1000000
+				/ srv_stats_auto_recalc_pages_per_sec;
+		}
 	}
 
 	mutex_enter(&dict_sys->mutex);
@@ -320,6 +412,36 @@ dict_stats_process_entry_from_recalc_pool()
 	dict_table_close(table, TRUE, FALSE);
 
 	mutex_exit(&dict_sys->mutex);
+
+	return(true);
+}
+
+/*****************************************************************//**
+Get the time the background stats thread has to wait before it may
+recalculate the stats of another table, so that it reads no more than
+srv_stats_auto_recalc_pages_per_sec pages per second on average.
+@return time to wait in microseconds, at most MIN_RECALC_INTERVAL seconds */
+static
+ulint
+dict_stats_recalc_throttle_delay()
+/*==============================*/
+{
+	ib_uint64_t	now;
+
+	if (srv_stats_auto_recalc_pages_per_sec == 0) {
+		return(0);
+	}
+
+	now = ut_time_us(NULL);
+
+	if (now >= recalc_not_before) {
+		return(0);
+	}
+
+	return(static_cast<ulint>(
+		ut_min(recalc_not_before - now,
+		       static_cast<ib_uint64_t>(MIN_RECALC_INTERVAL)
+		       * 1000000)));
 }
 
 /*****************************************************************//**
@@ -338,6 +460,8 @@ DECLARE_THREAD(dict_stats_thread)(
 
 	srv_dict_stats_thread_active = TRUE;
 
+	ulint	wait = MIN_RECALC_INTERVAL * 1000000;
+
 	while (!SHUTTING_DOWN()) {
 
 		/* Wake up periodically even if not signaled. This is
@@ -345,14 +469,23 @@ DECLARE_THREAD(dict_stats_thread)(
 		dict_stats_process_entry_from_recalc_pool() puts the entry back
 		in the list, the os_event_set() will be lost by the subsequent
 		os_event_reset(). */
-		os_event_wait_time(
-			dict_stats_event, MIN_RECALC_INTERVAL * 1000000);
+		os_event_wait_time(dict_stats_event, wait);
 
 		if (SHUTTING_DOWN()) {
 			break;
 		}
 
-		dict_stats_process_entry_from_recalc_pool();
+		/* If the previous recalc read too many pages, wait
+		before the next one. Otherwise go through all the tables
+		whose stats may be recalculated now, the most used first,
+		so that busy tables do not starve the others. */
+		wait = dict_stats_recalc_throttle_delay();
+
+		if (wait == 0
+		    && !dict_stats_process_entry_from_recalc_pool()) {
+
+			wait = MIN_RECALC_INTERVAL * 1000000;
+		}
 
 		os_event_reset(dict_stats_event);
 	}
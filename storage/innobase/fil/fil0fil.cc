@@ -45,6 +45,9 @@ Created 10/25/1995 Heikki Tuuri
 #include "page0zip.h"
 #include "trx0sys.h"
 #include "row0mysql.h"
+
+#include <algorithm>
+#include <vector>
 #ifndef UNIV_HOTBACKUP
 # include "buf0lru.h"
 # include "ibuf0ibuf.h"
@@ -140,6 +143,11 @@ UNIV_INTERN mysql_pfs_key_t	fil_system_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	fil_space_latch_key;
 #endif /* UNIV_PFS_RWLOCK */
 
+#ifdef UNIV_PFS_THREAD
+/* Key to register fil_discovery_thread with performance schema */
+UNIV_INTERN mysql_pfs_key_t	fil_discovery_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 /** File node of a tablespace or the log data space */
 struct fil_node_t {
 	fil_space_t*	space;	/*!< backpointer to the space where this node
@@ -4704,6 +4712,121 @@ fil_file_readdir_next_file(
 	return(-1);
 }
 
+/** An .ibd or .isl file found by fil_load_single_table_tablespaces() */
+struct fil_discovered_file_t {
+	const char*	dbname;		/*!< database directory name */
+	const char*	filename;	/*!< file name, including the .ibd
+					or .isl extension */
+	ulint		table_len;	/*!< length of filename without
+					the extension */
+};
+
+/** Orders the discovered files by database and table name, so that an .ibd
+file and an .isl file of the same table are adjacent */
+struct fil_discovered_file_less {
+	bool operator()(
+		const fil_discovered_file_t&	a,
+		const fil_discovered_file_t&	b) const
+	{
+		int	cmp = strcmp(a.dbname, b.dbname);
+
+		if (cmp == 0) {
+			cmp = memcmp(a.filename, b.filename,
+				     ut_min(a.table_len, b.table_len));
+		}
+
+		return(cmp < 0 || (cmp == 0 && a.table_len < b.table_len));
+	}
+};
+
+/** Tells whether two discovered files belong to the same table */
+struct fil_discovered_file_same_table {
+	bool operator()(
+		const fil_discovered_file_t&	a,
+		const fil_discovered_file_t&	b) const
+	{
+		return(a.table_len == b.table_len
+		       && !strcmp(a.dbname, b.dbname)
+		       && !memcmp(a.filename, b.filename, a.table_len));
+	}
+};
+
+typedef std::vector<fil_discovered_file_t> fil_discovered_files_t;
+
+/** The tablespace files being loaded by fil_load_single_table_tablespaces()
+and the fil_discovery_thread instances */
+struct fil_discovery_t {
+	fil_discovered_files_t	files;	/*!< one file of each table */
+	ulint			next;	/*!< index of the next file in
+					files to load; protected by
+					fil_system->mutex */
+	ulint			n_threads_active;
+					/*!< number of fil_discovery_thread
+					instances still loading files;
+					decremented atomically */
+	os_event_t		done;	/*!< set when n_threads_active
+					drops to 0 */
+};
+
+/** The tablespace discovery in progress, or NULL */
+static fil_discovery_t*	fil_discovery;
+
+/********************************************************************//**
+Loads the tablespaces of the discovered files until every file has been
+taken by the calling thread or by another discovery thread. */
+static
+void
+fil_discovery_load_files(void)
+/*==========================*/
+{
+	const fil_discovered_files_t&	files = fil_discovery->files;
+
+	for (;;) {
+		mutex_enter(&fil_system->mutex);
+		ulint	i = fil_discovery->next++;
+		mutex_exit(&fil_system->mutex);
+
+		if (i >= files.size()) {
+
+			return;
+		}
+
+		fil_load_single_table_tablespace(
+			files[i].dbname, files[i].filename);
+	}
+}
+
+/********************************************************************//**
+Tablespace discovery thread, which opens and validates the .ibd files found
+by fil_load_single_table_tablespaces() together with the thread that runs
+the crash recovery, if srv_n_tablespace_discovery_threads > 1.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(fil_discovery_thread)(
+/*=================================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+				/*!< in: a dummy parameter */
+{
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(fil_discovery_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	fil_discovery_load_files();
+
+	if (os_atomic_decrement_ulint(&fil_discovery->n_threads_active, 1)
+	    == 0) {
+		os_event_set(fil_discovery->done);
+	}
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /********************************************************************//**
 At the server startup, if we need crash recovery, scans the database
 directories under the MySQL datadir, looking for .ibd files. Those files are
@@ -4711,6 +4834,11 @@ single-table tablespaces. We need to know the space id in each of them so that
 we know into which file we should look to check the contents of a page stored
 in the doublewrite buffer, also to know where to apply log records where the
 space id is != 0.
+
+The directories are scanned first. The files found are then opened and
+validated by srv_n_tablespace_discovery_threads threads, the calling thread
+being one of them, because reading the first page of each file dominates
+the scan when there are many tables.
 @return	DB_SUCCESS or error number */
 UNIV_INTERN
 dberr_t
@@ -4725,6 +4853,8 @@ fil_load_single_table_tablespaces(void)
 	os_file_stat_t	dbinfo;
 	os_file_stat_t	fileinfo;
 	dberr_t		err		= DB_SUCCESS;
+	mem_heap_t*	heap;
+	fil_discovery_t	discovery;
 
 	/* The datadir of MySQL is always the default directory of mysqld */
 
@@ -4737,6 +4867,9 @@ fil_load_single_table_tablespaces(void)
 
 	dbpath = static_cast<char*>(mem_alloc(dbpath_len));
 
+	/* The names of the discovered files */
+	heap = mem_heap_create(16384);
+
 	/* Scan all directories under the datadir. They are the database
 	directories of MySQL. */
 
@@ -4773,6 +4906,8 @@ fil_load_single_table_tablespaces(void)
 		dbdir = os_file_opendir(dbpath, FALSE);
 
 		if (dbdir != NULL) {
+			const char*	dbname = mem_heap_strdup(
+				heap, dbinfo.name);
 
 			/* We found a database directory; loop through it,
 			looking for possible .ibd files in it */
@@ -4795,9 +4930,16 @@ fil_load_single_table_tablespaces(void)
 						   + strlen(fileinfo.name) - 4,
 						   ".isl"))) {
 					/* The name ends in .ibd or .isl;
-					try opening the file */
-					fil_load_single_table_tablespace(
-						dbinfo.name, fileinfo.name);
+					remember to try opening the file */
+					fil_discovered_file_t	file;
+
+					file.dbname = dbname;
+					file.filename = mem_heap_strdup(
+						heap, fileinfo.name);
+					file.table_len = strlen(
+						fileinfo.name) - 4;
+
+					discovery.files.push_back(file);
 				}
 next_file_item:
 				ret = fil_file_readdir_next_file(&err,
@@ -4823,6 +4965,55 @@ next_datadir_item:
 
 	mem_free(dbpath);
 
+	/* fil_load_single_table_tablespace() looks for both the .ibd and
+	the .isl file of a table, so each table must be loaded only once.
+	Otherwise two threads could create the same tablespace. */
+	std::sort(discovery.files.begin(), discovery.files.end(),
+		  fil_discovered_file_less());
+	discovery.files.erase(
+		std::unique(discovery.files.begin(), discovery.files.end(),
+			    fil_discovered_file_same_table()),
+		discovery.files.end());
+
+	ulint	n_files = discovery.files.size();
+	ulint	n_threads = srv_n_tablespace_discovery_threads;
+
+	if (n_threads > n_files) {
+		n_threads = n_files > 0 ? n_files : 1;
+	}
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Loading %lu single-table tablespaces with %lu threads.",
+		(ulong) n_files, (ulong) n_threads);
+
+	discovery.next = 0;
+	discovery.n_threads_active = 0;
+	discovery.done = NULL;
+
+	ut_ad(fil_discovery == NULL);
+	fil_discovery = &discovery;
+
+	if (n_threads > 1) {
+		discovery.n_threads_active = n_threads - 1;
+		discovery.done = os_event_create();
+
+		for (ulint i = 1; i < n_threads; i++) {
+			os_thread_create(fil_discovery_thread, NULL, NULL);
+		}
+	}
+
+	fil_discovery_load_files();
+
+	/* Wait for the files taken by the other threads */
+	if (discovery.done != NULL) {
+		os_event_wait(discovery.done);
+		os_event_free(discovery.done);
+	}
+
+	fil_discovery = NULL;
+
+	mem_heap_free(heap);
+
 	if (0 != os_file_closedir(dir)) {
 		fprintf(stderr,
 			"InnoDB: Error: could not close MySQL datadir\n");
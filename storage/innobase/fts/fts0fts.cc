@@ -73,6 +73,10 @@ UNIV_INTERN ulong	fts_max_token_size;
 /** Variable specifying the minimum FTS max token size */
 UNIV_INTERN ulong	fts_min_token_size;
 
+/** Number of documents per block in the block directory written in
+front of the FTS INDEX ilists, 0 to write plain ilists */
+UNIV_INTERN ulong	fts_ilist_block_size;
+
 
 // FIXME: testing
 ib_time_t elapsed_time = 0;
@@ -3553,14 +3557,25 @@ fts_add_doc_by_id(
 					doc_id, doc.tokens);
 
 				bool	need_sync = false;
+				bool	need_wait = false;
 				if ((cache->total_size > fts_max_cache_size / 10
 				     || fts_need_sync)
 				    && !cache->sync->in_progress) {
 					need_sync = true;
+				} else if (cache->total_size > fts_max_cache_size
+					   && cache->sync->in_progress) {
+					/* Let the sync catch up, it does
+					not hold the cache lock while it
+					writes. */
+					need_wait = true;
 				}
 
 				rw_lock_x_unlock(&table->fts->cache->lock);
 
+				if (need_wait) {
+					os_event_wait(cache->sync->event);
+				}
+
 				DBUG_EXECUTE_IF(
 					"fts_instrument_sync",
 					fts_optimize_request_sync_table(table);
@@ -3832,6 +3847,110 @@ fts_doc_fetch_by_doc_id(
 	return(error);
 }
 
+/*********************************************************************//**
+Build the ilist of a node with a block directory in front of it, see
+FTS_ILIST_BLOCK_MARKER. The directory lets top-N queries skip the blocks
+of an ilist that cannot contribute to the result.
+@return ut_malloc'd ilist or NULL if the node can't be encoded this way */
+static
+byte*
+fts_ilist_add_directory(
+/*====================*/
+	const fts_node_t*	node,		/*!< in: node to encode */
+	ulint			block_size,	/*!< in: docs per block */
+	ulint*			len)		/*!< out: ilist length */
+{
+	byte*		ptr;
+	const byte*	end = node->ilist + node->ilist_size;
+	ulint		n_docs = 0;
+	ulint		n_blocks;
+	byte*		dir;
+	byte*		dir_ptr;
+	byte*		block_start;
+	ulint		block_docs = 0;
+	ulint		max_freq = 0;
+	doc_id_t	doc_id = 0;
+	doc_id_t	prev_last_doc_id = node->first_doc_id;
+	ulint		dir_len;
+	byte*		ilist;
+	byte*		ilist_ptr;
+
+	/* Count the documents in the ilist. */
+	for (ptr = node->ilist; ptr < end; ++ptr) {
+		fts_decode_vlc(&ptr);
+
+		while (*ptr) {
+			fts_decode_vlc(&ptr);
+		}
+
+		++n_docs;
+	}
+
+	n_blocks = (n_docs + block_size - 1) / block_size;
+
+	/* Each block entry is three integers of at most 5 bytes. */
+	dir = static_cast<byte*>(ut_malloc(5 + n_blocks * 3 * 5));
+	dir_ptr = dir + fts_encode_int(n_blocks, dir);
+
+	block_start = node->ilist;
+
+	for (ptr = node->ilist; ptr < end; ) {
+		ulint	freq = 0;
+
+		doc_id += fts_decode_vlc(&ptr);
+
+		while (*ptr) {
+			fts_decode_vlc(&ptr);
+			++freq;
+		}
+
+		/* Skip the end of positions marker. */
+		++ptr;
+
+		max_freq = ut_max(max_freq, freq);
+
+		if (++block_docs == block_size || ptr == end) {
+
+			/* The VLC can only encode 32 bit deltas. */
+			if (doc_id - prev_last_doc_id > 4294967295u) {
+				ut_free(dir);
+				return(NULL);
+			}
+
+			dir_ptr += fts_encode_int(
+				(ulint) (doc_id - prev_last_doc_id), dir_ptr);
+			dir_ptr += fts_encode_int(ptr - block_start, dir_ptr);
+			dir_ptr += fts_encode_int(max_freq, dir_ptr);
+
+			prev_last_doc_id = doc_id;
+			block_start = ptr;
+			block_docs = 0;
+			max_freq = 0;
+		}
+	}
+
+	ut_a(doc_id == node->last_doc_id);
+
+	dir_len = dir_ptr - dir;
+
+	*len = 1 + fts_get_encoded_len(dir_len) + dir_len + node->ilist_size;
+
+	ilist = static_cast<byte*>(ut_malloc(*len));
+
+	ilist_ptr = ilist;
+	*ilist_ptr++ = FTS_ILIST_BLOCK_MARKER;
+	ilist_ptr += fts_encode_int(dir_len, ilist_ptr);
+	memcpy(ilist_ptr, dir, dir_len);
+	ilist_ptr += dir_len;
+	memcpy(ilist_ptr, node->ilist, node->ilist_size);
+
+	ut_ad(ilist_ptr + node->ilist_size == ilist + *len);
+
+	ut_free(dir);
+
+	return(ilist);
+}
+
 /*********************************************************************//**
 Write out a single word's data as new entry/entries in the INDEX table.
 @return DB_SUCCESS if all OK. */
@@ -3851,6 +3970,8 @@ fts_write_node(
 	ib_time_t	start_time;
 	doc_id_t	last_doc_id;
 	doc_id_t	first_doc_id;
+	byte*		ilist = NULL;
+	ulint		ilist_size = node->ilist_size;
 
 	if (*graph) {
 		info = (*graph)->info;
@@ -3875,9 +3996,17 @@ fts_write_node(
 	pars_info_bind_int4_literal(
 		info, "doc_count", (const ib_uint32_t*) &doc_count);
 
+	/* Only an ilist that spans several blocks benefits from the
+	block directory. */
+	if (fts_ilist_block_size > 0
+	    && node->doc_count > fts_ilist_block_size) {
+		ilist = fts_ilist_add_directory(
+			node, fts_ilist_block_size, &ilist_size);
+	}
+
 	/* Set copy_name to FALSE since it's a static. */
 	pars_info_bind_literal(
-		info, "ilist", node->ilist, node->ilist_size,
+		info, "ilist", ilist ? ilist : node->ilist, ilist_size,
 		DATA_BLOB, DATA_BINARY_TYPE);
 
 	if (!*graph) {
@@ -3895,6 +4024,10 @@ fts_write_node(
 	elapsed_time += ut_time() - start_time;
 	++n_nodes;
 
+	if (ilist != NULL) {
+		ut_free(ilist);
+	}
+
 	return(error);
 }
 
@@ -4587,6 +4720,7 @@ fts_sync(
 
 	sync->unlock_cache = unlock_cache;
 	sync->in_progress = true;
+	os_event_reset(sync->event);
 
 	DEBUG_SYNC_C("fts_sync_begin");
 	fts_sync_begin(sync);
@@ -4597,14 +4731,11 @@ fts_sync(
 		sync->trx->dict_operation_lock_mode = RW_S_LATCH;
 	}
 
+	/* The cache lock is released while each node is written, so
+	that inserts and updates can go on adding to the cache. To make
+	sure that the sync finishes, fts_add_doc_by_id() waits for it
+	once the cache has grown beyond fts_max_cache_size. */
 begin_sync:
-	if (cache->total_size > fts_max_cache_size) {
-		/* Avoid the case: sync never finish when
-		insert/update keeps comming. */
-		ut_ad(sync->unlock_cache);
-		sync->unlock_cache = false;
-	}
-
 	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
 		fts_index_cache_t*	index_cache;
 
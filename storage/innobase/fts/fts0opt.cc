@@ -42,9 +42,18 @@ Completed 2011/7/10 Sunny and Jimmy Yang
 /** The FTS optimize thread's work queue. */
 static ib_wqueue_t* fts_optimize_wq;
 
+/** The work queue of the FTS optimize worker threads. Each work item
+is a fts_msg_t, handed out by the FTS optimize thread. */
+static ib_wqueue_t* fts_optimize_worker_wq;
+
 /** Time to wait for a message. */
 static const ulint FTS_QUEUE_WAIT_IN_USECS = 5000000;
 
+/** Number of times to retry getting the dict operation lock for a
+background sync, and time to wait between the tries. */
+static const ulint FTS_SYNC_LOCK_RETRIES = 100;
+static const ulint FTS_SYNC_LOCK_RETRY_USECS = 10000;
+
 /** Default optimize interval in secs. */
 static const ulint FTS_OPTIMIZE_INTERVAL_IN_SECS = 300;
 
@@ -87,7 +96,10 @@ enum fts_msg_type_t {
 
 	FTS_MSG_DEL_TABLE,		/*!< Remove a table from the optimize
 					threads work queue */
-	FTS_MSG_SYNC_TABLE		/*!< Sync fts cache of a table */
+	FTS_MSG_SYNC_TABLE,		/*!< Sync fts cache of a table */
+
+	FTS_MSG_OPTIMIZE_DONE		/*!< A worker thread has finished
+					optimizing a table */
 };
 
 /** Compressed list of words that have been read from FTS INDEX
@@ -175,6 +187,8 @@ struct fts_optimize_t {
 					been optimized */
 	ibool		del_list_regenerated;
 					/*!< BEING_DELETED list regenarated */
+	ib_time_t	time_limit;	/*!< The amount of time optimizing
+					in a single pass, in milliseconds */
 };
 
 /** Used by the optimize, to keep state during compacting nodes. */
@@ -204,6 +218,13 @@ struct fts_slot_t {
 
 	ib_time_t	interval_time;	/*!< Minimum time to wait before
 					optimizing the table again. */
+
+	bool		in_worker;	/*!< true while a worker thread
+					optimizes the table */
+
+	os_event_t	del_event;	/*!< Event of a remove request that
+					arrived while the table was in a
+					worker thread, or NULL */
 };
 
 /** A table remove message for the FTS optimize thread. */
@@ -215,9 +236,11 @@ struct fts_msg_del_t {
 					this message by the consumer */
 };
 
-/** Stop the optimize thread. */
+/** A worker thread's report of an optimize run. */
 struct fts_msg_optimize_t {
 	dict_table_t*	table;		/*!< Table to optimize */
+
+	bool		optimized;	/*!< true if the table was optimized */
 };
 
 /** The FTS optimize message work queue message type. */
@@ -234,15 +257,15 @@ struct fts_msg_t {
 /** The number of words to read and optimize in a single pass. */
 UNIV_INTERN ulong	fts_num_word_optimize;
 
+/** Number of FTS optimize worker threads */
+UNIV_INTERN ulong	fts_optimize_threads;
+
 // FIXME
 UNIV_INTERN char	fts_enable_diag_print;
 
 /** ZLib compressed block size.*/
 static ulint FTS_ZIP_BLOCK_SIZE	= 1024;
 
-/** The amount of time optimizing in a single pass, in milliseconds. */
-static ib_time_t fts_optimize_time_limit = 0;
-
 /** SQL Statement for changing state of rows to be deleted from FTS Index. */
 static	const char* fts_init_delete_sql =
 	"BEGIN\n"
@@ -404,6 +427,10 @@ fts_optimize_read_node(
 			break;
 
 		case 4: /* ILIST */
+			/* The block directory is rebuilt when the node
+			is written back. */
+			data = fts_ilist_skip_directory(data, &len);
+
 			node->ilist_size_alloc = node->ilist_size = len;
 			node->ilist = static_cast<byte*>(ut_malloc(len));
 			memcpy(node->ilist, data, len);
@@ -1589,8 +1616,8 @@ fts_optimize_compact(
 		/* Free the word that was optimized. */
 		fts_word_free(word);
 
-		if (fts_optimize_time_limit > 0
-		    && (ut_time() - start_time) > fts_optimize_time_limit) {
+		if (optim->time_limit > 0
+		    && (ut_time() - start_time) > optim->time_limit) {
 
 			optim->done = TRUE;
 		}
@@ -1795,7 +1822,7 @@ fts_optimize_words(
 	ut_a(!optim->done);
 
 	/* Get the time limit from the config table. */
-	fts_optimize_time_limit = fts_optimize_get_time_limit(
+	optim->time_limit = fts_optimize_get_time_limit(
 		optim->trx, &optim->fts_common_table);
 
 	start_time = ut_time();
@@ -2409,44 +2436,6 @@ fts_optimize_reset_start_time(
 	return(error);
 }
 
-/*********************************************************************//**
-Run OPTIMIZE on the given table by a background thread.
-@return DB_SUCCESS if all OK */
-static MY_ATTRIBUTE((nonnull))
-dberr_t
-fts_optimize_table_bk(
-/*==================*/
-	fts_slot_t*	slot)	/*!< in: table to optimiza */
-{
-	dberr_t		error;
-	dict_table_t*	table = slot->table;
-	fts_t*		fts = table->fts;
-
-	/* Avoid optimizing tables that were optimized recently. */
-	if (slot->last_run > 0
-	    && (ut_time() - slot->last_run) < slot->interval_time) {
-
-		return(DB_SUCCESS);
-
-	} else if (fts && fts->cache
-		   && fts->cache->deleted >= FTS_OPTIMIZE_THRESHOLD) {
-
-		error = fts_optimize_table(table);
-
-		if (error == DB_SUCCESS) {
-			slot->state = FTS_STATE_DONE;
-			slot->last_run = 0;
-			slot->completed = ut_time();
-		}
-	} else {
-		error = DB_SUCCESS;
-	}
-
-	/* Note time this run completed. */
-	slot->last_run = ut_time();
-
-	return(error);
-}
 /*********************************************************************//**
 Run OPTIMIZE on the given table.
 @return DB_SUCCESS if all OK */
@@ -2463,6 +2452,8 @@ fts_optimize_table(
 	ut_print_timestamp(stderr);
 	fprintf(stderr, " InnoDB: FTS start optimize %s\n", table->name);
 
+	os_atomic_increment_ulint(&fts->n_optimize, 1);
+
 	optim = fts_optimize_create(table);
 
 	// FIXME: Call this only at the start of optimize, currently we
@@ -2535,6 +2526,8 @@ fts_optimize_table(
 
 	fts_optimize_free(optim);
 
+	os_atomic_decrement_ulint(&fts->n_optimize, 1);
+
 	ut_print_timestamp(stderr);
 	fprintf(stderr, " InnoDB: FTS end optimize %s\n", table->name);
 
@@ -2703,7 +2696,8 @@ fts_optimize_find_slot(
 
 		slot = static_cast<fts_slot_t*>(ib_vector_get(tables, i));
 
-		if (slot->table->id == table->id) {
+		if (slot->state != FTS_STATE_EMPTY
+		    && slot->table->id == table->id) {
 			return(slot);
 		}
 	}
@@ -2843,6 +2837,11 @@ fts_optimize_how_many(
 		slot = static_cast<const fts_slot_t*>(
 			ib_vector_get_const(tables, i));
 
+		/* Tables that are being optimized are not due. */
+		if (slot->in_worker) {
+			continue;
+		}
+
 		switch (slot->state) {
 		case FTS_STATE_DONE:
 		case FTS_STATE_LOADED:
@@ -2976,10 +2975,19 @@ fts_optimize_sync_table(
 	dict_table_t*   table = NULL;
 
 	/* Prevent DROP INDEX etc. from running when we are syncing
-	cache in background. */
-	if (!rw_lock_s_lock_nowait(&dict_operation_lock, __FILE__, __LINE__)) {
-		/* Exit when fail to get dict operation lock. */
-		return;
+	cache in background. Give a DDL that holds the lock a little
+	time, rather than drop the request at once. */
+	for (ulint i = 0;
+	     !rw_lock_s_lock_nowait(&dict_operation_lock, __FILE__, __LINE__);
+	     ++i) {
+
+		if (i >= FTS_SYNC_LOCK_RETRIES
+		    || srv_shutdown_state != SRV_SHUTDOWN_NONE) {
+			/* Exit when fail to get dict operation lock. */
+			return;
+		}
+
+		os_thread_sleep(FTS_SYNC_LOCK_RETRY_USECS);
 	}
 
 	table = dict_table_open_on_id(table_id, FALSE, DICT_TABLE_OP_NORMAL);
@@ -2995,8 +3003,202 @@ fts_optimize_sync_table(
 	rw_lock_s_unlock(&dict_operation_lock);
 }
 
+/*********************************************************************//**
+Hand the table of a slot over to a worker thread for OPTIMIZE, unless it
+was optimized recently.
+@return true if the table was handed over */
+static MY_ATTRIBUTE((nonnull))
+bool
+fts_optimize_table_bk(
+/*==================*/
+	fts_slot_t*	slot)	/*!< in/out: table to optimize */
+{
+	fts_msg_t*	msg;
+
+	/* Avoid optimizing tables that were optimized recently. */
+	if (slot->last_run > 0
+	    && (ut_time() - slot->last_run) < slot->interval_time) {
+
+		return(false);
+	}
+
+	slot->in_worker = true;
+
+	msg = fts_optimize_create_msg(FTS_MSG_OPTIMIZE_TABLE, slot->table);
+
+	ib_wqueue_add(fts_optimize_worker_wq, msg, msg->heap);
+
+	return(true);
+}
+
+/**********************************************************************//**
+Note that a worker thread is done with the table of a slot, and complete
+the removal of the table if it was requested in the meantime.
+@return TRUE if the table was removed */
+static
+ibool
+fts_optimize_table_done(
+/*====================*/
+	ib_vector_t*			tables,	/*!< in/out: vector of
+						tables */
+	const fts_msg_optimize_t*	done)	/*!< in: report of the
+						worker thread */
+{
+	fts_slot_t*	slot;
+
+	slot = fts_optimize_find_slot(tables, done->table);
+
+	ut_a(slot != NULL);
+	ut_a(slot->in_worker);
+
+	slot->in_worker = false;
+
+	if (done->optimized) {
+		slot->state = FTS_STATE_DONE;
+		slot->completed = ut_time();
+	}
+
+	/* Note time this run completed. */
+	slot->last_run = ut_time();
+
+	if (slot->del_event != NULL) {
+		fts_msg_del_t	remove;
+		ibool		removed;
+
+		remove.table = slot->table;
+		remove.event = slot->del_event;
+
+		slot->del_event = NULL;
+
+		removed = fts_optimize_del_table(tables, &remove);
+		ut_a(removed);
+
+		/* Signal the producer that we have removed the table. */
+		os_event_set(remove.event);
+
+		return(TRUE);
+	}
+
+	return(FALSE);
+}
+
+/*********************************************************************//**
+Run OPTIMIZE on a table handed over by the optimize thread, if enough
+documents were deleted from it.
+@return true if the table was optimized */
+static MY_ATTRIBUTE((nonnull))
+bool
+fts_optimize_worker_table(
+/*======================*/
+	dict_table_t*	table)	/*!< in: table to optimize */
+{
+	fts_t*		fts = table->fts;
+
+	if (fts && fts->cache
+	    && fts->cache->deleted >= FTS_OPTIMIZE_THRESHOLD) {
+
+		return(fts_optimize_table(table) == DB_SUCCESS);
+	}
+
+	return(false);
+}
+
 /**********************************************************************//**
-Optimize all FTS tables.
+Sync and optimize the FTS tables handed over by the optimize thread.
+Several workers run at a time, each on a different table.
+@return Dummy return */
+static
+os_thread_ret_t
+fts_optimize_worker_thread(
+/*=======================*/
+	void*		arg)			/*!< in: work queue */
+{
+	os_event_t	exit_event = NULL;
+	ib_wqueue_t*	wq = (ib_wqueue_t*) arg;
+
+	ut_ad(!srv_read_only_mode);
+	my_thread_init();
+
+	while (exit_event == NULL) {
+		fts_msg_t*		msg;
+		fts_msg_t*		reply;
+		fts_msg_optimize_t*	optimize;
+
+		msg = static_cast<fts_msg_t*>(ib_wqueue_wait(wq));
+
+		switch (msg->type) {
+		case FTS_MSG_STOP:
+			exit_event = static_cast<os_event_t>(msg->ptr);
+			break;
+
+		case FTS_MSG_OPTIMIZE_TABLE:
+			reply = fts_optimize_create_msg(
+				FTS_MSG_OPTIMIZE_DONE, NULL);
+
+			optimize = static_cast<fts_msg_optimize_t*>(
+				mem_heap_alloc(reply->heap, sizeof(*optimize)));
+
+			optimize->table = static_cast<dict_table_t*>(
+				msg->ptr);
+			optimize->optimized = fts_optimize_worker_table(
+				optimize->table);
+			reply->ptr = optimize;
+
+			/* Tell the optimize thread that we are done
+			with the table. */
+			ib_wqueue_add(fts_optimize_wq, reply, reply->heap);
+			break;
+
+		case FTS_MSG_SYNC_TABLE:
+			fts_optimize_sync_table(
+				*static_cast<table_id_t*>(msg->ptr));
+			break;
+
+		default:
+			ut_error;
+		}
+
+		mem_heap_free(msg->heap);
+	}
+
+	os_event_set(exit_event);
+	my_thread_end();
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/**********************************************************************//**
+Stop the worker threads, after they have processed the work items
+that are already queued for them. */
+static
+void
+fts_optimize_stop_workers(void)
+/*===========================*/
+{
+	/* Each worker takes one stop message and exits, after it is
+	done with the work items queued ahead of it. */
+	for (ulint i = 0; i < fts_optimize_threads; ++i) {
+		fts_msg_t*	msg;
+		os_event_t	event;
+
+		event = os_event_create();
+
+		msg = fts_optimize_create_msg(FTS_MSG_STOP, event);
+
+		ib_wqueue_add(fts_optimize_worker_wq, msg, msg->heap);
+
+		os_event_wait(event);
+		os_event_free(event);
+	}
+}
+
+/**********************************************************************//**
+Optimize all FTS tables. The tables are handed over to the worker
+threads, and this thread keeps track of when they are due.
 @return Dummy return */
 UNIV_INTERN
 os_thread_ret_t
@@ -3012,11 +3214,17 @@ fts_optimize_thread(
 	ulint		n_tables = 0;
 	os_event_t	exit_event = 0;
 	ulint		n_optimize = 0;
+	ulint		n_running = 0;
+	ulint		max_running;
 	ib_wqueue_t*	wq = (ib_wqueue_t*) arg;
 
 	ut_ad(!srv_read_only_mode);
 	my_thread_init();
 
+	/* Keep a worker free for the sync requests, unless there is
+	only one. */
+	max_running = fts_optimize_threads > 1 ? fts_optimize_threads - 1 : 1;
+
 	heap = mem_heap_create(sizeof(dict_table_t*) * 64);
 	heap_alloc = ib_heap_allocator_create(heap);
 
@@ -3025,12 +3233,13 @@ fts_optimize_thread(
 	while(!done && srv_shutdown_state == SRV_SHUTDOWN_NONE) {
 
 		/* If there is no message in the queue and we have tables
-		to optimize then optimize the tables. */
+		to optimize then hand them over to the worker threads. */
 
 		if (!done
 		    && ib_wqueue_is_empty(wq)
 		    && n_tables > 0
-		    && n_optimize > 0) {
+		    && n_optimize > 0
+		    && n_running < max_running) {
 
 			fts_slot_t*	slot;
 
@@ -3039,12 +3248,16 @@ fts_optimize_thread(
 			slot = static_cast<fts_slot_t*>(
 				ib_vector_get(tables, current));
 
-			/* Handle the case of empty slots. */
-			if (slot->state != FTS_STATE_EMPTY) {
+			/* Handle the case of empty slots, and of tables
+			that a worker is still optimizing. */
+			if (slot->state != FTS_STATE_EMPTY
+			    && !slot->in_worker) {
 
 				slot->state = FTS_STATE_RUNNING;
 
-				fts_optimize_table_bk(slot);
+				if (fts_optimize_table_bk(slot)) {
+					++n_running;
+				}
 			}
 
 			++current;
@@ -3056,8 +3269,10 @@ fts_optimize_thread(
 				current = 0;
 			}
 
-		} else if (n_optimize == 0 || !ib_wqueue_is_empty(wq)) {
+		} else {
 			fts_msg_t*	msg;
+			fts_msg_del_t*	remove;
+			fts_slot_t*	slot;
 
 			msg = static_cast<fts_msg_t*>(
 				ib_wqueue_timedwait(wq,
@@ -3104,28 +3319,56 @@ fts_optimize_thread(
 				break;
 
 			case FTS_MSG_DEL_TABLE:
-				if (fts_optimize_del_table(
-					tables, static_cast<fts_msg_del_t*>(
-						msg->ptr))) {
+				remove = static_cast<fts_msg_del_t*>(msg->ptr);
+				slot = fts_optimize_find_slot(
+					tables, remove->table);
+
+				if (slot != NULL && slot->in_worker) {
+					/* The producer is signalled when
+					the worker is done with the table,
+					see fts_optimize_table_done(). */
+					ut_ad(slot->del_event == NULL);
+					slot->del_event = remove->event;
+					break;
+				}
+
+				if (fts_optimize_del_table(tables, remove)) {
 					--n_tables;
 				}
 
 				/* Signal the producer that we have
 				removed the table. */
-				os_event_set(
-					((fts_msg_del_t*) msg->ptr)->event);
+				os_event_set(remove->event);
 				break;
 
 			case FTS_MSG_SYNC_TABLE:
-				fts_optimize_sync_table(
-					*static_cast<table_id_t*>(msg->ptr));
+				/* Let a worker do the sync, it frees
+				the message. */
+				ib_wqueue_add(
+					fts_optimize_worker_wq,
+					msg, msg->heap);
+				msg = NULL;
+				break;
+
+			case FTS_MSG_OPTIMIZE_DONE:
+				ut_a(n_running > 0);
+				--n_running;
+
+				if (fts_optimize_table_done(
+					tables,
+					static_cast<fts_msg_optimize_t*>(
+						msg->ptr))) {
+					--n_tables;
+				}
 				break;
 
 			default:
 				ut_error;
 			}
 
-			mem_heap_free(msg->heap);
+			if (msg != NULL) {
+				mem_heap_free(msg->heap);
+			}
 
 			if (!done) {
 				n_optimize = fts_optimize_how_many(tables);
@@ -3136,22 +3379,67 @@ fts_optimize_thread(
 	}
 
 	/* Server is being shutdown, sync the data from FTS cache to disk
-	if needed */
+	if needed. The worker threads sync the tables in parallel. */
 	if (n_tables > 0) {
 		ulint	i;
 
 		for (i = 0; i < ib_vector_size(tables); i++) {
 			fts_slot_t*	slot;
+			fts_msg_t*	msg;
+			table_id_t*	table_id;
 
 			slot = static_cast<fts_slot_t*>(
 				ib_vector_get(tables, i));
 
-			if (slot->state != FTS_STATE_EMPTY) {
-				fts_optimize_sync_table(slot->table_id);
+			if (slot->state == FTS_STATE_EMPTY) {
+				continue;
 			}
+
+			msg = fts_optimize_create_msg(
+				FTS_MSG_SYNC_TABLE, NULL);
+
+			table_id = static_cast<table_id_t*>(
+				mem_heap_alloc(msg->heap, sizeof(table_id_t)));
+			*table_id = slot->table_id;
+			msg->ptr = table_id;
+
+			ib_wqueue_add(fts_optimize_worker_wq, msg, msg->heap);
+		}
+	}
+
+	fts_optimize_stop_workers();
+
+	/* Collect the reports of the OPTIMIZE runs that were still in
+	progress, and release the producers that are waiting for us. */
+	while (!ib_wqueue_is_empty(wq)) {
+		fts_msg_t*	msg;
+
+		msg = static_cast<fts_msg_t*>(ib_wqueue_wait(wq));
+
+		switch (msg->type) {
+		case FTS_MSG_OPTIMIZE_DONE:
+			ut_a(n_running > 0);
+			--n_running;
+
+			fts_optimize_table_done(
+				tables,
+				static_cast<fts_msg_optimize_t*>(msg->ptr));
+			break;
+
+		case FTS_MSG_DEL_TABLE:
+			os_event_set(
+				((fts_msg_del_t*) msg->ptr)->event);
+			break;
+
+		default:
+			break;
 		}
+
+		mem_heap_free(msg->heap);
 	}
 
+	ut_a(n_running == 0);
+
 	ib_vector_free(tables);
 
 	ib_logf(IB_LOG_LEVEL_INFO, "FTS optimize thread exiting.");
@@ -3167,7 +3455,7 @@ fts_optimize_thread(
 }
 
 /**********************************************************************//**
-Startup the optimize thread and create the work queue. */
+Startup the optimize thread, its worker threads and their work queues. */
 UNIV_INTERN
 void
 fts_optimize_init(void)
@@ -3175,13 +3463,23 @@ fts_optimize_init(void)
 {
 	ut_ad(!srv_read_only_mode);
 
-	/* For now we only support one optimize thread. */
+	/* There is one optimize thread, that hands the tables over to
+	the worker threads. */
 	ut_a(fts_optimize_wq == NULL);
 
 	fts_optimize_wq = ib_wqueue_create();
 	ut_a(fts_optimize_wq != NULL);
+
+	fts_optimize_worker_wq = ib_wqueue_create();
+	ut_a(fts_optimize_worker_wq != NULL);
+
 	last_check_sync_time = ut_time();
 
+	for (ulint i = 0; i < fts_optimize_threads; ++i) {
+		os_thread_create(fts_optimize_worker_thread,
+				 fts_optimize_worker_wq, NULL);
+	}
+
 	os_thread_create(fts_optimize_thread, fts_optimize_wq, NULL);
 }
 
@@ -3231,6 +3529,7 @@ fts_optimize_start_shutdown(void)
 	os_event_wait(event);
 	os_event_free(event);
 
+	ib_wqueue_free(fts_optimize_worker_wq);
 	ib_wqueue_free(fts_optimize_wq);
 
 }
@@ -3247,4 +3546,5 @@ fts_optimize_end(void)
 	// FIXME: Potential race condition here: We should wait for
 	// the optimize thread to confirm shutdown.
 	fts_optimize_wq = NULL;
+	fts_optimize_worker_wq = NULL;
 }
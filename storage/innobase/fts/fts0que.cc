@@ -40,6 +40,7 @@ Completed 2011/7/10 Sunny and Jimmy Yang
 #include "fts0vlc.ic"
 #endif
 
+#include <algorithm>
 #include <vector>
 
 #define FTS_ELEM(t, n, i, j) (t[(i) * n + (j)])
@@ -57,6 +58,13 @@ Completed 2011/7/10 Sunny and Jimmy Yang
 /*Initial byte length for 'words' in fts_ranking_t */
 #define RANKING_WORDS_INIT_LEN	4
 
+/* Number of docs per block when an ilist without a block directory is
+read for a top-N query */
+#define FTS_TOPN_BLOCK_SIZE	128
+
+/* Doc id of an exhausted posting list cursor */
+#define FTS_TOPN_DOC_END	(~(doc_id_t) 0)
+
 // FIXME: Need to have a generic iterator that traverses the ilist.
 
 typedef std::vector<fts_string_t>	word_vector_t;
@@ -234,6 +242,58 @@ struct fts_word_freq_t {
 	double		idf;		/*!< Inverse document frequency */
 };
 
+/** A block of the ilists of a term in a top-N query, see
+FTS_ILIST_BLOCK_MARKER */
+struct fts_topn_block_t {
+	doc_id_t	base_doc_id;	/*!< Doc id the first delta in the
+					block is relative to */
+	doc_id_t	last_doc_id;	/*!< Last doc id in the block */
+	byte*		start;		/*!< First byte of the block */
+	byte*		end;		/*!< End of the block */
+	ulint		max_freq;	/*!< Maximum term frequency of the
+					docs in the block */
+	fts_rank_t	max_rank;	/*!< Rank contributed by max_freq */
+	fts_rank_t	max_rank_left;	/*!< Maximum of max_rank in this and
+					the following blocks */
+};
+
+typedef std::vector<fts_topn_block_t>	fts_topn_block_vector_t;
+typedef std::vector<fts_node_t>		fts_topn_node_vector_t;
+
+/** Posting list cursor of a term in a top-N query. The term walks
+through the docs of all its nodes in doc id order. */
+struct fts_topn_term_t {
+	fts_string_t	word;		/*!< The term */
+	fts_topn_node_vector_t
+			nodes;		/*!< Nodes of the term, with the
+					ilists copied to fts_topn_t::heap */
+	fts_topn_block_vector_t
+			blocks;		/*!< Blocks of the nodes */
+	ib_uint64_t	doc_count;	/*!< Number of docs containing the
+					term, as used for the IDF */
+	double		idf;		/*!< Inverse document frequency */
+	ulint		cur_block;	/*!< Block of the cursor */
+	byte*		ptr;		/*!< Next doc in cur_block */
+	doc_id_t	doc_id;		/*!< Doc of the cursor, or
+					FTS_TOPN_DOC_END */
+	ulint		freq;		/*!< Term frequency in doc_id */
+};
+
+typedef std::vector<fts_topn_term_t>	fts_topn_term_vector_t;
+typedef std::vector<fts_ranking_t>	fts_topn_heap_t;
+
+/** State of a top-N query */
+struct fts_topn_t {
+	fts_query_t*	query;		/*!< The query */
+	mem_heap_t*	heap;		/*!< Heap for the ilist copies */
+	fts_topn_term_vector_t
+			terms;		/*!< Terms in query order */
+	fts_topn_term_t*
+			cur_term;	/*!< Term whose nodes are read */
+	ulint		n_ranked;	/*!< Number of docs ranked */
+	ulint		n_skipped;	/*!< Number of blocks skipped */
+};
+
 /********************************************************************
 Callback function to fetch the rows in an FTS INDEX record.
 @return always TRUE */
@@ -3251,6 +3311,8 @@ fts_query_read_node(
 
 		case 4: /* ILIST */
 
+			data = fts_ilist_skip_directory(data, &len);
+
 			error = fts_query_filter_doc_ids(
 					query, &word_freq->word, word_freq,
 					&node, data, len, FALSE);
@@ -3816,6 +3878,702 @@ fts_query_str_preprocess(
 	return(str_ptr);
 }
 
+/*******************************************************************//**
+Check whether a query can be evaluated with fts_query_topn(). Only
+natural language queries of distinct simple terms can, as their rank is
+a plain sum over the terms.
+@return true if the top-N evaluation applies */
+static
+bool
+fts_query_topn_applicable(
+/*======================*/
+	fts_query_t*	query,		/*!< in/out: query instance */
+	uint		flags)		/*!< in: FTS search mode */
+{
+	const fts_ast_node_t*	node;
+
+	DBUG_EXECUTE_IF("fts_query_topn_disable", return(false););
+
+	if (query->boolean_mode || (flags & FTS_EXPAND)) {
+		return(false);
+	}
+
+	ut_ad(query->root->type == FTS_AST_LIST);
+
+	node = query->root->list.head;
+
+	if (node == NULL) {
+		return(false);
+	}
+
+	for (; node != NULL; node = node->next) {
+		fts_string_t	word;
+		ulint		n_words = rbt_size(query->word_freqs);
+
+		if (node->type != FTS_AST_TERM
+		    || node->term.wildcard
+		    || node->term.ptr->len == 0) {
+			return(false);
+		}
+
+		word.f_str = node->term.ptr->str;
+		word.f_len = node->term.ptr->len;
+
+		/* A repeated term would be counted twice in the IDF
+		but only once in the rank, leave that to the full
+		evaluation. */
+		fts_query_add_word_freq(query, &word);
+
+		if (rbt_size(query->word_freqs) == n_words) {
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/*****************************************************************//**
+Callback function to fetch the rows of a term in a top-N query.
+@return FALSE if the result cache limit is exceeded */
+static
+ibool
+fts_query_topn_fetch_node(
+/*======================*/
+	void*		row,		/*!< in: sel_node_t* */
+	void*		user_arg)	/*!< in: pointer to fts_fetch_t */
+{
+	sel_node_t*	sel_node = static_cast<sel_node_t*>(row);
+	fts_fetch_t*	fetch = static_cast<fts_fetch_t*>(user_arg);
+	fts_topn_t*	topn = static_cast<fts_topn_t*>(fetch->read_arg);
+	que_node_t*	exp;
+	fts_node_t	node;
+	int		i;
+
+	memset(&node, 0, sizeof(node));
+
+	/* Skip the word, all rows are of the current term. */
+	exp = que_node_get_next(sel_node->select_list);
+
+	for (i = 1; exp; exp = que_node_get_next(exp), ++i) {
+
+		dfield_t*	dfield = que_node_get_val(exp);
+		byte*		data = static_cast<byte*>(
+			dfield_get_data(dfield));
+		ulint		len = dfield_get_len(dfield);
+
+		ut_a(len != UNIV_SQL_NULL);
+
+		/* Note: The column numbers below must match the SELECT. */
+
+		switch (i) {
+		case 1: /* DOC_COUNT */
+			node.doc_count = mach_read_from_4(data);
+			break;
+
+		case 2: /* FIRST_DOC_ID */
+			node.first_doc_id = fts_read_doc_id(data);
+			break;
+
+		case 3: /* LAST_DOC_ID */
+			node.last_doc_id = fts_read_doc_id(data);
+			break;
+
+		case 4: /* ILIST */
+			node.ilist = static_cast<byte*>(
+				mem_heap_dup(topn->heap, data, len));
+			node.ilist_size = len;
+			break;
+
+		default:
+			ut_error;
+		}
+	}
+
+	/* Make sure all columns were read. */
+	ut_a(i == 5);
+
+	topn->cur_term->nodes.push_back(node);
+
+	topn->query->total_size += sizeof(node) + node.ilist_size;
+
+	return(topn->query->total_size <= fts_result_cache_limit);
+}
+
+/*****************************************************************//**
+Read the nodes of a term in a top-N query, from the index cache and
+from disk.
+@return DB_SUCCESS if all go well */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+fts_query_topn_read_nodes(
+/*======================*/
+	fts_topn_t*		topn,	/*!< in/out: top-N query state */
+	fts_topn_term_t*	term)	/*!< in/out: term to read */
+{
+	fts_query_t*		query = topn->query;
+	fts_cache_t*		cache = query->index->table->fts->cache;
+	const fts_index_cache_t*index_cache;
+	const ib_vector_t*	nodes;
+	fts_fetch_t		fetch;
+	que_t*			graph = NULL;
+	dberr_t			error;
+
+	topn->cur_term = term;
+
+	rw_lock_x_lock(&cache->lock);
+
+	index_cache = fts_find_index_cache(cache, query->index);
+
+	/* Must find the index cache. */
+	ut_a(index_cache != NULL);
+
+	nodes = fts_cache_find_word(index_cache, &term->word);
+
+	for (ulint i = 0; nodes && i < ib_vector_size(nodes); ++i) {
+		fts_node_t	node;
+
+		node = *static_cast<const fts_node_t*>(
+			ib_vector_get_const(nodes, i));
+
+		node.ilist = static_cast<byte*>(
+			mem_heap_dup(topn->heap, node.ilist, node.ilist_size));
+
+		term->nodes.push_back(node);
+
+		query->total_size += sizeof(node) + node.ilist_size;
+	}
+
+	rw_lock_x_unlock(&cache->lock);
+
+	if (query->total_size > fts_result_cache_limit) {
+		return(DB_FTS_EXCEED_RESULT_CACHE_LIMIT);
+	}
+
+	fetch.read_arg = topn;
+	fetch.read_record = fts_query_topn_fetch_node;
+
+	error = fts_index_fetch_nodes(
+		query->trx, &graph, &query->fts_index_table, &term->word,
+		&fetch);
+
+	fts_que_graph_free(graph);
+
+	if (error == DB_SUCCESS
+	    && query->total_size > fts_result_cache_limit) {
+		error = DB_FTS_EXCEED_RESULT_CACHE_LIMIT;
+	}
+
+	return(error);
+}
+
+/*******************************************************************//**
+Compare two nodes on their first doc id.
+@return true if n1 sorts before n2 */
+static
+bool
+fts_query_topn_node_less(
+/*=====================*/
+	const fts_node_t&	n1,	/*!< in: node */
+	const fts_node_t&	n2)	/*!< in: node */
+{
+	return(n1.first_doc_id < n2.first_doc_id);
+}
+
+/*****************************************************************//**
+Split the ilist of a node into blocks. The blocks come from the block
+directory if the ilist has one, otherwise they are built here. */
+static
+void
+fts_query_topn_add_blocks(
+/*======================*/
+	fts_topn_term_t*	term,	/*!< in/out: term */
+	const fts_node_t*	node)	/*!< in: node of the term */
+{
+	fts_topn_block_t	block;
+	byte*			ptr = node->ilist;
+	byte*			end = node->ilist + node->ilist_size;
+	doc_id_t		doc_id = 0;
+	ulint			n_docs = 0;
+
+	memset(&block, 0, sizeof(block));
+
+	if (*ptr == FTS_ILIST_BLOCK_MARKER) {
+		byte*		data;
+		ulint		dir_len;
+		ulint		n_blocks;
+		doc_id_t	last_doc_id = node->first_doc_id;
+
+		++ptr;
+		dir_len = fts_decode_vlc(&ptr);
+		data = ptr + dir_len;
+
+		n_blocks = fts_decode_vlc(&ptr);
+
+		for (ulint i = 0; i < n_blocks; ++i) {
+			block.base_doc_id = (i == 0) ? 0 : last_doc_id;
+
+			last_doc_id += fts_decode_vlc(&ptr);
+			block.last_doc_id = last_doc_id;
+
+			block.start = data;
+			data += fts_decode_vlc(&ptr);
+			block.end = data;
+
+			block.max_freq = fts_decode_vlc(&ptr);
+
+			term->blocks.push_back(block);
+		}
+
+		ut_a(data == end);
+		ut_a(last_doc_id == node->last_doc_id);
+
+		return;
+	}
+
+	block.start = ptr;
+
+	while (ptr < end) {
+		ulint	freq = 0;
+
+		doc_id += fts_decode_vlc(&ptr);
+
+		while (*ptr) {
+			fts_decode_vlc(&ptr);
+			++freq;
+		}
+
+		/* Skip the end of positions marker. */
+		++ptr;
+
+		block.max_freq = ut_max(block.max_freq, freq);
+
+		if (++n_docs == FTS_TOPN_BLOCK_SIZE || ptr == end) {
+			block.last_doc_id = doc_id;
+			block.end = ptr;
+
+			term->blocks.push_back(block);
+
+			block.base_doc_id = doc_id;
+			block.start = ptr;
+			block.max_freq = 0;
+			n_docs = 0;
+		}
+	}
+
+	ut_a(doc_id == node->last_doc_id);
+}
+
+/*****************************************************************//**
+Decode the next doc of the current block of a term cursor. */
+UNIV_INLINE
+void
+fts_query_topn_decode(
+/*==================*/
+	fts_topn_term_t*	term)	/*!< in/out: term cursor */
+{
+	ulint	freq = 0;
+
+	term->doc_id += fts_decode_vlc(&term->ptr);
+
+	while (*term->ptr) {
+		fts_decode_vlc(&term->ptr);
+		++freq;
+	}
+
+	/* Skip the end of positions marker. */
+	++term->ptr;
+
+	term->freq = freq;
+}
+
+/*****************************************************************//**
+Position a term cursor on the first doc of a block. */
+static
+void
+fts_query_topn_enter_block(
+/*=======================*/
+	fts_topn_term_t*	term,	/*!< in/out: term cursor */
+	ulint			i)	/*!< in: block number */
+{
+	term->cur_block = i;
+
+	if (i >= term->blocks.size()) {
+		term->doc_id = FTS_TOPN_DOC_END;
+		return;
+	}
+
+	term->doc_id = term->blocks[i].base_doc_id;
+	term->ptr = term->blocks[i].start;
+
+	fts_query_topn_decode(term);
+}
+
+/*****************************************************************//**
+Move a term cursor to its next doc. */
+static
+void
+fts_query_topn_next(
+/*================*/
+	fts_topn_term_t*	term)	/*!< in/out: term cursor */
+{
+	ut_ad(term->doc_id != FTS_TOPN_DOC_END);
+
+	if (term->ptr < term->blocks[term->cur_block].end) {
+		fts_query_topn_decode(term);
+	} else {
+		fts_query_topn_enter_block(term, term->cur_block + 1);
+	}
+}
+
+/*****************************************************************//**
+Move a term cursor past a doc id, skipping whole blocks without
+decoding them where possible.
+@return number of blocks skipped */
+static
+ulint
+fts_query_topn_skip(
+/*================*/
+	fts_topn_term_t*	term,	/*!< in/out: term cursor */
+	doc_id_t		doc_id)	/*!< in: doc id to move past */
+{
+	ulint	n_skipped = 0;
+
+	while (term->doc_id <= doc_id) {
+		if (term->blocks[term->cur_block].last_doc_id <= doc_id) {
+			fts_query_topn_enter_block(
+				term, term->cur_block + 1);
+			++n_skipped;
+		} else {
+			fts_query_topn_next(term);
+		}
+	}
+
+	return(n_skipped);
+}
+
+/*****************************************************************//**
+Count the deleted docs that contain a term, for a single term query
+which does not count them in the IDF.
+@return number of deleted docs containing the term */
+static
+ulint
+fts_query_topn_count_deleted(
+/*=========================*/
+	const fts_query_t*	query,	/*!< in: query instance */
+	fts_topn_term_t*	term)	/*!< in/out: term cursor, left
+					positioned at the first doc */
+{
+	ulint			n_deleted = 0;
+	ulint			size = ib_vector_size(query->deleted->doc_ids);
+	const fts_update_t*	array =
+		(const fts_update_t*) query->deleted->doc_ids->data;
+
+	fts_query_topn_enter_block(term, 0);
+
+	/* The deleted doc ids are sorted but may be repeated. */
+	for (ulint i = 0; i < size && term->doc_id != FTS_TOPN_DOC_END; ++i) {
+		doc_id_t	doc_id = array[i].doc_id;
+
+		if (i > 0 && doc_id == array[i - 1].doc_id) {
+			continue;
+		}
+
+		if (doc_id > term->doc_id) {
+			fts_query_topn_skip(term, doc_id - 1);
+		}
+
+		if (doc_id == term->doc_id) {
+			++n_deleted;
+		}
+	}
+
+	fts_query_topn_enter_block(term, 0);
+
+	return(n_deleted);
+}
+
+/*******************************************************************//**
+Compare two rankings in the final result order, descending on the rank
+and ascending on the doc id, like fts_query_sort_result_on_rank() does.
+@return true if r1 ranks before r2 */
+static
+bool
+fts_query_topn_ranks_before(
+/*========================*/
+	const fts_ranking_t&	r1,	/*!< in: ranking */
+	const fts_ranking_t&	r2)	/*!< in: ranking */
+{
+	return(r1.rank > r2.rank
+	       || (r1.rank == r2.rank && r1.doc_id < r2.doc_id));
+}
+
+/*****************************************************************//**
+Evaluate a natural language query when only the first "limit" docs in
+rank order are needed. The postings of the terms are walked in doc id
+order, and every block whose maximum term frequencies can't beat the
+lowest rank kept so far is skipped without being decoded (block-max
+WAND). The ranks of the docs returned are the same as the full
+evaluation computes.
+@return DB_SUCCESS if all go well, *result is left NULL if the query
+must be evaluated in full */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+fts_query_topn(
+/*===========*/
+	fts_query_t*	query,		/*!< in/out: query instance */
+	ulint		limit,		/*!< in: number of docs needed */
+	fts_result_t**	result)		/*!< out: result doc ids */
+{
+	fts_topn_t		topn;
+	const fts_ast_node_t*	node;
+	fts_topn_heap_t		heap;
+	ulint			n_docs = 0;
+	ulint			total_size = query->total_size;
+	ulint			size = ib_vector_size(query->deleted->doc_ids);
+	const fts_update_t*	array =
+		(const fts_update_t*) query->deleted->doc_ids->data;
+	dberr_t			error = DB_SUCCESS;
+
+	ut_ad(*result == NULL);
+
+	topn.query = query;
+	topn.heap = mem_heap_create(16384);
+	topn.cur_term = NULL;
+	topn.n_ranked = 0;
+	topn.n_skipped = 0;
+
+	for (node = query->root->list.head; node; node = node->next) {
+		fts_topn_term_t	term;
+
+		memset(&term.word, 0, sizeof(term.word));
+		term.word.f_str = node->term.ptr->str;
+		term.word.f_len = node->term.ptr->len;
+		term.doc_count = 0;
+		term.idf = 0;
+
+		topn.terms.push_back(term);
+	}
+
+	for (ulint i = 0; i < topn.terms.size(); ++i) {
+		fts_topn_term_t*	term = &topn.terms[i];
+
+		error = fts_query_topn_read_nodes(&topn, term);
+
+		if (error != DB_SUCCESS) {
+			goto func_exit;
+		}
+
+		std::sort(term->nodes.begin(), term->nodes.end(),
+			  fts_query_topn_node_less);
+
+		for (ulint j = 0; j < term->nodes.size(); ++j) {
+			const fts_node_t*	fts_node = &term->nodes[j];
+
+			/* A doc found in two nodes is ranked on the node
+			read first, leave that to the full evaluation. */
+			if (j > 0
+			    && fts_node->first_doc_id
+			    <= term->nodes[j - 1].last_doc_id) {
+				goto func_exit;
+			}
+
+			term->doc_count += fts_node->doc_count;
+
+			if (fts_node->ilist_size > 0) {
+				fts_query_topn_add_blocks(term, fts_node);
+			}
+		}
+
+		n_docs += term->doc_count;
+
+		if (query->flags == FTS_OPT_RANKING) {
+			term->doc_count -= fts_query_topn_count_deleted(
+				query, term);
+		}
+
+		/* Same as fts_query_calculate_idf(). */
+		if (term->doc_count > 0) {
+			if (query->total_docs == term->doc_count) {
+				term->idf = log10(1.0001);
+			} else {
+				term->idf = log10(
+					query->total_docs
+					/ (double) term->doc_count);
+			}
+		}
+
+		/* Pruning relies on the ranks growing with the term
+		frequency. */
+		if (term->idf < 0) {
+			goto func_exit;
+		}
+
+		for (ulint j = term->blocks.size(); j > 0; --j) {
+			fts_topn_block_t*	block = &term->blocks[j - 1];
+
+			block->max_rank = static_cast<fts_rank_t>(
+				(double) block->max_freq
+				* term->idf * term->idf);
+
+			block->max_rank_left = block->max_rank;
+
+			if (j < term->blocks.size()) {
+				block->max_rank_left = ut_max(
+					block->max_rank_left,
+					term->blocks[j].max_rank_left);
+			}
+		}
+
+		fts_query_topn_enter_block(term, 0);
+	}
+
+	/* Nothing to prune, the full evaluation is as fast. */
+	if (limit >= n_docs) {
+		goto func_exit;
+	}
+
+	for (;;) {
+		doc_id_t	doc_id = FTS_TOPN_DOC_END;
+		fts_ranking_t	ranking;
+
+		for (ulint i = 0; i < topn.terms.size(); ++i) {
+			doc_id = ut_min(doc_id, topn.terms[i].doc_id);
+		}
+
+		if (doc_id == FTS_TOPN_DOC_END) {
+			break;
+		}
+
+		/* Docs are visited in doc id order, so a doc that ranks
+		the same as the lowest kept one can't replace it. */
+		if (heap.size() == limit) {
+			fts_rank_t	min_rank = heap.front().rank;
+			fts_rank_t	max_rank = 0;
+			fts_rank_t	max_rank_left = 0;
+			doc_id_t	last_doc_id = FTS_TOPN_DOC_END;
+
+			for (ulint i = 0; i < topn.terms.size(); ++i) {
+				const fts_topn_term_t*	term = &topn.terms[i];
+				const fts_topn_block_t*	block;
+
+				if (term->doc_id == FTS_TOPN_DOC_END) {
+					continue;
+				}
+
+				block = &term->blocks[term->cur_block];
+
+				max_rank_left += block->max_rank_left;
+
+				last_doc_id = ut_min(
+					last_doc_id, block->last_doc_id);
+			}
+
+			/* No doc left can make it into the result. */
+			if (max_rank_left <= min_rank) {
+				break;
+			}
+
+			/* The terms are summed in the same order as the
+			docs are ranked, so that the float rounding
+			can't make the bound lower than a rank. */
+			for (ulint i = 0; i < topn.terms.size(); ++i) {
+				const fts_topn_term_t*	term = &topn.terms[i];
+
+				if (term->doc_id <= last_doc_id) {
+					max_rank += term->blocks[
+						term->cur_block].max_rank;
+				}
+			}
+
+			/* No doc up to last_doc_id can make it into the
+			result, skip to the next block. */
+			if (max_rank <= min_rank) {
+				for (ulint i = 0; i < topn.terms.size(); ++i) {
+					topn.n_skipped += fts_query_topn_skip(
+						&topn.terms[i], last_doc_id);
+				}
+
+				continue;
+			}
+		}
+
+		ranking.doc_id = doc_id;
+		ranking.rank = 0;
+		ranking.words = NULL;
+		ranking.words_len = 0;
+
+		/* Same as fts_query_calculate_ranking(). */
+		for (ulint i = 0; i < topn.terms.size(); ++i) {
+			fts_topn_term_t*	term = &topn.terms[i];
+
+			if (term->doc_id == doc_id) {
+				double	weight = (double) term->freq
+					* term->idf;
+
+				ranking.rank += static_cast<fts_rank_t>(
+					weight * term->idf);
+
+				fts_query_topn_next(term);
+			}
+		}
+
+		++topn.n_ranked;
+
+		/* Don't put deleted docs into result */
+		if (fts_bsearch(const_cast<fts_update_t*>(array), 0,
+				static_cast<int>(size), doc_id) >= 0) {
+			continue;
+		}
+
+		if (heap.size() < limit) {
+			heap.push_back(ranking);
+			std::push_heap(heap.begin(), heap.end(),
+				       fts_query_topn_ranks_before);
+
+			query->total_size += sizeof(ranking);
+		} else if (ranking.rank > heap.front().rank) {
+			std::pop_heap(heap.begin(), heap.end(),
+				      fts_query_topn_ranks_before);
+			heap.back() = ranking;
+			std::push_heap(heap.begin(), heap.end(),
+				       fts_query_topn_ranks_before);
+		}
+	}
+
+	*result = static_cast<fts_result_t*>(ut_malloc(sizeof(**result)));
+	memset(*result, 0x0, sizeof(**result));
+
+	(*result)->rankings_by_id = rbt_create(
+		sizeof(fts_ranking_t), fts_ranking_doc_id_cmp);
+
+	for (ulint i = 0; i < heap.size(); ++i) {
+		rbt_insert((*result)->rankings_by_id, &heap[i], &heap[i]);
+	}
+
+	srv_stats.n_fts_topn_queries.inc();
+	srv_stats.n_fts_topn_blocks_skipped.add(topn.n_skipped);
+
+	if (fts_enable_diag_print) {
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"FTS top-%lu query ranked %lu of %lu docs,"
+			" skipped %lu blocks.",
+			(ulong) limit, (ulong) topn.n_ranked, (ulong) n_docs,
+			(ulong) topn.n_skipped);
+	}
+
+func_exit:
+	mem_heap_free(topn.heap);
+
+	query->total_size = total_size
+		+ (*result != NULL
+		   ? sizeof(fts_result_t) + SIZEOF_RBT_CREATE
+		   + heap.size() * (SIZEOF_RBT_NODE_ADD
+				    + sizeof(fts_ranking_t))
+		   : 0);
+
+	return(error);
+}
+
 /*******************************************************************//**
 FTS Query entry point.
 @return DB_SUCCESS if successful otherwise error code */
@@ -3829,6 +4587,8 @@ fts_query(
 	const byte*	query_str,	/*!< in: FTS query */
 	ulint		query_len,	/*!< in: FTS query string len
 					in bytes */
+	ulint		limit,		/*!< in: number of docs needed in
+					rank order, or ULINT_UNDEFINED */
 	fts_result_t**	result)		/*!< in/out: result doc ids */
 {
 	fts_query_t	query;
@@ -3964,28 +4724,40 @@ fts_query(
 			        fts_result_cache_limit = 2048;
 		);
 
+		/* Rank only the docs that can make it into the first
+		"limit" ones if that is all the caller needs. */
+		if (limit != ULINT_UNDEFINED
+		    && fts_query_topn_applicable(&query, flags)) {
+			query.error = fts_query_topn(&query, limit, result);
+		}
+
 		/* Traverse the Abstract Syntax Tree (AST) and execute
 		the query. */
-		query.error = fts_ast_visit(
-			FTS_NONE, ast, fts_query_visitor,
-			&query, &will_be_ignored);
-
-		/* If query expansion is requested, extend the search
-		with first search pass result */
-		if (query.error == DB_SUCCESS && (flags & FTS_EXPAND)) {
-			query.error = fts_expand_query(index, &query);
-		}
+		if (query.error == DB_SUCCESS && *result == NULL) {
+			query.error = fts_ast_visit(
+				FTS_NONE, ast, fts_query_visitor,
+				&query, &will_be_ignored);
+
+			/* If query expansion is requested, extend the
+			search with first search pass result */
+			if (query.error == DB_SUCCESS
+			    && (flags & FTS_EXPAND)) {
+				query.error = fts_expand_query(index, &query);
+			}
 
-		/* Calculate the inverse document frequency of the terms. */
-		if (query.error == DB_SUCCESS
-		    && query.flags != FTS_OPT_RANKING) {
-			fts_query_calculate_idf(&query);
-		}
+			/* Calculate the inverse document frequency of
+			the terms. */
+			if (query.error == DB_SUCCESS
+			    && query.flags != FTS_OPT_RANKING) {
+				fts_query_calculate_idf(&query);
+			}
 
-		/* Copy the result from the query state, so that we can
-		return it to the caller. */
-		if (query.error == DB_SUCCESS) {
-			*result = fts_query_get_result(&query, *result);
+			/* Copy the result from the query state, so that
+			we can return it to the caller. */
+			if (query.error == DB_SUCCESS) {
+				*result = fts_query_get_result(
+					&query, *result);
+			}
 		}
 
 		error = query.error;
@@ -64,7 +64,14 @@ ha_create_func(
 	     || type == MEM_HEAP_FOR_PAGE_HASH);
 
 	ut_ad(ut_is_2pow(n_sync_obj));
-	table = hash_create(n);
+
+	if (type == MEM_HEAP_FOR_PAGE_HASH && n_sync_obj > 0) {
+		/* buf_pool->page_hash is resized together with the
+		buffer pool, while the rw_locks stay in place */
+		table = hash_create_aligned(n, n_sync_obj);
+	} else {
+		table = hash_create(n);
+	}
 
 	/* Creating MEM_HEAP_BTR_SEARCH type heaps can potentially fail,
 	but in practise it never should in this case, hence the asserts. */
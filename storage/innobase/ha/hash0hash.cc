@@ -285,31 +285,27 @@ hash_unlock_x_all_but(
 #endif /* !UNIV_HOTBACKUP */
 
 /*************************************************************//**
-Creates a hash table with >= n array cells. The actual number of cells is
-chosen to be a prime number slightly bigger than n.
+Creates a hash table with exactly n_cells array cells.
 @return	own: created table */
-UNIV_INTERN
+static
 hash_table_t*
-hash_create(
-/*========*/
-	ulint	n)	/*!< in: number of array cells */
+hash_create_low(
+/*============*/
+	ulint	n_cells)	/*!< in: number of array cells */
 {
 	hash_cell_t*	array;
-	ulint		prime;
 	hash_table_t*	table;
 
-	prime = ut_find_prime(n);
-
 	table = static_cast<hash_table_t*>(mem_alloc(sizeof(hash_table_t)));
 
 	array = static_cast<hash_cell_t*>(
-		ut_malloc(sizeof(hash_cell_t) * prime));
+		ut_malloc(sizeof(hash_cell_t) * n_cells));
 
 	/* The default type of hash_table is HASH_TABLE_SYNC_NONE i.e.:
 	the caller is responsible for access control to the table. */
 	table->type = HASH_TABLE_SYNC_NONE;
 	table->array = array;
-	table->n_cells = prime;
+	table->n_cells = n_cells;
 #ifndef UNIV_HOTBACKUP
 # if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 	table->adaptive = FALSE;
@@ -327,6 +323,95 @@ hash_create(
 	return(table);
 }
 
+/*************************************************************//**
+Creates a hash table with >= n array cells. The actual number of cells is
+chosen to be a prime number slightly bigger than n.
+@return	own: created table */
+UNIV_INTERN
+hash_table_t*
+hash_create(
+/*========*/
+	ulint	n)	/*!< in: number of array cells */
+{
+	return(hash_create_low(ut_find_prime(n)));
+}
+
+#ifndef UNIV_HOTBACKUP
+/*************************************************************//**
+Calculates the number of cells of a hash table that can be resized by
+hash_resize_aligned(): a multiple of n_sync_obj, by a prime number.
+@return	number of cells, >= n */
+static
+ulint
+hash_calc_n_cells_aligned(
+/*======================*/
+	ulint	n,		/*!< in: minimum number of array cells */
+	ulint	n_sync_obj)	/*!< in: number of sync objects,
+				a power of 2 */
+{
+	ut_ad(ut_is_2pow(n_sync_obj));
+
+	return(ut_find_prime((n + n_sync_obj - 1) / n_sync_obj)
+	       * n_sync_obj);
+}
+
+/*************************************************************//**
+Creates a hash table with >= n array cells, that is going to be
+protected by n_sync_obj sync objects.  The number of cells is a multiple
+of n_sync_obj, so that the table can later be resized with
+hash_resize_aligned().
+@return	own: created table */
+UNIV_INTERN
+hash_table_t*
+hash_create_aligned(
+/*================*/
+	ulint	n,		/*!< in: number of array cells */
+	ulint	n_sync_obj)	/*!< in: number of sync objects,
+				a power of 2 */
+{
+	return(hash_create_low(hash_calc_n_cells_aligned(n, n_sync_obj)));
+}
+
+/*************************************************************//**
+Replaces the cell array of a hash table created by hash_create_aligned()
+with an empty array of >= n cells.  hash_calc_hash() reduces a fold value
+modulo n_cells, and hash_get_sync_obj_index() reduces that modulo
+n_sync_obj; as n_cells stays a multiple of n_sync_obj, every fold value
+keeps being protected by the same sync object.  Threads that picked a
+sync object before the resize thus hold the right one after it.  The
+caller must hold all the sync objects in exclusive mode, and must insert
+the nodes of the returned array into the table again.
+@return	own: the old cell array, to be freed with ut_free() */
+UNIV_INTERN
+hash_cell_t*
+hash_resize_aligned(
+/*================*/
+	hash_table_t*	table,		/*!< in/out: hash table */
+	ulint		n,		/*!< in: number of array cells */
+	ulint*		n_old_cells)	/*!< out: number of cells in the
+					returned array */
+{
+	hash_cell_t*	old_array = table->array;
+	ulint		n_cells;
+
+	ut_ad(table->magic_n == HASH_TABLE_MAGIC_N);
+	ut_ad(table->type != HASH_TABLE_SYNC_NONE);
+	ut_ad(table->n_cells % table->n_sync_obj == 0);
+
+	n_cells = hash_calc_n_cells_aligned(n, table->n_sync_obj);
+
+	*n_old_cells = table->n_cells;
+
+	table->array = static_cast<hash_cell_t*>(
+		ut_malloc(sizeof(hash_cell_t) * n_cells));
+	table->n_cells = n_cells;
+
+	hash_table_clear(table);
+
+	return(old_array);
+}
+#endif /* !UNIV_HOTBACKUP */
+
 /*************************************************************//**
 Frees a hash table. */
 UNIV_INTERN
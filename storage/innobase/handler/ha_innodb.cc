@@ -373,6 +373,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 #  endif /* UNIV_MEM_DEBUG */
 	{&mem_pool_mutex_key, "mem_pool_mutex", 0},
 	{&mutex_list_mutex_key, "mutex_list_mutex", 0},
+	{&page_cleaner_mutex_key, "page_cleaner_mutex", 0},
 	{&page_zip_stat_per_index_mutex_key, "page_zip_stat_per_index_mutex", 0},
 	{&purge_sys_bh_mutex_key, "purge_sys_bh_mutex", 0},
 	{&recv_sys_mutex_key, "recv_sys_mutex", 0},
@@ -395,6 +396,8 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&srv_sys_mutex_key, "srv_sys_mutex", 0},
 	{&lock_sys_mutex_key, "lock_mutex", 0},
 	{&lock_sys_wait_mutex_key, "lock_wait_mutex", 0},
+	{&lock_sys_rec_mutex_key, "lock_rec_mutex", 0},
+	{&lock_sys_table_mutex_key, "lock_table_mutex", 0},
 	{&trx_mutex_key, "trx_mutex", 0},
 	{&srv_sys_tasks_mutex_key, "srv_threads_mutex", 0},
 	/* mutex with os_fast_mutex_ interfaces */
@@ -402,9 +405,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&event_os_mutex_key, "event_os_mutex", 0},
 #  endif /* PFS_SKIP_EVENT_MUTEX */
 	{&os_mutex_key, "os_mutex", 0},
-#ifndef HAVE_ATOMIC_BUILTINS
 	{&srv_conc_mutex_key, "srv_conc_mutex", 0},
-#endif /* !HAVE_ATOMIC_BUILTINS */
 #ifndef HAVE_ATOMIC_BUILTINS_64
 	{&monitor_mutex_key, "monitor_mutex", 0},
 #endif /* !HAVE_ATOMIC_BUILTINS_64 */
@@ -457,8 +458,15 @@ static PSI_thread_info	all_innodb_threads[] = {
 	{&srv_purge_thread_key, "srv_purge_thread", 0},
 	{&buf_page_cleaner_thread_key, "page_cleaner_thread", 0},
 	{&buf_lru_manager_thread_key, "lru_manager_thread", 0},
+	{&buf_page_cleaner_worker_thread_key, "page_cleaner_worker_thread", 0},
+	{&buf_lru_manager_worker_thread_key, "lru_manager_worker_thread", 0},
 	{&recv_writer_thread_key, "recv_writer_thread", 0},
-	{&srv_log_tracking_thread_key, "srv_redo_log_follow_thread", 0}
+	{&recv_apply_thread_key, "recv_apply_thread", 0},
+	{&fil_discovery_thread_key, "fil_discovery_thread", 0},
+	{&recv_log_read_ahead_thread_key, "recv_log_read_ahead_thread", 0},
+	{&srv_log_tracking_thread_key, "srv_redo_log_follow_thread", 0},
+	{&log_writer_thread_key, "log_writer_thread", 0},
+	{&log_flusher_thread_key, "log_flusher_thread", 0}
 };
 # endif /* UNIV_PFS_THREAD */
 
@@ -771,11 +779,19 @@ static MYSQL_THDVAR_STR(tmpdir,
   "Directory for temporary non-tablespace files.",
   innodb_tmpdir_validate, NULL, NULL);
 
+static MYSQL_THDVAR_ULONG(ddl_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads that sort and load secondary indexes in parallel,"
+  " one index per thread, when ALTER TABLE or CREATE INDEX builds more"
+  " than one index. The clustered index is always scanned by one thread.",
+  NULL, NULL, 1, 1, 64, 0);
+
 static SHOW_VAR innodb_status_variables[]= {
   {"buffer_pool_dump_status",
   (char*) &export_vars.innodb_buffer_pool_dump_status,	  SHOW_CHAR},
   {"buffer_pool_load_status",
   (char*) &export_vars.innodb_buffer_pool_load_status,	  SHOW_CHAR},
+  {"buffer_pool_resize_status",
+  (char*) &export_vars.innodb_buffer_pool_resize_status,  SHOW_CHAR},
   {"background_log_sync",
   (char*) &export_vars.innodb_background_log_sync,	  SHOW_LONG},
   {"buffer_pool_pages_data",
@@ -846,6 +862,10 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_dblwr_writes,		  SHOW_LONG},
   {"deadlocks",
   (char*) &export_vars.innodb_deadlocks,		  SHOW_LONG},
+  {"fts_topn_blocks_skipped",
+  (char*) &export_vars.innodb_fts_topn_blocks_skipped,	  SHOW_LONG},
+  {"fts_topn_queries",
+  (char*) &export_vars.innodb_fts_topn_queries,		  SHOW_LONG},
   {"have_atomic_builtins",
   (char*) &export_vars.innodb_have_atomic_builtins,	  SHOW_BOOL},
   {"history_list_length",
@@ -938,6 +958,10 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_rows_deleted,		  SHOW_LONG},
   {"rows_inserted",
   (char*) &export_vars.innodb_rows_inserted,		  SHOW_LONG},
+  {"rows_prefetch_batches",
+  (char*) &export_vars.innodb_rows_prefetch_batches,	  SHOW_LONG},
+  {"rows_prefetched",
+  (char*) &export_vars.innodb_rows_prefetched,		  SHOW_LONG},
   {"rows_read",
   (char*) &export_vars.innodb_rows_read,		  SHOW_LONG},
   {"rows_updated",
@@ -1628,6 +1652,13 @@ innobase_srv_conc_exit_innodb(
 	    && trx->n_tickets_to_enter_innodb == 0) {
 
 		srv_conc_force_exit_innodb(trx);
+
+		/* The statement has used up its tickets: it is a long
+		one, e.g. a scan. Queue it separately from short statements
+		until it ends. */
+		if (!trx->declared_to_be_inside_innodb) {
+			trx->conc_long = true;
+		}
 	}
 }
 
@@ -1647,6 +1678,10 @@ innobase_srv_conc_force_exit_innodb(
 	if (trx->declared_to_be_inside_innodb) {
 		srv_conc_force_exit_innodb(trx);
 	}
+
+	if (!trx->declared_to_be_inside_innodb) {
+		trx->conc_long = false;
+	}
 }
 
 /******************************************************************//**
@@ -1749,6 +1784,19 @@ thd_lock_wait_timeout(
 	return(THDVAR(thd, lock_wait_timeout));
 }
 
+/******************************************************************//**
+Returns the number of index build threads for the current connection.
+@return	value of innodb_ddl_threads */
+UNIV_INTERN
+ulong
+thd_ddl_threads(
+/*============*/
+	THD*	thd)	/*!< in: thread handle, or NULL to query
+			the global innodb_ddl_threads */
+{
+	return(THDVAR(thd, ddl_threads));
+}
+
 /******************************************************************//**
 Set the time waited for the lock for the current query. */
 UNIV_INTERN
@@ -3612,6 +3660,15 @@ mem_free_and_error:
 		goto mem_free_and_error;
 	}
 
+	/* The default dir for parallel doublewrite files is the datadir
+	of MySQL */
+
+	if (!srv_parallel_doublewrite_path) {
+		srv_parallel_doublewrite_path = default_path;
+	}
+
+	srv_normalize_path_for_win(srv_parallel_doublewrite_path);
+
 	if (innobase_mirrored_log_groups == 1) {
 		sql_print_warning(
 			"innodb_mirrored_log_groups is an unimplemented "
@@ -4009,6 +4066,9 @@ innobase_change_buffering_inited_ok:
 	innobase_old_blocks_pct = static_cast<uint>(
 		buf_LRU_old_ratio_update(innobase_old_blocks_pct, TRUE));
 
+	/* Report the size rounded to whole chunks */
+	innobase_buffer_pool_size = static_cast<long long>(srv_buf_pool_size);
+
 	ibuf_max_size_update(innobase_change_buffer_max_size);
 
 	innobase_open_tables = hash_create(200);
@@ -9258,6 +9318,23 @@ ha_innobase::ft_init_ext(
 	uint			flags,	/* in: */
 	uint			keynr,	/* in: */
 	String*			key)	/* in: */
+{
+	return(ft_init_ext_with_limit(flags, keynr, key, HA_POS_ERROR));
+}
+
+/**********************************************************************//**
+Initialize FT index scan for a query that reads no more than "limit" rows
+in rank order
+@return FT_INFO structure if successful or NULL */
+UNIV_INTERN
+FT_INFO*
+ha_innobase::ft_init_ext_with_limit(
+/*================================*/
+	uint			flags,	/* in: */
+	uint			keynr,	/* in: */
+	String*			key,	/* in: */
+	ha_rows			limit)	/* in: number of rows needed,
+					or HA_POS_ERROR */
 {
 	trx_t*			trx;
 	dict_table_t*		ft_table;
@@ -9343,7 +9420,10 @@ ha_innobase::ft_init_ext(
 		ft_table->fts->fts_status |= ADDED_TABLE_SYNCED;
 	}
 
-	error = fts_query(trx, index, flags, query, query_len, &result);
+	error = fts_query(trx, index, flags, query, query_len,
+			  (limit == HA_POS_ERROR || limit >= ULINT_UNDEFINED)
+			  ? ULINT_UNDEFINED : (ulint) limit,
+			  &result);
 
 	if (error != DB_SUCCESS) {
 		my_error(convert_error_code_to_mysql(error, 0, NULL),
@@ -11781,6 +11861,73 @@ func_exit:
 	DBUG_RETURN((ha_rows) n_rows);
 }
 
+/*********************************************************************//**
+Estimates the number of index records that are equal to a key from the
+histogram that the persistent statistics keep on the key prefix, if
+innodb_stats_histogram_buckets was set when they were calculated. This
+does not access the index.
+@return estimated number of rows, or HA_POS_ERROR if there is no
+histogram for the key */
+UNIV_INTERN
+ha_rows
+ha_innobase::records_in_eq_range_from_stats(
+/*=======================================*/
+	uint			keynr,		/*!< in: index number */
+	key_range		*key)		/*!< in: key value */
+{
+	KEY*		key_info;
+	dict_index_t*	index;
+	dtuple_t*	tuple;
+	ib_uint64_t	n_rows;
+	mem_heap_t*	heap;
+
+	DBUG_ENTER("records_in_eq_range_from_stats");
+
+	ut_a(prebuilt->trx == thd_to_trx(ha_thd()));
+
+	index = innobase_get_index(keynr);
+
+	/* Most indexes have no histograms, do not bother converting
+	the key for them. index->stat_hist is checked again under the
+	stats latch. */
+	if (index == NULL
+	    || index->stat_hist == NULL
+	    || dict_table_is_discarded(prebuilt->table)
+	    || dict_index_is_corrupted(index)
+	    || !row_merge_is_index_usable(prebuilt->trx, index)) {
+
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	key_info = table->key_info + keynr;
+
+	heap = mem_heap_create(key_info->actual_key_parts * sizeof(dfield_t)
+			       + sizeof(dtuple_t));
+
+	tuple = dtuple_create(heap, key_info->actual_key_parts);
+	dict_index_copy_types(tuple, index, key_info->actual_key_parts);
+
+	row_sel_convert_mysql_key_to_innobase(
+				tuple,
+				prebuilt->srch_key_val1,
+				prebuilt->srch_key_val_len,
+				index,
+				(byte*) key->key,
+				(ulint) key->length,
+				prebuilt->trx);
+
+	n_rows = dict_stats_hist_estimate(index, tuple);
+
+	mem_heap_free(heap);
+
+	if (n_rows == UINT64_UNDEFINED) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	/* Never claim that no rows match, see records_in_range() */
+	DBUG_RETURN(n_rows == 0 ? 1 : (ha_rows) n_rows);
+}
+
 /*********************************************************************//**
 Gives an UPPER BOUND to the number of rows in a table. This is used in
 filesort.cc.
@@ -13407,6 +13554,9 @@ ha_innobase::start_stmt(
 	/* Reset the AUTOINC statement level counter for multi-row INSERTs. */
 	trx->n_autoinc_rows = 0;
 
+	/* Count the statement for the background stats thread */
+	++prebuilt->table->stats_n_queries;
+
 	prebuilt->sql_stat_start = TRUE;
 	prebuilt->hint_need_to_fetch_extra_cols = 0;
 	reset_template();
@@ -13628,6 +13778,9 @@ ha_innobase::external_lock(
 
 		*trx->detailed_error = 0;
 
+		/* Count the statement for the background stats thread */
+		++prebuilt->table->stats_n_queries;
+
 		innobase_register_trx(ht, thd, trx);
 
 		if (trx->isolation_level == TRX_ISO_SERIALIZABLE
@@ -15965,6 +16118,123 @@ innodb_old_blocks_pct_update(
 			*static_cast<const uint*>(save), TRUE));
 }
 
+/*************************************************************//**
+Check whether innodb_buffer_pool_size can be changed to the requested
+value, and round the value up to a multiple of
+innodb_buffer_pool_chunk_size * innodb_buffer_pool_instances.
+@return	0 for valid innodb_buffer_pool_size */
+static
+int
+innodb_buffer_pool_size_validate(
+/*=============================*/
+	THD*				thd,	/*!< in: thread handle */
+	struct st_mysql_sys_var*	var,	/*!< in: pointer to system
+						variable */
+	void*				save,	/*!< out: immediate result
+						for update function */
+	struct st_mysql_value*		value)	/*!< in: incoming string */
+{
+	long long	intbuf;
+
+	if (value->val_int(value, &intbuf)) {
+		/* The value is NULL. That is invalid. */
+		return(1);
+	}
+
+	if (!srv_was_started || srv_read_only_mode) {
+		push_warning_printf(
+			thd, Sql_condition::WARN_LEVEL_WARN,
+			ER_WRONG_ARGUMENTS,
+			"InnoDB: Cannot update innodb_buffer_pool_size,"
+			" because InnoDB is not started or is in"
+			" read-only mode.");
+		return(1);
+	}
+
+	if (srv_buf_pool_old_size != srv_buf_pool_size) {
+		push_warning_printf(
+			thd, Sql_condition::WARN_LEVEL_WARN,
+			ER_WRONG_ARGUMENTS,
+			"InnoDB: Another buffer pool resize is already"
+			" in progress.");
+		return(1);
+	}
+
+	if (intbuf < 5 * 1024 * 1024L
+	    || (srv_buf_pool_instances > 1
+		&& intbuf < BUF_POOL_SIZE_THRESHOLD)) {
+		push_warning_printf(
+			thd, Sql_condition::WARN_LEVEL_WARN,
+			ER_WRONG_ARGUMENTS,
+			"InnoDB: Cannot update innodb_buffer_pool_size to"
+			" less than %s.",
+			srv_buf_pool_instances > 1
+			? "1GB if innodb_buffer_pool_instances > 1"
+			: "5MB");
+		return(1);
+	}
+
+	ulint	requested_buf_pool_size = buf_pool_size_align(
+		static_cast<ulint>(intbuf));
+
+	if (requested_buf_pool_size != static_cast<ulint>(intbuf)) {
+		push_warning_printf(
+			thd, Sql_condition::WARN_LEVEL_WARN,
+			ER_WRONG_ARGUMENTS,
+			"InnoDB: innodb_buffer_pool_size is rounded up to"
+			" %lu, a multiple of innodb_buffer_pool_chunk_size"
+			" * innodb_buffer_pool_instances.",
+			(ulong) requested_buf_pool_size);
+	}
+
+	*static_cast<long long*>(save) = requested_buf_pool_size;
+
+	return(0);
+}
+
+/****************************************************************//**
+Request the buffer pool to be resized to the "saved" value of
+innodb_buffer_pool_size. The resize is done by buf_resize_thread, and
+the system variable is updated when it has completed. This function
+is registered as a callback with MySQL. */
+static
+void
+innodb_buffer_pool_size_update(
+/*===========================*/
+	THD*				thd,	/*!< in: thread handle */
+	struct st_mysql_sys_var*	var,	/*!< in: pointer to
+						system variable */
+	void*				var_ptr,/*!< out: where the
+						formal string goes */
+	const void*			save)	/*!< in: immediate result
+						from check function */
+{
+	ulint	in_val = static_cast<ulint>(
+		*static_cast<const long long*>(save));
+
+	if (srv_buf_pool_old_size != srv_buf_pool_size) {
+		/* A concurrent SET got here first. */
+		push_warning_printf(
+			thd, Sql_condition::WARN_LEVEL_WARN,
+			ER_WRONG_ARGUMENTS,
+			"InnoDB: Another buffer pool resize is already"
+			" in progress.");
+		return;
+	}
+
+	srv_buf_pool_size = in_val;
+
+	ut_snprintf(export_vars.innodb_buffer_pool_resize_status,
+		    sizeof(export_vars.innodb_buffer_pool_resize_status),
+		    "Requested to resize buffer pool.");
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Requested to resize buffer pool (new size: %lu bytes).",
+		(ulong) in_val);
+
+	os_event_set(srv_buf_resize_event);
+}
+
 /****************************************************************//**
 Update the system variable innodb_old_blocks_pct using the "saved"
 value. This function is registered as a callback with MySQL. */
@@ -15985,6 +16255,21 @@ innodb_change_buffer_max_size_update(
 	ibuf_max_size_update(innobase_change_buffer_max_size);
 }
 
+/****************************************************************//**
+Set innodb_buffer_pool_size to the size that the buffer pool was resized
+to, and update the change buffer limit that depends on it. Called by
+buf_resize_thread when a resize has completed. */
+UNIV_INTERN
+void
+innodb_set_buf_pool_size(
+/*=====================*/
+	ulint	buf_pool_size)	/*!< in: new buffer pool size */
+{
+	innobase_buffer_pool_size = static_cast<long long>(buf_pool_size);
+
+	ibuf_max_size_update(innobase_change_buffer_max_size);
+}
+
 #ifdef UNIV_DEBUG
 ulong srv_fil_make_page_dirty_debug = 0;
 ulong srv_saved_page_number_debug = 0;
@@ -17629,6 +17914,18 @@ static MYSQL_SYSVAR_BOOL(doublewrite, innobase_use_doublewrite,
   "Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(parallel_doublewrite, srv_parallel_doublewrite,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Doublewrite the pages to one file per buffer pool instance, with "
+  "separate areas for flush list and LRU list flushing, instead of the "
+  "doublewrite buffer in the system tablespace (disabled by default).",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_STR(parallel_doublewrite_path,
+  srv_parallel_doublewrite_path,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Path to the InnoDB parallel doublewrite files.", NULL, NULL, NULL);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, innobase_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Prevent partial page writes, via atomic writes (beta). "
@@ -17681,7 +17978,9 @@ static MYSQL_SYSVAR_BOOL(track_redo_log_now,
 
 static MYSQL_SYSVAR_ULONG(purge_batch_size, srv_purge_batch_size,
   PLUGIN_VAR_OPCMDARG,
-  "Number of UNDO log pages to purge in one batch from the history list.",
+  "Number of UNDO log pages to purge in one batch from the history list. "
+  "While the history list is growing the batch is enlarged up to this "
+  "many pages per purge thread.",
   NULL, NULL,
   300,			/* Default setting */
   1,			/* Minimum value */
@@ -17907,6 +18206,30 @@ static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
   "statistics (by ANALYZE, default 20)",
   NULL, NULL, 20, 1, ~0ULL, 0);
 
+static MYSQL_SYSVAR_ULONG(stats_analyze_threads,
+  srv_stats_analyze_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "The number of threads that analyze the indexes of a table in parallel "
+  "when calculating persistent statistics (default 1)",
+  NULL, NULL, 1, 1, 32, 0);
+
+static MYSQL_SYSVAR_ULONG(stats_histogram_buckets,
+  srv_stats_histogram_buckets,
+  PLUGIN_VAR_RQCMDARG,
+  "The number of buckets in the histograms on the key prefixes of an index "
+  "that are built with its persistent statistics, for the optimizer to "
+  "estimate the rows of equality ranges that it does not dive into "
+  "(default 0: no histograms)",
+  NULL, NULL, 0, 0, DICT_STATS_HIST_MAX_BUCKETS, 0);
+
+static MYSQL_SYSVAR_ULONG(stats_auto_recalc_pages_per_sec,
+  srv_stats_auto_recalc_pages_per_sec,
+  PLUGIN_VAR_RQCMDARG,
+  "The maximum number of index pages per second that the automatic "
+  "recalculation of persistent statistics reads on average "
+  "(default 0: no limit)",
+  NULL, NULL, 0, 0, ULONG_MAX, 0);
+
 static MYSQL_SYSVAR_BOOL(adaptive_hash_index, btr_search_enabled,
   PLUGIN_VAR_OPCMDARG,
   "Enable InnoDB adaptive hash index (enabled by default).  "
@@ -17956,9 +18279,17 @@ static MYSQL_SYSVAR_ULONG(autoextend_increment, srv_auto_extend_increment,
   NULL, NULL, 64L, 1L, 1000L, 0);
 
 static MYSQL_SYSVAR_LONGLONG(buffer_pool_size, innobase_buffer_pool_size,
-  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  PLUGIN_VAR_RQCMDARG,
   "The size of the memory buffer InnoDB uses to cache data and indexes of its tables.",
-  NULL, NULL, 128*1024*1024L, 5*1024*1024L, LONGLONG_MAX, 1024*1024L);
+  innodb_buffer_pool_size_validate,
+  innodb_buffer_pool_size_update,
+  128*1024*1024L, 5*1024*1024L, LONGLONG_MAX, 1024*1024L);
+
+static MYSQL_SYSVAR_ULONG(buffer_pool_chunk_size, srv_buf_pool_chunk_unit,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Size of a single memory chunk within each buffer pool instance."
+  " The buffer pool is resized online in units of this size.",
+  NULL, NULL, 128*1024*1024L, 1024*1024L, LONG_MAX, 1024*1024L);
 
 static MYSQL_SYSVAR_BOOL(buffer_pool_populate, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -18081,6 +18412,17 @@ static MYSQL_SYSVAR_ENUM(cleaner_lsn_age_factor,
   NULL, NULL, SRV_CLEANER_LSN_AGE_FACTOR_HIGH_CHECKPOINT,
   &innodb_cleaner_lsn_age_factor_typelib);
 
+static MYSQL_SYSVAR_ULONG(page_cleaners, srv_n_page_cleaners,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Number of slots flushing the buffer pool instances in parallel, each "
+  "owning a subset of the instances, with one thread flushing their flush "
+  "lists and one flushing their LRU lists. "
+  "Limited to innodb_buffer_pool_instances. Default is 1.",
+  NULL, NULL,
+  1,			/* Default setting */
+  1,			/* Minimum value */
+  SRV_MAX_N_PAGE_CLEANERS, 0);	/* Maximum value */
+
 static MYSQL_SYSVAR_ENUM(empty_free_list_algorithm,
   srv_empty_free_list_algorithm,
   PLUGIN_VAR_OPCMDARG,
@@ -18197,6 +18539,14 @@ static MYSQL_SYSVAR_ULONG(ft_result_cache_limit, fts_result_cache_limit,
   "InnoDB Fulltext search query result cache limit in bytes",
   NULL, NULL, 2000000000L, 1000000L, 4294967295UL, 0);
 
+static MYSQL_SYSVAR_ULONG(ft_ilist_block_size, fts_ilist_block_size,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of documents per block in the block directory that is written in"
+  " front of InnoDB Fulltext search index ilists, so that ORDER BY MATCH"
+  " ... LIMIT queries can skip blocks. 0 (the default) writes ilists that"
+  " older servers can read.",
+  NULL, NULL, 0, 0, 65536, 0);
+
 static MYSQL_SYSVAR_ULONG(ft_min_token_size, fts_min_token_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "InnoDB Fulltext search minimum token size in characters",
@@ -18213,6 +18563,12 @@ static MYSQL_SYSVAR_ULONG(ft_num_word_optimize, fts_num_word_optimize,
   "InnoDB Fulltext search number of words to optimize for each optimize table call ",
   NULL, NULL, 2000, 1000, 10000, 0);
 
+static MYSQL_SYSVAR_ULONG(ft_optimize_threads, fts_optimize_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of InnoDB Fulltext search threads that sync and optimize "
+  "different tables in parallel in the background",
+  NULL, NULL, 1, 1, 32, 0);
+
 static MYSQL_SYSVAR_ULONG(ft_sort_pll_degree, fts_sort_pll_degree,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "InnoDB Fulltext search parallel sort degree, will round up to nearest power of 2 number",
@@ -18228,6 +18584,13 @@ static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   "Maximum modification log file size for online index creation",
   NULL, NULL, 128<<20, 65536, ~0ULL, 0);
 
+static MYSQL_SYSVAR_ULONG(online_alter_log_max_delay, srv_online_max_delay,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum delay in microseconds of an insert, update or delete on a table"
+  " that is being rebuilt online, applied while the modification log is"
+  " more than half of innodb_online_alter_log_max_size. 0 disables the delay.",
+  NULL, NULL, 0, 0, 1000000, 0);
+
 static MYSQL_SYSVAR_BOOL(optimize_fulltext_only, innodb_optimize_fulltext_only,
   PLUGIN_VAR_NOCMDARG,
   "Only optimize the Fulltext index of the table",
@@ -18248,6 +18611,31 @@ static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   "Helps to save your data in case the disk image of the database becomes corrupt.",
   NULL, NULL, 0, 0, 6, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_apply_threads, srv_n_recv_apply_threads,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying the redo log records to the pages during"
+  " crash recovery, from 1 to 32. Default is 1.",
+  NULL, NULL,
+  1,			/* Default setting */
+  1,			/* Minimum value */
+  SRV_MAX_N_RECV_APPLY_THREADS, 0);	/* Maximum value */
+
+static MYSQL_SYSVAR_ULONG(tablespace_discovery_threads,
+  srv_n_tablespace_discovery_threads,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads opening and validating the .ibd files at the start"
+  " of crash recovery, from 1 to 32. Default is 1.",
+  NULL, NULL,
+  1,			/* Default setting */
+  1,			/* Minimum value */
+  SRV_MAX_N_TABLESPACE_DISCOVERY_THREADS, 0);	/* Maximum value */
+
+static MYSQL_SYSVAR_BOOL(recovery_log_read_ahead, srv_recv_log_read_ahead,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Read the redo log ahead in a separate thread during crash recovery, while"
+  " the log records read so far are parsed and applied (off by default).",
+  NULL, NULL, FALSE);
+
 #ifndef DBUG_OFF
 static MYSQL_SYSVAR_ULONG(force_recovery_crash, srv_force_recovery_crash,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
@@ -18266,6 +18654,21 @@ static MYSQL_SYSVAR_LONG(log_buffer_size, innobase_log_buffer_size,
   "The size of the buffer which InnoDB uses to write log to the log files on disk.",
   NULL, NULL, 8*1024*1024L, 256*1024L, LONG_MAX, 1024);
 
+static MYSQL_SYSVAR_BOOL(log_concurrent_mtr_commit,
+  srv_log_concurrent_mtr_commit,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Hold the log mutex at mini-transaction commit only to reserve space in the "
+  "log buffer, copying the redo log records and adding the dirty pages to the "
+  "flush lists concurrently with other commits.",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(log_writer_threads, srv_log_writer_threads,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write and flush the redo log in dedicated background threads, with "
+  "committing transactions waiting for them instead of writing the log "
+  "themselves.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_LONGLONG(log_file_size, innobase_log_file_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Size of each log file in a log group.",
@@ -18398,6 +18801,13 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(use_native_aio_batch, srv_use_native_aio_batch,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Submit the native AIO requests of read-ahead and page flush batches "
+  "to the kernel together when the batch is complete. Linux native AIO "
+  "only.",
+  NULL, NULL, TRUE);
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -18648,6 +19058,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(api_bk_commit_interval),
   MYSQL_SYSVAR(autoextend_increment),
   MYSQL_SYSVAR(buffer_pool_size),
+  MYSQL_SYSVAR(buffer_pool_chunk_size),
   MYSQL_SYSVAR(buffer_pool_populate),
   MYSQL_SYSVAR(buffer_pool_instances),
   MYSQL_SYSVAR(buffer_pool_filename),
@@ -18671,6 +19082,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(parallel_doublewrite),
+  MYSQL_SYSVAR(parallel_doublewrite_path),
   MYSQL_SYSVAR(api_enable_binlog),
   MYSQL_SYSVAR(api_enable_mdl),
   MYSQL_SYSVAR(api_disable_rowlock),
@@ -18688,16 +19101,21 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(use_global_flush_log_at_trx_commit),
   MYSQL_SYSVAR(flush_method),
   MYSQL_SYSVAR(force_recovery),
+  MYSQL_SYSVAR(recovery_apply_threads),
+  MYSQL_SYSVAR(tablespace_discovery_threads),
+  MYSQL_SYSVAR(recovery_log_read_ahead),
 #ifndef DBUG_OFF
   MYSQL_SYSVAR(force_recovery_crash),
 #endif /* !DBUG_OFF */
   MYSQL_SYSVAR(ft_cache_size),
   MYSQL_SYSVAR(ft_total_cache_size),
   MYSQL_SYSVAR(ft_result_cache_limit),
+  MYSQL_SYSVAR(ft_ilist_block_size),
   MYSQL_SYSVAR(ft_enable_stopword),
   MYSQL_SYSVAR(ft_max_token_size),
   MYSQL_SYSVAR(ft_min_token_size),
   MYSQL_SYSVAR(ft_num_word_optimize),
+  MYSQL_SYSVAR(ft_optimize_threads),
   MYSQL_SYSVAR(ft_sort_pll_degree),
   MYSQL_SYSVAR(large_prefix),
   MYSQL_SYSVAR(force_load_corrupted),
@@ -18710,6 +19128,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* UNIV_LOG_ARCHIVE */
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
+  MYSQL_SYSVAR(log_concurrent_mtr_commit),
+  MYSQL_SYSVAR(log_writer_threads),
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
   MYSQL_SYSVAR(log_group_home_dir),
@@ -18737,7 +19157,10 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_transient_sample_pages),
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
+  MYSQL_SYSVAR(stats_analyze_threads),
+  MYSQL_SYSVAR(stats_histogram_buckets),
   MYSQL_SYSVAR(stats_auto_recalc),
+  MYSQL_SYSVAR(stats_auto_recalc_pages_per_sec),
   MYSQL_SYSVAR(adaptive_hash_index),
   MYSQL_SYSVAR(adaptive_hash_index_partitions),
   MYSQL_SYSVAR(stats_method),
@@ -18747,6 +19170,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(support_xa),
   MYSQL_SYSVAR(sort_buffer_size),
   MYSQL_SYSVAR(online_alter_log_max_size),
+  MYSQL_SYSVAR(online_alter_log_max_delay),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
   MYSQL_SYSVAR(table_locks),
@@ -18761,6 +19185,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(version),
   MYSQL_SYSVAR(use_sys_malloc),
   MYSQL_SYSVAR(use_native_aio),
+  MYSQL_SYSVAR(use_native_aio_batch),
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif // HAVE_LIBNUMA
@@ -18816,6 +19241,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_output),
   MYSQL_SYSVAR(status_output_locks),
   MYSQL_SYSVAR(cleaner_lsn_age_factor),
+  MYSQL_SYSVAR(page_cleaners),
   MYSQL_SYSVAR(foreground_preflush),
   MYSQL_SYSVAR(empty_free_list_algorithm),
   MYSQL_SYSVAR(print_all_deadlocks),
@@ -18838,6 +19264,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(fake_changes),
   MYSQL_SYSVAR(locking_fake_changes),
   MYSQL_SYSVAR(tmpdir),
+  MYSQL_SYSVAR(ddl_threads),
   MYSQL_SYSVAR(compressed_columns_zip_level),
   MYSQL_SYSVAR(compressed_columns_threshold),
   NULL
@@ -18864,6 +19291,7 @@ i_s_xtradb_internal_hash_tables,
 i_s_xtradb_rseg,
 i_s_xtradb_zip_dict,
 i_s_xtradb_zip_dict_cols,
+i_s_xtradb_page_cleaners,
 i_s_innodb_trx,
 i_s_innodb_locks,
 i_s_innodb_lock_waits,
@@ -154,6 +154,8 @@ class ha_innobase: public handler
 	int ft_init();
 	void ft_end();
 	FT_INFO *ft_init_ext(uint flags, uint inx, String* key);
+	FT_INFO *ft_init_ext_with_limit(uint flags, uint inx, String* key,
+					ha_rows limit);
 	int ft_read(uchar* buf);
 
 	void position(const uchar *record);
@@ -169,6 +171,7 @@ class ha_innobase: public handler
 	void position(uchar *record);
 	ha_rows records_in_range(uint inx, key_range *min_key, key_range
 								*max_key);
+	ha_rows records_in_eq_range_from_stats(uint inx, key_range *key);
 	ha_rows estimate_rows_upper_bound();
 
 	void update_create_info(HA_CREATE_INFO* create_info);
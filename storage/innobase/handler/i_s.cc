@@ -4019,6 +4019,13 @@ static const char* fts_config_key[] = {
         NULL
 };
 
+static const char* fts_status_key[] = {
+	FTS_STATUS_CACHE_SIZE,
+	FTS_STATUS_SYNC_IN_PROGRESS,
+	FTS_STATUS_OPTIMIZE_IN_PROGRESS,
+	NULL
+};
+
 /*******************************************************************//**
 Fill the dynamic table INFORMATION_SCHEMA.INNODB_FT_CONFIG
 @return	0 on success, 1 on failure */
@@ -4122,6 +4129,32 @@ i_s_fts_config_fill(
 
 	trx_free_for_background(trx);
 
+	/* The state of the background SYNC and OPTIMIZE of the table
+	is read without latching, it is only a hint. */
+	for (i = 0; fts_status_key[i]; i++) {
+		const fts_cache_t*	cache = user_table->fts->cache;
+		ulint			value;
+
+		if (strcmp(fts_status_key[i], FTS_STATUS_CACHE_SIZE) == 0) {
+			value = cache->total_size;
+		} else if (strcmp(fts_status_key[i],
+				  FTS_STATUS_SYNC_IN_PROGRESS) == 0) {
+			value = cache->sync->in_progress;
+		} else {
+			value = user_table->fts->n_optimize;
+		}
+
+		ut_snprintf((char*) str, sizeof(str), "%lu", (ulong) value);
+
+		OK(field_store_string(
+			fields[FTS_CONFIG_KEY], fts_status_key[i]));
+
+		OK(field_store_string(
+			fields[FTS_CONFIG_VALUE], (const char*) str));
+
+		OK(schema_table_store_record(thd, table));
+	}
+
 	dict_table_close(user_table, FALSE, FALSE);
 
 	rw_lock_s_unlock(&dict_operation_lock);
@@ -5289,10 +5322,12 @@ i_s_innodb_fill_buffer_pool(
 
 	heap = mem_heap_create(10000);
 
-	/* Go through each chunk of buffer pool. Currently, we only
-	have one single chunk for each buffer pool */
-	for (ulint n = 0; n < buf_pool->n_chunks; n++) {
+	/* Go through each chunk of buffer pool. A buffer pool resize
+	can free chunks; buf_pool->LRU_list_mutex keeps them in place
+	while a batch of blocks is examined. */
+	for (ulint n = 0; status == 0; n++) {
 		const buf_block_t*	block;
+		const buf_block_t*	chunk_blocks;
 		ulint			n_blocks;
 		buf_page_info_t*	info_buffer;
 		ulint			num_page;
@@ -5301,11 +5336,24 @@ i_s_innodb_fill_buffer_pool(
 		ulint			num_to_process = 0;
 		ulint			block_id = 0;
 
+		mutex_enter(&buf_pool->LRU_list_mutex);
+
+		if (n >= buf_pool->n_chunks) {
+			mutex_exit(&buf_pool->LRU_list_mutex);
+			break;
+		}
+
 		/* Get buffer block of the nth chunk */
-		block = buf_get_nth_chunk_block(buf_pool, n, &chunk_size);
+		block = chunk_blocks = buf_get_nth_chunk_block(
+			buf_pool, n, &chunk_size);
+
+		mutex_exit(&buf_pool->LRU_list_mutex);
+
 		num_page = 0;
 
 		while (chunk_size > 0) {
+			ulint	size;
+
 			/* we cache maximum MAX_BUF_INFO_CACHED number of
 			buffer page info */
 			num_to_process = ut_min(chunk_size,
@@ -5319,6 +5367,16 @@ i_s_innodb_fill_buffer_pool(
 			info_buffer = (buf_page_info_t*) mem_heap_zalloc(
 				heap, mem_size);
 
+			mutex_enter(&buf_pool->LRU_list_mutex);
+
+			if (n >= buf_pool->n_chunks
+			    || buf_get_nth_chunk_block(buf_pool, n, &size)
+			    != chunk_blocks) {
+				/* The chunk was freed meanwhile */
+				mutex_exit(&buf_pool->LRU_list_mutex);
+				break;
+			}
+
 			/* GO through each block in the chunk */
 			for (n_blocks = num_to_process; n_blocks--; block++) {
 				i_s_innodb_buffer_page_get_info(
@@ -5328,6 +5386,8 @@ i_s_innodb_fill_buffer_pool(
 				num_page++;
 			}
 
+			mutex_exit(&buf_pool->LRU_list_mutex);
+
 			/* Fill in information schema table with information
 			just collected from the buffer chunk scan */
 			status = i_s_innodb_buffer_page_fill(
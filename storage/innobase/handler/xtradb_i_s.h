@@ -24,5 +24,6 @@ extern struct st_mysql_plugin	i_s_xtradb_internal_hash_tables;
 extern struct st_mysql_plugin	i_s_xtradb_rseg;
 extern struct st_mysql_plugin	i_s_xtradb_zip_dict;
 extern struct st_mysql_plugin	i_s_xtradb_zip_dict_cols;
+extern struct st_mysql_plugin	i_s_xtradb_page_cleaners;
 
 #endif /* XTRADB_I_S_H */
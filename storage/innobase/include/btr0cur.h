@@ -203,6 +203,37 @@ btr_cur_open_at_rnd_pos_func(
 	mtr_t*		mtr);		/*!< in: mtr */
 #define btr_cur_open_at_rnd_pos(i,l,c,m)				\
 	btr_cur_open_at_rnd_pos_func(i,l,c,__FILE__,__LINE__,m)
+/**********************************************************************//**
+Positions a cursor on the last user record of the rightmost leaf page of
+an index, using the page remembered by btr_cur_store_append_hint() instead
+of descending the tree. The page is x-latched optimistically: the hint is
+rejected if the page was freed, evicted, reorganized or split since it was
+stored. Used for appending records in ascending key order.
+@return true if the cursor was positioned and the page x-latched in mtr;
+false if the caller must search the tree */
+UNIV_INTERN
+bool
+btr_cur_open_at_append_hint(
+/*========================*/
+	dict_index_t*		index,	/*!< in: index */
+	btr_append_hint_t*	hint,	/*!< in/out: append hint; reset if
+					it is no longer valid */
+	btr_cur_t*		cursor,	/*!< out: cursor */
+	mtr_t*			mtr)	/*!< in/out: mini-transaction */
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/**********************************************************************//**
+Remembers the page of a record that was just inserted for the next call
+of btr_cur_open_at_append_hint(). The hint is only stored if the record
+is the last user record of the rightmost leaf page, and reset otherwise. */
+UNIV_INTERN
+void
+btr_cur_store_append_hint(
+/*======================*/
+	btr_append_hint_t*	hint,	/*!< out: append hint */
+	buf_block_t*		block,	/*!< in: x-latched leaf page */
+	const rec_t*		rec,	/*!< in: record on block */
+	mtr_t*			mtr)	/*!< in: mini-transaction */
+	MY_ATTRIBUTE((nonnull));
 /*************************************************************//**
 Tries to perform an insert to a page in an index tree, next to cursor.
 It is assumed that mtr holds an x-latch on the page. The operation does
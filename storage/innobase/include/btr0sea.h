@@ -33,6 +33,7 @@ Created 2/17/1996 Heikki Tuuri
 #include "btr0types.h"
 #include "mtr0mtr.h"
 #include "ha0ha.h"
+#include "ut0counter.h"
 
 /*****************************************************************//**
 Creates and initializes the adaptive search system at a database start. */
@@ -55,7 +56,8 @@ void
 btr_search_disable(void);
 /*====================*/
 /********************************************************************//**
-Enable the adaptive hash search system. */
+Enable the adaptive hash search system, unless the buffer pool is
+being resized. */
 UNIV_INTERN
 void
 btr_search_enable(void);
@@ -144,7 +146,9 @@ btr_search_drop_page_hash_index(
 				block->buf_fix_count == 0 */
 /********************************************************************//**
 Drops a possible page hash index when a page is evicted from the buffer pool
-or freed in a file segment. */
+or freed in a file segment. If the page is in the buffer pool, also
+increments its modify clock, so that optimistic latching of the freed page,
+e.g. by btr_cur_open_at_append_hint(), fails. */
 UNIV_INTERN
 void
 btr_search_drop_page_hash_when_freed(
@@ -229,6 +233,37 @@ btr_search_index_init(
 /*===============*/
 	dict_index_t*	index);	/*!< in: index */
 
+/********************************************************************//**
+Returns the modification version of the adaptive hash index partition
+of an index. The version is odd while the partition hash table is being
+modified.
+@return the partition version */
+UNIV_INLINE
+ulint
+btr_search_get_version(
+/*===================*/
+	const dict_index_t*	index)	/*!< in: index */
+	MY_ATTRIBUTE((warn_unused_result));
+
+/********************************************************************//**
+Latches the adaptive hash index partition of an index in exclusive mode
+in order to modify its hash table. Lookups that do not hold the latch
+are invalidated until btr_search_x_unlock() is called. */
+UNIV_INLINE
+void
+btr_search_x_lock(
+/*==============*/
+	const dict_index_t*	index);	/*!< in: index */
+
+/********************************************************************//**
+Unlatches the adaptive hash index partition latched with
+btr_search_x_lock(). */
+UNIV_INLINE
+void
+btr_search_x_unlock(
+/*================*/
+	const dict_index_t*	index);	/*!< in: index */
+
 /********************************************************************//**
 Latches all adaptive hash index latches in exclusive mode.  */
 UNIV_INLINE
@@ -321,11 +356,47 @@ struct btr_search_t{
 #endif /* UNIV_DEBUG */
 };
 
+/** Modification version of an adaptive hash index partition */
+struct btr_search_version_t{
+	volatile ulint	version;	/*!< incremented before and after
+					every modification of the partition
+					hash table, so that it is odd while
+					the table is being modified; lets
+					btr_search_guess_on_hash() search
+					the table without the latch */
+	byte		pad[CACHE_LINE_SIZE - sizeof(ulint)];
+					/*!< keep the versions of different
+					partitions in separate cache lines */
+};
+
+/** Number of counters of the lookups in progress that search the adaptive
+hash index without its latch */
+#define BTR_SEARCH_N_READER_SLOTS	64
+
+/** Counter of the lookups in progress that search the adaptive hash index
+without its latch. The threads are spread over BTR_SEARCH_N_READER_SLOTS
+counters, so that they do not contend on a single cache line. */
+struct btr_search_reader_t{
+	volatile ulint	n_readers;	/*!< number of lookups in progress */
+	byte		pad[CACHE_LINE_SIZE - sizeof(ulint)];
+					/*!< keep the counters in separate
+					cache lines */
+};
+
 /** The hash index system */
 struct btr_search_sys_t{
 	hash_table_t**	hash_tables;	/*!< the array of adaptive hash index
 					tables, mapping dtuple_fold values to
 					rec_t pointers on index pages */
+	btr_search_version_t*
+			versions;	/*!< the array of partition versions */
+	btr_search_reader_t*
+			readers;	/*!< the array of BTR_SEARCH_N_READER_SLOTS
+					counters of the lookups that do not
+					hold the latch; btr_search_disable()
+					waits for them to drop to zero before
+					it frees the memory that the lookups
+					may be reading */
 };
 
 /** The adaptive hash index */
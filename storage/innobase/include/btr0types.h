@@ -30,6 +30,7 @@ Created 2/17/1996 Heikki Tuuri
 
 #include "rem0types.h"
 #include "page0types.h"
+#include "buf0types.h"
 #include "sync0rw.h"
 
 /** Persistent cursor */
@@ -39,6 +40,16 @@ struct btr_cur_t;
 /** B-tree search information for the adaptive hash index */
 struct btr_search_t;
 
+/** The rightmost leaf page of an index where the previous record was
+appended, see btr_cur_open_at_append_hint() */
+struct btr_append_hint_t {
+	buf_block_t*	block;		/*!< leaf page, or NULL */
+	ib_uint64_t	modify_clock;	/*!< modify clock of block when
+					the hint was stored */
+	ulint		withdraw_clock;	/*!< buf_withdraw_clock when the
+					hint was stored */
+};
+
 #ifndef UNIV_HOTBACKUP
 
 /** @brief The array of latches protecting the adaptive search partitions
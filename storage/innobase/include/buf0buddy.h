@@ -70,6 +70,36 @@ buf_buddy_free(
 					up to UNIV_PAGE_SIZE */
 	MY_ATTRIBUTE((nonnull));
 
+/**********************************************************************//**
+Try to reallocate a block, so that the memory it occupies can be
+withdrawn from the buffer pool.  The caller must hold
+buf_pool->LRU_list_mutex and must not hold buf_pool->zip_mutex or
+any block->mutex.
+@return	true if a destination block could be allocated, false if
+buf_pool->free was exhausted */
+UNIV_INTERN
+bool
+buf_buddy_realloc(
+/*==============*/
+	buf_pool_t*	buf_pool,	/*!< in/out: buffer pool instance */
+	void*		buf,		/*!< in: block to be reallocated,
+					must be pointed to by the
+					buffer pool */
+	ulint		size)		/*!< in: block size,
+					up to UNIV_PAGE_SIZE */
+	MY_ATTRIBUTE((nonnull));
+
+/**********************************************************************//**
+Recombine the free blocks of buf_pool->zip_free[] that are located in
+the chunks being withdrawn, so that their page frames can be returned
+to the buffer pool.  The caller must hold buf_pool->LRU_list_mutex. */
+UNIV_INTERN
+void
+buf_buddy_condense_free(
+/*====================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+	MY_ATTRIBUTE((nonnull));
+
 #ifndef UNIV_NONINL
 # include "buf0buddy.ic"
 #endif
@@ -76,6 +76,10 @@ Created 11/5/1995 Heikki Tuuri
 					/*!< The maximum number of buffer
 					pools that can be defined */
 
+#define BUF_POOL_SIZE_THRESHOLD	(1024 * 1024 * 1024)
+					/*!< Below this size, only one
+					buffer pool instance is used */
+
 #define BUF_POOL_WATCH_SIZE		(srv_n_purge_threads + 1)
 					/*!< Maximum number of concurrent
 					buffer pool watches */
@@ -91,6 +95,16 @@ extern ibool		buf_debug_prints;/*!< If this is set TRUE, the program
 #endif /* UNIV_DEBUG */
 extern ulint srv_buf_pool_instances;
 extern ulint srv_buf_pool_curr_size;
+
+extern volatile bool	buf_pool_withdrawing;
+					/*!< true when withdrawing blocks
+					from the chunks that a buffer pool
+					resize is going to free */
+extern volatile ulint	buf_withdraw_clock;
+					/*!< incremented every time blocks
+					have been withdrawn from the
+					buffer pool, see
+					buf_pool_is_obsolete() */
 #else /* !UNIV_HOTBACKUP */
 extern buf_block_t*	back_block1;	/*!< first block, for --apply-log */
 extern buf_block_t*	back_block2;	/*!< second block, for page reorganize */
@@ -225,6 +239,39 @@ buf_pool_free(
 	ulint	n_instances);	/*!< in: numbere of instances to free */
 
 /********************************************************************//**
+Determines if a block is in one of the chunks that the ongoing buffer
+pool resize is going to free.  The caller must hold one of the buffer
+pool mutexes that the resize acquires before it frees chunks.
+@return	true if the block will be withdrawn */
+UNIV_INTERN
+bool
+buf_block_will_withdrawn(
+/*=====================*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	const buf_block_t*	block);		/*!< in: block */
+/********************************************************************//**
+Determines if a frame is in one of the chunks that the ongoing buffer
+pool resize is going to free.  The caller must hold one of the buffer
+pool mutexes that the resize acquires before it frees chunks.
+@return	true if the frame will be withdrawn */
+UNIV_INTERN
+bool
+buf_frame_will_withdrawn(
+/*=====================*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	const byte*		ptr);		/*!< in: pointer to a frame */
+/********************************************************************//**
+This is the thread for resizing the buffer pool.  It waits for an event
+and when it is woken up, grows or shrinks the buffer pool to
+srv_buf_pool_size.
+@return	this function does not return, it calls os_thread_exit() */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_resize_thread)(
+/*==============================*/
+	void*	arg MY_ATTRIBUTE((unused)));	/*!< in: a dummy parameter
+						required by os_thread_create */
+/********************************************************************//**
 Clears the adaptive hash index on all pages in the buffer pool. */
 UNIV_INTERN
 void
@@ -241,7 +288,9 @@ buf_relocate(
 /*=========*/
 	buf_page_t*	bpage,	/*!< in/out: control block being relocated;
 				buf_page_get_state(bpage) must be
-				BUF_BLOCK_ZIP_DIRTY or BUF_BLOCK_ZIP_PAGE */
+				BUF_BLOCK_ZIP_DIRTY or BUF_BLOCK_ZIP_PAGE,
+				or BUF_BLOCK_FILE_PAGE when the buffer
+				pool is being shrunk */
 	buf_page_t*	dpage);	/*!< in/out: destination control block */
 /*********************************************************************//**
 Gets the current size of buffer buf_pool in bytes.
@@ -257,6 +306,27 @@ UNIV_INLINE
 ulint
 buf_pool_get_n_pages(void);
 /*=======================*/
+/*********************************************************************//**
+Rounds a buffer pool size up to a multiple of the size of one chunk in
+every buffer pool instance, the unit in which the buffer pool is
+allocated and resized.
+@return	aligned size in bytes */
+UNIV_INLINE
+ulint
+buf_pool_size_align(
+/*================*/
+	ulint	size);	/*!< in: size in bytes */
+/*********************************************************************//**
+Checks whether blocks may have been withdrawn from the buffer pool, and
+possibly freed, since buf_withdraw_clock had the given value.  A cached
+block pointer must not be dereferenced if this returns true.
+@return	true if a block pointer cached at withdraw_clock is obsolete */
+UNIV_INLINE
+bool
+buf_pool_is_obsolete(
+/*=================*/
+	ulint	withdraw_clock);	/*!< in: buf_withdraw_clock when
+					the pointer was cached */
 /********************************************************************//**
 Gets the smallest oldest_modification lsn for any page in the pool. Returns
 zero if all modified pages have been flushed to disk.
@@ -1669,6 +1739,9 @@ struct buf_block_t{
 	ibool		in_unzip_LRU_list;/*!< TRUE if the page is in the
 					decompressed LRU list;
 					used in debugging */
+	ibool		in_withdraw_list;/*!< TRUE if the block is in
+					buf_pool->withdraw; used in
+					debugging */
 #endif /* UNIV_DEBUG */
 	ib_mutex_t	mutex;		/*!< mutex protecting this block:
 					state, io_fix, buf_fix_count,
@@ -1868,7 +1941,6 @@ struct buf_pool_t{
 					mutex */
 	ulint		instance_no;	/*!< Array index of this buffer
 					pool instance */
-	ulint		old_pool_size;  /*!< Old pool size in bytes */
 	ulint		curr_pool_size;	/*!< Current pool size in bytes */
 	ulint		LRU_old_ratio;  /*!< Reserve this much of the buffer
 					pool for "old" blocks */
@@ -1877,8 +1949,21 @@ struct buf_pool_t{
 					the buffer pool to the buddy system */
 #endif
 	ulint		n_chunks;	/*!< number of buffer pool chunks */
-	buf_chunk_t*	chunks;		/*!< buffer pool chunks */
-	ulint		curr_size;	/*!< current pool size in pages */
+	ulint		n_chunks_new;	/*!< new number of buffer pool chunks
+					while the buffer pool is resized */
+	buf_chunk_t*	chunks;		/*!< buffer pool chunks, terminated
+					by an element whose blocks is NULL */
+	buf_chunk_t*	chunks_old;	/*!< the array that chunks replaced
+					at the last resize; it is freed at
+					the next resize, because
+					buf_block_align() reads chunks
+					without holding any mutex */
+	ulint		curr_size;	/*!< current pool size in pages; while
+					the buffer pool is resized, the
+					target size */
+	ulint		old_size;	/*!< pool size in pages before the
+					ongoing resize; equal to curr_size
+					otherwise */
 	ulint		read_ahead_area;/*!< size in pages of the area which
 					the read-ahead algorithms read if
 					invoked */
@@ -1981,6 +2066,16 @@ struct buf_pool_t{
 	UT_LIST_BASE_NODE_T(buf_page_t) free;
 					/*!< base node of the free
 					block list */
+	UT_LIST_BASE_NODE_T(buf_page_t) withdraw;
+					/*!< base node of the withdrawn
+					block list.  It is only used while
+					shrinking the buffer pool, to collect
+					the free blocks of the chunks to be
+					freed.  Protected by free_list_mutex,
+					like the free list */
+	ulint		withdraw_target;/*!< target length of the withdraw
+					list while shrinking the buffer
+					pool */
 	UT_LIST_BASE_NODE_T(buf_page_t) LRU;
 					/*!< base node of the LRU list */
 	buf_page_t*	LRU_old;	/*!< pointer to the about
@@ -37,6 +37,13 @@ Created 2011/12/19 Inaam Rana
 extern buf_dblwr_t*	buf_dblwr;
 /** Set to TRUE when the doublewrite buffer is being created */
 extern ibool		buf_dblwr_being_created;
+/** Parallel doublewrite buffers, or NULL if innodb_parallel_doublewrite
+is off. For each buffer pool instance i, element 2 * i buffers the flush
+list writes and element 2 * i + 1 the LRU and single page writes. */
+extern buf_dblwr_t*	buf_dblwr_parallel;
+
+/** Name prefix of the parallel doublewrite files */
+#define BUF_DBLWR_PARALLEL_FILE_NAME	"xb_doublewrite_"
 
 /****************************************************************//**
 Creates the doublewrite buffer to a new InnoDB installation. The header of the
@@ -46,6 +53,17 @@ void
 buf_dblwr_create(void);
 /*==================*/
 
+/****************************************************************//**
+Creates the parallel doublewrite files, one for each buffer pool instance,
+if innodb_parallel_doublewrite is set. Parallel doublewrite files that are
+not used any more are deleted. Must be called after crash recovery has
+restored the pages from the parallel doublewrite files.
+@return DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+buf_dblwr_create_parallel(void);
+/*===========================*/
+
 /****************************************************************//**
 At a database startup initializes the doublewrite buffer memory structure if
 we already have a doublewrite buffer created in the data files. If we are
@@ -108,6 +126,19 @@ void
 buf_dblwr_flush_buffered_writes(void);
 /*=================================*/
 /********************************************************************//**
+Flushes possible buffered writes of one buffer pool instance and flush type
+from the parallel doublewrite buffer to disk. Does nothing if
+innodb_parallel_doublewrite is off: the batch of the doublewrite buffer in
+the system tablespace is then shared by all instances and flushed by
+buf_dblwr_flush_buffered_writes(). */
+UNIV_INTERN
+void
+buf_dblwr_flush_instance_batch(
+/*===========================*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	buf_flush_t		flush_type);	/*!< in: BUF_FLUSH_LRU or
+						BUF_FLUSH_LIST */
+/********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
 the page to the datafile and sync the datafile. This function is used
 for single page flushes. If all the buffers allocated for single page
@@ -129,6 +160,10 @@ struct buf_dblwr_t{
 	ulint		block1;	/*!< the page number of the first
 				doublewrite block (64 pages) */
 	ulint		block2;	/*!< page number of the second block */
+	char*		file_name;/*!< name of the parallel doublewrite
+				file, or NULL if the blocks are in the
+				system tablespace */
+	os_file_t	file;	/*!< parallel doublewrite file handle */
 	ulint		first_free;/*!< first free position in write_buf
 				measured in units of UNIV_PAGE_SIZE */
 	ulint		b_reserved;/*!< number of slots currently reserved
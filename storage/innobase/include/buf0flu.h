@@ -39,6 +39,22 @@ extern ibool buf_page_cleaner_is_active;
 /** Flag indicating if the lru_manager is in active state. */
 extern bool buf_lru_manager_is_active;
 
+/** Number of page cleaner and LRU manager worker threads that are
+running. */
+extern ulint buf_page_cleaner_n_workers_active;
+
+/** Statistics of a page cleaner slot, see buf_flush_page_cleaner_init() */
+struct buf_flush_cleaner_stats_t {
+	ulint	n_instances;		/*!< number of buffer pool instances
+					in the slot */
+	ulint	flush_list_batches;	/*!< number of flush list batches */
+	ulint	flush_list_pages;	/*!< pages flushed by them */
+	ulint	flush_list_time;	/*!< milliseconds spent in them */
+	ulint	lru_batches;		/*!< number of LRU tail batches */
+	ulint	lru_pages;		/*!< pages flushed by them */
+	ulint	lru_time;		/*!< milliseconds spent in them */
+};
+
 /********************************************************************//**
 Remove a block from the flush list of modified blocks.  */
 UNIV_INTERN
@@ -197,6 +213,50 @@ DECLARE_THREAD(buf_flush_lru_manager_thread)(
 /*=========================================*/
 	void*	arg);		/*!< in: a dummy parameter required by
 				os_thread_create */
+/******************************************************************//**
+Page cleaner worker thread, which flushes the flush lists of the buffer
+pool instances of one page cleaner slot when the page_cleaner thread
+requests it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg);		/*!< in: the page cleaner slot */
+/******************************************************************//**
+LRU manager worker thread, which flushes the LRU list tails of the buffer
+pool instances of one page cleaner slot when the lru_manager thread
+requests it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_lru_manager_worker)(
+/*=========================================*/
+	void*	arg);		/*!< in: the page cleaner slot */
+/******************************************************************//**
+Creates the srv_n_page_cleaners page cleaner slots and starts a page
+cleaner worker thread and an LRU manager worker thread for each slot but
+the first, which the page_cleaner and lru_manager threads flush
+themselves. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void);
+/*=============================*/
+/******************************************************************//**
+Frees the page cleaner slots. The worker threads must have exited. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_free(void);
+/*=============================*/
+/******************************************************************//**
+Gets the statistics of a page cleaner slot.
+@return false if there is no such slot */
+UNIV_INTERN
+bool
+buf_flush_page_cleaner_get_stats(
+/*=============================*/
+	ulint				slot_no,/*!< in: slot number */
+	buf_flush_cleaner_stats_t*	stats);	/*!< out: statistics */
 /*********************************************************************//**
 Clears up tail of the LRU lists:
 * Put replaceable pages at the tail of LRU to the free list
@@ -209,6 +269,18 @@ ulint
 buf_flush_LRU_tail(void);
 /*====================*/
 /*********************************************************************//**
+Flushes and evicts blocks from the tail of the LRU list of one buffer
+pool instance and waits for the batch to end.  This is used for freeing
+the blocks of the chunks that buf_pool_resize() is withdrawing.
+NOTE: The calling thread is not allowed to own any latches on pages! */
+UNIV_INTERN
+void
+buf_flush_LRU_and_wait(
+/*===================*/
+	buf_pool_t*	buf_pool,	/*!< in/out: buffer pool instance */
+	ulint		min_n);		/*!< in: wished minimum number of
+					blocks flushed or evicted */
+/*********************************************************************//**
 Wait for any possible LRU flushes that are in progress to end. */
 UNIV_INTERN
 void
@@ -565,6 +565,47 @@ struct zip_pad_info_t {
 				/*!< Creation state of mutex member */
 };
 
+/** A field of a histogram bucket endpoint */
+struct dict_hist_field_t {
+	const byte*	data;	/*!< field data, NULL if the field
+				is SQL NULL */
+	ulint		len;	/*!< length of data, or UNIV_SQL_NULL */
+};
+
+/** A bucket of an equi-height histogram on a key prefix of an index */
+struct dict_hist_bucket_t {
+	const dict_hist_field_t*
+			endpoint;
+				/*!< the greatest key prefix in the bucket,
+				or NULL if the bucket was not loaded */
+	ib_uint64_t	n_rows;	/*!< approximate number of records
+				in the bucket */
+	ib_uint64_t	n_endpoint_rows;
+				/*!< approximate number of records
+				equal to the endpoint */
+	ib_uint64_t	n_distinct;
+				/*!< approximate number of different
+				key prefixes in the bucket */
+};
+
+/** Equi-height histograms on the key prefixes of an index, built by
+the persistent statistics from a sample of the leaf pages. All the
+members are allocated from heap. */
+struct dict_index_hist_t {
+	mem_heap_t*	heap;	/*!< memory heap of the histograms */
+	ulint		n_prefixes;
+				/*!< number of key prefixes that may
+				have a histogram, index->n_uniq */
+	ulint*		n_buckets;
+				/*!< n_buckets[n - 1] is the number of
+				buckets on the n-column prefix, 0 if
+				there is no histogram for it */
+	dict_hist_bucket_t**
+			buckets;/*!< buckets[n - 1] are the buckets on
+				the n-column prefix in ascending order
+				of their endpoints */
+};
+
 /** Data structure for an index.  Most fields will be
 initialized to 0, NULL or FALSE in dict_mem_index_create(). */
 struct dict_index_t{
@@ -656,6 +697,19 @@ struct dict_index_t{
 	ulint		stat_n_leaf_pages;
 				/*!< approximate number of leaf pages in the
 				index tree */
+	dict_index_hist_t*
+			stat_hist;
+				/*!< histograms of the key prefixes,
+				or NULL; protected by the table's
+				stats_latch */
+	ib_uint64_t	stat_modified_counter;
+				/*!< number of records inserted, updated
+				or delete-marked in this index since its
+				persistent stats were last calculated; the
+				background stats thread recalculates only
+				the indexes where this exceeds 10% of the
+				table rows; not protected by any latch,
+				because this is only used for heuristics */
 	/* @} */
 	prio_rw_lock_t	lock;	/*!< read-write lock protecting the
 				upper levels of the index tree */
@@ -1132,6 +1186,13 @@ struct dict_table_t{
 				/*!< see BG_STAT_* above.
 				Writes are covered by dict_sys->mutex.
 				Dirty reads are possible. */
+	ulint		stats_n_queries;
+				/*!< number of statements that used the
+				table since the background stats thread
+				last recalculated its stats; the thread
+				picks the most used tables first. Not
+				protected by any latch, because this is
+				only used for heuristics */
 				/* @} */
 	/*----------------------*/
 				/**!< The following fields are used by the
@@ -1195,7 +1256,9 @@ struct dict_table_t{
 				/*!< Count of the number of record locks on
 				this table. We use this to determine whether
 				we can evict the table from the dictionary
-				cache. It is protected by lock_sys->mutex. */
+				cache. It is updated atomically, by the
+				owner of the lock_sys partition mutex of
+				the page. */
 	ulint		n_ref_count;
 				/*!< count of how many handles are opened
 				to this table; dropping of the table is
@@ -45,6 +45,15 @@ dict_table_check_if_in_cache_low(
 /*=============================*/
 	const char*	table_name);		/*!< in: table name */
 
+/**********************************************************************//**
+Checks if a table is in the dictionary cache, by its id.
+@return	table, NULL if not found */
+UNIV_INLINE
+dict_table_t*
+dict_table_check_if_in_cache_on_id_low(
+/*===================================*/
+	table_id_t	table_id);		/*!< in: table id */
+
 /**********************************************************************//**
 Returns a table object based on table id.
 @return	table, NULL if does not exist */
@@ -29,9 +29,14 @@ Created Jan 06, 2010 Vasil Dimov
 #include "univ.i"
 
 #include "db0err.h"
+#include "data0types.h"
 #include "dict0types.h"
 #include "trx0types.h"
 
+/** Maximum number of buckets in a histogram on a key prefix of an index,
+see innodb_stats_histogram_buckets */
+#define DICT_STATS_HIST_MAX_BUCKETS	255
+
 enum dict_stats_upd_option_t {
 	DICT_STATS_RECALC_PERSISTENT,/* (re) calculate the
 				statistics using a precise and slow
@@ -143,6 +148,22 @@ dict_stats_update(
 					the stats or to fetch them from
 					the persistent storage */
 
+/*********************************************************************//**
+Recalculates the persistent statistics of a table for the background
+stats thread. Unlike dict_stats_update(DICT_STATS_RECALC_PERSISTENT) this
+analyzes and saves only the clustered index and the secondary indexes
+where more than 10% of the table rows were modified since they were last
+analyzed; the stats of the other indexes are kept.
+@return DB_* error code or DB_SUCCESS */
+UNIV_INTERN
+dberr_t
+dict_stats_update_incremental(
+/*==========================*/
+	dict_table_t*	table,	/*!< in/out: table */
+	ulint*		n_pages)/*!< out: estimated number of pages
+				that were read */
+	MY_ATTRIBUTE((nonnull));
+
 /*********************************************************************//**
 Removes the information for a particular index's stats from the persistent
 storage if it exists and if there is data stored for this index.
@@ -181,6 +202,19 @@ dict_stats_update_for_index(
 	dict_index_t*	index)	/*!< in/out: index */
 	MY_ATTRIBUTE((nonnull));
 
+/*********************************************************************//**
+Estimates the number of records of an index that are equal to a search
+tuple, from the histogram on the key prefix that is as long as the tuple.
+@return approximate number of records, or UINT64_UNDEFINED if the index
+has no histogram on that key prefix */
+UNIV_INTERN
+ib_uint64_t
+dict_stats_hist_estimate(
+/*=====================*/
+	const dict_index_t*	index,	/*!< in: index */
+	const dtuple_t*		tuple)	/*!< in: search tuple */
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+
 /*********************************************************************//**
 Renames a table in InnoDB persistent stats storage.
 This function creates its own transaction and commits it.
@@ -334,6 +334,10 @@ struct fts_t {
 
 	ib_vector_t*	indexes;	/*!< Vector of FTS indexes, this is
 					mainly for caching purposes. */
+
+	ulint		n_optimize;	/*!< Number of OPTIMIZE runs in
+					progress on the table, updated with
+					atomic operations */
 	mem_heap_t*	fts_heap;	/*!< heap for fts_t allocation */
 };
 
@@ -362,6 +366,14 @@ extern ulong		fts_max_token_size;
 /** Variable specifying the minimum FTS max token size */
 extern ulong		fts_min_token_size;
 
+/** Number of documents per block in the block directory written in
+front of the FTS INDEX ilists, 0 to write plain ilists */
+extern ulong		fts_ilist_block_size;
+
+/** Number of threads that sync and optimize the FTS tables in the
+background */
+extern ulong		fts_optimize_threads;
+
 /** Whether the total memory used for FTS cache is exhausted, and we will
 need a sync to free some memory */
 extern bool		fts_need_sync;
@@ -571,6 +583,9 @@ fts_query(
 	const byte*	query,			/*!< in: FTS query */
 	ulint		query_len,		/*!< in: FTS query string len
 						in bytes */
+	ulint		limit,			/*!< in: number of docs needed
+						in rank order, or
+						ULINT_UNDEFINED for all */
 	fts_result_t**	result)			/*!< out: query result, to be
 						freed by the caller.*/
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
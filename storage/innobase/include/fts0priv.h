@@ -98,6 +98,18 @@ minus this count gives us the total number of documents. */
  RUNNING, OPTIMIZING, DELETED. */
 #define FTS_TABLE_STATE			"table_state"
 
+/** FTS status names, shown with the config table parameters in
+INFORMATION_SCHEMA.INNODB_FT_CONFIG but not stored in the config table */
+
+/** Memory used by the FTS cache of the table, in bytes */
+#define FTS_STATUS_CACHE_SIZE		"cache_size"
+
+/** Whether a SYNC of the FTS cache is in progress */
+#define FTS_STATUS_SYNC_IN_PROGRESS	"sync_in_progress"
+
+/** Number of OPTIMIZE runs in progress on the table */
+#define FTS_STATUS_OPTIMIZE_IN_PROGRESS	"optimize_in_progress"
+
 /** The minimum length of an FTS auxiliary table names's id component
 e.g., For an auxiliary table name
 
@@ -218,6 +218,23 @@ struct fts_node_t {
 	bool		synced;		/*!< flag whether the node is synced */
 };
 
+/** First byte of an ilist stored in the FTS auxiliary INDEX table that
+starts with a block directory. The directory is laid out as
+
+	FTS_ILIST_BLOCK_MARKER
+	VLC: length in bytes of the rest of the directory
+	VLC: number of blocks
+	for each block:
+		VLC: last doc id of the block, as a delta from the last
+		     doc id of the previous block (first_doc_id for the
+		     first block)
+		VLC: length in bytes of the block in the ilist
+		VLC: maximum number of positions of a doc in the block
+
+and is followed by the ilist itself, unchanged. A plain ilist can never
+start with this byte because that would encode a zero first doc id. */
+#define FTS_ILIST_BLOCK_MARKER	0x80
+
 /** A tokenizer word. Contains information about one word. */
 struct fts_tokenizer_word_t {
 	fts_string_t	text;		/*!< Token text. */
@@ -396,6 +413,18 @@ fts_encode_int(
 	byte*		buf);			/*!< in: buffer, must have
 						enough space */
 
+/******************************************************************//**
+Skip the block directory in front of an ilist read from the FTS
+auxiliary INDEX table, see FTS_ILIST_BLOCK_MARKER.
+@return start of the doc id list */
+UNIV_INLINE
+byte*
+fts_ilist_skip_directory(
+/*=====================*/
+	byte*		ilist,			/*!< in: ilist as stored */
+	ulint*		len);			/*!< in/out: length of the
+						ilist */
+
 /******************************************************************//**
 Decode a UTF-8 character.
 
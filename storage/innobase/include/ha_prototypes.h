@@ -363,6 +363,16 @@ thd_lock_wait_timeout(
 /*==================*/
 	THD*	thd);	/*!< in: thread handle, or NULL to query
 			the global innodb_lock_wait_timeout */
+
+/******************************************************************//**
+Returns the number of index build threads for the current connection.
+@return	value of innodb_ddl_threads */
+UNIV_INTERN
+ulong
+thd_ddl_threads(
+/*============*/
+	THD*	thd);	/*!< in: thread handle, or NULL to query
+			the global innodb_ddl_threads */
 /******************************************************************//**
 Add up the time waited for the lock for the current query. */
 UNIV_INTERN
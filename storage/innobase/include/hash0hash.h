@@ -64,6 +64,34 @@ hash_create(
 	ulint	n);	/*!< in: number of array cells */
 #ifndef UNIV_HOTBACKUP
 /*************************************************************//**
+Creates a hash table with >= n array cells, that is going to be
+protected by n_sync_obj sync objects.  The number of cells is a multiple
+of n_sync_obj, so that the table can later be resized with
+hash_resize_aligned().
+@return	own: created table */
+UNIV_INTERN
+hash_table_t*
+hash_create_aligned(
+/*================*/
+	ulint	n,		/*!< in: number of array cells */
+	ulint	n_sync_obj);	/*!< in: number of sync objects,
+				a power of 2 */
+/*************************************************************//**
+Replaces the cell array of a hash table created by hash_create_aligned()
+with an empty array of >= n cells.  Every fold value keeps being
+protected by the same sync object.  The caller must hold all the sync
+objects in exclusive mode, and must insert the nodes of the returned
+array into the table again.
+@return	own: the old cell array, to be freed with ut_free() */
+UNIV_INTERN
+hash_cell_t*
+hash_resize_aligned(
+/*================*/
+	hash_table_t*	table,		/*!< in/out: hash table */
+	ulint		n,		/*!< in: number of array cells */
+	ulint*		n_old_cells);	/*!< out: number of cells in the
+					returned array */
+/*************************************************************//**
 Creates a sync object array array to protect a hash table.
 ::sync_obj can be mutexes or rw_locks depening on the type of
 hash table. */
@@ -919,13 +919,34 @@ struct lock_op_t{
 	enum lock_mode	mode;	/*!< lock mode */
 };
 
+/** Number of lock_sys->rec_mutexes; must be a power of 2 */
+#define LOCK_SYS_N_REC_MUTEXES		32
+/** Number of lock_sys->table_mutexes; must be a power of 2 */
+#define LOCK_SYS_N_TABLE_MUTEXES	16
+
 /** The lock system struct */
 struct lock_sys_t{
 	ib_mutex_t	mutex;			/*!< Mutex protecting the
-						locks */
+						locks; the owner of this
+						mutex also owns all the
+						partition mutexes below */
+	ib_mutex_t*	rec_mutexes;		/*!< array of
+						LOCK_SYS_N_REC_MUTEXES
+						mutexes, each protecting
+						the record lock queues of
+						the pages that hash to it;
+						enough for granting a lock
+						without waiting */
+	ib_mutex_t*	table_mutexes;		/*!< array of
+						LOCK_SYS_N_TABLE_MUTEXES
+						mutexes, each protecting
+						the table lock queues of
+						the tables whose id maps
+						to it */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
-	ulint		rec_num;
+	ulint		rec_num;		/*!< number of record locks,
+						updated atomically */
 	ib_mutex_t	wait_mutex;		/*!< Mutex protecting the
 						next two fields */
 	srv_slot_t*	waiting_threads;	/*!< Array  of user threads
@@ -956,19 +977,44 @@ struct lock_sys_t{
 /** The lock system */
 extern lock_sys_t*	lock_sys;
 
-/** Test if lock_sys->mutex can be acquired without waiting. */
-#define lock_mutex_enter_nowait() mutex_enter_nowait(&lock_sys->mutex)
+/*********************************************************************//**
+Acquires all the lock_sys partition mutexes, in ascending order. The
+caller must own lock_sys->mutex. */
+UNIV_INTERN
+void
+lock_sys_partitions_enter(void);
+/*===========================*/
+/*********************************************************************//**
+Releases all the lock_sys partition mutexes. */
+UNIV_INTERN
+void
+lock_sys_partitions_exit(void);
+/*==========================*/
+
+/*********************************************************************//**
+Tries to acquire lock_sys->mutex and all the partition mutexes without
+waiting. If any of them is busy, the ones already acquired are released.
+@return 0 if succeeded, 1 if any of the mutexes was busy */
+UNIV_INTERN
+ulint
+lock_mutex_enter_nowait(void);
+/*=========================*/
 
 /** Test if lock_sys->mutex is owned. */
 #define lock_mutex_own() mutex_own(&lock_sys->mutex)
 
-/** Acquire the lock_sys->mutex. */
+/** Acquire the lock_sys->mutex and all the partition mutexes, which
+excludes every other thread from the lock system. Code that only reads
+or modifies the lock queue of one page or table acquires the partition
+mutex of the queue instead. */
 #define lock_mutex_enter() do {			\
 	mutex_enter(&lock_sys->mutex);		\
+	lock_sys_partitions_enter();		\
 } while (0)
 
-/** Release the lock_sys->mutex. */
+/** Release the lock_sys->mutex and all the partition mutexes. */
 #define lock_mutex_exit() do {			\
+	lock_sys_partitions_exit();		\
 	mutex_exit(&lock_sys->mutex);		\
 } while (0)
 
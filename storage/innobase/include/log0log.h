@@ -154,6 +154,59 @@ log_write_low(
 	byte*	str,		/*!< in: string */
 	ulint	str_len);	/*!< in: string length */
 /************************************************************//**
+Reserves space in the log buffer for a string of the given length and
+formats the log block headers around it, but does not copy the string.
+It is assumed that the caller holds the log mutex. The string must then
+be copied with log_copy_low() and the copy completed with
+log_copy_complete(); this is only used if srv_log_concurrent_mtr_commit
+is set.
+@return	log buffer offset where the string should be copied */
+UNIV_INTERN
+ulint
+log_reserve_low(
+/*============*/
+	ulint	str_len);	/*!< in: string length */
+/************************************************************//**
+Copies a string to log buffer space reserved with log_reserve_low().
+Does not need the log mutex. */
+UNIV_INTERN
+void
+log_copy_low(
+/*=========*/
+	ulint*		offset,	/*!< in/out: log buffer offset; advanced
+				past the copied string and any log block
+				trailers and headers it spans */
+	const byte*	str,	/*!< in: string */
+	ulint		str_len);/*!< in: string length */
+/************************************************************//**
+Marks a log buffer copy started with log_reserve_low() as completed, so
+that the log buffer may be written or moved. Does not need the log
+mutex. */
+UNIV_INTERN
+void
+log_copy_complete(void);
+/*===================*/
+/************************************************************//**
+Reserves a slot tracking a mini-transaction which will add dirty pages to
+the flush lists without holding log_flush_order_mutex. It is assumed that
+the caller holds the log mutex and that log_open() has been called after
+acquiring it, which guarantees that a slot is free.
+@return	slot number, to be passed to log_closed_release() */
+UNIV_INTERN
+ib_uint64_t
+log_closed_reserve(
+/*===============*/
+	lsn_t	start_lsn);	/*!< in: start lsn of the mini-transaction */
+/************************************************************//**
+Releases a slot reserved with log_closed_reserve() once the
+mini-transaction has added its dirty pages to the flush lists. Does not
+need the log mutex. */
+UNIV_INTERN
+void
+log_closed_release(
+/*===============*/
+	ib_uint64_t	no);	/*!< in: slot number */
+/************************************************************//**
 Closes the log.
 @return	lsn */
 UNIV_INTERN
@@ -235,6 +288,26 @@ UNIV_INTERN
 void
 log_buffer_flush_to_disk(void);
 /*==========================*/
+/******************************************************************//**
+Log writer thread, which writes the log buffer to the log files on behalf of
+the threads waiting in log_write_up_to(), if srv_log_writer_threads is set.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
+/******************************************************************//**
+Log flusher thread, which flushes the log files written by log_writer_thread
+to disk, if srv_log_writer_threads is set.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
 /****************************************************************//**
 This functions writes the log buffer to the log file and if 'flush'
 is set it forces a flush of the log file as well. This is meant to be
@@ -605,6 +678,17 @@ extern log_t*	log_sys;
 /* The counting of lsn's starts from this value: this must be non-zero */
 #define LOG_START_LSN		((lsn_t) (16 * OS_FILE_LOG_BLOCK_SIZE))
 
+/* Number of slots tracking mini-transactions that have released the log
+mutex but not yet added their dirty pages to the flush lists, when
+srv_log_concurrent_mtr_commit is set; this bounds the number of
+mini-transaction commits running concurrently */
+#define LOG_CLOSED_N_SLOTS	1024
+
+/* Number of events on which threads wait for log_writer_thread and
+log_flusher_thread to write or flush the log up to an lsn; the log block
+number of the lsn selects the event */
+#define LOG_FLUSH_EVENTS_N	1024
+
 #define LOG_BUFFER_SIZE		(srv_log_buffer_size * UNIV_PAGE_SIZE)
 #define LOG_ARCHIVE_BUF_SIZE	(srv_log_buffer_size * UNIV_PAGE_SIZE / 4)
 
@@ -795,6 +879,15 @@ struct log_group_t{
 			log_groups;	/*!< list of log groups */
 };
 
+/** Tracks a mini-transaction that has reserved redo log space but may not
+yet have added its dirty pages to the flush lists */
+struct log_closed_slot_t{
+	lsn_t		start_lsn;	/*!< start lsn of the mini-transaction */
+	volatile ibool	closed;		/*!< TRUE when the dirty pages of
+					the mini-transaction are in the
+					flush lists */
+};
+
 /** Redo log buffer */
 struct log_t{
 	byte		pad[64];	/*!< padding to prevent other memory
@@ -814,6 +907,22 @@ struct log_t{
 					mtr_commit and still ensure that
 					insertions in the flush_list happen
 					in the LSN order. */
+	volatile ulint	n_pending_copies;/*!< number of mini-transactions
+					that have reserved space in the log
+					buffer with log_reserve_low() but not
+					yet copied their log records there;
+					the buffer must not be written or
+					moved unless this is zero. Only used
+					if srv_log_concurrent_mtr_commit */
+	log_closed_slot_t* closed_slots;/*!< array of LOG_CLOSED_N_SLOTS
+					slots for mini-transactions that add
+					their dirty pages to the flush lists
+					without log_flush_order_mutex, or NULL
+					if !srv_log_concurrent_mtr_commit */
+	ib_uint64_t	closed_no;	/*!< number of the oldest slot which
+					may be in use; protected by mutex */
+	ib_uint64_t	closed_next_no;	/*!< number of the next slot to
+					reserve; protected by mutex */
 #endif /* !UNIV_HOTBACKUP */
 	byte*		buf_ptr;	/* unaligned log buffer */
 	byte*		buf;		/*!< log buffer */
@@ -912,6 +1021,25 @@ struct log_t{
 					but NOTE that to set or reset this
 					event, the thread MUST own the log
 					mutex! */
+	os_event_t	writer_event;	/*!< set to wake up
+					log_writer_thread */
+	os_event_t	flusher_event;	/*!< set to wake up
+					log_flusher_thread */
+	os_event_t*	flush_events;	/*!< array of LOG_FLUSH_EVENTS_N
+					events on which threads wait in
+					log_write_up_to() for the log writer
+					and flusher threads, or NULL if
+					!srv_log_writer_threads */
+	volatile ulint	flush_requested;/*!< set to TRUE when a thread
+					waits for the log to be flushed to
+					disk, so that log_writer_thread wakes
+					up log_flusher_thread after its next
+					write; log_writer_thread resets it
+					with os_compare_and_swap_ulint() */
+	volatile bool	writer_is_active;/*!< true while
+					log_writer_thread is running */
+	volatile bool	flusher_is_active;/*!< true while
+					log_flusher_thread is running */
 	ulint		n_log_ios;	/*!< number of log i/os initiated thus
 					far */
 	ulint		n_log_ios_old;	/*!< number of log i/o's at the
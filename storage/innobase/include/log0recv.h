@@ -448,6 +448,12 @@ struct recv_sys_t{
 	hash_table_t*	addr_hash;/*!< hash table of file addresses of pages */
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
+#ifndef UNIV_HOTBACKUP
+	ulint		n_apply_threads_active;
+				/*!< number of recv_apply_thread
+				instances still applying the current
+				batch; protected by mutex */
+#endif /* !UNIV_HOTBACKUP */
 
 	recv_dblwr_t	dblwr;
 };
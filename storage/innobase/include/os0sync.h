@@ -902,6 +902,50 @@ architecture. Disable memory barrier for Intel architecture for now. */
 	"Memory barrier is not used"
 #endif
 
+#ifdef HAVE_IB_LINUX_FUTEX
+/** Word that threads can sleep on with os_futex_wait(). Every call of
+os_futex_wake() changes its value. */
+typedef ib_uint32_t	os_futex_t;
+
+/** Full memory barrier: no load or store is reordered across it */
+# define os_mb	__sync_synchronize()
+
+/**********************************************************//**
+Puts the calling thread to sleep on a futex until os_futex_wake() is called
+for it. Returns at once if the value of the futex word is no longer val.
+The thread may also wake up spuriously, so the caller must check the
+condition it is waiting for again. */
+UNIV_INLINE
+void
+os_futex_wait(
+/*==========*/
+	volatile os_futex_t*	futex,	/*!< in: futex word */
+	os_futex_t		val);	/*!< in: value of the futex word
+					read before the waited condition
+					was last checked */
+/**********************************************************//**
+Like os_futex_wait(), but returns when the time runs out.
+@return 0 if woken up or if the value was no longer val, or
+OS_SYNC_TIME_EXCEEDED if the time ran out */
+UNIV_INLINE
+ulint
+os_futex_wait_time(
+/*===============*/
+	volatile os_futex_t*	futex,	/*!< in: futex word */
+	os_futex_t		val,	/*!< in: value of the futex word
+					read before the waited condition
+					was last checked */
+	ulint			time_in_usec);
+					/*!< in: timeout in microseconds */
+/**********************************************************//**
+Wakes up all threads sleeping on a futex. */
+UNIV_INLINE
+void
+os_futex_wake(
+/*==========*/
+	volatile os_futex_t*	futex);	/*!< in/out: futex word */
+#endif /* HAVE_IB_LINUX_FUTEX */
+
 #ifndef UNIV_NONINL
 #include "os0sync.ic"
 #endif
@@ -37,17 +37,17 @@ Created 2/16/1997 Heikki Tuuri
 #include "read0types.h"
 
 /*********************************************************************//**
-Opens a read view where exactly the transactions serialized before this
-point in time are seen in the view.
-@return	own: read view struct */
+Opens the pre-allocated read view of a transaction, where exactly the
+transactions serialized before this point in time are seen in the view.
+The view is opened without acquiring trx_sys->mutex. If no transaction
+has committed since the previous snapshot of the view was taken, that
+snapshot is reused.
+@return	read view struct */
 UNIV_INTERN
 read_view_t*
 read_view_open_now(
 /*===============*/
-	trx_id_t	cr_trx_id,	/*!< in: trx_id of creating
-					transaction, or 0 used in purge */
-	read_view_t*&	view);		/*!< in,out: pre-allocated view array or
-					NULL if a new one needs to be created */
+	trx_t*		trx);		/*!< in/out: transaction */
 
 /*********************************************************************//**
 Clones a read view object. This function will allocate space for two read
@@ -63,13 +63,35 @@ read_view_clone(
 	read_view_t*&		prebuilt_clone);/*!< in,out: prebuilt view or
 						NULL */
 /*********************************************************************//**
-Insert the view in the proper order into the trx_sys->view_list. The
-read view list is ordered by read_view_t::low_limit_no in descending order. */
+Opens the pre-allocated read view of a transaction as a copy of another
+read view. The caller must own trx_sys->mutex.
+@return	read view struct */
 UNIV_INTERN
-void
-read_view_add(
-/*==========*/
-	read_view_t*	view);		/*!< in: view to add to */
+read_view_t*
+read_view_open_clone(
+/*=================*/
+	trx_t*			trx,	/*!< in/out: transaction */
+	const read_view_t*	view);	/*!< in: view to copy */
+/*********************************************************************//**
+Clones the oldest open read view in trx_sys->view_list. The caller must
+own trx_sys->mutex. The closed views of transactions that are older than
+the oldest open view are removed from the list.
+@return	clone of the oldest open view, or NULL if no view is open */
+UNIV_INTERN
+read_view_t*
+read_view_clone_oldest(
+/*===================*/
+	read_view_t*&	prebuilt_clone);/*!< in,out: prebuilt view or
+					NULL */
+/*********************************************************************//**
+Counts the open read views in trx_sys->view_list. The caller must own
+trx_sys->mutex. The views of transactions can be opened and closed
+concurrently, so the count is approximate.
+@return	number of open read views */
+UNIV_INTERN
+ulint
+read_view_get_n_open(void);
+/*======================*/
 /*********************************************************************//**
 Makes a copy of the oldest existing read view, or opens a new. The view
 must be closed with ..._close.
@@ -93,6 +115,17 @@ read_view_remove(
 	bool		own_mutex);	/*!< in: true if caller owns the
 					trx_sys_t::mutex */
 /*********************************************************************//**
+Closes the pre-allocated read view of a transaction. The view stays in
+trx_sys->view_list until purge removes it, so that it can be opened again
+without acquiring trx_sys->mutex. */
+UNIV_INLINE
+void
+read_view_close(
+/*============*/
+	read_view_t*	view,		/*!< in: read view, can be 0 */
+	bool		own_mutex);	/*!< in: true if caller owns the
+					trx_sys_t::mutex */
+/*********************************************************************//**
 Frees memory allocated by a read view. */
 UNIV_INTERN
 void
@@ -195,10 +228,34 @@ struct read_view_t{
 	trx_id_t	creator_trx_id;
 				/*!< trx id of creating transaction, or
 				0 used in purge */
+	ulint		n_released;
+				/*!< trx_sys->descr_n_released when the
+				snapshot was taken, or ULINT_UNDEFINED if
+				the snapshot must not be reused */
+	trx_t*		trx;	/*!< the transaction whose prebuilt_view
+				this is, or NULL */
+	ulint		state;	/*!< READ_VIEW_CLOSED or READ_VIEW_OPEN;
+				for the views of transactions, protected
+				by trx->mutex or trx_sys->mutex, and only
+				modified by the thread of trx */
+	bool		in_list;/*!< true if the view is in
+				trx_sys->view_list; protected by
+				trx_sys->mutex, and for the views of
+				transactions also by trx->mutex if
+				modified by other threads than that of
+				trx */
 	UT_LIST_NODE_T(read_view_t) view_list;
 				/*!< List of read views in trx_sys */
 };
 
+/** Read view states @{ */
+#define READ_VIEW_CLOSED	1	/*!< The view is not used for
+					consistent reads, and purge
+					ignores it. */
+#define READ_VIEW_OPEN		2	/*!< The view is used for
+					consistent reads. */
+/* @} */
+
 /** Read view types @{ */
 #define VIEW_NORMAL		1	/*!< Normal consistent read view
 					where transaction does not see changes
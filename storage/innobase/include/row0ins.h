@@ -32,6 +32,7 @@ Created 4/20/1996 Heikki Tuuri
 #include "dict0types.h"
 #include "trx0types.h"
 #include "row0types.h"
+#include "btr0types.h"
 
 /***************************************************************//**
 Checks if foreign key constraint fails for an index entry. Sets shared locks
@@ -97,8 +98,11 @@ row_ins_clust_index_entry_low(
 	ulint		n_uniq,	/*!< in: 0 or index->n_uniq */
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	ulint		n_ext,	/*!< in: number of externally stored columns */
-	que_thr_t*	thr)	/*!< in: query thread or NULL */
-	MY_ATTRIBUTE((nonnull, warn_unused_result));
+	que_thr_t*	thr,	/*!< in: query thread or NULL */
+	btr_append_hint_t* append_hint)
+				/*!< in/out: position of the previous
+				append to the index, or NULL */
+	MY_ATTRIBUTE((nonnull(3,5,7), warn_unused_result));
 /***************************************************************//**
 Tries to insert an entry into a secondary index. If a record with exactly the
 same fields is found, the other record is necessarily marked deleted.
@@ -163,8 +167,11 @@ row_ins_clust_index_entry(
 	dict_index_t*	index,	/*!< in: clustered index */
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	que_thr_t*	thr,	/*!< in: query thread */
-	ulint		n_ext)	/*!< in: number of externally stored columns */
-	MY_ATTRIBUTE((nonnull, warn_unused_result));
+	ulint		n_ext,	/*!< in: number of externally stored columns */
+	btr_append_hint_t* append_hint)
+				/*!< in/out: position of the previous
+				append to the index, or NULL */
+	MY_ATTRIBUTE((nonnull(1,2,3), warn_unused_result));
 /***************************************************************//**
 Inserts an entry into a secondary index. Tries first optimistic,
 then pessimistic descent down the tree. If the entry matches enough
@@ -216,6 +223,11 @@ struct ins_node_t{
 				entry_list and sys fields are stored here;
 				if this is NULL, entry list should be created
 				and buffers for sys fields in row allocated */
+	btr_append_hint_t append_hint;
+				/*!< rightmost leaf page of the clustered
+				index where the previous row was appended;
+				lets inserts in ascending primary key order
+				skip the descent down the tree */
 	ulint		magic_n;
 };
 
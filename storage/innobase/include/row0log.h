@@ -111,6 +111,18 @@ row_log_table_get_error(
 					that is being rebuilt online */
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
 
+/******************************************************//**
+Delays a DML operation on a table that is being rebuilt online while
+the modification log is more than half full, so that the log can be
+applied faster than it is written. The caller must not hold any
+latches. */
+UNIV_INTERN
+void
+row_log_table_throttle(
+/*===================*/
+	dict_index_t*	index)	/*!< in/out: clustered index */
+	MY_ATTRIBUTE((nonnull));
+
 /******************************************************//**
 Logs a delete operation to a table that is being rebuilt.
 This will be merged in row_log_table_apply_delete(). */
@@ -722,7 +722,11 @@ struct mysql_row_templ_t {
 	LEX_CSTRING	zip_dict_data;	/*!< associated compression dictionary */
 };
 
+/* Initial number of rows in fetch_cache; the cache is doubled every time
+a batch fills it completely, until it reaches MYSQL_FETCH_CACHE_MAX_BYTES */
 #define MYSQL_FETCH_CACHE_SIZE		8
+/* Upper bound on the size of fetch_cache in bytes */
+#define MYSQL_FETCH_CACHE_MAX_BYTES	(64 * 1024)
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
 
@@ -896,8 +900,7 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
-					/*!< a cache for fetched rows if we
+	byte**		fetch_cache;	/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
 					batch; we reserve mysql_row_len
@@ -906,6 +909,13 @@ struct row_prebuilt_t {
 					allocated mem buf start, because
 					there is a 4 byte magic number at the
 					start and at the end */
+	ulint		fetch_cache_alloc;/*!< number of rows allocated
+					in fetch_cache */
+	ulint		fetch_cache_limit;/*!< number of rows to fetch into
+					fetch_cache in the next batch; starts
+					at MYSQL_FETCH_CACHE_SIZE and grows
+					while the cursor keeps filling the
+					cache */
 	ibool		keep_other_fields_on_keyread; /*!< when using fetch
 					cache with HA_EXTRA_KEYREAD, don't
 					overwrite other fields in mysql row
@@ -169,6 +169,14 @@ row_search_for_mysql(
 					with stored position! In opening of a
 					cursor 'direction' should be 0. */
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/********************************************************************//**
+Frees the prefetch cache of a prebuilt struct, checking the magic numbers
+around each cached row. */
+UNIV_INTERN
+void
+row_sel_prefetch_cache_free(
+/*========================*/
+	row_prebuilt_t*	prebuilt);	/*!< in/out: prebuilt struct */
 /*******************************************************************//**
 Checks if MySQL at the moment is allowed for this table to retrieve a
 consistent read result, or store it to the query cache.
@@ -280,6 +280,11 @@ enum monitor_id_t {
 	MONITOR_DML_PURGE_DELAY,
 	MONITOR_PURGE_STOP_COUNT,
 	MONITOR_PURGE_RESUME_COUNT,
+	MONITOR_PURGE_BATCH_SIZE,
+	MONITOR_PURGE_TABLE_GROUPS,
+	MONITOR_PURGE_THREAD_RECS_MIN,
+	MONITOR_PURGE_THREAD_RECS_MAX,
+	MONITOR_PURGE_PESSIMISTIC,
 
 	/* Recovery related counters */
 	MONITOR_MODULE_RECOVERY,
@@ -377,6 +382,12 @@ enum monitor_id_t {
 	MONITOR_ONLINE_CREATE_INDEX,
 	MONITOR_PENDING_ALTER_TABLE,
 
+	MONITOR_MODULE_ONLINE_ALTER,
+	MONITOR_ONLINE_LOG_WRITTEN,
+	MONITOR_ONLINE_LOG_APPLIED,
+	MONITOR_ONLINE_LOG_APPLIED_OPS,
+	MONITOR_ONLINE_LOG_THROTTLED,
+
 	MONITOR_MODULE_ICP,
 	MONITOR_ICP_ATTEMPTS,
 	MONITOR_ICP_NO_MATCH,
@@ -126,6 +126,18 @@ struct srv_stats_t {
 	/** Number of rows inserted */
 	ulint_ctr_64_t		n_rows_inserted;
 
+	/** Number of rows copied to the row prefetch cache */
+	ulint_ctr_64_t		n_rows_prefetched;
+
+	/** Number of batches of rows copied to the row prefetch cache */
+	ulint_ctr_64_t		n_rows_prefetch_batches;
+
+	/** Number of FTS queries ranked with the top-N evaluation */
+	ulint_ctr_1_t		n_fts_topn_queries;
+
+	/** Number of FTS ilist blocks skipped by top-N queries */
+	ulint_ctr_1_t		n_fts_topn_blocks_skipped;
+
 	ulint_ctr_1_t		lock_deadlock_count;
 
 	ulint_ctr_1_t		n_lock_max_wait_time;
@@ -145,6 +157,9 @@ extern os_event_t	srv_error_event;
 /** The buffer pool dump/load thread waits on this event. */
 extern os_event_t	srv_buf_dump_event;
 
+/** The buffer pool resize thread waits on this event. */
+extern os_event_t	srv_buf_resize_event;
+
 /** The buffer pool dump/load file name */
 #define SRV_BUF_DUMP_FILENAME_DEFAULT	"ib_buffer_pool"
 extern char*		srv_buf_dump_filename;
@@ -235,12 +250,19 @@ extern ibool	srv_locks_unsafe_for_binlog;
 extern ulong	srv_sort_buf_size;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
+/** Maximum delay in microseconds of a DML operation on a table that is
+being rebuilt online while its modification log is more than half full */
+extern ulong	srv_online_max_delay;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+/* If this flag is TRUE, the native aio requests that are posted in a
+batch with OS_AIO_SIMULATED_WAKE_LATER are submitted to the kernel
+together when the batch is complete. Linux native aio only. */
+extern my_bool	srv_use_native_aio_batch;
 extern my_bool	srv_numa_interleave;
 #ifdef __WIN__
 extern ibool	srv_use_native_conditions;
@@ -289,6 +311,13 @@ extern ib_uint64_t	srv_log_file_size;
 extern ib_uint64_t	srv_log_file_size_requested;
 extern ulint	srv_log_buffer_size;
 extern uint	srv_flush_log_at_timeout;
+/** If TRUE, mini-transactions copy their redo log records to the log buffer
+and add their dirty pages to the flush lists after releasing the log mutex,
+without log_flush_order_mutex */
+extern my_bool	srv_log_concurrent_mtr_commit;
+/** If TRUE, the log is written and flushed by log_writer_thread and
+log_flusher_thread, and other threads wait for them in log_write_up_to() */
+extern my_bool	srv_log_writer_threads;
 extern char	srv_use_global_flush_log_at_trx_commit;
 extern char	srv_adaptive_flushing;
 
@@ -309,6 +338,9 @@ extern my_bool	srv_use_sys_malloc;
 extern ibool	srv_use_sys_malloc;
 #endif /* UNIV_HOTBACKUP */
 extern ulint	srv_buf_pool_size;	/*!< requested size in bytes */
+extern ulong	srv_buf_pool_chunk_unit;/*!< size in bytes of a buffer
+					pool chunk, the unit in which
+					the buffer pool is resized */
 extern ulint    srv_buf_pool_instances; /*!< requested number of buffer pool instances */
 extern ulong	srv_n_page_hash_locks;	/*!< number of locks to
 					protect buf_pool->page_hash */
@@ -356,6 +388,11 @@ extern ulong	srv_cleaner_lsn_age_factor;
 					/*!< page cleaner LSN age factor
 					formula option */
 
+extern ulong	srv_n_page_cleaners;	/*!< number of page cleaner slots
+					the buffer pool instances are
+					divided into, each flushed by its
+					own thread */
+
 extern ulong	srv_empty_free_list_algorithm;
 					/*!< Empty free list for a query thread
 					handling algorithm option */
@@ -401,6 +438,9 @@ extern ulong	srv_adaptive_flushing_lwm;
 extern ulong	srv_flushing_avg_loops;
 
 extern ulong	srv_force_recovery;
+extern ulong	srv_n_recv_apply_threads;
+extern ulong	srv_n_tablespace_discovery_threads;
+extern my_bool	srv_recv_log_read_ahead;
 #ifndef DBUG_OFF
 extern ulong	srv_force_recovery_crash;
 #endif /* !DBUG_OFF */
@@ -418,9 +458,14 @@ extern unsigned long long	srv_stats_transient_sample_pages;
 extern my_bool			srv_stats_persistent;
 extern unsigned long long	srv_stats_persistent_sample_pages;
 extern my_bool			srv_stats_auto_recalc;
+extern ulong			srv_stats_analyze_threads;
+extern ulong			srv_stats_histogram_buckets;
+extern ulong			srv_stats_auto_recalc_pages_per_sec;
 
 extern ibool	srv_use_doublewrite_buf;
 extern ulong	srv_doublewrite_batch_size;
+extern my_bool	srv_parallel_doublewrite;
+extern char*	srv_parallel_doublewrite_path;
 extern ibool	srv_use_atomic_writes;
 #ifdef HAVE_POSIX_FALLOCATE
 extern ibool	srv_use_posix_fallocate;
@@ -475,6 +520,9 @@ extern ibool	srv_error_monitor_active;
 /* TRUE during the lifetime of the buffer pool dump/load thread */
 extern ibool	srv_buf_dump_thread_active;
 
+/* TRUE during the lifetime of the buffer pool resize thread */
+extern ibool	srv_buf_resize_thread_active;
+
 /* TRUE during the lifetime of the stats thread */
 extern ibool	srv_dict_stats_thread_active;
 
@@ -529,6 +577,12 @@ extern ib_mutex_t	server_mutex;
 
 #define SRV_MAX_N_PURGE_THREADS 32
 
+#define SRV_MAX_N_RECV_APPLY_THREADS 32
+
+#define SRV_MAX_N_TABLESPACE_DISCOVERY_THREADS 32
+
+#define SRV_MAX_N_PAGE_CLEANERS 64
+
 /* Array of English strings describing the current state of an
 i/o handler thread */
 extern const char* srv_io_thread_op_info[];
@@ -602,6 +656,8 @@ extern my_bool srv_fake_changes_locks;
 /* Keys to register InnoDB threads with performance schema */
 extern mysql_pfs_key_t	buf_page_cleaner_thread_key;
 extern mysql_pfs_key_t	buf_lru_manager_thread_key;
+extern mysql_pfs_key_t	buf_page_cleaner_worker_thread_key;
+extern mysql_pfs_key_t	buf_lru_manager_worker_thread_key;
 extern mysql_pfs_key_t	trx_rollback_clean_thread_key;
 extern mysql_pfs_key_t	io_handler_thread_key;
 extern mysql_pfs_key_t	srv_lock_timeout_thread_key;
@@ -610,7 +666,12 @@ extern mysql_pfs_key_t	srv_monitor_thread_key;
 extern mysql_pfs_key_t	srv_master_thread_key;
 extern mysql_pfs_key_t	srv_purge_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
+extern mysql_pfs_key_t	fil_discovery_thread_key;
+extern mysql_pfs_key_t	recv_log_read_ahead_thread_key;
 extern mysql_pfs_key_t	srv_log_tracking_thread_key;
+extern mysql_pfs_key_t	log_writer_thread_key;
+extern mysql_pfs_key_t	log_flusher_thread_key;
 
 /* This macro register the current thread and its key with performance
 schema */
@@ -987,6 +1048,8 @@ struct export_var_t{
 	ulint innodb_data_reads;		/*!< I/O read requests */
 	char  innodb_buffer_pool_dump_status[512];/*!< Buf pool dump status */
 	char  innodb_buffer_pool_load_status[512];/*!< Buf pool load status */
+	char  innodb_buffer_pool_resize_status[512];/*!< Buf pool resize
+						status */
 	ulint innodb_buffer_pool_pages_total;	/*!< Buffer pool size */
 	ulint innodb_buffer_pool_pages_data;	/*!< Data pages */
 	ulint innodb_buffer_pool_bytes_data;	/*!< File bytes used */
@@ -1064,6 +1127,10 @@ struct export_var_t{
 	ulint innodb_current_row_locks;
 	ulint innodb_rows_read;			/*!< srv_n_rows_read */
 	ulint innodb_rows_inserted;		/*!< srv_n_rows_inserted */
+	ulint innodb_rows_prefetched;		/*!< srv_n_rows_prefetched */
+	ulint innodb_rows_prefetch_batches;	/*!< srv_n_rows_prefetch_batches */
+	ulint innodb_fts_topn_queries;		/*!< srv_n_fts_topn_queries */
+	ulint innodb_fts_topn_blocks_skipped;	/*!< srv_n_fts_topn_blocks_skipped */
 	ulint innodb_rows_updated;		/*!< srv_n_rows_updated */
 	ulint innodb_rows_deleted;		/*!< srv_n_rows_deleted */
 	ulint innodb_num_open_files;		/*!< fil_n_file_opened */
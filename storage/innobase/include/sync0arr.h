@@ -30,6 +30,7 @@ Created 9/5/1995 Heikki Tuuri
 #include "ut0lst.h"
 #include "ut0mem.h"
 #include "os0thread.h"
+#include "os0sync.h"
 
 /** Synchronization wait array cell */
 struct sync_cell_t;
@@ -77,6 +78,66 @@ sync_array_wait_event(
 /*==================*/
 	sync_array_t*	arr,	/*!< in: wait array */
 	ulint		index);	 /*!< in: index of the reserved cell */
+#ifdef HAVE_IB_LINUX_FUTEX
+/******************************************************************//**
+Get an instance of the sync wait array and reserve a wait array cell
+in the instance for a thread that will sleep on a futex word of the
+object instead of its event. The cell only makes the wait visible to
+the diagnostics and to the error monitor thread.
+@return the instance found, never NULL. */
+UNIV_INLINE
+sync_array_t*
+sync_array_get_and_reserve_futex_cell(
+/*==================================*/
+	void*			object,	/*!< in: pointer to the object to
+					wait for */
+	ulint			type,	/*!< in: lock request type */
+	volatile os_futex_t*	futex,	/*!< in: futex word of the object */
+	const char*		file,	/*!< in: file where requested */
+	ulint			line,	/*!< in: line where requested */
+	ulint*			index);	/*!< out: index of the reserved cell */
+/******************************************************************//**
+Reserves a wait array cell for a thread that will sleep on a futex
+word of the object instead of its event. The event is not touched.
+@return true if free cell is found, otherwise false */
+UNIV_INTERN
+bool
+sync_array_reserve_futex_cell(
+/*==========================*/
+	sync_array_t*		arr,	/*!< in: wait array */
+	void*			object,	/*!< in: pointer to the object to
+					wait for */
+	ulint			type,	/*!< in: lock request type */
+	volatile os_futex_t*	futex,	/*!< in: futex word of the object */
+	const char*		file,	/*!< in: file where requested */
+	ulint			line,	/*!< in: line where requested */
+	ulint*			index);	/*!< out: index of the reserved cell */
+
+/** Time in microseconds after which a thread sleeping on the futex word
+of a latch reserves a sync array cell for its wait */
+#define SYNC_ARRAY_FUTEX_CELL_DELAY	1000000
+
+/******************************************************************//**
+Sleeps on the futex word of a latch, unless the word no longer has the
+value read before the waited condition was last checked. The sync array
+is not used for short waits. If the wait lasts longer than
+SYNC_ARRAY_FUTEX_CELL_DELAY, a cell is reserved for it, so that it can be
+seen by the long semaphore wait checks, and the thread sleeps on until it
+is woken up. In the debug version the deadlock check is then run. */
+UNIV_INTERN
+void
+sync_array_wait_futex(
+/*==================*/
+	void*			object,	/*!< in: pointer to the object to
+					wait for */
+	ulint			type,	/*!< in: lock request type */
+	volatile os_futex_t*	futex,	/*!< in: futex word of the object */
+	os_futex_t		val,	/*!< in: value of the futex word
+					read before the waited condition
+					was last checked */
+	const char*		file,	/*!< in: file where requested */
+	ulint			line);	/*!< in: line where requested */
+#endif /* HAVE_IB_LINUX_FUTEX */
 /******************************************************************//**
 Frees the cell. NOTE! sync_array_wait_event frees the cell
 automatically! */
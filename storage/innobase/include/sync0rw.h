@@ -741,6 +741,15 @@ struct rw_lock_t {
 	struct os_event	wait_ex_event;
 				/*!< Event for next-writer to wait on. A thread
 				must decrement lock_word before waiting. */
+#ifdef HAVE_IB_LINUX_FUTEX
+	volatile os_futex_t	futex;
+				/*!< Threads waiting for the lock sleep on
+				this word instead of event, with a sync
+				array cell only after a long wait */
+	volatile os_futex_t	wait_ex_futex;
+				/*!< The next writer sleeps on this word
+				instead of wait_ex_event */
+#endif /* HAVE_IB_LINUX_FUTEX */
 #ifndef INNODB_RW_LOCKS_USE_ATOMICS
 	ib_mutex_t	mutex;		/*!< The mutex protecting rw_lock_t */
 #endif /* INNODB_RW_LOCKS_USE_ATOMICS */
@@ -94,6 +94,7 @@ extern mysql_pfs_key_t	mem_hash_mutex_key;
 # endif /* UNIV_MEM_DEBUG */
 extern mysql_pfs_key_t	mem_pool_mutex_key;
 extern mysql_pfs_key_t	mutex_list_mutex_key;
+extern mysql_pfs_key_t	page_cleaner_mutex_key;
 extern mysql_pfs_key_t	purge_sys_bh_mutex_key;
 extern mysql_pfs_key_t	recv_sys_mutex_key;
 extern mysql_pfs_key_t	recv_writer_mutex_key;
@@ -116,12 +117,12 @@ extern mysql_pfs_key_t	trx_undo_mutex_key;
 extern mysql_pfs_key_t	trx_mutex_key;
 extern mysql_pfs_key_t	lock_sys_mutex_key;
 extern mysql_pfs_key_t	lock_sys_wait_mutex_key;
+extern mysql_pfs_key_t	lock_sys_rec_mutex_key;
+extern mysql_pfs_key_t	lock_sys_table_mutex_key;
 extern mysql_pfs_key_t	trx_sys_mutex_key;
 extern mysql_pfs_key_t	srv_sys_mutex_key;
 extern mysql_pfs_key_t	srv_sys_tasks_mutex_key;
-#ifndef HAVE_ATOMIC_BUILTINS
 extern mysql_pfs_key_t	srv_conc_mutex_key;
-#endif /* !HAVE_ATOMIC_BUILTINS */
 #ifndef HAVE_ATOMIC_BUILTINS_64
 extern mysql_pfs_key_t	monitor_mutex_key;
 #endif /* !HAVE_ATOMIC_BUILTINS_64 */
@@ -869,8 +870,10 @@ or row lock! */
 /*------------------------------------- MySQL query cache mutex */
 /*------------------------------------- MySQL binlog mutex */
 /*-------------------------------*/
-#define SYNC_LOCK_WAIT_SYS	300
-#define SYNC_LOCK_SYS		299
+#define SYNC_LOCK_WAIT_SYS	301
+#define SYNC_LOCK_SYS		300
+#define SYNC_LOCK_SYS_PARTITION	299	/* lock_sys->rec_mutexes and
+					lock_sys->table_mutexes */
 #define SYNC_TRX_SYS		298
 #define SYNC_TRX		297
 #define SYNC_THREADS		295
@@ -923,6 +926,12 @@ implementation of a mutual exclusion semaphore. */
 /** InnoDB mutex */
 struct ib_mutex_t {
 	struct os_event	event;	/*!< Used by sync0arr.cc for the wait queue */
+#ifdef HAVE_IB_LINUX_FUTEX
+	volatile os_futex_t	futex;	/*!< Threads waiting for the mutex
+				sleep on this word instead of event,
+				with a sync array cell only after a
+				long wait */
+#endif /* HAVE_IB_LINUX_FUTEX */
 	volatile lock_word_t	lock_word;	/*!< lock_word is the target
 				of the atomic test-and-set instruction when
 				atomic operations are enabled. */
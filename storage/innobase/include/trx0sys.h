@@ -184,6 +184,22 @@ trx_id_t
 trx_sys_get_max_trx_id(void);
 /*========================*/
 
+/*****************************************************************//**
+Starts a change of the trx_sys fields that read_view_open_now() copies
+without acquiring trx_sys->mutex: max_trx_id, the descriptors array,
+serial_min_no and descr_n_released. The caller must own trx_sys->mutex
+and end the change with trx_sys_descr_change_end(). */
+UNIV_INLINE
+void
+trx_sys_descr_change_begin(void);
+/*============================*/
+/*****************************************************************//**
+Ends a change started by trx_sys_descr_change_begin(). */
+UNIV_INLINE
+void
+trx_sys_descr_change_end(void);
+/*==========================*/
+
 /*************************************************************//**
 Find a slot for a given trx ID in a descriptors array.
 @return: slot pointer */
@@ -643,14 +659,37 @@ struct trx_sys_t{
 					transaction number */
 	char		pad1[64];	/*!< Ensure max_trx_id does not share
 					cache line with other fields. */
-	trx_id_t*	descriptors;	/*!< Array of trx descriptors */
-	ulint		descr_n_max;	/*!< The current size of the descriptors
+	trx_id_t* volatile descriptors;	/*!< Array of trx descriptors */
+	volatile ulint	descr_n_max;	/*!< The current size of the descriptors
 					array. */
+	mem_heap_t*	descr_heap;	/*!< Memory heap for the descriptors
+					array. An array is not freed when it
+					is replaced by a bigger one, because
+					read_view_open_now() may still be
+					copying it. */
 	char		pad2[64];	/*!< Ensure static descriptor fields
 					do not share cache lines with
 					descr_n_used */
-	ulint		descr_n_used;	/*!< Number of used elements in the
+	volatile ulint	descr_n_used;	/*!< Number of used elements in the
 					descriptors array. */
+	trx_id_t	serial_min_no;	/*!< trx_t::no of the first
+					transaction in trx_serial_list, or
+					TRX_ID_MAX if the list is empty */
+	volatile ulint	descr_n_released;
+					/*!< Number of commits and rollbacks,
+					incremented by
+					trx_release_descriptor(). A read view
+					snapshot can be reused while this has
+					not changed. */
+	volatile ulint	descr_version;	/*!< Incremented before and after
+					every change of max_trx_id, the
+					descriptors array, serial_min_no and
+					descr_n_released, so that it is odd
+					while a change is in progress. This
+					allows read_view_open_now() to copy
+					these fields without acquiring the
+					mutex, see
+					trx_sys_descr_change_begin() */
 	char		pad3[64];	/*!< Ensure descriptors do not share
 					cache line with other fields */
 #ifdef UNIV_DEBUG
@@ -705,8 +744,13 @@ struct trx_sys_t{
 					transactions), protected by
 					rseg->mutex */
 	UT_LIST_BASE_NODE_T(read_view_t) view_list;
-					/*!< List of read views sorted
-					on trx no, biggest first */
+					/*!< List of the pre-allocated read
+					views of transactions and of the
+					cursor read views, newest snapshot
+					first. The views of transactions stay
+					in the list while closed, until purge
+					removes them; they are opened and
+					closed under trx_t::mutex. */
 };
 
 /** When a trx id which is zero modulo this number (which must be a power of
@@ -854,6 +854,13 @@ struct trx_t{
 					declared_to_... is TRUE; when we come
 					to srv_conc_innodb_enter, if the value
 					here is > 0, we decrement this by 1 */
+	bool		conc_long;
+					/*!< true if the current statement
+					has used up its tickets at least once
+					and queues for InnoDB as a long
+					statement; only changed while
+					declared_to_be_inside_innodb is
+					FALSE */
 	ulint		dict_operation_lock_mode;
 					/*!< 0, RW_S_LATCH, or RW_X_LATCH:
 					the latch mode trx currently holds
@@ -956,7 +963,11 @@ struct trx_t{
 					associated to a transaction (i.e.
 					same as global_read_view) or read view
 					associated to a cursor */
-	read_view_t*	prebuilt_view;	/* pre-built view array */
+	read_view_t*	prebuilt_view;	/* pre-built view array; it is in
+					trx_sys->view_list from its creation
+					until trx_free_low(), and it is
+					opened and closed under this
+					trx->mutex */
 	/*------------------------------*/
 	UT_LIST_BASE_NODE_T(trx_named_savept_t)
 			trx_savepoints;	/*!< savepoints set with SAVEPOINT ...,
@@ -46,6 +46,40 @@ typedef ib_uint32_t (*ib_ut_crc32_t)(const byte* ptr, ulint len);
 
 extern ib_ut_crc32_t	ut_crc32;
 
+/********************************************************************//**
+Calculates CRC32 with the slice-by-8 table algorithm. ut_crc32() is
+one of the following implementations, chosen by ut_crc32_init(); they
+are exported for unit tests and benchmarks.
+@return CRC-32C (polynomial 0x11EDC6F41) */
+UNIV_INTERN
+ib_uint32_t
+ut_crc32_slice8(
+/*============*/
+	const byte*	buf,	/*!< in: data over which to calculate CRC32 */
+	ulint		len);	/*!< in: data length */
+
+/********************************************************************//**
+Calculates CRC32 using one stream of CPU instructions. Requires
+ut_crc32_sse2_enabled.
+@return CRC-32C (polynomial 0x11EDC6F41) */
+UNIV_INTERN
+ib_uint32_t
+ut_crc32_sse42(
+/*===========*/
+	const byte*	buf,	/*!< in: data over which to calculate CRC32 */
+	ulint		len);	/*!< in: data length */
+
+/********************************************************************//**
+Calculates CRC32 using CPU instructions, interleaving three streams of
+instructions over long buffers. Requires ut_crc32_sse2_enabled.
+@return CRC-32C (polynomial 0x11EDC6F41) */
+UNIV_INTERN
+ib_uint32_t
+ut_crc32_sse42_interleaved(
+/*=======================*/
+	const byte*	buf,	/*!< in: data over which to calculate CRC32 */
+	ulint		len);	/*!< in: data length */
+
 extern bool	ut_crc32_sse2_enabled;
 
 #endif /* ut0crc32_h */
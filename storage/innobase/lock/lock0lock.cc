@@ -388,6 +388,10 @@ static const ulint	lock_types = UT_ARR_SIZE(lock_compatibility_matrix);
 UNIV_INTERN mysql_pfs_key_t	lock_sys_mutex_key;
 /* Key to register mutex with performance schema */
 UNIV_INTERN mysql_pfs_key_t	lock_sys_wait_mutex_key;
+/* Key to register mutex with performance schema */
+UNIV_INTERN mysql_pfs_key_t	lock_sys_rec_mutex_key;
+/* Key to register mutex with performance schema */
+UNIV_INTERN mysql_pfs_key_t	lock_sys_table_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
 #ifdef UNIV_DEBUG
@@ -584,6 +588,161 @@ lock_sec_rec_cons_read_sees(
 	return(max_trx_id < view->up_limit_id);
 }
 
+/*********************************************************************//**
+Gets the lock_sys partition mutex that protects the record lock queue
+of a page, identified by the lock hash value of the page.
+@return partition mutex */
+UNIV_INLINE
+ib_mutex_t*
+lock_rec_hash_get_mutex(
+/*====================*/
+	ulint	hash)	/*!< in: lock_rec_hash() of the page */
+{
+	return(lock_sys->rec_mutexes
+	       + ut_2pow_remainder(hash, LOCK_SYS_N_REC_MUTEXES));
+}
+
+/*********************************************************************//**
+Gets the lock_sys partition mutex that protects the record lock queue
+of a page.
+@return partition mutex */
+UNIV_INLINE
+ib_mutex_t*
+lock_rec_get_mutex(
+/*===============*/
+	ulint	space,	/*!< in: space id */
+	ulint	page_no)/*!< in: page number */
+{
+	return(lock_rec_hash_get_mutex(lock_rec_hash(space, page_no)));
+}
+
+/*********************************************************************//**
+Gets the lock_sys partition mutex that protects the record lock queue
+of a buffer block.
+@return partition mutex */
+UNIV_INLINE
+ib_mutex_t*
+lock_rec_block_get_mutex(
+/*=====================*/
+	const buf_block_t*	block)	/*!< in: buffer block */
+{
+	return(lock_rec_hash_get_mutex(buf_block_get_lock_hash_val(block)));
+}
+
+/*********************************************************************//**
+Gets the lock_sys partition mutex that protects the table lock queue
+of a table.
+@return partition mutex */
+UNIV_INLINE
+ib_mutex_t*
+lock_table_get_mutex(
+/*=================*/
+	const dict_table_t*	table)	/*!< in: table */
+{
+	return(lock_sys->table_mutexes
+	       + ut_2pow_remainder(table->id, LOCK_SYS_N_TABLE_MUTEXES));
+}
+
+/*********************************************************************//**
+Gets the lock_sys partition mutex that protects the queue of a lock.
+@return partition mutex */
+UNIV_INLINE
+ib_mutex_t*
+lock_get_mutex(
+/*===========*/
+	const lock_t*	lock)	/*!< in: record or table lock */
+{
+	if (lock_get_type_low(lock) == LOCK_REC) {
+		return(lock_rec_get_mutex(lock->un_member.rec_lock.space,
+					  lock->un_member.rec_lock.page_no));
+	}
+
+	return(lock_table_get_mutex(lock->un_member.tab_lock.table));
+}
+
+/*********************************************************************//**
+Acquires all the lock_sys partition mutexes, in ascending order. The
+caller must own lock_sys->mutex. */
+UNIV_INTERN
+void
+lock_sys_partitions_enter(void)
+/*===========================*/
+{
+	ut_ad(lock_mutex_own());
+
+	for (ulint i = 0; i < LOCK_SYS_N_REC_MUTEXES; i++) {
+		mutex_enter(&lock_sys->rec_mutexes[i]);
+	}
+
+	for (ulint i = 0; i < LOCK_SYS_N_TABLE_MUTEXES; i++) {
+		mutex_enter(&lock_sys->table_mutexes[i]);
+	}
+}
+
+/*********************************************************************//**
+Releases all the lock_sys partition mutexes. */
+UNIV_INTERN
+void
+lock_sys_partitions_exit(void)
+/*==========================*/
+{
+	ut_ad(lock_mutex_own());
+
+	for (ulint i = LOCK_SYS_N_TABLE_MUTEXES; i--; ) {
+		mutex_exit(&lock_sys->table_mutexes[i]);
+	}
+
+	for (ulint i = LOCK_SYS_N_REC_MUTEXES; i--; ) {
+		mutex_exit(&lock_sys->rec_mutexes[i]);
+	}
+}
+
+/*********************************************************************//**
+Tries to acquire lock_sys->mutex and all the partition mutexes without
+waiting. If any of them is busy, the ones already acquired are released.
+@return 0 if succeeded, 1 if any of the mutexes was busy */
+UNIV_INTERN
+ulint
+lock_mutex_enter_nowait(void)
+/*=========================*/
+{
+	ulint	i;
+	ulint	j;
+
+	if (mutex_enter_nowait(&lock_sys->mutex)) {
+
+		return(1);
+	}
+
+	for (i = 0; i < LOCK_SYS_N_REC_MUTEXES; i++) {
+		if (mutex_enter_nowait(&lock_sys->rec_mutexes[i])) {
+			goto busy_rec;
+		}
+	}
+
+	for (j = 0; j < LOCK_SYS_N_TABLE_MUTEXES; j++) {
+		if (mutex_enter_nowait(&lock_sys->table_mutexes[j])) {
+			goto busy_table;
+		}
+	}
+
+	return(0);
+
+busy_table:
+	while (j--) {
+		mutex_exit(&lock_sys->table_mutexes[j]);
+	}
+
+busy_rec:
+	while (i--) {
+		mutex_exit(&lock_sys->rec_mutexes[i]);
+	}
+
+	mutex_exit(&lock_sys->mutex);
+
+	return(1);
+}
+
 /*********************************************************************//**
 Creates the lock system at database start. */
 UNIV_INTERN
@@ -613,6 +772,24 @@ lock_sys_create(
 	mutex_create(lock_sys_wait_mutex_key,
 		     &lock_sys->wait_mutex, SYNC_LOCK_WAIT_SYS);
 
+	lock_sys->rec_mutexes = static_cast<ib_mutex_t*>(
+		mem_zalloc(LOCK_SYS_N_REC_MUTEXES * sizeof(ib_mutex_t)));
+
+	for (ulint i = 0; i < LOCK_SYS_N_REC_MUTEXES; i++) {
+		mutex_create(lock_sys_rec_mutex_key,
+			     &lock_sys->rec_mutexes[i],
+			     SYNC_LOCK_SYS_PARTITION);
+	}
+
+	lock_sys->table_mutexes = static_cast<ib_mutex_t*>(
+		mem_zalloc(LOCK_SYS_N_TABLE_MUTEXES * sizeof(ib_mutex_t)));
+
+	for (ulint i = 0; i < LOCK_SYS_N_TABLE_MUTEXES; i++) {
+		mutex_create(lock_sys_table_mutex_key,
+			     &lock_sys->table_mutexes[i],
+			     SYNC_LOCK_SYS_PARTITION);
+	}
+
 	lock_sys->timeout_event = os_event_create();
 
 	lock_sys->rec_hash = hash_create(n_cells);
@@ -641,6 +818,18 @@ lock_sys_close(void)
 	mutex_free(&lock_sys->mutex);
 	mutex_free(&lock_sys->wait_mutex);
 
+	for (ulint i = 0; i < LOCK_SYS_N_REC_MUTEXES; i++) {
+		mutex_free(&lock_sys->rec_mutexes[i]);
+	}
+
+	mem_free(lock_sys->rec_mutexes);
+
+	for (ulint i = 0; i < LOCK_SYS_N_TABLE_MUTEXES; i++) {
+		mutex_free(&lock_sys->table_mutexes[i]);
+	}
+
+	mem_free(lock_sys->table_mutexes);
+
 	os_event_free(lock_sys->timeout_event);
 
 	for (srv_slot_t* slot = lock_sys->waiting_threads;
@@ -797,11 +986,12 @@ lock_is_table_exclusive(
 {
 	const lock_t*	lock;
 	ibool		ok	= FALSE;
+	ib_mutex_t*	mutex	= lock_table_get_mutex(table);
 
 	ut_ad(table);
 	ut_ad(trx);
 
-	lock_mutex_enter();
+	mutex_enter(mutex);
 
 	for (lock = UT_LIST_GET_FIRST(table->locks);
 	     lock != NULL;
@@ -834,7 +1024,7 @@ not_ok:
 	}
 
 func_exit:
-	lock_mutex_exit();
+	mutex_exit(mutex);
 
 	return(ok);
 }
@@ -1166,8 +1356,8 @@ lock_rec_get_next_on_page_const(
 	ulint	space;
 	ulint	page_no;
 
-	ut_ad(lock_mutex_own());
 	ut_ad(lock_get_type_low(lock) == LOCK_REC);
+	ut_ad(mutex_own(lock_get_mutex(lock)));
 
 	space = lock->un_member.rec_lock.space;
 	page_no = lock->un_member.rec_lock.page_no;
@@ -1215,7 +1405,7 @@ lock_rec_get_first_on_page_addr(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_rec_get_mutex(space, page_no)));
 
 	for (lock = static_cast<lock_t*>(
 			HASH_GET_FIRST(lock_sys->rec_hash,
@@ -1243,11 +1433,12 @@ lock_rec_expl_exist_on_page(
 	ulint	space,	/*!< in: space id */
 	ulint	page_no)/*!< in: page number */
 {
-	lock_t*	lock;
+	lock_t*		lock;
+	ib_mutex_t*	mutex = lock_rec_get_mutex(space, page_no);
 
-	lock_mutex_enter();
+	mutex_enter(mutex);
 	lock = lock_rec_get_first_on_page_addr(space, page_no);
-	lock_mutex_exit();
+	mutex_exit(mutex);
 
 	return(lock);
 }
@@ -1267,10 +1458,10 @@ lock_rec_get_first_on_page(
 	ulint	space	= buf_block_get_space(block);
 	ulint	page_no	= buf_block_get_page_no(block);
 
-	ut_ad(lock_mutex_own());
-
 	hash = buf_block_get_lock_hash_val(block);
 
+	ut_ad(mutex_own(lock_rec_hash_get_mutex(hash)));
+
 	for (lock = static_cast<lock_t*>(
 			HASH_GET_FIRST( lock_sys->rec_hash, hash));
 	     lock != NULL;
@@ -1286,6 +1477,28 @@ lock_rec_get_first_on_page(
 	return(lock);
 }
 
+/*********************************************************************//**
+Determines if there are explicit record locks on a page that the caller
+has latched. While the page is latched, locks on it can be released but
+not created. If there are none, the page can be changed without
+updating the lock table, and without acquiring lock_sys->mutex.
+@return	true if there are record locks on the page */
+static
+bool
+lock_rec_block_has_locks(
+/*=====================*/
+	const buf_block_t*	block)	/*!< in: latched buffer block */
+{
+	ib_mutex_t*	mutex = lock_rec_block_get_mutex(block);
+	bool		has_locks;
+
+	mutex_enter(mutex);
+	has_locks = lock_rec_get_first_on_page(block) != NULL;
+	mutex_exit(mutex);
+
+	return(has_locks);
+}
+
 /*********************************************************************//**
 Gets the next explicit lock request on a record.
 @return	next lock, NULL if none exists or if heap_no == ULINT_UNDEFINED */
@@ -1296,7 +1509,7 @@ lock_rec_get_next(
 	ulint	heap_no,/*!< in: heap number of the record */
 	lock_t*	lock)	/*!< in: lock */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_get_mutex(lock)));
 
 	do {
 		ut_ad(lock_get_type_low(lock) == LOCK_REC);
@@ -1331,7 +1544,7 @@ lock_rec_get_first(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_rec_block_get_mutex(block)));
 
 	for (lock = lock_rec_get_first_on_page(block); lock;
 	     lock = lock_rec_get_next_on_page(lock)) {
@@ -1498,7 +1711,7 @@ lock_rec_has_expl(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_rec_block_get_mutex(block)));
 	ut_ad((precise_mode & LOCK_MODE_MASK) == LOCK_S
 	      || (precise_mode & LOCK_MODE_MASK) == LOCK_X);
 	ut_ad(!(precise_mode & LOCK_INSERT_INTENTION));
@@ -1550,7 +1763,7 @@ lock_rec_other_has_expl_req(
 {
 	const lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_rec_block_get_mutex(block)));
 	ut_ad(mode == LOCK_X || mode == LOCK_S);
 	ut_ad(gap == 0 || gap == LOCK_GAP);
 	ut_ad(wait == 0 || wait == LOCK_WAIT);
@@ -1594,7 +1807,7 @@ lock_rec_other_has_conflicting(
 	const lock_t*		lock;
 	ibool			is_supremum;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_rec_block_get_mutex(block)));
 
 	is_supremum = (heap_no == PAGE_HEAP_NO_SUPREMUM);
 
@@ -1624,7 +1837,7 @@ lock_rec_find_similar_on_page(
 	lock_t*		lock,		/*!< in: lock_rec_get_first_on_page() */
 	const trx_t*	trx)		/*!< in: transaction */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock == NULL || mutex_own(lock_get_mutex(lock)));
 
 	for (/* No op */;
 	     lock != NULL;
@@ -1822,7 +2035,7 @@ lock_rec_create(
 	ulint		n_bytes;
 	const page_t*	page;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_rec_block_get_mutex(block)));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1870,14 +2083,14 @@ lock_rec_create(
 	/* Set the bit corresponding to rec */
 	lock_rec_set_nth_bit(lock, heap_no);
 
-	index->table->n_rec_locks++;
+	os_atomic_increment_ulint(&index->table->n_rec_locks, 1);
 
 	ut_ad(index->table->n_ref_count > 0 || !index->table->can_be_evicted);
 
 	HASH_INSERT(lock_t, hash, lock_sys->rec_hash,
 		    lock_rec_fold(space, page_no), lock);
 
-	lock_sys->rec_num++;
+	os_atomic_increment_ulint(&lock_sys->rec_num, 1);
 
 	if (!caller_owns_trx_mutex) {
 		trx_mutex_enter(trx);
@@ -1895,8 +2108,8 @@ lock_rec_create(
 		trx_mutex_exit(trx);
 	}
 
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return(lock);
 }
@@ -2058,7 +2271,7 @@ lock_rec_add_to_queue(
 	lock_t*	lock;
 	lock_t*	first_lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_rec_block_get_mutex(block)));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index)
 	      || dict_index_get_online_status(index) != ONLINE_INDEX_CREATION);
@@ -2173,7 +2386,7 @@ lock_rec_lock_fast(
 	trx_t*			trx;
 	enum lock_rec_req_status status = LOCK_REC_SUCCESS;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_rec_block_get_mutex(block)));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2251,7 +2464,7 @@ lock_rec_lock_slow(
 	trx_t*			trx;
 	dberr_t			err = DB_SUCCESS;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_rec_block_get_mutex(block)));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2305,7 +2518,9 @@ Tries to lock the specified record in the mode requested. If not immediately
 possible, enqueues a waiting lock request. This is a low-level function
 which does NOT look at implicit locks! Checks lock compatibility within
 explicit locks. This function sets a normal next-key lock, or in the case
-of a page supremum record, a gap type lock.
+of a page supremum record, a gap type lock. The lock is granted while
+holding only the lock_sys partition mutex of the page; lock_sys->mutex is
+acquired only if the request has to wait.
 @return	DB_SUCCESS, DB_SUCCESS_LOCKED_REC, DB_LOCK_WAIT, DB_DEADLOCK,
 or DB_QUE_THR_SUSPENDED */
 static
@@ -2325,7 +2540,11 @@ lock_rec_lock(
 	dict_index_t*		index,	/*!< in: index of record */
 	que_thr_t*		thr)	/*!< in: query thread */
 {
-	ut_ad(lock_mutex_own());
+	ib_mutex_t*	mutex = lock_rec_block_get_mutex(block);
+	const trx_t*	trx = thr_get_trx(thr);
+	dberr_t		err;
+
+	ut_ad(!lock_mutex_own());
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2337,20 +2556,51 @@ lock_rec_lock(
 	      || mode - (LOCK_MODE_MASK & mode) == 0);
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
+	mutex_enter(mutex);
+
 	/* We try a simplified and faster subroutine for the most
 	common cases */
 	switch (lock_rec_lock_fast(impl, mode, block, heap_no, index, thr)) {
 	case LOCK_REC_SUCCESS:
+		mutex_exit(mutex);
 		return(DB_SUCCESS);
 	case LOCK_REC_SUCCESS_CREATED:
+		mutex_exit(mutex);
 		return(DB_SUCCESS_LOCKED_REC);
 	case LOCK_REC_FAIL:
-		return(lock_rec_lock_slow(impl, mode, block,
-					  heap_no, index, thr));
+		break;
 	}
 
-	ut_error;
-	return(DB_ERROR);
+	if (lock_rec_has_expl(mode, block, heap_no, trx->id)
+	    || !lock_rec_other_has_conflicting(
+		    static_cast<enum lock_mode>(mode),
+		    block, heap_no, trx)) {
+
+		/* The lock can be granted without waiting, and
+		nobody can enqueue a conflicting request while we
+		hold the partition mutex. */
+
+		err = lock_rec_lock_slow(impl, mode, block,
+					 heap_no, index, thr);
+
+		mutex_exit(mutex);
+
+		return(err);
+	}
+
+	mutex_exit(mutex);
+
+	/* We may have to wait. Enqueueing a waiting request and the
+	deadlock check require the whole lock system. The queue may
+	have changed in between, so start over. */
+
+	lock_mutex_enter();
+
+	err = lock_rec_lock_slow(impl, mode, block, heap_no, index, thr);
+
+	lock_mutex_exit();
+
+	return(err);
 }
 
 /*********************************************************************//**
@@ -2506,8 +2756,8 @@ lock_rec_dequeue_from_page(
 	lock_t*		lock;
 	trx_lock_t*	trx_lock;
 
-	ut_ad(lock_mutex_own());
 	ut_ad(lock_get_type_low(in_lock) == LOCK_REC);
+	ut_ad(mutex_own(lock_get_mutex(in_lock)));
 	/* We may or may not be holding in_lock->trx->mutex here. */
 
 	trx_lock = &in_lock->trx->lock;
@@ -2515,16 +2765,16 @@ lock_rec_dequeue_from_page(
 	space = in_lock->un_member.rec_lock.space;
 	page_no = in_lock->un_member.rec_lock.page_no;
 
-	in_lock->index->table->n_rec_locks--;
+	os_atomic_decrement_ulint(&in_lock->index->table->n_rec_locks, 1);
 
 	HASH_DELETE(lock_t, hash, lock_sys->rec_hash,
 		    lock_rec_fold(space, page_no), in_lock);
-	lock_sys->rec_num--;
+	os_atomic_decrement_ulint(&lock_sys->rec_num, 1);
 
 	UT_LIST_REMOVE(trx_locks, trx_lock->trx_locks, in_lock);
 
-	MONITOR_INC(MONITOR_RECLOCK_REMOVED);
-	MONITOR_DEC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_REMOVED);
+	MONITOR_ATOMIC_DEC(MONITOR_NUM_RECLOCK);
 
 	/* Check if waiting locks in the queue can now be granted: grant
 	locks if there are no conflicting locks ahead. Stop at the first
@@ -2558,24 +2808,24 @@ lock_rec_discard(
 	ulint		page_no;
 	trx_lock_t*	trx_lock;
 
-	ut_ad(lock_mutex_own());
 	ut_ad(lock_get_type_low(in_lock) == LOCK_REC);
+	ut_ad(mutex_own(lock_get_mutex(in_lock)));
 
 	trx_lock = &in_lock->trx->lock;
 
 	space = in_lock->un_member.rec_lock.space;
 	page_no = in_lock->un_member.rec_lock.page_no;
 
-	in_lock->index->table->n_rec_locks--;
+	os_atomic_decrement_ulint(&in_lock->index->table->n_rec_locks, 1);
 
 	HASH_DELETE(lock_t, hash, lock_sys->rec_hash,
 		    lock_rec_fold(space, page_no), in_lock);
-	lock_sys->rec_num--;
+	os_atomic_decrement_ulint(&lock_sys->rec_num, 1);
 
 	UT_LIST_REMOVE(trx_locks, trx_lock->trx_locks, in_lock);
 
-	MONITOR_INC(MONITOR_RECLOCK_REMOVED);
-	MONITOR_DEC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_REMOVED);
+	MONITOR_ATOMIC_DEC(MONITOR_NUM_RECLOCK);
 }
 
 /*************************************************************//**
@@ -2708,6 +2958,11 @@ lock_rec_inherit_to_gap_if_gap_lock(
 {
 	lock_t*	lock;
 
+	if (!lock_rec_block_has_locks(block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	for (lock = lock_rec_get_first(block, heap_no);
@@ -2794,6 +3049,11 @@ lock_move_reorganize_page(
 	mem_heap_t*	heap		= NULL;
 	ulint		comp;
 
+	if (!lock_rec_block_has_locks(block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	lock = lock_rec_get_first_on_page(block);
@@ -2938,6 +3198,11 @@ lock_move_rec_list_end(
 	lock_t*		lock;
 	const ulint	comp	= page_rec_is_comp(rec);
 
+	if (!lock_rec_block_has_locks(block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	/* Note: when we move locks from record to record, waiting locks
@@ -3037,6 +3302,11 @@ lock_move_rec_list_start(
 	ut_ad(block->frame == page_align(rec));
 	ut_ad(new_block->frame == page_align(old_end));
 
+	if (!lock_rec_block_has_locks(block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	for (lock = lock_rec_get_first_on_page(block); lock;
@@ -3132,6 +3402,12 @@ lock_update_split_right(
 {
 	ulint	heap_no = lock_get_min_heap_no(right_block);
 
+	if (!lock_rec_block_has_locks(left_block)
+	    && !lock_rec_block_has_locks(right_block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	/* Move the locks on the supremum of the left page to the supremum
@@ -3165,6 +3441,11 @@ lock_update_merge_right(
 						page which will be
 						discarded */
 {
+	if (!lock_rec_block_has_locks(left_block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	/* Inherit the locks from the supremum of the left page to the
@@ -3200,6 +3481,11 @@ lock_update_root_raise(
 	const buf_block_t*	block,	/*!< in: index page to which copied */
 	const buf_block_t*	root)	/*!< in: root page */
 {
+	if (!lock_rec_block_has_locks(root)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	/* Move the locks on the supremum of the root to the supremum
@@ -3222,6 +3508,11 @@ lock_update_copy_and_discard(
 	const buf_block_t*	block)		/*!< in: index page;
 						NOT the root! */
 {
+	if (!lock_rec_block_has_locks(block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	/* Move the locks on the supremum of the old page to the supremum
@@ -3245,6 +3536,11 @@ lock_update_split_left(
 {
 	ulint	heap_no = lock_get_min_heap_no(right_block);
 
+	if (!lock_rec_block_has_locks(right_block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	/* Inherit the locks to the supremum of the left page from the
@@ -3274,6 +3570,12 @@ lock_update_merge_left(
 
 	ut_ad(left_block->frame == page_align(orig_pred));
 
+	if (!lock_rec_block_has_locks(left_block)
+	    && !lock_rec_block_has_locks(right_block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	left_next_rec = page_rec_get_next_const(orig_pred);
@@ -3323,6 +3625,12 @@ lock_rec_reset_and_inherit_gap_locks(
 	ulint			heap_no)	/*!< in: heap_no of the
 						donating record */
 {
+	if (!lock_rec_block_has_locks(heir_block)
+	    && !lock_rec_block_has_locks(block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	lock_rec_reset_and_release_wait(heir_block, heir_heap_no);
@@ -3349,16 +3657,14 @@ lock_update_discard(
 	const rec_t*	rec;
 	ulint		heap_no;
 
-	lock_mutex_enter();
-
-	if (!lock_rec_get_first_on_page(block)) {
+	if (!lock_rec_block_has_locks(block)) {
 		/* No locks exist on page, nothing to do */
 
-		lock_mutex_exit();
-
 		return;
 	}
 
+	lock_mutex_enter();
+
 	/* Inherit all the locks on the page to the record and reset all
 	the locks on the page */
 
@@ -3453,6 +3759,11 @@ lock_update_delete(
 								       FALSE));
 	}
 
+	if (!lock_rec_block_has_locks(block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	/* Let the next record inherit the locks from rec, in gap mode */
@@ -3488,6 +3799,11 @@ lock_rec_store_on_page_infimum(
 
 	ut_ad(block->frame == page_align(rec));
 
+	if (!lock_rec_block_has_locks(block)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	lock_rec_move(block, block, PAGE_HEAP_NO_INFIMUM, heap_no);
@@ -3513,6 +3829,11 @@ lock_rec_restore_from_page_infimum(
 {
 	ulint	heap_no = page_rec_get_heap_no(rec);
 
+	if (!lock_rec_block_has_locks(donator)) {
+
+		return;
+	}
+
 	lock_mutex_enter();
 
 	lock_rec_move(block, donator, heap_no, PAGE_HEAP_NO_INFIMUM);
@@ -4095,7 +4416,7 @@ lock_table_create(
 	lock_t*	lock;
 
 	ut_ad(table && trx);
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_table_get_mutex(table)));
 	ut_ad(trx_mutex_own(trx));
 
 	/* Non-locking autocommit read-only transactions should not set
@@ -4138,8 +4459,8 @@ lock_table_create(
 
 	ib_vector_push(lock->trx->lock.table_locks, &lock);
 
-	MONITOR_INC(MONITOR_TABLELOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_TABLELOCK);
+	MONITOR_ATOMIC_INC(MONITOR_TABLELOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_TABLELOCK);
 
 	return(lock);
 }
@@ -4234,11 +4555,11 @@ lock_table_remove_low(
 	trx_t*		trx;
 	dict_table_t*	table;
 
-	ut_ad(lock_mutex_own());
-
 	trx = lock->trx;
 	table = lock->un_member.tab_lock.table;
 
+	ut_ad(mutex_own(lock_table_get_mutex(table)));
+
 	/* Remove the table from the transaction's AUTOINC vector, if
 	the lock that is being released is an AUTOINC lock. */
 	if (lock_get_mode(lock) == LOCK_AUTO_INC) {
@@ -4271,8 +4592,8 @@ lock_table_remove_low(
 	UT_LIST_REMOVE(trx_locks, trx->lock.trx_locks, lock);
 	UT_LIST_REMOVE(un_member.tab_lock.locks, table->locks, lock);
 
-	MONITOR_INC(MONITOR_TABLELOCK_REMOVED);
-	MONITOR_DEC(MONITOR_NUM_TABLELOCK);
+	MONITOR_ATOMIC_INC(MONITOR_TABLELOCK_REMOVED);
+	MONITOR_ATOMIC_DEC(MONITOR_NUM_TABLELOCK);
 }
 
 /*********************************************************************//**
@@ -4399,7 +4720,7 @@ lock_table_other_has_incompatible(
 {
 	const lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(lock_table_get_mutex(table)));
 
 	for (lock = UT_LIST_GET_LAST(table->locks);
 	     lock != NULL;
@@ -4434,6 +4755,7 @@ lock_table(
 	trx_t*		trx;
 	dberr_t		err;
 	const lock_t*	wait_for;
+	ib_mutex_t*	mutex;
 
 	ut_ad(table != NULL);
 	ut_ad(thr != NULL);
@@ -4461,6 +4783,32 @@ lock_table(
 		return(DB_SUCCESS);
 	}
 
+	/* If no other transaction has an incompatible request, the lock
+	can be granted while holding only the partition mutex of the
+	table. AUTO_INC locks are always handled under lock_sys->mutex. */
+
+	if (mode != LOCK_AUTO_INC) {
+		mutex = lock_table_get_mutex(table);
+
+		mutex_enter(mutex);
+
+		if (!lock_table_other_has_incompatible(
+			    trx, LOCK_WAIT, table, mode)) {
+
+			trx_mutex_enter(trx);
+
+			lock_table_create(table, mode | flags, trx);
+
+			trx_mutex_exit(trx);
+
+			mutex_exit(mutex);
+
+			return(DB_SUCCESS);
+		}
+
+		mutex_exit(mutex);
+	}
+
 	lock_mutex_enter();
 
 	/* We have to check if the new lock is compatible with any locks
@@ -4564,8 +4912,8 @@ lock_table_dequeue(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
 	ut_a(lock_get_type_low(in_lock) == LOCK_TABLE);
+	ut_ad(mutex_own(lock_get_mutex(in_lock)));
 
 	lock = UT_LIST_GET_NEXT(un_member.tab_lock.locks, in_lock);
 
@@ -4609,6 +4957,7 @@ lock_rec_unlock(
 	ulint		heap_no;
 	const char*	stmt;
 	size_t		stmt_len;
+	ib_mutex_t*	mutex;
 
 	ut_ad(trx);
 	ut_ad(rec);
@@ -4618,7 +4967,25 @@ lock_rec_unlock(
 
 	heap_no = page_rec_get_heap_no(rec);
 
-	lock_mutex_enter();
+	/* Unless somebody is waiting for a lock on the record, no lock
+	can be granted and the partition mutex of the page suffices. */
+
+	mutex = lock_rec_block_get_mutex(block);
+
+	mutex_enter(mutex);
+
+	for (lock = lock_rec_get_first(block, heap_no); lock != NULL;
+	     lock = lock_rec_get_next(heap_no, lock)) {
+
+		if (lock_get_wait(lock)) {
+			mutex_exit(mutex);
+			mutex = NULL;
+
+			lock_mutex_enter();
+			break;
+		}
+	}
+
 	trx_mutex_enter(trx);
 
 	first_lock = lock_rec_get_first(block, heap_no);
@@ -4633,7 +5000,12 @@ lock_rec_unlock(
 		}
 	}
 
-	lock_mutex_exit();
+	if (mutex == NULL) {
+		lock_mutex_exit();
+	} else {
+		mutex_exit(mutex);
+	}
+
 	trx_mutex_exit(trx);
 
 	stmt = innobase_get_stmt(trx->mysql_thd, &stmt_len);
@@ -4665,90 +5037,198 @@ released:
 		}
 	}
 
-	lock_mutex_exit();
+	if (mutex == NULL) {
+		lock_mutex_exit();
+	} else {
+		mutex_exit(mutex);
+	}
+
 	trx_mutex_exit(trx);
 }
 
+/*********************************************************************//**
+Checks if releasing a lock can grant lock requests of other transactions,
+which requires lock_sys->mutex. AUTO_INC locks are always released under
+lock_sys->mutex.
+@return true if the lock must be released under lock_sys->mutex */
+static
+bool
+lock_release_needs_lock_sys(
+/*========================*/
+	const lock_t*	lock)	/*!< in: record or table lock */
+{
+	const lock_t*	other;
+
+	ut_ad(mutex_own(lock_get_mutex(lock)));
+
+	if (lock_get_type_low(lock) == LOCK_REC) {
+
+		for (other = lock_rec_get_first_on_page_addr(
+			     lock->un_member.rec_lock.space,
+			     lock->un_member.rec_lock.page_no);
+		     other != NULL;
+		     other = lock_rec_get_next_on_page_const(other)) {
+
+			if (lock_get_wait(other)) {
+
+				return(true);
+			}
+		}
+
+		return(false);
+	}
+
+	if (lock_get_mode(lock) == LOCK_AUTO_INC) {
+
+		return(true);
+	}
+
+	for (other = UT_LIST_GET_FIRST(lock->un_member.tab_lock.table->locks);
+	     other != NULL;
+	     other = UT_LIST_GET_NEXT(un_member.tab_lock.locks, other)) {
+
+		if (lock_get_wait(other)) {
+
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/*********************************************************************//**
+Releases a lock of a committing transaction, and grants locks to other
+transactions waiting in the queue if they now are entitled to a lock. The
+caller must own lock_sys->mutex, or the partition mutex of the lock if
+lock_release_needs_lock_sys() does not hold. */
+static
+void
+lock_release_low(
+/*=============*/
+	trx_t*		trx,		/*!< in/out: transaction */
+	lock_t*		lock,		/*!< in/out: lock to release */
+	trx_id_t	max_trx_id)	/*!< in: trx_sys_get_max_trx_id() */
+{
+	ut_ad(mutex_own(lock_get_mutex(lock)));
+	ut_ad(lock->trx == trx);
+
+	if (lock_get_type_low(lock) == LOCK_REC) {
+
+#ifdef UNIV_DEBUG
+		/* Check if the transcation locked a record
+		in a system table in X mode. It should have set
+		the dict_op code correctly if it did. */
+		if (lock->index->table->id < DICT_HDR_FIRST_ID
+		    && lock_get_mode(lock) == LOCK_X) {
+
+			ut_ad(lock_get_mode(lock) != LOCK_IX);
+			ut_ad(trx->dict_operation != TRX_DICT_OP_NONE);
+		}
+#endif /* UNIV_DEBUG */
+
+		lock_rec_dequeue_from_page(lock);
+	} else {
+		dict_table_t*	table;
+
+		table = lock->un_member.tab_lock.table;
+#ifdef UNIV_DEBUG
+		ut_ad(lock_get_type_low(lock) & LOCK_TABLE);
+
+		/* Check if the transcation locked a system table
+		in IX mode. It should have set the dict_op code
+		correctly if it did. */
+		if (table->id < DICT_HDR_FIRST_ID
+		    && (lock_get_mode(lock) == LOCK_X
+			|| lock_get_mode(lock) == LOCK_IX)) {
+
+			ut_ad(trx->dict_operation != TRX_DICT_OP_NONE);
+		}
+#endif /* UNIV_DEBUG */
+
+		if (lock_get_mode(lock) != LOCK_IS
+		    && trx->undo_no != 0) {
+
+			/* The trx may have modified the table. We
+			block the use of the MySQL query cache for
+			all currently active transactions. */
+
+			table->query_cache_inv_trx_id = max_trx_id;
+		}
+
+		lock_table_dequeue(lock);
+	}
+}
+
 /*********************************************************************//**
 Releases transaction locks, and releases possible other transactions waiting
-because of these locks. */
+because of these locks. The locks that nobody is waiting for are released
+while holding only their lock_sys partition mutex; the rest are released
+under lock_sys->mutex. */
 static
 void
 lock_release(
 /*=========*/
-	trx_t*	trx)	/*!< in/out: transaction */
+	trx_t*		trx,	/*!< in/out: transaction */
+	ib_mutex_t*	mutex)	/*!< in: lock_sys partition mutex owned
+				by the caller; released here */
 {
 	lock_t*		lock;
 	ulint		count = 0;
 	trx_id_t	max_trx_id;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(mutex_own(mutex));
+	ut_ad(!lock_mutex_own());
 	ut_ad(!trx_mutex_own(trx));
 
 	max_trx_id = trx_sys_get_max_trx_id();
 
-	for (lock = UT_LIST_GET_LAST(trx->lock.trx_locks);
-	     lock != NULL;
-	     lock = UT_LIST_GET_LAST(trx->lock.trx_locks)) {
-
-		if (lock_get_type_low(lock) == LOCK_REC) {
+	/* Only this thread and the holders of lock_sys->mutex modify
+	trx->lock.trx_locks now, and owning any partition mutex
+	excludes the latter. */
 
-#ifdef UNIV_DEBUG
-			/* Check if the transcation locked a record
-			in a system table in X mode. It should have set
-			the dict_op code correctly if it did. */
-			if (lock->index->table->id < DICT_HDR_FIRST_ID
-			    && lock_get_mode(lock) == LOCK_X) {
-
-				ut_ad(lock_get_mode(lock) != LOCK_IX);
-				ut_ad(trx->dict_operation != TRX_DICT_OP_NONE);
-			}
-#endif /* UNIV_DEBUG */
+	while ((lock = UT_LIST_GET_LAST(trx->lock.trx_locks)) != NULL) {
+		ib_mutex_t*	lock_mutex = lock_get_mutex(lock);
 
-			lock_rec_dequeue_from_page(lock);
-		} else {
-			dict_table_t*	table;
+		if (lock_mutex != mutex) {
+			mutex_exit(mutex);
+			mutex = lock_mutex;
+			mutex_enter(mutex);
+			continue;
+		}
 
-			table = lock->un_member.tab_lock.table;
-#ifdef UNIV_DEBUG
-			ut_ad(lock_get_type_low(lock) & LOCK_TABLE);
+		if (lock_release_needs_lock_sys(lock)) {
+			break;
+		}
 
-			/* Check if the transcation locked a system table
-			in IX mode. It should have set the dict_op code
-			correctly if it did. */
-			if (table->id < DICT_HDR_FIRST_ID
-			    && (lock_get_mode(lock) == LOCK_X
-				|| lock_get_mode(lock) == LOCK_IX)) {
+		lock_release_low(trx, lock, max_trx_id);
+	}
 
-				ut_ad(trx->dict_operation != TRX_DICT_OP_NONE);
-			}
-#endif /* UNIV_DEBUG */
+	mutex_exit(mutex);
 
-			if (lock_get_mode(lock) != LOCK_IS
-			    && trx->undo_no != 0) {
+	if (lock != NULL) {
+		lock_mutex_enter();
 
-				/* The trx may have modified the table. We
-				block the use of the MySQL query cache for
-				all currently active transactions. */
+		for (lock = UT_LIST_GET_LAST(trx->lock.trx_locks);
+		     lock != NULL;
+		     lock = UT_LIST_GET_LAST(trx->lock.trx_locks)) {
 
-				table->query_cache_inv_trx_id = max_trx_id;
-			}
+			lock_release_low(trx, lock, max_trx_id);
 
-			lock_table_dequeue(lock);
-		}
+			if (count == LOCK_RELEASE_INTERVAL) {
+				/* Release the  mutex for a while, so that we
+				do not monopolize it */
 
-		if (count == LOCK_RELEASE_INTERVAL) {
-			/* Release the  mutex for a while, so that we
-			do not monopolize it */
+				lock_mutex_exit();
 
-			lock_mutex_exit();
+				lock_mutex_enter();
 
-			lock_mutex_enter();
+				count = 0;
+			}
 
-			count = 0;
+			++count;
 		}
 
-		++count;
+		lock_mutex_exit();
 	}
 
 	/* We don't remove the locks one by one from the vector for
@@ -5650,7 +6130,8 @@ lock_rec_queue_validate(
 
 		ut_ad(lock_mutex_own());
 		/* trx_id cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys->mutex */
+		because lock_trx_release_locks() acquires a lock_sys
+		partition mutex */
 
 		if (trx_desc != NULL
 		    && lock_rec_other_has_expl_req(LOCK_S, 0, LOCK_WAIT,
@@ -5988,6 +6469,7 @@ lock_rec_insert_check_and_lock(
 	dberr_t		err;
 	ulint		next_rec_heap_no;
 	ibool		inherit_in = *inherit;
+	ib_mutex_t*	mutex;
 
 	ut_ad(block->frame == page_align(rec));
 	ut_ad(!dict_index_is_online_ddl(index)
@@ -6009,7 +6491,9 @@ lock_rec_insert_check_and_lock(
 	next_rec = page_rec_get_next_const(rec);
 	next_rec_heap_no = page_rec_get_heap_no(next_rec);
 
-	lock_mutex_enter();
+	mutex = lock_rec_block_get_mutex(block);
+
+	mutex_enter(mutex);
 	/* Because this code is invoked for a running transaction by
 	the thread that is serving the transaction, it is not necessary
 	to hold trx->mutex here. */
@@ -6024,7 +6508,7 @@ lock_rec_insert_check_and_lock(
 	if (UNIV_LIKELY(lock == NULL)) {
 		/* We optimize CPU time usage in the simplest case */
 
-		lock_mutex_exit();
+		mutex_exit(mutex);
 
 		if (inherit_in && !dict_index_is_clust(index)) {
 			/* Update the page max trx id field */
@@ -6050,24 +6534,42 @@ lock_rec_insert_check_and_lock(
 	had to wait for their insert. Both had waiting gap type lock requests
 	on the successor, which produced an unnecessary deadlock. */
 
-	if (lock_rec_other_has_conflicting(
+	if (!lock_rec_other_has_conflicting(
 		    static_cast<enum lock_mode>(
 			    LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION),
 		    block, next_rec_heap_no, trx)) {
 
-		/* Note that we may get DB_SUCCESS also here! */
-		trx_mutex_enter(trx);
-
-		err = lock_rec_enqueue_waiting(
-			LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION,
-			block, next_rec_heap_no, index, thr);
+		mutex_exit(mutex);
 
-		trx_mutex_exit(trx);
-	} else {
 		err = DB_SUCCESS;
-	}
+	} else {
+		mutex_exit(mutex);
 
-	lock_mutex_exit();
+		/* Enqueueing a waiting request and the deadlock check
+		require lock_sys->mutex. The conflicting lock may have
+		been released in between. */
+
+		lock_mutex_enter();
+
+		if (lock_rec_other_has_conflicting(
+			    static_cast<enum lock_mode>(
+				    LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION),
+			    block, next_rec_heap_no, trx)) {
+
+			/* Note that we may get DB_SUCCESS also here! */
+			trx_mutex_enter(trx);
+
+			err = lock_rec_enqueue_waiting(
+				LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION,
+				block, next_rec_heap_no, index, thr);
+
+			trx_mutex_exit(trx);
+		} else {
+			err = DB_SUCCESS;
+		}
+
+		lock_mutex_exit();
+	}
 
 	switch (err) {
 	case DB_SUCCESS_LOCKED_REC:
@@ -6159,7 +6661,8 @@ lock_rec_convert_impl_to_expl(
 		mutex_exit(&trx_sys->mutex);
 
 		/* trx_id cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys->mutex */
+		because lock_trx_release_locks() acquires a lock_sys
+		partition mutex */
 
 		if (impl_trx_desc != NULL
 		    && !lock_rec_has_expl(LOCK_X | LOCK_REC_NOT_GAP, block,
@@ -6228,16 +6731,12 @@ lock_clust_rec_modify_check_and_lock(
 
 	lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
@@ -6292,16 +6791,12 @@ lock_sec_rec_modify_check_and_lock(
 	index record, and this would not have been possible if another active
 	transaction had modified this secondary index record. */
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
 
 #ifdef UNIV_DEBUG
 	{
@@ -6400,8 +6895,6 @@ lock_sec_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
@@ -6410,9 +6903,7 @@ lock_sec_rec_read_check_and_lock(
 	err = lock_rec_lock(FALSE, mode | gap_mode,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
@@ -6481,8 +6972,6 @@ lock_clust_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
@@ -6491,9 +6980,7 @@ lock_clust_rec_read_check_and_lock(
 	err = lock_rec_lock(FALSE, mode | gap_mode,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
@@ -6919,6 +7406,8 @@ lock_trx_release_locks(
 /*===================*/
 	trx_t*	trx)	/*!< in/out: transaction */
 {
+	ib_mutex_t*	mutex;
+
 	assert_trx_in_list(trx);
 
 	if (trx_state_eq(trx, TRX_STATE_PREPARED)) {
@@ -6935,11 +7424,15 @@ lock_trx_release_locks(
 	}
 
 	/* The transition of trx->state to TRX_STATE_COMMITTED_IN_MEMORY
-	is protected by both the lock_sys->mutex and the trx->mutex.
+	is protected by both a lock_sys partition mutex, which excludes
+	the holders of lock_sys->mutex, and the trx->mutex.
 	We also lock trx_sys->mutex, because state transition to
 	TRX_STATE_COMMITTED_IN_MEMORY must be atomic with removing trx
 	from the descriptors array. */
-	lock_mutex_enter();
+	mutex = lock_sys->rec_mutexes
+		+ ut_2pow_remainder(trx->id, LOCK_SYS_N_REC_MUTEXES);
+
+	mutex_enter(mutex);
 	mutex_enter(&trx_sys->mutex);
 	trx_mutex_enter(trx);
 
@@ -6980,9 +7473,7 @@ lock_trx_release_locks(
 
 	mutex_exit(&trx_sys->mutex);
 
-	lock_release(trx);
-
-	lock_mutex_exit();
+	lock_release(trx, mutex);
 }
 
 /*********************************************************************//**
@@ -7028,12 +7519,13 @@ lock_table_get_n_locks(
 	const dict_table_t*	table)	/*!< in: table */
 {
 	ulint		n_table_locks;
+	ib_mutex_t*	mutex = lock_table_get_mutex(table);
 
-	lock_mutex_enter();
+	mutex_enter(mutex);
 
 	n_table_locks = UT_LIST_GET_LEN(table->locks);
 
-	lock_mutex_exit();
+	mutex_exit(mutex);
 
 	return(n_table_locks);
 }
@@ -7218,14 +7710,15 @@ lock_trx_has_rec_x_lock(
 		intention_lock = LOCK_IX;
 		rec_lock = LOCK_X;
 	}
-	lock_mutex_enter();
 	ut_a(lock_table_has(trx, table, intention_lock));
 	if (UNIV_LIKELY(srv_fake_changes_locks)) {
+		ib_mutex_t*	mutex = lock_rec_block_get_mutex(block);
 
+		mutex_enter(mutex);
 		ut_a(lock_rec_has_expl(rec_lock | LOCK_REC_NOT_GAP,
 				       block, heap_no, trx->id));
+		mutex_exit(mutex);
 	}
-	lock_mutex_exit();
 	return(true);
 }
 #endif /* UNIV_DEBUG */
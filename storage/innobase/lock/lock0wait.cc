@@ -90,15 +90,16 @@ lock_wait_table_release_slot(
 	lock mutex to change the state of the slot to free. This is by design,
 	because when we query the slot state we always hold both the lock and
 	trx_t::mutex. To reduce contention on the lock mutex when reserving the
-	slot we avoid acquiring the lock mutex. */
+	slot we avoid acquiring the lock mutex. No lock queue is accessed
+	here, so the lock_sys partition mutexes are not needed. */
 
-	lock_mutex_enter();
+	mutex_enter(&lock_sys->mutex);
 
 	slot->thr->slot = NULL;
 	slot->thr = NULL;
 	slot->in_use = FALSE;
 
-	lock_mutex_exit();
+	mutex_exit(&lock_sys->mutex);
 
 	/* Scan backwards and adjust the last free slot pointer. */
 	for (slot = lock_sys->last_slot;
@@ -268,13 +269,16 @@ lock_wait_suspend_thread(
 
 	ulint	lock_type = ULINT_UNDEFINED;
 
-	lock_mutex_enter();
+	/* trx->lock.wait_lock is only changed by the holders of
+	lock_sys->mutex, and the type of a lock never changes. */
+
+	mutex_enter(&lock_sys->mutex);
 
 	if (const lock_t* wait_lock = trx->lock.wait_lock) {
 		lock_type = lock_get_type_low(wait_lock);
 	}
 
-	lock_mutex_exit();
+	mutex_exit(&lock_sys->mutex);
 
 	had_dict_lock = trx->dict_operation_lock_mode;
 
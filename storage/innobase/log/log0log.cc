@@ -96,6 +96,11 @@ UNIV_INTERN mysql_pfs_key_t	log_sys_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	log_flush_order_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
+#ifdef UNIV_PFS_THREAD
+UNIV_INTERN mysql_pfs_key_t	log_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	log_flusher_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 #ifdef UNIV_DEBUG
 UNIV_INTERN ibool	log_do_write = TRUE;
 #endif /* UNIV_DEBUG */
@@ -165,6 +170,36 @@ log_io_complete_archive(void);
 /*=========================*/
 #endif /* UNIV_LOG_ARCHIVE */
 
+/****************************************************************//**
+Frees the slots of the mini-transactions that have added their dirty pages
+to the flush lists, in the order the slots were reserved.
+@return	start lsn of the oldest mini-transaction which may still have dirty
+pages outside the flush lists, or log_sys->lsn if none */
+static
+lsn_t
+log_closed_advance(void)
+/*====================*/
+{
+	log_t*	log	= log_sys;
+
+	ut_ad(mutex_own(&(log->mutex)));
+	ut_ad(srv_log_concurrent_mtr_commit);
+
+	while (log->closed_no < log->closed_next_no) {
+		log_closed_slot_t*	slot = &log->closed_slots[
+			log->closed_no % LOG_CLOSED_N_SLOTS];
+
+		if (!slot->closed) {
+
+			return(slot->start_lsn);
+		}
+
+		log->closed_no++;
+	}
+
+	return(log->lsn);
+}
+
 /****************************************************************//**
 Returns the oldest modified block lsn in the pool, or log_sys->lsn if none
 exists.
@@ -175,9 +210,19 @@ log_buf_pool_get_oldest_modification(void)
 /*======================================*/
 {
 	lsn_t	lsn;
+	lsn_t	closed_lsn	= LSN_MAX;
 
 	ut_ad(mutex_own(&(log_sys->mutex)));
 
+	if (srv_log_concurrent_mtr_commit) {
+		/* Mini-transactions add their dirty pages to the flush
+		lists after releasing the log mutex. Any page not yet there
+		was modified at or after closed_lsn. This must be determined
+		before looking at the flush lists. */
+		closed_lsn = log_closed_advance();
+		os_rmb;
+	}
+
 	lsn = buf_pool_get_oldest_modification();
 
 	if (!lsn) {
@@ -185,7 +230,35 @@ log_buf_pool_get_oldest_modification(void)
 		lsn = log_sys->lsn;
 	}
 
-	return(lsn);
+	return(ut_min(lsn, closed_lsn));
+}
+
+/****************************************************************//**
+Waits until the mini-transactions that have reserved space in the log
+buffer with log_reserve_low() have copied their log records there. The
+caller holds the log mutex, so no new reservations can be made. */
+static
+void
+log_wait_for_pending_copies(void)
+/*=============================*/
+{
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	if (!srv_log_concurrent_mtr_commit) {
+
+		return;
+	}
+
+	for (ulint i = 0; log_sys->n_pending_copies > 0; i++) {
+
+		if (i < srv_n_spin_wait_rounds) {
+			ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+		} else {
+			os_thread_yield();
+		}
+	}
+
+	os_rmb;
 }
 
 /****************************************************************//**
@@ -248,6 +321,8 @@ log_buffer_extend(
 
 	log_sys->is_extending = true;
 
+	log_wait_for_pending_copies();
+
 	while (log_sys->n_pending_writes != 0
 	       || ut_calc_align_down(log_sys->buf_free,
 				     OS_FILE_LOG_BLOCK_SIZE)
@@ -259,6 +334,8 @@ log_buffer_extend(
 		log_buffer_flush_to_disk();
 
 		mutex_enter(&(log_sys->mutex));
+
+		log_wait_for_pending_copies();
 	}
 
 	move_start = ut_calc_align_down(
@@ -345,6 +422,24 @@ loop:
 		goto loop;
 	}
 
+	if (srv_log_concurrent_mtr_commit) {
+		log_closed_advance();
+
+		if (log->closed_next_no - log->closed_no
+		    >= LOG_CLOSED_N_SLOTS) {
+
+			/* Too many mini-transactions are still adding
+			their pages to the flush lists */
+			mutex_exit(&(log->mutex));
+
+			os_thread_yield();
+
+			mutex_enter(&(log->mutex));
+
+			goto loop;
+		}
+	}
+
 	/* Calculate an upper limit for the space the string may take in the
 	log buffer */
 
@@ -416,14 +511,15 @@ loop:
 }
 
 /************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
-UNIV_INTERN
+Writes to the log the string given, or only reserves space for it and
+formats the log block headers if the string is NULL. It is assumed that the
+caller holds the log mutex. */
+static
 void
-log_write_low(
-/*==========*/
-	byte*	str,		/*!< in: string */
-	ulint	str_len)	/*!< in: string length */
+log_write_or_reserve_low(
+/*=====================*/
+	const byte*	str,		/*!< in: string, or NULL */
+	ulint		str_len)	/*!< in: string length */
 {
 	log_t*	log	= log_sys;
 	ulint	len;
@@ -450,10 +546,12 @@ part_loop:
 			- LOG_BLOCK_TRL_SIZE;
 	}
 
-	ut_memcpy(log->buf + log->buf_free, str, len);
+	if (str != NULL) {
+		ut_memcpy(log->buf + log->buf_free, str, len);
+		str = str + len;
+	}
 
 	str_len -= len;
-	str = str + len;
 
 	log_block = static_cast<byte*>(
 		ut_align_down(
@@ -487,6 +585,154 @@ part_loop:
 	srv_stats.log_write_requests.inc();
 }
 
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+UNIV_INTERN
+void
+log_write_low(
+/*==========*/
+	byte*	str,		/*!< in: string */
+	ulint	str_len)	/*!< in: string length */
+{
+	ut_ad(str != NULL);
+
+	log_write_or_reserve_low(str, str_len);
+}
+
+/************************************************************//**
+Reserves space in the log buffer for a string of the given length and
+formats the log block headers around it, but does not copy the string.
+It is assumed that the caller holds the log mutex. The string must then
+be copied with log_copy_low() and the copy completed with
+log_copy_complete(); this is only used if srv_log_concurrent_mtr_commit
+is set.
+@return	log buffer offset where the string should be copied */
+UNIV_INTERN
+ulint
+log_reserve_low(
+/*============*/
+	ulint	str_len)	/*!< in: string length */
+{
+	ulint	offset	= log_sys->buf_free;
+
+	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(srv_log_concurrent_mtr_commit);
+
+	os_atomic_increment_ulint(&log_sys->n_pending_copies, 1);
+
+	log_write_or_reserve_low(NULL, str_len);
+
+	return(offset);
+}
+
+/************************************************************//**
+Copies a string to log buffer space reserved with log_reserve_low().
+Does not need the log mutex. */
+UNIV_INTERN
+void
+log_copy_low(
+/*=========*/
+	ulint*		offset,	/*!< in/out: log buffer offset; advanced
+				past the copied string and any log block
+				trailers and headers it spans */
+	const byte*	str,	/*!< in: string */
+	ulint		str_len)/*!< in: string length */
+{
+	ut_ad(log_sys->n_pending_copies > 0);
+
+	while (str_len > 0) {
+		ulint	block_offset = *offset % OS_FILE_LOG_BLOCK_SIZE;
+		ulint	len;
+
+		ut_ad(block_offset >= LOG_BLOCK_HDR_SIZE);
+		ut_ad(block_offset < OS_FILE_LOG_BLOCK_SIZE
+		      - LOG_BLOCK_TRL_SIZE);
+
+		len = ut_min(str_len, OS_FILE_LOG_BLOCK_SIZE
+			     - LOG_BLOCK_TRL_SIZE - block_offset);
+
+		ut_memcpy(log_sys->buf + *offset, str, len);
+
+		str += len;
+		str_len -= len;
+		*offset += len;
+
+		if (block_offset + len
+		    == OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE) {
+			/* Skip the trailer of this block and the header
+			of the next one, formatted by log_reserve_low() */
+			*offset += LOG_BLOCK_TRL_SIZE + LOG_BLOCK_HDR_SIZE;
+		}
+	}
+
+	ut_ad(*offset <= log_sys->buf_size);
+}
+
+/************************************************************//**
+Marks a log buffer copy started with log_reserve_low() as completed, so
+that the log buffer may be written or moved. Does not need the log
+mutex. */
+UNIV_INTERN
+void
+log_copy_complete(void)
+/*===================*/
+{
+	ut_ad(log_sys->n_pending_copies > 0);
+
+	/* This is a full memory barrier: the copied log records are
+	visible to the thread that sees the decremented counter. */
+	os_atomic_decrement_ulint(&log_sys->n_pending_copies, 1);
+}
+
+/************************************************************//**
+Reserves a slot tracking a mini-transaction which will add dirty pages to
+the flush lists without holding log_flush_order_mutex. It is assumed that
+the caller holds the log mutex and that log_open() has been called after
+acquiring it, which guarantees that a slot is free.
+@return	slot number, to be passed to log_closed_release() */
+UNIV_INTERN
+ib_uint64_t
+log_closed_reserve(
+/*===============*/
+	lsn_t	start_lsn)	/*!< in: start lsn of the mini-transaction */
+{
+	log_t*			log	= log_sys;
+	ib_uint64_t		no;
+	log_closed_slot_t*	slot;
+
+	ut_ad(mutex_own(&(log->mutex)));
+	ut_ad(srv_log_concurrent_mtr_commit);
+	ut_a(log->closed_next_no - log->closed_no < LOG_CLOSED_N_SLOTS);
+
+	no = log->closed_next_no++;
+	slot = &log->closed_slots[no % LOG_CLOSED_N_SLOTS];
+
+	slot->start_lsn = start_lsn;
+	slot->closed = FALSE;
+
+	return(no);
+}
+
+/************************************************************//**
+Releases a slot reserved with log_closed_reserve() once the
+mini-transaction has added its dirty pages to the flush lists. Does not
+need the log mutex. */
+UNIV_INTERN
+void
+log_closed_release(
+/*===============*/
+	ib_uint64_t	no)	/*!< in: slot number */
+{
+	ut_ad(srv_log_concurrent_mtr_commit);
+
+	/* The flush list insertions must be visible before the slot is
+	seen as closed by log_closed_advance(). */
+	os_wmb;
+
+	log_sys->closed_slots[no % LOG_CLOSED_N_SLOTS].closed = TRUE;
+}
+
 /************************************************************//**
 Closes the log.
 @return	lsn */
@@ -593,8 +839,11 @@ log_close(void)
 function_exit:
 
 #ifdef UNIV_LOG_DEBUG
-	log_check_log_recs(log->buf + log->old_buf_free,
-			   log->buf_free - log->old_buf_free, log->old_lsn);
+	if (!srv_log_concurrent_mtr_commit) {
+		log_check_log_recs(log->buf + log->old_buf_free,
+				   log->buf_free - log->old_buf_free,
+				   log->old_lsn);
+	}
 #endif
 
 	return(lsn);
@@ -650,7 +899,7 @@ log_group_get_capacity(
 /*===================*/
 	const log_group_t*	group)	/*!< in: log group */
 {
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || recv_recovery_is_on());
 
 	return((group->file_size - LOG_FILE_HDR_SIZE) * group->n_files);
 }
@@ -667,7 +916,7 @@ log_group_calc_size_offset(
 					log group */
 	const log_group_t*	group)	/*!< in: log group */
 {
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || recv_recovery_is_on());
 
 	return(offset - LOG_FILE_HDR_SIZE * (1 + offset / group->file_size));
 }
@@ -684,7 +933,7 @@ log_group_calc_real_offset(
 					log group */
 	const log_group_t*	group)	/*!< in: log group */
 {
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || recv_recovery_is_on());
 
 	return(offset + LOG_FILE_HDR_SIZE
 	       * (1 + offset / (group->file_size - LOG_FILE_HDR_SIZE)));
@@ -706,7 +955,7 @@ log_group_calc_lsn_offset(
 	lsn_t	group_size;
 	lsn_t	offset;
 
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || recv_recovery_is_on());
 
 	gr_lsn = group->lsn;
 
@@ -941,6 +1190,17 @@ log_init(void)
 	log_sys->buf_size = LOG_BUFFER_SIZE;
 	log_sys->is_extending = false;
 
+	log_sys->n_pending_copies = 0;
+	log_sys->closed_slots = NULL;
+	log_sys->closed_no = 0;
+	log_sys->closed_next_no = 0;
+
+	if (srv_log_concurrent_mtr_commit) {
+		log_sys->closed_slots = static_cast<log_closed_slot_t*>(
+			mem_zalloc(LOG_CLOSED_N_SLOTS
+				   * sizeof *log_sys->closed_slots));
+	}
+
 	log_sys->max_buf_free = log_sys->buf_size / LOG_BUF_FLUSH_RATIO
 		- LOG_BUF_FLUSH_MARGIN;
 	log_sys->check_flush_or_checkpoint = TRUE;
@@ -971,6 +1231,23 @@ log_init(void)
 
 	os_event_set(log_sys->one_flushed_event);
 
+	log_sys->writer_event = os_event_create();
+	log_sys->flusher_event = os_event_create();
+	log_sys->flush_events = NULL;
+	log_sys->flush_requested = FALSE;
+	log_sys->writer_is_active = false;
+	log_sys->flusher_is_active = false;
+
+	if (srv_log_writer_threads) {
+		log_sys->flush_events = static_cast<os_event_t*>(
+			mem_alloc(LOG_FLUSH_EVENTS_N
+				  * sizeof *log_sys->flush_events));
+
+		for (ulint i = 0; i < LOG_FLUSH_EVENTS_N; i++) {
+			log_sys->flush_events[i] = os_event_create();
+		}
+	}
+
 	/*----------------------------*/
 
 	log_sys->next_checkpoint_no = 0;
@@ -1211,6 +1488,8 @@ log_sys_check_flush_completion(void)
 			/* Move the log buffer content to the start of the
 			buffer */
 
+			log_wait_for_pending_copies();
+
 			move_start = ut_calc_align_down(
 				log_sys->write_end_offset,
 				OS_FILE_LOG_BLOCK_SIZE);
@@ -1500,14 +1779,13 @@ loop:
 }
 
 /******************************************************//**
-This function is called, e.g., when a transaction wants to commit. It checks
-that the log has been written to the log file up to the last log entry written
-by the transaction. If there is a flush running, it waits and checks if the
-flush flushed enough. If not, starts a new flush. */
-UNIV_INTERN
+Writes the log buffer to the log files up to an lsn, and flushes them to disk
+if requested. If there is a flush running, it waits and checks if the flush
+flushed enough. If not, starts a new flush. */
+static
 void
-log_write_up_to(
-/*============*/
+log_write_up_to_low(
+/*================*/
 	lsn_t	lsn,	/*!< in: log sequence number up to which
 			the log should be written,
 			LSN_MAX if not specified */
@@ -1599,6 +1877,8 @@ loop:
 		goto loop;
 	}
 
+	log_wait_for_pending_copies();
+
 	if (!flush_to_disk
 	    && log_sys->buf_free == log_sys->buf_next_to_write) {
 		/* Nothing to write and no flush to disk requested */
@@ -1732,6 +2012,327 @@ do_waits:
 	}
 }
 
+/******************************************************//**
+Checks whether the log has been written, or written and flushed to disk, up
+to an lsn.
+@return true if it has */
+static inline
+bool
+log_write_is_done(
+/*==============*/
+	lsn_t	lsn,		/*!< in: log sequence number */
+	ibool	flush_to_disk)	/*!< in: TRUE if the log must also be
+				flushed to disk */
+{
+	os_rmb;
+
+	return(flush_to_disk
+	       ? log_sys->flushed_to_disk_lsn >= lsn
+	       : log_sys->written_to_all_lsn >= lsn);
+}
+
+/******************************************************//**
+Checks whether the threads that would write, and if requested flush, the
+log on behalf of log_write_up_to() callers are running.
+@return true if they are */
+static inline
+bool
+log_writer_threads_are_active(
+/*==========================*/
+	ibool	flush_to_disk)	/*!< in: TRUE if the log must also be
+				flushed to disk */
+{
+	return(srv_log_writer_threads
+	       && log_sys->writer_is_active
+	       && (!flush_to_disk || log_sys->flusher_is_active));
+}
+
+/******************************************************//**
+Wakes up the threads waiting in log_wait_for_writer_threads() for an lsn
+that has been written or flushed to disk.  */
+static
+void
+log_notify_waiters(
+/*===============*/
+	lsn_t	old_lsn,	/*!< in: lsn written or flushed before */
+	lsn_t	new_lsn)	/*!< in: lsn written or flushed now */
+{
+	ulint	n = 0;
+
+	for (lsn_t lsn = ut_uint64_align_down(old_lsn, OS_FILE_LOG_BLOCK_SIZE);
+	     lsn <= new_lsn && n < LOG_FLUSH_EVENTS_N;
+	     lsn += OS_FILE_LOG_BLOCK_SIZE, n++) {
+
+		os_event_set(log_sys->flush_events[
+			(lsn / OS_FILE_LOG_BLOCK_SIZE) % LOG_FLUSH_EVENTS_N]);
+	}
+}
+
+/******************************************************//**
+Waits for log_writer_thread, and log_flusher_thread if requested, to write
+the log up to an lsn. Spins briefly, then sleeps on the event selected by
+the lsn, so that the writer threads only wake up the threads whose lsn
+they have reached.
+@return false if the threads are not running, and the caller must write the
+log itself */
+static
+bool
+log_wait_for_writer_threads(
+/*========================*/
+	lsn_t	lsn,		/*!< in: log sequence number up to which
+				the log should be written, LSN_MAX if not
+				specified */
+	ulint	wait,		/*!< in: LOG_NO_WAIT, LOG_WAIT_ONE_GROUP,
+				or LOG_WAIT_ALL_GROUPS */
+	ibool	flush_to_disk)	/*!< in: TRUE if we want the written log
+				also to be flushed to disk */
+{
+	os_event_t	event;
+
+	if (!log_writer_threads_are_active(flush_to_disk)) {
+
+		return(false);
+	}
+
+	if (lsn == LSN_MAX) {
+		lsn = log_get_lsn();
+	}
+
+	if (log_write_is_done(lsn, flush_to_disk)) {
+
+		return(true);
+	}
+
+	if (flush_to_disk) {
+		log_sys->flush_requested = TRUE;
+	}
+
+	os_event_set(log_sys->writer_event);
+
+	if (wait == LOG_NO_WAIT) {
+
+		return(true);
+	}
+
+	for (ulint i = 0; i < srv_n_spin_wait_rounds; i++) {
+
+		if (log_write_is_done(lsn, flush_to_disk)) {
+
+			return(true);
+		}
+
+		ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+	}
+
+	event = log_sys->flush_events[
+		(lsn / OS_FILE_LOG_BLOCK_SIZE) % LOG_FLUSH_EVENTS_N];
+
+	for (;;) {
+		ib_int64_t	sig_count = os_event_reset(event);
+
+		if (log_write_is_done(lsn, flush_to_disk)) {
+
+			return(true);
+		}
+
+		if (!log_writer_threads_are_active(flush_to_disk)) {
+
+			return(false);
+		}
+
+		os_event_wait_time_low(event, 100000, sig_count);
+
+		/* Make sure our request has not been missed by a writer
+		that was just starting up */
+		if (flush_to_disk) {
+			log_sys->flush_requested = TRUE;
+		}
+
+		os_event_set(log_sys->writer_event);
+	}
+}
+
+/******************************************************//**
+This function is called, e.g., when a transaction wants to commit. It checks
+that the log has been written to the log file up to the last log entry written
+by the transaction. If there is a flush running, it waits and checks if the
+flush flushed enough. If not, starts a new flush. */
+UNIV_INTERN
+void
+log_write_up_to(
+/*============*/
+	lsn_t	lsn,	/*!< in: log sequence number up to which
+			the log should be written,
+			LSN_MAX if not specified */
+	ulint	wait,	/*!< in: LOG_NO_WAIT, LOG_WAIT_ONE_GROUP,
+			or LOG_WAIT_ALL_GROUPS */
+	ibool	flush_to_disk)
+			/*!< in: TRUE if we want the written log
+			also to be flushed to disk */
+{
+	if (srv_log_writer_threads
+	    && log_wait_for_writer_threads(lsn, wait, flush_to_disk)) {
+
+		return;
+	}
+
+	log_write_up_to_low(lsn, wait, flush_to_disk);
+}
+
+/******************************************************************//**
+Log writer thread, which writes the log buffer to the log files on behalf of
+the threads waiting in log_write_up_to(), if srv_log_writer_threads is set.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ib_int64_t	sig_count;
+
+	ut_ad(!srv_read_only_mode);
+	ut_ad(srv_log_writer_threads);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_writer_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	sig_count = os_event_reset(log_sys->writer_event);
+
+	log_sys->writer_is_active = true;
+
+	while (srv_shutdown_state < SRV_SHUTDOWN_FLUSH_PHASE) {
+		lsn_t	old_lsn;
+		lsn_t	lsn;
+		bool	flush;
+
+		if (os_event_wait_time_low(log_sys->writer_event, 100000,
+					   sig_count)
+		    == OS_SYNC_TIME_EXCEEDED) {
+
+			continue;
+		}
+
+		/* Requests made from now on will wake us up again */
+		sig_count = os_event_reset(log_sys->writer_event);
+
+		/* Take the flush requests before reading the lsn to write.
+		The log of a request made until now is covered by this
+		write. A request made from now on sets the flag again
+		before it sets writer_event, so the next round serves it:
+		no request is lost between the read and the reset. */
+		flush = os_compare_and_swap_ulint(
+			&log_sys->flush_requested, TRUE, FALSE);
+
+		mutex_enter(&log_sys->mutex);
+		old_lsn = log_sys->written_to_all_lsn;
+		lsn = log_sys->lsn;
+		mutex_exit(&log_sys->mutex);
+
+		/* Write everything in the log buffer: all the waiting
+		threads are served by one write */
+		log_write_up_to_low(lsn, LOG_WAIT_ALL_GROUPS, FALSE);
+
+		/* The write may have gone past the lsn we asked for if
+		more log was generated meanwhile: wake up the waiters of
+		all the log that is now written */
+		mutex_enter(&log_sys->mutex);
+		lsn = ut_max(lsn, log_sys->written_to_all_lsn);
+		mutex_exit(&log_sys->mutex);
+
+		log_notify_waiters(old_lsn, lsn);
+
+		if (flush) {
+			os_event_set(log_sys->flusher_event);
+		}
+	}
+
+	log_sys->writer_is_active = false;
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+Log flusher thread, which flushes the log files written by log_writer_thread
+to disk, if srv_log_writer_threads is set.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ib_int64_t	sig_count;
+
+	ut_ad(!srv_read_only_mode);
+	ut_ad(srv_log_writer_threads);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_flusher_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	sig_count = os_event_reset(log_sys->flusher_event);
+
+	log_sys->flusher_is_active = true;
+
+	while (srv_shutdown_state < SRV_SHUTDOWN_FLUSH_PHASE) {
+		lsn_t	flushed_lsn;
+		lsn_t	lsn;
+
+		if (os_event_wait_time_low(log_sys->flusher_event, 100000,
+					   sig_count)
+		    == OS_SYNC_TIME_EXCEEDED) {
+
+			continue;
+		}
+
+		sig_count = os_event_reset(log_sys->flusher_event);
+
+		if (srv_unix_file_flush_method == SRV_UNIX_O_DSYNC
+		    || srv_unix_file_flush_method == SRV_UNIX_ALL_O_DIRECT) {
+			/* The log writes were already flushed to disk by
+			log_writer_thread */
+			continue;
+		}
+
+		mutex_enter(&log_sys->mutex);
+		flushed_lsn = log_sys->flushed_to_disk_lsn;
+		lsn = log_sys->written_to_all_lsn;
+		mutex_exit(&log_sys->mutex);
+
+		if (lsn <= flushed_lsn) {
+
+			continue;
+		}
+
+		/* One fsync covers all the writes done so far */
+		fil_flush(UT_LIST_GET_FIRST(log_sys->log_groups)->space_id);
+
+		mutex_enter(&log_sys->mutex);
+		if (log_sys->flushed_to_disk_lsn < lsn) {
+			log_sys->flushed_to_disk_lsn = lsn;
+		}
+		mutex_exit(&log_sys->mutex);
+
+		log_notify_waiters(flushed_lsn, lsn);
+	}
+
+	log_sys->flusher_is_active = false;
+
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /****************************************************************//**
 Does a syncronous flush of the log buffer to disk. */
 UNIV_INTERN
@@ -2415,7 +3016,10 @@ log_group_read_log_seg(
 	lsn_t	source_offset;
 	bool	sync;
 
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	/* During recovery, recv_log_read_ahead_thread reads on behalf of
+	the recovery thread, which owns the mutex */
+	ut_ad(mutex_own(&(log_sys->mutex))
+	      || (type == LOG_RECOVER && recv_recovery_is_on()));
 
 	sync = (type == LOG_RECOVER);
 loop:
@@ -3499,7 +4103,8 @@ loop:
 	before proceeding further. */
 	srv_shutdown_state = SRV_SHUTDOWN_FLUSH_PHASE;
 	count = 0;
-	while (buf_page_cleaner_is_active || buf_lru_manager_is_active) {
+	while (buf_page_cleaner_is_active || buf_lru_manager_is_active
+	       || buf_page_cleaner_n_workers_active > 0) {
 		if (srv_print_verbose_log && count == 0) {
 			ib_logf(IB_LOG_LEVEL_INFO,
 				"Waiting for page_cleaner to "
@@ -3512,6 +4117,14 @@ loop:
 		}
 	}
 
+	/* The log writer threads quit at the flush phase; from now on
+	log_write_up_to() writes the log itself. */
+	while (log_sys->writer_is_active || log_sys->flusher_is_active) {
+		os_event_set(log_sys->writer_event);
+		os_event_set(log_sys->flusher_event);
+		os_thread_sleep(10000);
+	}
+
 	mutex_enter(&log_sys->mutex);
 	server_busy = log_sys->n_pending_checkpoint_writes
 #ifdef UNIV_LOG_ARCHIVE
@@ -3928,12 +4541,28 @@ log_shutdown(void)
 
 	os_event_free(log_sys->no_flush_event);
 	os_event_free(log_sys->one_flushed_event);
+	os_event_free(log_sys->writer_event);
+	os_event_free(log_sys->flusher_event);
+
+	if (log_sys->flush_events != NULL) {
+		for (ulint i = 0; i < LOG_FLUSH_EVENTS_N; i++) {
+			os_event_free(log_sys->flush_events[i]);
+		}
+
+		mem_free(log_sys->flush_events);
+		log_sys->flush_events = NULL;
+	}
 
 	rw_lock_free(&log_sys->checkpoint_lock);
 
 	mutex_free(&log_sys->mutex);
 	mutex_free(&log_sys->log_flush_order_mutex);
 
+	if (log_sys->closed_slots != NULL) {
+		mem_free(log_sys->closed_slots);
+		log_sys->closed_slots = NULL;
+	}
+
 #ifdef UNIV_LOG_ARCHIVE
 	rw_lock_free(&log_sys->archive_lock);
 	os_event_free(log_sys->archiving_on);
@@ -71,6 +71,10 @@ this must be less than UNIV_PAGE_SIZE as it is stored in the buffer pool */
 /** Read-ahead area in applying log records to file pages */
 #define RECV_READ_AHEAD_AREA	32
 
+/** Number of RECV_SCAN_SIZE segments that recv_log_read_ahead_thread reads
+at a time, if srv_recv_log_read_ahead is set */
+#define RECV_LOG_READ_AHEAD_N_SEGS	16
+
 /** The recovery system */
 UNIV_INTERN recv_sys_t*	recv_sys = NULL;
 /** TRUE when applying redo log records during crash recovery; FALSE
@@ -162,6 +166,8 @@ UNIV_INTERN mysql_pfs_key_t	recv_sys_mutex_key;
 #ifndef UNIV_HOTBACKUP
 # ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t	recv_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	recv_apply_thread_key;
+UNIV_INTERN mysql_pfs_key_t	recv_log_read_ahead_thread_key;
 # endif /* UNIV_PFS_THREAD */
 
 # ifdef UNIV_PFS_MUTEX
@@ -171,6 +177,29 @@ UNIV_INTERN mysql_pfs_key_t	recv_writer_mutex_key;
 /** Flag indicating if recv_writer thread is active. */
 UNIV_INTERN bool		recv_writer_thread_active = false;
 UNIV_INTERN os_thread_t		recv_writer_thread_handle = 0;
+
+/** The partition numbers passed to the recv_apply_thread instances */
+static ulint	recv_apply_thread_nos[SRV_MAX_N_RECV_APPLY_THREADS];
+
+/** Log read-ahead requests from the recovery thread to
+recv_log_read_ahead_thread */
+struct recv_log_read_ahead_t{
+	log_group_t*	group;		/*!< log group being scanned */
+	byte*		buf;		/*!< buffer to read the log into */
+	lsn_t		start_lsn;	/*!< start lsn of the read; the read
+					is RECV_LOG_READ_AHEAD_N_SEGS
+					* RECV_SCAN_SIZE bytes long */
+	bool		quit;		/*!< true if the thread should
+					exit instead of reading */
+	bool		active;		/*!< true while the thread runs */
+	os_event_t	request_event;	/*!< set by the recovery thread
+					when a read is requested */
+	os_event_t	done_event;	/*!< set by the read-ahead thread
+					when the read has completed */
+};
+
+/** The log read-ahead of the recovery thread */
+static recv_log_read_ahead_t	recv_log_read_ahead;
 #endif /* !UNIV_HOTBACKUP */
 
 /* prototypes */
@@ -1910,6 +1939,169 @@ recv_read_in_area(
 	return(n);
 }
 
+/*******************************************************************//**
+Applies the hashed log records to the pages of one partition of the hash
+table. The pages are partitioned by their read-ahead area, so that the pages
+read in by recv_read_in_area() all belong to the calling thread. The caller
+must not own recv_sys->mutex. */
+static
+void
+recv_apply_hashed_log_recs_part(
+/*============================*/
+	ulint	part_no,	/*!< in: partition to apply */
+	ulint	n_parts)	/*!< in: number of partitions */
+{
+	recv_addr_t*	recv_addr;
+	mtr_t		mtr;
+
+	mutex_enter(&recv_sys->mutex);
+
+	for (ulint i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
+
+		for (recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_FIRST(recv_sys->addr_hash, i));
+		     recv_addr != 0;
+		     recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_NEXT(addr_hash, recv_addr))) {
+
+			ulint	space = recv_addr->space;
+			ulint	page_no = recv_addr->page_no;
+			ulint	zip_size;
+
+			if (recv_addr->state != RECV_NOT_PROCESSED
+			    || ut_fold_ulint_pair(
+				    space, page_no / RECV_READ_AHEAD_AREA)
+			    % n_parts != part_no) {
+
+				continue;
+			}
+
+			mutex_exit(&recv_sys->mutex);
+
+			zip_size = fil_space_get_zip_size(space);
+
+			if (buf_page_peek(space, page_no)) {
+				buf_block_t*	block;
+
+				mtr_start(&mtr);
+
+				block = buf_page_get(
+					space, zip_size, page_no,
+					RW_X_LATCH, &mtr);
+				buf_block_dbg_add_level(
+					block, SYNC_NO_ORDER_CHECK);
+
+				recv_recover_page(FALSE, block);
+				mtr_commit(&mtr);
+			} else {
+				recv_read_in_area(space, zip_size, page_no);
+			}
+
+			mutex_enter(&recv_sys->mutex);
+		}
+	}
+
+	mutex_exit(&recv_sys->mutex);
+}
+
+/******************************************************************//**
+Redo log apply thread, which applies the hashed log records to the pages of
+one partition of the hash table during a recovery batch, if
+srv_n_recv_apply_threads > 1.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(
+/*==============================*/
+	void*	arg)	/*!< in: pointer to the partition number */
+{
+	ulint	part_no = *static_cast<ulint*>(arg);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	recv_apply_hashed_log_recs_part(part_no, srv_n_recv_apply_threads);
+
+	mutex_enter(&recv_sys->mutex);
+	ut_a(recv_sys->n_apply_threads_active > 0);
+	recv_sys->n_apply_threads_active--;
+	mutex_exit(&recv_sys->mutex);
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*******************************************************************//**
+Applies the hashed log records to the pages with srv_n_recv_apply_threads
+threads, the calling thread being one of them, and reports the progress.
+The caller must own recv_sys->mutex.
+@return TRUE if there were log records to apply and the progress was
+printed */
+static
+ibool
+recv_apply_hashed_log_recs_parallel(void)
+/*=====================================*/
+{
+	ulint	n_threads = srv_n_recv_apply_threads;
+	ulint	n_addrs = recv_sys->n_addrs;
+	ulint	last_pct = 0;
+
+	ut_ad(mutex_own(&recv_sys->mutex));
+	ut_ad(n_threads > 1);
+	ut_ad(n_threads <= SRV_MAX_N_RECV_APPLY_THREADS);
+
+	if (n_addrs == 0) {
+
+		return(FALSE);
+	}
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Starting an apply batch of log records to the database"
+		" with %lu threads...", (ulong) n_threads);
+	fputs("InnoDB: Progress in percent: ", stderr);
+
+	recv_sys->n_apply_threads_active = n_threads - 1;
+
+	mutex_exit(&recv_sys->mutex);
+
+	for (ulint i = 1; i < n_threads; i++) {
+		recv_apply_thread_nos[i] = i;
+		os_thread_create(recv_apply_thread,
+				 recv_apply_thread_nos + i, NULL);
+	}
+
+	recv_apply_hashed_log_recs_part(0, n_threads);
+
+	mutex_enter(&recv_sys->mutex);
+
+	/* Wait until all the pages have been processed, also those read
+	in by the other threads */
+
+	while (recv_sys->n_addrs != 0
+	       || recv_sys->n_apply_threads_active != 0) {
+
+		ulint	pct = (n_addrs - recv_sys->n_addrs) * 100 / n_addrs;
+
+		if (pct != last_pct) {
+			fprintf(stderr, "%lu ", (ulong) pct);
+			last_pct = pct;
+		}
+
+		mutex_exit(&recv_sys->mutex);
+
+		os_thread_sleep(100000);
+
+		mutex_enter(&recv_sys->mutex);
+	}
+
+	return(TRUE);
+}
+
 /*******************************************************************//**
 Empties the hash table of stored log records, applying them to appropriate
 pages. */
@@ -1952,6 +2144,11 @@ loop:
 	recv_sys->apply_log_recs = TRUE;
 	recv_sys->apply_batch_on = TRUE;
 
+	if (srv_n_recv_apply_threads > 1) {
+		has_printed = recv_apply_hashed_log_recs_parallel();
+		goto wait_for_batch;
+	}
+
 	for (i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
 
 		for (recv_addr = static_cast<recv_addr_t*>(
@@ -2010,6 +2207,7 @@ loop:
 		}
 	}
 
+wait_for_batch:
 	/* Wait until all the pages have been processed */
 
 	while (recv_sys->n_addrs != 0) {
@@ -2986,6 +3184,140 @@ recv_scan_log_recs(
 }
 
 #ifndef UNIV_HOTBACKUP
+/******************************************************************//**
+Log read-ahead thread, which reads the next log segments from the log group
+while the recovery thread parses and hashes the previous ones, if
+srv_recv_log_read_ahead is set.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(recv_log_read_ahead_thread)(
+/*=======================================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	recv_log_read_ahead_t*	ra = &recv_log_read_ahead;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_log_read_ahead_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	for (;;) {
+		os_event_wait(ra->request_event);
+		os_event_reset(ra->request_event);
+
+		if (ra->quit) {
+			break;
+		}
+
+		/* The recovery thread owns log_sys->mutex and does
+		no log i/o while it waits for this read */
+		log_group_read_log_seg(
+			LOG_RECOVER, ra->buf, ra->group, ra->start_lsn,
+			ra->start_lsn
+			+ RECV_LOG_READ_AHEAD_N_SEGS * RECV_SCAN_SIZE,
+			FALSE);
+
+		os_event_set(ra->done_event);
+	}
+
+	ra->active = false;
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*******************************************************//**
+Scans a log group like recv_group_scan_log_recs(), but lets
+recv_log_read_ahead_thread read the next RECV_LOG_READ_AHEAD_N_SEGS
+segments of the log into a second buffer while the previous ones are
+parsed and hashed, so that the log i/o overlaps with the parsing and with
+the apply batches started from recv_scan_log_recs(). */
+static
+void
+recv_group_scan_log_recs_read_ahead(
+/*================================*/
+	log_group_t*	group,		/*!< in: log group */
+	ulint		available_memory,/*!< in: we let the hash table of
+					recs to grow to this size, at the
+					maximum */
+	lsn_t*		contiguous_lsn,	/*!< in/out: it is known that all log
+					groups contain contiguous log data up
+					to this lsn */
+	lsn_t*		group_scanned_lsn)/*!< out: scanning succeeded up to
+					this lsn */
+{
+	recv_log_read_ahead_t*	ra = &recv_log_read_ahead;
+	const ulint		len = RECV_LOG_READ_AHEAD_N_SEGS
+				      * RECV_SCAN_SIZE;
+	byte*			buf_unaligned;
+	byte*			bufs[2];
+	ulint			cur = 0;
+	ibool			finished = FALSE;
+	lsn_t			start_lsn = *contiguous_lsn;
+
+	buf_unaligned = static_cast<byte*>(
+		ut_malloc(2 * len + UNIV_PAGE_SIZE));
+	bufs[0] = static_cast<byte*>(ut_align(buf_unaligned,
+					      UNIV_PAGE_SIZE));
+	bufs[1] = bufs[0] + len;
+
+	ra->group = group;
+	ra->buf = bufs[0];
+	ra->start_lsn = start_lsn;
+	ra->quit = false;
+	ra->active = true;
+	ra->request_event = os_event_create();
+	ra->done_event = os_event_create();
+
+	os_thread_create(recv_log_read_ahead_thread, NULL, NULL);
+
+	os_event_set(ra->request_event);
+
+	while (!finished) {
+		os_event_wait(ra->done_event);
+		os_event_reset(ra->done_event);
+
+		/* Read the next segments while these are parsed */
+		ra->buf = bufs[1 - cur];
+		ra->start_lsn = start_lsn + len;
+		os_event_set(ra->request_event);
+
+		for (ulint offset = 0; offset < len && !finished;
+		     offset += RECV_SCAN_SIZE) {
+
+			finished = recv_scan_log_recs(
+				available_memory, TRUE,
+				bufs[cur] + offset, RECV_SCAN_SIZE,
+				start_lsn + offset, contiguous_lsn,
+				group_scanned_lsn);
+		}
+
+		start_lsn += len;
+		cur = 1 - cur;
+	}
+
+	/* Wait for the last read-ahead, which was not needed */
+	os_event_wait(ra->done_event);
+
+	ra->quit = true;
+	os_event_set(ra->request_event);
+
+	while (ra->active) {
+		os_thread_sleep(1000);
+	}
+
+	os_event_free(ra->request_event);
+	os_event_free(ra->done_event);
+
+	ut_free(buf_unaligned);
+}
+
 /*******************************************************//**
 Scans log from a buffer and stores new log data to the parsing buffer. Parses
 and hashes the log records if new data found. */
@@ -3003,24 +3335,35 @@ recv_group_scan_log_recs(
 	ibool	finished;
 	lsn_t	start_lsn;
 	lsn_t	end_lsn;
+	ulint	available_memory;
 
-	finished = FALSE;
+	available_memory = (buf_pool_get_n_pages()
+			    - (recv_n_pool_free_frames
+			       * srv_buf_pool_instances))
+		* UNIV_PAGE_SIZE;
 
-	start_lsn = *contiguous_lsn;
+	if (srv_recv_log_read_ahead) {
+		recv_group_scan_log_recs_read_ahead(
+			group, available_memory, contiguous_lsn,
+			group_scanned_lsn);
+	} else {
+		finished = FALSE;
 
-	while (!finished) {
-		end_lsn = start_lsn + RECV_SCAN_SIZE;
+		start_lsn = *contiguous_lsn;
 
-		log_group_read_log_seg(LOG_RECOVER, log_sys->buf,
-				       group, start_lsn, end_lsn, FALSE);
-
-		finished = recv_scan_log_recs(
-			(buf_pool_get_n_pages()
-			- (recv_n_pool_free_frames * srv_buf_pool_instances))
-			* UNIV_PAGE_SIZE,
-			TRUE, log_sys->buf, RECV_SCAN_SIZE,
-			start_lsn, contiguous_lsn, group_scanned_lsn);
-		start_lsn = end_lsn;
+		while (!finished) {
+			end_lsn = start_lsn + RECV_SCAN_SIZE;
+
+			log_group_read_log_seg(LOG_RECOVER, log_sys->buf,
+					       group, start_lsn, end_lsn,
+					       FALSE);
+
+			finished = recv_scan_log_recs(
+				available_memory,
+				TRUE, log_sys->buf, RECV_SCAN_SIZE,
+				start_lsn, contiguous_lsn, group_scanned_lsn);
+			start_lsn = end_lsn;
+		}
 	}
 
 #ifdef UNIV_DEBUG
@@ -152,7 +152,8 @@ mtr_memo_slot_note_modification(
 	if (slot->object != NULL && slot->type == MTR_MEMO_PAGE_X_FIX) {
 		buf_block_t*	block = (buf_block_t*) slot->object;
 
-		ut_ad(!mtr->made_dirty || log_flush_order_mutex_own());
+		ut_ad(!mtr->made_dirty || srv_log_concurrent_mtr_commit
+		      || log_flush_order_mutex_own());
 		buf_flush_note_modification(block, mtr);
 	}
 }
@@ -229,6 +230,67 @@ mtr_add_dirtied_pages_to_flush_list(
 	}
 }
 
+/************************************************************//**
+Writes the contents of a mini-transaction log to the database log and
+appends the dirty pages to the flush list when
+srv_log_concurrent_mtr_commit is set. The log mutex is only held while
+reserving space in the log buffer: the log records are copied and the
+pages are inserted into the flush lists concurrently with other
+mini-transactions, without log_flush_order_mutex. */
+static
+void
+mtr_log_reserve_and_copy(
+/*=====================*/
+	mtr_t*	mtr)	/*!< in/out: mtr */
+{
+	dyn_array_t*	mlog		= &mtr->log;
+	ulint		offset		= ULINT_UNDEFINED;
+	ib_uint64_t	closed_no	= 0;
+
+	ut_ad(srv_log_concurrent_mtr_commit);
+
+	mutex_enter(&log_sys->mutex);
+
+	mtr->start_lsn = log_open(dyn_array_get_data_size(mlog));
+
+	if (mtr->log_mode == MTR_LOG_ALL) {
+		offset = log_reserve_low(dyn_array_get_data_size(mlog));
+	} else {
+		ut_ad(mtr->log_mode == MTR_LOG_NONE
+		      || mtr->log_mode == MTR_LOG_NO_REDO);
+	}
+
+	mtr->end_lsn = log_close();
+
+	if (mtr->made_dirty) {
+		closed_no = log_closed_reserve(mtr->start_lsn);
+	}
+
+	log_release();
+
+	if (offset != ULINT_UNDEFINED) {
+
+		for (dyn_block_t* block = mlog;
+		     block != 0;
+		     block = dyn_array_get_next_block(mlog, block)) {
+
+			log_copy_low(&offset,
+				     dyn_block_get_data(block),
+				     dyn_block_get_used(block));
+		}
+
+		log_copy_complete();
+	}
+
+	if (mtr->modifications) {
+		mtr_memo_note_modifications(mtr);
+	}
+
+	if (mtr->made_dirty) {
+		log_closed_release(closed_no);
+	}
+}
+
 /************************************************************//**
 Writes the contents of a mini-transaction log, if any, to the database log. */
 static
@@ -254,6 +316,12 @@ mtr_log_reserve_and_write(
 				     | MLOG_SINGLE_REC_FLAG);
 	}
 
+	if (srv_log_concurrent_mtr_commit) {
+		mtr_log_reserve_and_copy(mtr);
+
+		return;
+	}
+
 	if (mlog->heap == NULL) {
 		ulint	len;
 
@@ -245,6 +245,15 @@ struct os_aio_array_t{
 				There is one such event for each
 				possible pending IO. The size of the
 				array is equal to n_slots. */
+	struct iocb**		pending;
+				/* The requests that were posted with
+				OS_AIO_SIMULATED_WAKE_LATER and have
+				not been submitted to the kernel yet.
+				Divided into segments like the slots.
+				Protected by mutex. */
+	ulint*			n_pending;
+				/* Number of requests in pending, one
+				count per segment. Protected by mutex. */
 #endif /* LINUX_NATIV_AIO */
 };
 
@@ -257,6 +266,13 @@ struct os_aio_array_t{
 
 /** number of attempts before giving up on io_setup(). */
 #define OS_AIO_IO_SETUP_RETRY_ATTEMPTS	5
+
+/** time to sleep, in microseconds if io_submit() of a batch returns
+EAGAIN. */
+#define OS_AIO_SUBMIT_RETRY_SLEEP	(10000UL)
+
+/** number of attempts before giving up on io_submit() of a batch. */
+#define OS_AIO_SUBMIT_RETRY_ATTEMPTS	1000
 #endif
 
 /** Array of events used in simulated aio */
@@ -3965,6 +3981,8 @@ os_aio_array_create(
 #if defined(LINUX_NATIVE_AIO)
 	array->aio_ctx = NULL;
 	array->aio_events = NULL;
+	array->pending = NULL;
+	array->n_pending = NULL;
 
 	/* If we are not using native aio interface then skip this
 	part of initialization. */
@@ -3998,6 +4016,17 @@ os_aio_array_create(
 	memset(io_event, 0x0, sizeof(*io_event) * n);
 	array->aio_events = io_event;
 
+	/* Initialize the arrays of requests that are submitted
+	in a batch. */
+	array->pending = static_cast<struct iocb**>(
+		ut_malloc(n * sizeof(*array->pending)));
+
+	array->n_pending = static_cast<ulint*>(
+		ut_malloc(n_segments * sizeof(*array->n_pending)));
+
+	memset(array->n_pending, 0x0,
+	       n_segments * sizeof(*array->n_pending));
+
 skip_native_aio:
 #endif /* LINUX_NATIVE_AIO */
 	for (ulint i = 0; i < n; i++) {
@@ -4054,6 +4083,8 @@ os_aio_array_free(
 	if (srv_use_native_aio) {
 		ut_free(array->aio_events);
 		ut_free(array->aio_ctx);
+		ut_free(array->pending);
+		ut_free(array->n_pending);
 	}
 #endif /* LINUX_NATIVE_AIO */
 
@@ -4435,12 +4466,11 @@ loop:
 	if (array->n_reserved == array->n_slots) {
 		os_mutex_exit(array->mutex);
 
-		if (!srv_use_native_aio) {
-			/* If the handler threads are suspended, wake them
-			so that we get more slots */
+		/* If the handler threads are suspended, wake them
+		so that we get more slots. With native aio, submit
+		the requests that are waiting for the end of a batch. */
 
-			os_aio_simulated_wake_handler_threads();
-		}
+		os_aio_simulated_wake_handler_threads();
 
 		os_event_wait(array->not_full);
 
@@ -4626,15 +4656,153 @@ os_aio_simulated_wake_handler_thread(
 	os_mutex_exit(array->mutex);
 }
 
+#if defined(LINUX_NATIVE_AIO)
+/*******************************************************************//**
+Submits a batch of requests to the kernel. If the kernel is out of
+resources, retries every OS_AIO_SUBMIT_RETRY_SLEEP microseconds, at most
+OS_AIO_SUBMIT_RETRY_ATTEMPTS times. */
+static
+void
+os_aio_linux_submit_batch(
+/*======================*/
+	io_context_t	io_ctx,		/*!< in: io context of the segment */
+	struct iocb**	iocbs,		/*!< in: requests to submit */
+	ulint		n)		/*!< in: number of requests */
+{
+	ulint	submitted = 0;
+	ulint	retries = 0;
+
+	while (submitted < n) {
+		int	ret;
+
+		ret = io_submit(io_ctx, n - submitted, iocbs + submitted);
+
+#if defined(UNIV_AIO_DEBUG)
+		fprintf(stderr,
+			"io_submit[batch] ret[%d]: n[%lu] ctx[%p]\n",
+			ret, (ulong) (n - submitted), io_ctx);
+#endif
+
+		if (ret > 0) {
+			submitted += ret;
+		} else if ((ret == 0 || ret == -EAGAIN)
+			   && retries < OS_AIO_SUBMIT_RETRY_ATTEMPTS) {
+			/* The kernel is out of resources: give the
+			i/o-handler threads time to reap completed
+			requests. */
+			++retries;
+			os_thread_sleep(OS_AIO_SUBMIT_RETRY_SLEEP);
+		} else {
+			/* The requests were already reported as
+			queued to the callers, who cannot retry. */
+			ib_logf(IB_LOG_LEVEL_FATAL,
+				"Native Linux AIO interface. io_submit()"
+				" call failed when submitting a batch of"
+				" %lu I/O requests with error %d after"
+				" %lu attempts.",
+				(ulong) (n - submitted),
+				ret == 0 ? EAGAIN : -ret,
+				(ulong) retries + 1);
+		}
+	}
+}
+
+/*******************************************************************//**
+Submits to the kernel the requests of an aio array segment that were
+posted with OS_AIO_SIMULATED_WAKE_LATER. The caller must own the array
+mutex. If the kernel does not take the whole batch at once, the mutex is
+released while the rest of it is retried, so that the other threads can
+use the array in the meantime. */
+static
+void
+os_aio_linux_submit_pending_low(
+/*============================*/
+	os_aio_array_t*	array,		/*!< in/out: aio array */
+	ulint		segment)	/*!< in: local segment number */
+{
+	struct iocb**	iocbs;
+	ulint		n;
+	int		ret;
+
+	n = array->n_pending[segment];
+	iocbs = &array->pending[segment * (array->n_slots
+					   / array->n_segments)];
+
+	ret = io_submit(array->aio_ctx[segment], n, iocbs);
+
+#if defined(UNIV_AIO_DEBUG)
+	fprintf(stderr,
+		"io_submit[batch] ret[%d]: n[%lu] ctx[%p] seg[%lu]\n",
+		ret, (ulong) n, array->aio_ctx[segment], (ulong) segment);
+#endif
+
+	array->n_pending[segment] = 0;
+
+	if (UNIV_LIKELY(ret >= 0 && static_cast<ulint>(ret) == n)) {
+		return;
+	}
+
+	/* Take the rest of the batch off the segment, which other
+	threads may fill again while the mutex is released. */
+	ulint		submitted = ret > 0 ? ret : 0;
+	ulint		n_left = n - submitted;
+	struct iocb**	left = static_cast<struct iocb**>(
+		ut_malloc(n_left * sizeof(*left)));
+
+	memcpy(left, iocbs + submitted, n_left * sizeof(*left));
+
+	os_mutex_exit(array->mutex);
+
+	os_aio_linux_submit_batch(array->aio_ctx[segment], left, n_left);
+
+	ut_free(left);
+
+	os_mutex_enter(array->mutex);
+}
+
+/*******************************************************************//**
+Submits to the kernel the requests of an aio array that were posted
+with OS_AIO_SIMULATED_WAKE_LATER, with one io_submit() call for each
+segment. */
+static
+void
+os_aio_linux_submit_pending(
+/*========================*/
+	os_aio_array_t*	array)	/*!< in/out: aio array */
+{
+	os_mutex_enter(array->mutex);
+
+	for (ulint i = 0; i < array->n_segments; ++i) {
+		if (array->n_pending[i] > 0) {
+			os_aio_linux_submit_pending_low(array, i);
+		}
+	}
+
+	os_mutex_exit(array->mutex);
+}
+#endif /* LINUX_NATIVE_AIO */
+
 /**********************************************************************//**
-Wakes up simulated aio i/o-handler threads if they have something to do. */
+Wakes up simulated aio i/o-handler threads if they have something to do.
+With Linux native aio, submits to the kernel the requests that were posted
+with OS_AIO_SIMULATED_WAKE_LATER. */
 UNIV_INTERN
 void
 os_aio_simulated_wake_handler_threads(void)
 /*=======================================*/
 {
 	if (srv_use_native_aio) {
-		/* We do not use simulated aio: do nothing */
+#if defined(LINUX_NATIVE_AIO)
+		if (srv_use_native_aio_batch) {
+			os_aio_linux_submit_pending(os_aio_read_array);
+
+			if (!srv_read_only_mode) {
+				os_aio_linux_submit_pending(
+					os_aio_write_array);
+			}
+		}
+#endif /* LINUX_NATIVE_AIO */
+		/* We do not use simulated aio: do nothing else */
 
 		return;
 	}
@@ -4685,14 +4853,19 @@ readahead requests. */
 
 #if defined(LINUX_NATIVE_AIO)
 /*******************************************************************//**
-Dispatch an AIO request to the kernel.
+Dispatch an AIO request to the kernel. If submit_later is set, the request
+is only queued, and it is submitted together with the other requests of
+the batch by os_aio_simulated_wake_handler_threads().
 @return	TRUE on success. */
 static
 ibool
 os_aio_linux_dispatch(
 /*==================*/
 	os_aio_array_t*	array,	/*!< in: io request array. */
-	os_aio_slot_t*	slot)	/*!< in: an already reserved slot. */
+	os_aio_slot_t*	slot,	/*!< in: an already reserved slot. */
+	ibool		submit_later)
+				/*!< in: TRUE if the request is part
+				of a batch */
 {
 	int		ret;
 	ulint		io_ctx_index;
@@ -4710,6 +4883,23 @@ os_aio_linux_dispatch(
 	iocb = &slot->control;
 	io_ctx_index = (slot->pos * array->n_segments) / array->n_slots;
 
+	if (submit_later) {
+		ulint	slots_per_seg = array->n_slots / array->n_segments;
+
+		os_mutex_enter(array->mutex);
+
+		/* Every queued request has a reserved slot in the
+		segment: the segment part of the array cannot overflow. */
+		ut_a(array->n_pending[io_ctx_index] < slots_per_seg);
+
+		array->pending[io_ctx_index * slots_per_seg
+			       + array->n_pending[io_ctx_index]++] = iocb;
+
+		os_mutex_exit(array->mutex);
+
+		return(TRUE);
+	}
+
 	ret = io_submit(array->aio_ctx[io_ctx_index], 1, &iocb);
 
 #if defined(UNIV_AIO_DEBUG)
@@ -4882,7 +5072,9 @@ try_again:
 				       &(slot->control));
 
 #elif defined(LINUX_NATIVE_AIO)
-			if (!os_aio_linux_dispatch(array, slot)) {
+			if (!os_aio_linux_dispatch(
+				    array, slot,
+				    wake_later && srv_use_native_aio_batch)) {
 				goto err_exit;
 			}
 #endif /* WIN_ASYNC_IO */
@@ -4902,7 +5094,9 @@ try_again:
 					&(slot->control));
 
 #elif defined(LINUX_NATIVE_AIO)
-			if (!os_aio_linux_dispatch(array, slot)) {
+			if (!os_aio_linux_dispatch(
+				    array, slot,
+				    wake_later && srv_use_native_aio_batch)) {
 				goto err_exit;
 			}
 #endif /* WIN_ASYNC_IO */
@@ -5193,6 +5387,10 @@ retry:
 	ret = io_getevents(io_ctx, 1, seg_size, events, &timeout);
 
 	if (ret > 0) {
+		/* Mark the requests as completed. The error handling
+		will be done in the calling function. */
+		os_mutex_enter(array->mutex);
+
 		for (i = 0; i < ret; i++) {
 			os_aio_slot_t*	slot;
 			struct iocb*	control;
@@ -5220,14 +5418,13 @@ retry:
 			/* We have not overstepped to next segment. */
 			ut_a(slot->pos < end_pos);
 
-			/* Mark this request as completed. The error handling
-			will be done in the calling function. */
-			os_mutex_enter(array->mutex);
 			slot->n_bytes = events[i].res;
 			slot->ret = events[i].res2;
 			slot->io_already_done = TRUE;
-			os_mutex_exit(array->mutex);
 		}
+
+		os_mutex_exit(array->mutex);
+
 		return;
 	}
 
@@ -5248,7 +5445,17 @@ retry:
 		the return code will be the number of IOs. We get EINTR only
 		if there are no completed IOs and we have been interrupted. */
 	case 0:
-		/* No pending request! Go back and check again. */
+		/* No pending request! Submit the requests of a batch
+		whose submission has not been requested yet, and go back
+		and check again. */
+		os_mutex_enter(array->mutex);
+
+		if (array->n_pending[segment] > 0) {
+			os_aio_linux_submit_pending_low(array, segment);
+		}
+
+		os_mutex_exit(array->mutex);
+
 		goto retry;
 	}
 
@@ -135,12 +135,14 @@ FACT C: Purge does not remove any delete-marked row that is visible
 in any cursor read view.
 
 PROOF: We know that:
- 1: Currently active read views in trx_sys_t::view_list are ordered by
-    read_view_t::low_limit_no in descending order, that is,
-    newest read view first.
+ 1: A read view snapshot that is taken later has a greater or equal
+    read_view_t::low_limit_no, and if that is equal, a greater or equal
+    read_view_t::low_limit_id.
 
- 2: Purge clones the oldest read view and uses that to determine whether there
-    are any active transactions that can see the to be purged records.
+ 2: Purge clones the oldest open read view in trx_sys_t::view_list and uses
+    that to determine whether there are any active transactions that can see
+    the to be purged records. The list is ordered by the age of the
+    snapshots, so the oldest open view is the last open one in it.
 
 Therefore any joining or active transaction will not have a view older
 than the purge view, according to 1.
@@ -167,12 +169,28 @@ For details see: row_vers_old_has_index_entry() and row_purge_poss_sec()
 
 Some additional issues:
 
-What if trx_sys->view_list == NULL and some transaction T1 and Purge both
-try to open read_view at same time. Only one can acquire trx_sys->mutex.
-In which order will the views be opened? Should it matter? If no, why?
-
-The order does not matter. No new transactions can be created and no running
-transaction can commit or rollback (or free views).
+The snapshot of a read view is copied without acquiring trx_sys->mutex,
+while trx_sys_t::descr_version does not change. The view is then moved to
+the start of trx_sys_t::view_list under trx_sys->mutex, if no transaction
+has committed or rolled back since the snapshot was taken, that is, if
+trx_sys_t::descr_n_released has not changed. Otherwise the snapshot is
+taken again while holding the mutex. Thus the list is ordered by
+descr_n_released. Two snapshots with the same descr_n_released see the
+same committed transactions, and neither of them has a low_limit_no greater
+than the trx_t::no of a transaction that is still in
+trx_sys_t::trx_serial_list, so for Purge either one is as old as the other.
+
+Purge walks the list from the end under trx_sys->mutex, and examines each
+view under the trx_t::mutex of its transaction. It removes the closed views
+that it passes, and stops at the first open one. What if some transaction
+T1 opens its view while Purge is doing that? Either Purge sees the open view
+of T1, or T1 moves its view to the start of the list after Purge released
+trx_sys->mutex, and the view of T1 is not older than the purge view.
+
+What if T1 reuses the snapshot of its previous view, that Purge ignored while
+it was closed? The snapshot is only reused if trx_sys_t::descr_n_released has
+not changed since it was taken, and if the view is still in the list, at the
+place where it was put when the snapshot was taken.
 */
 
 /*********************************************************************//**
@@ -193,6 +211,10 @@ read_view_create_low(
 					  sizeof(read_view_t));
 		view->max_descr = 0;
 		view->descriptors = NULL;
+		view->n_released = ULINT_UNDEFINED;
+		view->trx = NULL;
+		view->state = READ_VIEW_CLOSED;
+		view->in_list = false;
 	}
 
 	if (UNIV_UNLIKELY(view->max_descr < n)) {
@@ -219,7 +241,8 @@ read_view_create_low(
 Clones a read view object. This function will allocate space for two read
 views contiguously, one identical in size and content as @param view (starting
 at returned pointer) and another view immediately following the trx_ids array.
-The second view will have space for an extra trx_id_t element.
+The second view will have space for an extra trx_id_t element. The clone
+keeps its own read_view_t::trx, read_view_t::state and list node.
 @return	read view struct */
 UNIV_INTERN
 read_view_t*
@@ -230,20 +253,18 @@ read_view_clone(
 						NULL */
 {
 	read_view_t*	clone;
-	trx_id_t*	old_descriptors;
-	ulint		old_max_descr;
 
 	ut_ad(mutex_own(&trx_sys->mutex));
 
 	clone = read_view_create_low(view->n_descr, prebuilt_clone);
 
-	old_descriptors = clone->descriptors;
-	old_max_descr = clone->max_descr;
-
-	memcpy(clone, view, sizeof(*view));
-
-	clone->descriptors = old_descriptors;
-	clone->max_descr = old_max_descr;
+	clone->type = view->type;
+	clone->undo_no = view->undo_no;
+	clone->low_limit_no = view->low_limit_no;
+	clone->low_limit_id = view->low_limit_id;
+	clone->up_limit_id = view->up_limit_id;
+	clone->creator_trx_id = view->creator_trx_id;
+	clone->n_released = view->n_released;
 
 	if (view->n_descr) {
 		memcpy(clone->descriptors, view->descriptors,
@@ -254,40 +275,29 @@ read_view_clone(
 }
 
 /*********************************************************************//**
-Insert the view in the proper order into the trx_sys->view_list. The
-read view list is ordered by read_view_t::low_limit_no in descending order. */
-UNIV_INTERN
+Adds a view to the start of trx_sys->view_list. Its snapshot must not be
+older than that of any view in the list, so it has to be taken while
+trx_sys_t::descr_n_released has the current value. */
+static
 void
 read_view_add(
 /*==========*/
 	read_view_t*	view)		/*!< in: view to add to */
 {
-	read_view_t*	elem;
-	read_view_t*	prev_elem;
-
 	ut_ad(mutex_own(&trx_sys->mutex));
 	ut_ad(read_view_validate(view));
+	ut_ad(!view->in_list);
+	ut_ad(view->n_released == trx_sys->descr_n_released);
 
-	/* Find the correct slot for insertion. */
-	for (elem = UT_LIST_GET_FIRST(trx_sys->view_list), prev_elem = NULL;
-	     elem != NULL && view->low_limit_no < elem->low_limit_no;
-	     prev_elem = elem, elem = UT_LIST_GET_NEXT(view_list, elem)) {
-		/* No op */
-	}
-
-	if (prev_elem == NULL) {
-		UT_LIST_ADD_FIRST(view_list, trx_sys->view_list, view);
-	} else {
-		UT_LIST_INSERT_AFTER(
-			view_list, trx_sys->view_list, prev_elem, view);
-	}
-
-	ut_ad(read_view_list_validate());
+	UT_LIST_ADD_FIRST(view_list, trx_sys->view_list, view);
+	view->in_list = true;
 }
 
 /*********************************************************************//**
 Opens a read view where exactly the transactions serialized before this
-point in time are seen in the view.
+point in time are seen in the view. This does not acquire trx_sys->mutex:
+the fields of trx_sys are copied again if trx_sys_t::descr_version
+changed while they were being copied.
 @return	own: read view struct */
 static
 read_view_t*
@@ -298,63 +308,80 @@ read_view_open_now_low(
 	read_view_t*&	view)		/*!< in,out: pre-allocated view array or
 					NULL if a new one needs to be created */
 {
-	trx_id_t*	descr;
-	ulint		i;
+	const volatile trx_sys_t*	sys = trx_sys;
+					/*!< declared volatile to ensure that
+					the fields are read from memory */
+	trx_id_t			serial_min_no;
 
-	ut_ad(mutex_own(&trx_sys->mutex));
+	for (;;) {
+		const volatile trx_id_t*	descr;
+		ulint				version;
+		ulint				n_max;
+		ulint				n_used;
+		ulint				n;
+		ulint				i;
 
-	view = read_view_create_low(trx_sys->descr_n_used, view);
+		version = sys->descr_version;
 
-	view->undo_no = 0;
-	view->type = VIEW_NORMAL;
-	view->creator_trx_id = cr_trx_id;
+		if (UNIV_UNLIKELY(version & 1)) {
 
-	/* No future transactions should be visible in the view */
+			/* A transaction is being started or committed. */
+			os_thread_yield();
 
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
+			continue;
+		}
 
-	descr = trx_find_descriptor(trx_sys->descriptors,
-				    trx_sys->descr_n_used,
-				    cr_trx_id);
-	if (UNIV_LIKELY(descr != NULL)) {
-		ut_ad(trx_sys->descr_n_used > 0);
-		ut_ad(view->n_descr > 0);
+		os_rmb;
 
-		view->n_descr--;
+		/* trx_reserve_descriptor() makes a bigger array visible
+		before its size. Old arrays are never freed. */
 
-		i = descr - trx_sys->descriptors;
-	} else {
-		i = trx_sys->descr_n_used;
-	}
+		n_max = sys->descr_n_max;
 
-	if (UNIV_LIKELY(i > 0)) {
-		/* Copy the [0; i-1] range */
-		memcpy(view->descriptors, trx_sys->descriptors,
-		       i * sizeof(trx_id_t));
-	}
+		os_rmb;
+
+		descr = sys->descriptors;
+		n_used = ut_min(sys->descr_n_used, n_max);
+
+		view = read_view_create_low(n_used, view);
 
-	if (UNIV_UNLIKELY(i + 1 < trx_sys->descr_n_used)) {
-		/* Copy the [i+1; descr_n_used-1] range */
-		memcpy(view->descriptors + i,
-		       trx_sys->descriptors + i + 1,
-		       (trx_sys->descr_n_used - i - 1) *
-		       sizeof(trx_id_t));
- 	}
+		/* No future transactions should be visible in the view */
 
-	/* NOTE that a transaction whose trx number is < trx_sys->max_trx_id can
-	still be active, if it is in the middle of its commit! Note that when a
-	transaction starts, we initialize trx->no to TRX_ID_MAX. */
+		view->low_limit_no = sys->max_trx_id;
+		view->low_limit_id = view->low_limit_no;
+		view->n_released = sys->descr_n_released;
 
-	if (UT_LIST_GET_LEN(trx_sys->trx_serial_list) > 0) {
+		/* NOTE that a transaction whose trx number is <
+		trx_sys->max_trx_id can still be active, if it is in the
+		middle of its commit! Note that when a transaction starts,
+		we initialize trx->no to TRX_ID_MAX. */
 
-		trx_id_t	trx_no;
+		serial_min_no = sys->serial_min_no;
 
-		trx_no = UT_LIST_GET_FIRST(trx_sys->trx_serial_list)->no;
+		for (i = 0, n = 0; i < n_used; i++) {
+			trx_id_t	id = descr[i];
 
-		if (trx_no < view->low_limit_no) {
-			view->low_limit_no = trx_no;
+			if (id != cr_trx_id) {
+				view->descriptors[n++] = id;
+			}
 		}
+
+		view->n_descr = n;
+
+		os_rmb;
+
+		if (UNIV_LIKELY(sys->descr_version == version)) {
+
+			break;
+		}
+	}
+
+	view->undo_no = 0;
+	view->type = VIEW_NORMAL;
+	view->creator_trx_id = cr_trx_id;
+
+	if (serial_min_no < view->low_limit_no) {
+		view->low_limit_no = serial_min_no;
 	}
 
 	if (UNIV_LIKELY(view->n_descr > 0)) {
@@ -364,36 +391,239 @@ read_view_open_now_low(
 		view->up_limit_id = view->low_limit_id;
 	}
 
-	/* Purge views are not added to the view list. */
-	if (cr_trx_id > 0) {
-		read_view_add(view);
-	}
+	ut_ad(read_view_validate(view));
 
 	return(view);
 }
 
 /*********************************************************************//**
-Opens a read view where exactly the transactions serialized before this
-point in time are seen in the view.
-@return	own: read view struct */
+Gets the pre-allocated read view of a transaction, creating it if it does
+not exist yet. A new view is not in trx_sys->view_list.
+@return	trx->prebuilt_view */
+static
+read_view_t*
+read_view_get_prebuilt(
+/*===================*/
+	trx_t*		trx)		/*!< in/out: transaction */
+{
+	if (UNIV_UNLIKELY(trx->prebuilt_view == NULL)) {
+		read_view_t*	view;
+
+		view = read_view_create_low(0, trx->prebuilt_view);
+		view->trx = trx;
+	}
+
+	ut_ad(trx->prebuilt_view->trx == trx);
+
+	return(trx->prebuilt_view);
+}
+
+/*********************************************************************//**
+Opens the pre-allocated read view of a transaction, where exactly the
+transactions serialized before this point in time are seen in the view.
+If no transaction has committed since the previous snapshot of the view
+was taken, that snapshot is reused without acquiring any global mutex.
+Otherwise the snapshot is copied without trx_sys->mutex, and the mutex
+is only held for moving the view to the start of trx_sys->view_list.
+@return	read view struct */
 UNIV_INTERN
 read_view_t*
 read_view_open_now(
 /*===============*/
-	trx_id_t	cr_trx_id,	/*!< in: trx_id of creating
-					transaction, or 0 used in purge */
-	read_view_t*&	view)		/*!< in,out: pre-allocated view array or
-					NULL if a new one needs to be created */
+	trx_t*		trx)		/*!< in/out: transaction */
 {
+	read_view_t*	view;
+
+	view = read_view_get_prebuilt(trx);
+
+	ut_ad(view->state == READ_VIEW_CLOSED);
+
+	/* The previous snapshot sees the same transactions as a new one
+	would, unless a transaction has committed since it was taken:
+	the transactions started since then are invisible in both. It
+	does not see the changes of the current transaction unless it
+	was created by it, which only matters if the current transaction
+	can modify data. The view keeps its place in trx_sys->view_list,
+	unless purge has removed it from there while it was closed;
+	view->in_list is only changed under trx->mutex by others. */
+
+	trx_mutex_enter(trx);
+
+	if (view->in_list
+	    && view->n_released == trx_sys->descr_n_released
+	    && (view->creator_trx_id == trx->id
+		|| trx_is_autocommit_non_locking(trx))) {
+
+		view->creator_trx_id = trx->id;
+		view->state = READ_VIEW_OPEN;
+
+		trx_mutex_exit(trx);
+
+		return(view);
+	}
+
+	trx_mutex_exit(trx);
+
+	read_view_open_now_low(trx->id, view);
+
 	mutex_enter(&trx_sys->mutex);
 
-	view = read_view_open_now_low(cr_trx_id, view);
+	/* trx_sys->view_list is ordered by the age of the snapshots.
+	If a transaction has committed since the snapshot was taken,
+	a newer snapshot may already be at the start of the list. No
+	transaction can commit while we hold the mutex, so a snapshot
+	taken now will be the newest one. */
+
+	if (view->n_released != trx_sys->descr_n_released) {
+		read_view_open_now_low(trx->id, view);
+	}
+
+	trx_mutex_enter(trx);
+
+	if (view->in_list) {
+		UT_LIST_REMOVE(view_list, trx_sys->view_list, view);
+		view->in_list = false;
+	}
+
+	read_view_add(view);
+
+	view->state = READ_VIEW_OPEN;
+
+	trx_mutex_exit(trx);
 
 	mutex_exit(&trx_sys->mutex);
 
 	return(view);
 }
 
+/*********************************************************************//**
+Opens the pre-allocated read view of a transaction as a copy of another
+read view. The caller must own trx_sys->mutex.
+@return	read view struct */
+UNIV_INTERN
+read_view_t*
+read_view_open_clone(
+/*=================*/
+	trx_t*			trx,	/*!< in/out: transaction */
+	const read_view_t*	view)	/*!< in: view to copy */
+{
+	read_view_t*	clone;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+	ut_ad(view->in_list);
+
+	clone = read_view_get_prebuilt(trx);
+
+	ut_ad(clone->state == READ_VIEW_CLOSED);
+
+	read_view_clone(view, clone);
+
+	/* The copy does not see the changes of view->creator_trx_id,
+	so it must not be reused by the next transaction. */
+	clone->n_released = ULINT_UNDEFINED;
+
+	/* The copy is exactly as old as the original, so it belongs
+	next to it in trx_sys->view_list. */
+
+	trx_mutex_enter(trx);
+
+	if (clone->in_list) {
+		UT_LIST_REMOVE(view_list, trx_sys->view_list, clone);
+	}
+
+	UT_LIST_INSERT_AFTER(view_list, trx_sys->view_list,
+			     const_cast<read_view_t*>(view), clone);
+	clone->in_list = true;
+
+	clone->state = READ_VIEW_OPEN;
+
+	trx_mutex_exit(trx);
+
+	return(clone);
+}
+
+/*********************************************************************//**
+Clones the oldest open read view in trx_sys->view_list. The caller must
+own trx_sys->mutex. The list is ordered by the age of the snapshots, so
+the oldest open view is the last one that is open. The closed views of
+transactions that are passed over on the way are removed from the list,
+so that each closed view is examined only once.
+@return	clone of the oldest open view, or NULL if no view is open */
+UNIV_INTERN
+read_view_t*
+read_view_clone_oldest(
+/*===================*/
+	read_view_t*&	prebuilt_clone)	/*!< in,out: prebuilt view or
+					NULL */
+{
+	read_view_t*	view;
+	read_view_t*	oldest_view = NULL;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+	for (view = UT_LIST_GET_LAST(trx_sys->view_list);
+	     view != NULL && oldest_view == NULL; ) {
+
+		read_view_t*	prev_view = UT_LIST_GET_PREV(view_list, view);
+
+		if (view->trx == NULL) {
+			/* A cursor view is open while it is in the list */
+			ut_ad(view->state == READ_VIEW_OPEN);
+
+			oldest_view = read_view_clone(view, prebuilt_clone);
+		} else {
+			/* The views of transactions are opened and
+			closed under trx->mutex. */
+
+			trx_mutex_enter(view->trx);
+
+			if (view->state == READ_VIEW_OPEN) {
+				ut_ad(read_view_validate(view));
+
+				oldest_view = read_view_clone(
+					view, prebuilt_clone);
+			} else {
+				UT_LIST_REMOVE(view_list, trx_sys->view_list,
+					       view);
+				view->in_list = false;
+			}
+
+			trx_mutex_exit(view->trx);
+		}
+
+		view = prev_view;
+	}
+
+	return(oldest_view);
+}
+
+/*********************************************************************//**
+Counts the open read views in trx_sys->view_list. The caller must own
+trx_sys->mutex. The views of transactions can be opened and closed
+concurrently, so the count is approximate.
+@return	number of open read views */
+UNIV_INTERN
+ulint
+read_view_get_n_open(void)
+/*======================*/
+{
+	const read_view_t*	view;
+	ulint			n_open = 0;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+	for (view = UT_LIST_GET_FIRST(trx_sys->view_list);
+	     view != NULL;
+	     view = UT_LIST_GET_NEXT(view_list, view)) {
+
+		if (view->state == READ_VIEW_OPEN) {
+			n_open++;
+		}
+	}
+
+	return(n_open);
+}
+
 /*********************************************************************//**
 Makes a copy of the oldest existing read view, with the exception that also
 the creating trx of the oldest view is set as not visible in the 'copied'
@@ -418,7 +648,9 @@ read_view_purge_open(
 
 	mutex_enter(&trx_sys->mutex);
 
-	oldest_view = UT_LIST_GET_LAST(trx_sys->view_list);
+	/* Clone the oldest view to a pre-allocated clone view */
+
+	oldest_view = read_view_clone_oldest(prebuilt_clone);
 
 	if (oldest_view == NULL) {
 
@@ -429,12 +661,6 @@ read_view_purge_open(
 		return(view);
 	}
 
-	/* Clone the oldest view to a pre-allocated clone view */
-
-	oldest_view = read_view_clone(oldest_view, prebuilt_clone);
-
-	ut_ad(read_view_validate(oldest_view));
-
 	mutex_exit(&trx_sys->mutex);
 
 	ut_a(oldest_view->creator_trx_id > 0);
@@ -492,7 +718,7 @@ read_view_close_for_mysql(
 {
 	ut_a(trx->global_read_view);
 
-	read_view_remove(trx->global_read_view, false);
+	read_view_close(trx->global_read_view, false);
 
 	trx->read_view = NULL;
 	trx->global_read_view = NULL;
@@ -541,17 +767,18 @@ UNIV_INTERN
 i_s_xtradb_read_view_t*
 read_fill_i_s_xtradb_read_view(i_s_xtradb_read_view_t* rv)
 {
-	read_view_t*    view;
+	read_view_t*    view = NULL;
 
 	mutex_enter(&trx_sys->mutex);
 
-	if (UT_LIST_GET_LEN(trx_sys->view_list)) {
-		view = UT_LIST_GET_LAST(trx_sys->view_list);
-	} else {
+	if (!read_view_clone_oldest(view)) {
 		mutex_exit(&trx_sys->mutex);
+		read_view_free(view);
 		return NULL;
 	}
 
+	mutex_exit(&trx_sys->mutex);
+
 	if (view->type == VIEW_HIGH_GRANULARITY) {
 		rv->undo_no = view->undo_no;
 	} else {
@@ -562,7 +789,7 @@ read_fill_i_s_xtradb_read_view(i_s_xtradb_read_view_t* rv)
 	rv->up_limit_id = view->up_limit_id;
 	rv->low_limit_id = view->low_limit_id;
 
-	mutex_exit(&trx_sys->mutex);
+	read_view_free(view);
 
 	return rv;
 }
@@ -632,6 +859,9 @@ read_cursor_view_create_for_mysql(
 	view = curview->read_view;
 	view->undo_no = cr_trx->undo_no;
 	view->type = VIEW_HIGH_GRANULARITY;
+	view->state = READ_VIEW_OPEN;
+
+	read_view_add(view);
 
 	mutex_exit(&trx_sys->mutex);
 
@@ -94,6 +94,8 @@ ins_node_create(
 
 	node->entry_sys_heap = mem_heap_create(128);
 
+	node->append_hint.block = NULL;
+
 	node->magic_n = INS_NODE_MAGIC_N;
 
 	return(node);
@@ -2302,6 +2304,62 @@ row_ins_must_modify_rec(
 	       && !page_rec_is_infimum(btr_cur_get_rec(cursor)));
 }
 
+/***************************************************************//**
+Positions a cursor for inserting an entry into a clustered index without
+descending the tree, if the entry sorts after the last record of the
+rightmost leaf page remembered in the append hint. Because no record in
+the index can then have the same key, there is no need to look for
+duplicates or delete-marked records to convert the insert into an update.
+@return true if the cursor was positioned and the page x-latched in mtr */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+bool
+row_ins_clust_index_entry_append(
+/*=============================*/
+	dict_index_t*	index,	/*!< in: clustered index */
+	ulint		n_uniq,	/*!< in: 0 or index->n_uniq */
+	const dtuple_t*	entry,	/*!< in: index entry to insert */
+	btr_append_hint_t* append_hint,
+				/*!< in/out: position of the previous
+				append to the index */
+	btr_cur_t*	cursor,	/*!< out: cursor */
+	ulint**		offsets,/*!< in/out: rec_get_offsets() */
+	mem_heap_t**	offsets_heap,
+				/*!< in/out: memory heap for offsets */
+	mtr_t*		mtr)	/*!< in/out: mini-transaction */
+{
+	const rec_t*	rec;
+	ulint		matched_fields	= 0;
+	ulint		matched_bytes	= 0;
+
+	if (!btr_cur_open_at_append_hint(index, append_hint, cursor, mtr)) {
+		return(false);
+	}
+
+	rec = btr_cur_get_rec(cursor);
+
+	if (!page_rec_is_infimum(rec)) {
+		*offsets = rec_get_offsets(rec, index, *offsets,
+					   ULINT_UNDEFINED, offsets_heap);
+
+		if (cmp_dtuple_rec_with_match(entry, rec, *offsets,
+					      &matched_fields,
+					      &matched_bytes) <= 0
+		    || (n_uniq && matched_fields >= n_uniq)) {
+			/* Not an append, or a duplicate key. */
+			mtr_memo_release(mtr, btr_cur_get_block(cursor),
+					 MTR_MEMO_PAGE_X_FIX);
+			return(false);
+		}
+	}
+
+	cursor->low_match = matched_fields;
+	cursor->low_bytes = matched_bytes;
+	cursor->up_match = 0;
+	cursor->up_bytes = 0;
+
+	return(true);
+}
+
 /***************************************************************//**
 Tries to insert an entry into a clustered index, ignoring foreign key
 constraints. If a record with the same unique key is found, the other
@@ -2325,7 +2383,10 @@ row_ins_clust_index_entry_low(
 	ulint		n_uniq,	/*!< in: 0 or index->n_uniq */
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	ulint		n_ext,	/*!< in: number of externally stored columns */
-	que_thr_t*	thr)	/*!< in: query thread */
+	que_thr_t*	thr,	/*!< in: query thread */
+	btr_append_hint_t* append_hint)
+				/*!< in/out: position of the previous
+				append to the index, or NULL */
 {
 	btr_cur_t	cursor;
 	ulint*		offsets		= NULL;
@@ -2365,12 +2426,23 @@ row_ins_clust_index_entry_low(
 
 	cursor.thr = thr;
 
-	/* Note that we use PAGE_CUR_LE as the search mode, because then
-	the function will return in both low_match and up_match of the
-	cursor sensible values */
+	if (append_hint != NULL
+	    && search_mode == BTR_MODIFY_LEAF
+	    && row_ins_clust_index_entry_append(
+		    index, n_uniq, entry, append_hint, &cursor,
+		    &offsets, &offsets_heap, &mtr)) {
 
-	btr_cur_search_to_nth_level(index, 0, entry, PAGE_CUR_LE, search_mode,
-				    &cursor, 0, __FILE__, __LINE__, &mtr);
+		/* The entry goes after the last record of the index:
+		the rightmost leaf page was latched directly. */
+	} else {
+		/* Note that we use PAGE_CUR_LE as the search mode,
+		because then the function will return in both
+		low_match and up_match of the cursor sensible values */
+
+		btr_cur_search_to_nth_level(
+			index, 0, entry, PAGE_CUR_LE, search_mode,
+			&cursor, 0, __FILE__, __LINE__, &mtr);
+	}
 
 #ifdef UNIV_DEBUG
 	{
@@ -2512,6 +2584,14 @@ err_exit:
 				flags, &cursor, &offsets, &offsets_heap,
 				entry, &insert_rec, &big_rec,
 				n_ext, thr, &mtr);
+
+			if (append_hint != NULL && err == DB_SUCCESS
+			    && search_mode == BTR_MODIFY_LEAF) {
+				btr_cur_store_append_hint(
+					append_hint,
+					btr_cur_get_block(&cursor),
+					insert_rec, &mtr);
+			}
 		} else {
 			if (buf_LRU_buf_pool_running_out()) {
 
@@ -2918,7 +2998,10 @@ row_ins_clust_index_entry(
 	dict_index_t*	index,	/*!< in: clustered index */
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	que_thr_t*	thr,	/*!< in: query thread */
-	ulint		n_ext)	/*!< in: number of externally stored columns */
+	ulint		n_ext,	/*!< in: number of externally stored columns */
+	btr_append_hint_t* append_hint)
+				/*!< in/out: position of the previous
+				append to the index, or NULL */
 {
 	dberr_t	err;
 	ulint	n_uniq;
@@ -2934,12 +3017,17 @@ row_ins_clust_index_entry(
 
 	n_uniq = dict_index_is_unique(index) ? index->n_uniq : 0;
 
+	if (dict_index_is_online_ddl(index)) {
+		row_log_table_throttle(index);
+	}
+
 	/* Try first optimistic descent to the B-tree */
 
 	log_free_check();
 
 	err = row_ins_clust_index_entry_low(
-		0, BTR_MODIFY_LEAF, index, n_uniq, entry, n_ext, thr);
+		0, BTR_MODIFY_LEAF, index, n_uniq, entry, n_ext, thr,
+		append_hint);
 
 #ifdef UNIV_DEBUG
 	/* Work around Bug#14626800 ASSERTION FAILURE IN DEBUG_SYNC().
@@ -2960,7 +3048,8 @@ row_ins_clust_index_entry(
 	log_free_check();
 
 	return(row_ins_clust_index_entry_low(
-		       0, BTR_MODIFY_TREE, index, n_uniq, entry, n_ext, thr));
+		       0, BTR_MODIFY_TREE, index, n_uniq, entry, n_ext, thr,
+		       append_hint));
 }
 
 /***************************************************************//**
@@ -3028,6 +3117,7 @@ static
 dberr_t
 row_ins_index_entry(
 /*================*/
+	ins_node_t*	node,	/*!< in/out: row insert node */
 	dict_index_t*	index,	/*!< in: index */
 	dtuple_t*	entry,	/*!< in/out: index entry to insert */
 	que_thr_t*	thr)	/*!< in: query thread */
@@ -3037,7 +3127,8 @@ row_ins_index_entry(
 			return(DB_LOCK_WAIT);});
 
 	if (dict_index_is_clust(index)) {
-		return(row_ins_clust_index_entry(index, entry, thr, 0));
+		return(row_ins_clust_index_entry(
+			       index, entry, thr, 0, &node->append_hint));
 	} else {
 		return(row_ins_sec_index_entry(index, entry, thr));
 	}
@@ -3114,7 +3205,11 @@ row_ins_index_entry_step(
 
 	ut_ad(dtuple_check_typed(node->entry));
 
-	err = row_ins_index_entry(node->index, node->entry, thr);
+	err = row_ins_index_entry(node, node->index, node->entry, thr);
+
+	if (err == DB_SUCCESS) {
+		node->index->stat_modified_counter++;
+	}
 
 #ifdef UNIV_DEBUG
 	/* Work around Bug#14626800 ASSERTION FAILURE IN DEBUG_SYNC().
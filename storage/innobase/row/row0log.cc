@@ -404,6 +404,59 @@ row_log_table_get_error(
 	return(index->online_log->error);
 }
 
+/******************************************************//**
+Delays a DML operation on a table that is being rebuilt online while
+the modification log is more than half full, so that the log can be
+applied faster than it is written. The log is full when the temporary
+file reaches innodb_online_alter_log_max_size. The file only shrinks
+once every block written to it has been applied, so its size, not the
+unapplied part of the log, is what is compared. The caller must not
+hold any latches. */
+UNIV_INTERN
+void
+row_log_table_throttle(
+/*===================*/
+	dict_index_t*	index)	/*!< in/out: clustered index */
+{
+	ib_uint64_t	file_size = 0;
+	ib_uint64_t	limit = srv_online_max_size / 2;
+	ulint		delay;
+
+	ut_ad(dict_index_is_clust(index));
+
+	if (srv_online_max_delay == 0) {
+		return;
+	}
+
+	/* index->online_log is freed under the X-latch when the
+	rebuild completes or is aborted. The number of blocks is read
+	without log->mutex; a stale value only shifts the delay. */
+	rw_lock_s_lock(dict_index_get_lock(index));
+
+	if (dict_index_is_online_ddl(index) && index->online_log->table) {
+		const row_log_t*	log = index->online_log;
+
+		file_size = (ib_uint64_t) log->tail.blocks * srv_sort_buf_size;
+	}
+
+	rw_lock_s_unlock(dict_index_get_lock(index));
+
+	if (file_size <= limit) {
+		return;
+	}
+
+	/* Increase the delay linearly until the log is full. */
+	delay = (ulint) ut_min(
+		(ib_uint64_t) srv_online_max_delay,
+		srv_online_max_delay * (file_size - limit) / limit + 1);
+
+	MONITOR_ATOMIC_INC(MONITOR_ONLINE_LOG_THROTTLED);
+
+	DEBUG_SYNC_C("row_log_table_throttle");
+
+	os_thread_sleep(delay);
+}
+
 /******************************************************//**
 Starts logging an operation to a table that is being rebuilt.
 @return pointer to log, or NULL if no logging is necessary */
@@ -497,6 +550,7 @@ write_failed:
 	}
 
 	log->tail.total += size;
+	MONITOR_INC_VALUE(MONITOR_ONLINE_LOG_WRITTEN, size);
 	UNIV_MEM_INVALID(log->tail.buf, sizeof log->tail.buf);
 err_exit:
 	mutex_exit(&log->mutex);
@@ -1507,7 +1561,8 @@ row_log_table_apply_insert_low(
 	entry = row_build_index_entry(row, NULL, index, heap);
 
 	error = row_ins_clust_index_entry_low(
-		flags, BTR_MODIFY_TREE, index, index->n_uniq, entry, 0, thr);
+		flags, BTR_MODIFY_TREE, index, index->n_uniq, entry, 0, thr,
+		NULL);
 
 	switch (error) {
 	case DB_SUCCESS:
@@ -2466,6 +2521,8 @@ row_log_table_apply_op(
 	}
 
 	ut_ad(log->head.total <= log->tail.total);
+	MONITOR_INC(MONITOR_ONLINE_LOG_APPLIED_OPS);
+	MONITOR_INC_VALUE(MONITOR_ONLINE_LOG_APPLIED, next_mrec - mrec_start);
 	mem_heap_empty(offsets_heap);
 	mem_heap_empty(heap);
 	return(next_mrec);
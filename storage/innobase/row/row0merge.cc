@@ -2474,6 +2474,7 @@ row_merge_insert_index_tuples(
 	ulint			foffs = 0;
 	ulint*			offsets;
 	mrec_buf_t*		buf;
+	btr_append_hint_t	append_hint;
 	DBUG_ENTER("row_merge_insert_index_tuples");
 
 	ut_ad(!srv_read_only_mode);
@@ -2482,6 +2483,11 @@ row_merge_insert_index_tuples(
 
 	tuple_heap = mem_heap_create(1000);
 
+	/* The tuples arrive in ascending order: keep appending to the
+	rightmost leaf page without descending the tree for each tuple,
+	until that page is split. */
+	append_hint.block = NULL;
+
 	{
 		ulint i	= 1 + REC_OFFS_HEADER_SIZE
 			+ dict_index_get_n_fields(index);
@@ -2568,14 +2574,18 @@ row_merge_insert_index_tuples(
 
 			mtr_start(&mtr);
 			/* Insert after the last user record. */
-			btr_cur_open_at_index_side(
-				false, index, BTR_MODIFY_LEAF,
-				&cursor, 0, &mtr);
-			page_cur_position(
-				page_rec_get_prev(btr_cur_get_rec(&cursor)),
-				btr_cur_get_block(&cursor),
-				btr_cur_get_page_cur(&cursor));
-			cursor.flag = BTR_CUR_BINARY;
+			if (!btr_cur_open_at_append_hint(
+				    index, &append_hint, &cursor, &mtr)) {
+				btr_cur_open_at_index_side(
+					false, index, BTR_MODIFY_LEAF,
+					&cursor, 0, &mtr);
+				page_cur_position(
+					page_rec_get_prev(
+						btr_cur_get_rec(&cursor)),
+					btr_cur_get_block(&cursor),
+					btr_cur_get_page_cur(&cursor));
+				cursor.flag = BTR_CUR_BINARY;
+			}
 #ifdef UNIV_DEBUG
 			/* Check that the records are inserted in order. */
 			rec = btr_cur_get_rec(&cursor);
@@ -2596,7 +2606,11 @@ row_merge_insert_index_tuples(
 				&cursor, &ins_offsets, &ins_heap,
 				dtuple, &rec, &big_rec, 0, NULL, &mtr);
 
-			if (error == DB_FAIL) {
+			if (error == DB_SUCCESS) {
+				btr_cur_store_append_hint(
+					&append_hint,
+					btr_cur_get_block(&cursor), rec, &mtr);
+			} else if (error == DB_FAIL) {
 				ut_ad(!big_rec);
 				mtr_commit(&mtr);
 				mtr_start(&mtr);
@@ -3602,6 +3616,248 @@ row_merge_drop_table(
 	return(row_drop_table_for_mysql(table->name, trx, false, false));
 }
 
+/** Shared state of the threads that sort and load the secondary
+indexes of row_merge_build_indexes() in parallel. Only non-unique
+indexes are built this way, because they never report duplicates
+through the MySQL record buffer, which exists only once per table. */
+struct row_merge_bulk_t {
+	trx_t*		trx;		/*!< transaction */
+	dict_table_t*	old_table;	/*!< table where rows are read from */
+	dict_index_t**	indexes;	/*!< indexes being created */
+	merge_file_t*	merge_files;	/*!< sort files, one per index */
+	const ulint*	col_map;	/*!< column mapping, or NULL */
+	const char*	path;		/*!< directory for temporary files */
+	const ulint*	todo;		/*!< positions in indexes[] that
+					may be built by any thread */
+	ulint		n_todo;		/*!< number of elements in todo[] */
+	volatile ulint	next;		/*!< next element of todo[] to claim */
+	dberr_t*	errors;		/*!< outcome of each index build */
+	volatile bool*	done;		/*!< whether each index is built */
+	volatile bool	abort;		/*!< true if the threads should skip
+					the indexes that they claim */
+	os_event_t	event;		/*!< signalled when an index is built */
+	os_thread_t*	threads;	/*!< helper threads */
+	ulint		n_threads;	/*!< number of elements in threads[] */
+	mem_heap_t*	heap;		/*!< memory heap for this object */
+};
+
+/*********************************************************************//**
+Claim the next unclaimed index of a parallel index build, and sort and
+insert its entries.
+@return	true if an index was claimed, false if none were left */
+static MY_ATTRIBUTE((nonnull(1,3), warn_unused_result))
+bool
+row_merge_bulk_build_next(
+/*======================*/
+	row_merge_bulk_t*	bulk,	/*!< in/out: parallel build state */
+	row_merge_block_t*	block,	/*!< in/out: 3 buffers, or NULL
+					if allocating them failed */
+	int*			tmpfd)	/*!< in/out: temporary file handle */
+{
+	ulint	n = os_atomic_increment_ulint(&bulk->next, 1) - 1;
+
+	if (n >= bulk->n_todo) {
+		return(false);
+	}
+
+	ulint		i	= bulk->todo[n];
+	dict_index_t*	index	= bulk->indexes[i];
+	merge_file_t*	file	= &bulk->merge_files[i];
+	dberr_t		error;
+
+	ut_ad(!dict_index_is_unique(index));
+	ut_ad(!(index->type & DICT_FTS));
+	ut_ad(file->fd != -1);
+
+	if (bulk->abort) {
+		error = DB_INTERRUPTED;
+	} else if (block == NULL) {
+		error = DB_OUT_OF_MEMORY;
+	} else if (file->offset > 1
+		   && *tmpfd < 0
+		   && (*tmpfd = row_merge_file_create_low(bulk->path)) < 0) {
+		error = DB_OUT_OF_MEMORY;
+	} else {
+		row_merge_dup_t	dup = {index, NULL, bulk->col_map, 0};
+
+		error = row_merge_sort(bulk->trx, &dup, file, block, tmpfd);
+
+		if (error == DB_SUCCESS) {
+			error = row_merge_insert_index_tuples(
+				bulk->trx->id, index, bulk->old_table,
+				file->fd, block);
+		}
+	}
+
+	bulk->errors[i] = error;
+	os_wmb;
+	bulk->done[i] = true;
+	os_event_set(bulk->event);
+
+	return(true);
+}
+
+/*********************************************************************//**
+Thread that builds secondary indexes for row_merge_build_indexes()
+until no unclaimed index is left.
+@return	a dummy parameter */
+static
+os_thread_ret_t
+row_merge_bulk_thread(
+/*==================*/
+	void*	arg)	/*!< in/out: row_merge_bulk_t */
+{
+	row_merge_bulk_t*	bulk = static_cast<row_merge_bulk_t*>(arg);
+	ulint			block_size = 3 * srv_sort_buf_size;
+	row_merge_block_t*	block;
+	int			tmpfd = -1;
+
+	block = static_cast<row_merge_block_t*>(
+		os_mem_alloc_large(&block_size));
+
+	while (row_merge_bulk_build_next(bulk, block, &tmpfd)) {
+		/* Keep building until all indexes are claimed. */
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	if (block != NULL) {
+		os_mem_free_large(block, block_size);
+	}
+
+	os_thread_exit(NULL, false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Start helper threads for building the secondary indexes that
+row_merge_build_indexes() has collected sort files for, if the
+connection allows more than one index build thread and there is more
+than one index that can be built in parallel.
+@return	parallel build state, or NULL if the indexes should be built
+by the calling thread alone */
+static MY_ATTRIBUTE((nonnull(1,2,3,4), warn_unused_result))
+row_merge_bulk_t*
+row_merge_bulk_create(
+/*==================*/
+	trx_t*		trx,		/*!< in: transaction */
+	dict_table_t*	old_table,	/*!< in: table where rows are
+					read from */
+	dict_index_t**	indexes,	/*!< in: indexes to be created */
+	merge_file_t*	merge_files,	/*!< in/out: sort files */
+	ulint		n_indexes,	/*!< in: size of indexes[] */
+	const ulint*	col_map)	/*!< in: mapping of old column
+					numbers to new ones, or NULL */
+{
+	ulint			n_threads = thd_ddl_threads(trx->mysql_thd);
+	mem_heap_t*		heap;
+	row_merge_bulk_t*	bulk;
+	ulint*			todo;
+	ulint			n_todo = 0;
+
+	if (n_threads <= 1) {
+		return(NULL);
+	}
+
+	heap = mem_heap_create(256);
+	todo = static_cast<ulint*>(
+		mem_heap_alloc(heap, n_indexes * sizeof *todo));
+
+	for (ulint i = 0; i < n_indexes; i++) {
+		if (merge_files[i].fd != -1
+		    && !(indexes[i]->type & DICT_FTS)
+		    && !dict_index_is_unique(indexes[i])) {
+			todo[n_todo++] = i;
+		}
+	}
+
+	if (n_todo < 2) {
+		mem_heap_free(heap);
+		return(NULL);
+	}
+
+	bulk = static_cast<row_merge_bulk_t*>(
+		mem_heap_zalloc(heap, sizeof *bulk));
+
+	bulk->trx = trx;
+	bulk->old_table = old_table;
+	bulk->indexes = indexes;
+	bulk->merge_files = merge_files;
+	bulk->col_map = col_map;
+	bulk->path = thd_innodb_tmpdir(trx->mysql_thd);
+	bulk->todo = todo;
+	bulk->n_todo = n_todo;
+	bulk->errors = static_cast<dberr_t*>(
+		mem_heap_alloc(heap, n_indexes * sizeof *bulk->errors));
+	bulk->done = static_cast<bool*>(
+		mem_heap_zalloc(heap, n_indexes * sizeof *bulk->done));
+	bulk->event = os_event_create();
+	bulk->heap = heap;
+
+	/* The calling thread builds indexes as well while it waits. */
+	bulk->n_threads = ut_min(n_threads, n_todo) - 1;
+	bulk->threads = static_cast<os_thread_t*>(
+		mem_heap_alloc(heap, bulk->n_threads * sizeof *bulk->threads));
+
+	for (ulint i = 0; i < bulk->n_threads; i++) {
+		bulk->threads[i] = os_thread_create(
+			row_merge_bulk_thread, bulk, NULL);
+	}
+
+	return(bulk);
+}
+
+/*********************************************************************//**
+Wait until a secondary index that is being built in parallel has been
+built, helping with the unclaimed indexes meanwhile.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_bulk_wait(
+/*================*/
+	row_merge_bulk_t*	bulk,	/*!< in/out: parallel build state */
+	ulint			i,	/*!< in: position in indexes[] */
+	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
+	int*			tmpfd)	/*!< in/out: temporary file handle */
+{
+	while (!bulk->done[i]) {
+		if (row_merge_bulk_build_next(bulk, block, tmpfd)) {
+			continue;
+		}
+
+		ib_int64_t	sig_count = os_event_reset(bulk->event);
+
+		if (bulk->done[i]) {
+			break;
+		}
+
+		os_event_wait_low(bulk->event, sig_count);
+	}
+
+	os_rmb;
+	return(bulk->errors[i]);
+}
+
+/*********************************************************************//**
+Stop the helper threads of a parallel index build and free it. The
+indexes that have not been claimed yet will not be built. */
+static MY_ATTRIBUTE((nonnull))
+void
+row_merge_bulk_free(
+/*================*/
+	row_merge_bulk_t*	bulk)	/*!< in,own: parallel build state */
+{
+	bulk->abort = true;
+
+	for (ulint i = 0; i < bulk->n_threads; i++) {
+		os_thread_join(bulk->threads[i]);
+	}
+
+	os_event_free(bulk->event);
+	mem_heap_free(bulk->heap);
+}
+
 /*********************************************************************//**
 Build indexes on a table by reading a clustered index,
 creating a temporary file containing index entries, merge sorting
@@ -3648,6 +3904,7 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	ib_int64_t		sig_count = 0;
 	bool			fts_psort_initiated = false;
+	row_merge_bulk_t*	bulk = NULL;
 	DBUG_ENTER("row_merge_build_indexes");
 
 	ut_ad(!srv_read_only_mode);
@@ -3712,7 +3969,11 @@ row_merge_build_indexes(
 	innobase_rec_reset(table);
 
 	/* Read clustered index of the table and create files for
-	secondary index entries for merge sort */
+	secondary index entries for merge sort. This thread scans the
+	whole clustered index alone, whatever innodb_ddl_threads is,
+	because the scan also writes the online table rebuild log,
+	assigns AUTO_INCREMENT values and tokenizes FULLTEXT columns
+	in clustered index order. */
 
 	error = row_merge_read_clustered_index(
 		trx, table, old_table, new_table, online, indexes,
@@ -3728,7 +3989,14 @@ row_merge_build_indexes(
 	DEBUG_SYNC_C("row_merge_after_scan");
 
 	/* Now we have files containing index entries ready for
-	sorting and inserting. */
+	sorting and inserting. Non-unique secondary indexes may be
+	sorted and inserted by several threads at once, but each index
+	is merge sorted by one thread, so a single index is not built
+	any faster. The online log is still applied below, one index
+	at a time. */
+
+	bulk = row_merge_bulk_create(
+		trx, old_table, indexes, merge_files, n_indexes, col_map);
 
 	for (i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
@@ -3806,6 +4074,9 @@ wait_again:
 #ifdef FTS_INTERNAL_DIAG_PRINT
 			DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Insert\n");
 #endif
+		} else if (bulk && !dict_index_is_unique(sort_idx)
+			   && merge_files[i].fd != -1) {
+			error = row_merge_bulk_wait(bulk, i, block, &tmpfd);
 		} else if (merge_files[i].fd != -1) {
 			row_merge_dup_t	dup = {
 				sort_idx, table, col_map, 0};
@@ -3858,6 +4129,10 @@ wait_again:
 	}
 
 func_exit:
+	if (bulk != NULL) {
+		row_merge_bulk_free(bulk);
+	}
+
 	DBUG_EXECUTE_IF(
 		"ib_build_indexes_too_many_concurrent_trxs",
 		error = DB_TOO_MANY_CONCURRENT_TRXS;
@@ -213,6 +213,8 @@ row_purge_remove_clust_if_poss(
 		return(true);
 	}
 
+	MONITOR_INC(MONITOR_PURGE_PESSIMISTIC);
+
 	for (ulint n_tries = 0;
 	     n_tries < BTR_CUR_RETRY_DELETE_N_TIMES;
 	     n_tries++) {
@@ -532,6 +534,9 @@ row_purge_remove_sec_if_poss(
 
 		return;
 	}
+
+	MONITOR_INC(MONITOR_PURGE_PESSIMISTIC);
+
 retry:
 	success = row_purge_remove_sec_if_poss_tree(node, index, entry);
 	/* The delete operation may fail if we have little
@@ -3418,7 +3418,8 @@ row_sel_dequeue_cached_row_for_mysql(
 }
 
 /********************************************************************//**
-Initialise the prefetch cache. */
+Initialise the prefetch cache with room for prebuilt->fetch_cache_limit
+rows. The row pointers and the rows themselves share one allocation. */
 UNIV_INLINE
 void
 row_sel_prefetch_cache_init(
@@ -3426,14 +3427,21 @@ row_sel_prefetch_cache_init(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ulint	i;
+	ulint	n;
 	ulint	sz;
 	byte*	ptr;
 
-	/* Reserve space for the magic number. */
-	sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
+	n = prebuilt->fetch_cache_limit;
+
+	/* Reserve space for the row pointers and the magic numbers. */
+	sz = n * (sizeof(byte*) + prebuilt->mysql_row_len + 8);
 	ptr = static_cast<byte*>(mem_alloc(sz));
 
-	for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+	prebuilt->fetch_cache = reinterpret_cast<byte**>(ptr);
+	prebuilt->fetch_cache_alloc = n;
+	ptr += n * sizeof(byte*);
+
+	for (i = 0; i < n; i++) {
 
 		/* A user has reported memory corruption in these
 		buffers in Linux. Put magic numbers there to help
@@ -3450,6 +3458,73 @@ row_sel_prefetch_cache_init(
 	}
 }
 
+/********************************************************************//**
+Frees the prefetch cache of a prebuilt struct, checking the magic numbers
+around each cached row. */
+UNIV_INTERN
+void
+row_sel_prefetch_cache_free(
+/*========================*/
+	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
+{
+	ulint	i;
+	byte*	base = reinterpret_cast<byte*>(prebuilt->fetch_cache);
+	byte*	ptr = base + prebuilt->fetch_cache_alloc * sizeof(byte*);
+
+	for (i = 0; i < prebuilt->fetch_cache_alloc; i++) {
+		byte*	row;
+		ulint	magic1;
+		ulint	magic2;
+
+		magic1 = mach_read_from_4(ptr);
+		ptr += 4;
+
+		row = ptr;
+		ptr += prebuilt->mysql_row_len;
+
+		magic2 = mach_read_from_4(ptr);
+		ptr += 4;
+
+		if (ROW_PREBUILT_FETCH_MAGIC_N != magic1
+		    || row != prebuilt->fetch_cache[i]
+		    || ROW_PREBUILT_FETCH_MAGIC_N != magic2) {
+
+			fputs("InnoDB: Error: trying to free"
+				" a corrupt fetch buffer.\n", stderr);
+
+			mem_analyze_corruption(base);
+			ut_error;
+		}
+	}
+
+	mem_free(base);
+
+	prebuilt->fetch_cache = NULL;
+	prebuilt->fetch_cache_alloc = 0;
+}
+
+/********************************************************************//**
+Grows the number of rows fetched into the prefetch cache in one batch.
+Called when a batch filled the cache completely, that is, the cursor is
+doing a long scan: each doubling halves the number of times the cursor
+position has to be stored and restored, until the cache reaches
+MYSQL_FETCH_CACHE_MAX_BYTES. The memory is reallocated lazily by
+row_sel_fetch_last_buf() once the cache has been drained. */
+UNIV_INLINE
+void
+row_sel_prefetch_cache_grow(
+/*========================*/
+	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
+{
+	ulint	max_rows = MYSQL_FETCH_CACHE_MAX_BYTES
+		/ (prebuilt->mysql_row_len + 8);
+
+	if (prebuilt->fetch_cache_limit < max_rows) {
+		prebuilt->fetch_cache_limit = ut_min(
+			2 * prebuilt->fetch_cache_limit, max_rows);
+	}
+}
+
 /********************************************************************//**
 Get the last fetch cache buffer from the queue.
 @return pointer to buffer. */
@@ -3460,12 +3535,18 @@ row_sel_fetch_last_buf(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ut_ad(!prebuilt->templ_contains_blob);
-	ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+	ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
-	if (prebuilt->fetch_cache[0] == NULL) {
-		/* Allocate memory for the fetch cache */
+	if (prebuilt->fetch_cache_alloc < prebuilt->fetch_cache_limit) {
+		/* Allocate memory for the fetch cache, or replace
+		the cache with a bigger one. The cache is only ever
+		grown before a new batch is started. */
 		ut_ad(prebuilt->n_fetch_cached == 0);
 
+		if (prebuilt->fetch_cache != NULL) {
+			row_sel_prefetch_cache_free(prebuilt);
+		}
+
 		row_sel_prefetch_cache_init(prebuilt);
 	}
 
@@ -3522,19 +3603,14 @@ row_sel_try_search_shortcut_for_mysql(
 	ut_ad(dict_index_is_clust(index));
 	ut_ad(!prebuilt->templ_contains_blob);
 
-#ifndef UNIV_SEARCH_DEBUG
-	ut_ad(trx->has_search_latch);
+	ut_ad(!trx->has_search_latch);
 
-	btr_pcur_open_with_no_init(index, search_tuple, PAGE_CUR_GE,
-				   BTR_SEARCH_LEAF, pcur,
-				   RW_S_LATCH,
-				   mtr);
-#else /* UNIV_SEARCH_DEBUG */
+	/* The adaptive hash index is searched without holding its latch.
+	The record is protected by the page latch until mtr_commit(). */
 	btr_pcur_open_with_no_init(index, search_tuple, PAGE_CUR_GE,
 				   BTR_SEARCH_LEAF, pcur,
 				   0,
 				   mtr);
-#endif /* UNIV_SEARCH_DEBUG */
 	rec = btr_pcur_get_rec(pcur);
 
 	if (!page_rec_is_user_rec(rec)) {
@@ -3806,6 +3882,7 @@ row_search_for_mysql(
 		prebuilt->n_rows_fetched = 0;
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
+		prebuilt->fetch_cache_limit = MYSQL_FETCH_CACHE_SIZE;
 
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
@@ -3830,6 +3907,7 @@ row_search_for_mysql(
 			prebuilt->n_rows_fetched = 0;
 			prebuilt->n_fetch_cached = 0;
 			prebuilt->fetch_cache_first = 0;
+			prebuilt->fetch_cache_limit = MYSQL_FETCH_CACHE_SIZE;
 
 		} else if (UNIV_LIKELY(prebuilt->n_fetch_cached > 0)) {
 			row_sel_dequeue_cached_row_for_mysql(buf, prebuilt);
@@ -3841,7 +3919,8 @@ row_search_for_mysql(
 		}
 
 		if (prebuilt->fetch_cache_first > 0
-		    && prebuilt->fetch_cache_first < MYSQL_FETCH_CACHE_SIZE) {
+		    && prebuilt->fetch_cache_first
+		    < prebuilt->fetch_cache_limit) {
 
 			/* The previous returned row was popped from the fetch
 			cache, but the cache was not full at the time of the
@@ -3932,15 +4011,8 @@ row_search_for_mysql(
 			mysql_n_tables_locked == 0, because this might
 			also be INSERT INTO ... SELECT ... or
 			CREATE TABLE ... SELECT ... . Our algorithm is
-			NOT prepared to inserts interleaved with the SELECT,
-			and if we try that, we can deadlock on the adaptive
-			hash index semaphore! */
+			NOT prepared to inserts interleaved with the SELECT. */
 
-#ifndef UNIV_SEARCH_DEBUG
-			ut_ad(!trx->has_search_latch);
-			rw_lock_s_lock(btr_search_get_latch(index));
-			trx->has_search_latch = TRUE;
-#endif
 			switch (row_sel_try_search_shortcut_for_mysql(
 					&rec, prebuilt, &offsets, &heap,
 					&mtr)) {
@@ -3993,7 +4065,7 @@ row_search_for_mysql(
 				fputs(" shortcut\n", stderr); */
 
 				err = DB_SUCCESS;
-				goto release_search_latch;
+				goto shortcut_exit;
 
 			case SEL_EXHAUSTED:
 			shortcut_mismatch:
@@ -4003,11 +4075,7 @@ row_search_for_mysql(
 				fputs(" record not found 2\n", stderr); */
 
 				err = DB_RECORD_NOT_FOUND;
-release_search_latch:
-				rw_lock_s_unlock(
-					btr_search_get_latch(index));
-				trx->has_search_latch = FALSE;
-
+shortcut_exit:
 				/* NOTE that we do NOT store the cursor
 				position */
 				goto func_exit;
@@ -4021,9 +4089,6 @@ release_search_latch:
 
 			mtr_commit(&mtr);
 			mtr_start(&mtr);
-
-			rw_lock_s_unlock(btr_search_get_latch(index));
-			trx->has_search_latch = FALSE;
 		}
 	}
 
@@ -4853,7 +4918,7 @@ requires_clust_rec:
 		not cache rows because there the cursor is a scrollable
 		cursor. */
 
-		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+		ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
@@ -4906,10 +4971,14 @@ requires_clust_rec:
 			row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
 		}
 
-		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+		if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit) {
 			goto next_rec;
 		}
 
+		/* The batch filled the cache while the page latches
+		are held: make the next batch of this scan bigger. */
+		row_sel_prefetch_cache_grow(prebuilt);
+
 	} else {
 		if (UNIV_UNLIKELY
 		    (prebuilt->template_type == ROW_MYSQL_DUMMY_TEMPLATE)) {
@@ -5144,6 +5213,12 @@ normal_return:
 
 	mtr_commit(&mtr);
 
+	if (prebuilt->n_fetch_cached > 0) {
+		srv_stats.n_rows_prefetched.add(
+			(size_t) trx->id, prebuilt->n_fetch_cached);
+		srv_stats.n_rows_prefetch_batches.add((size_t) trx->id, 1);
+	}
+
 	if (prebuilt->idx_cond != 0) {
 
 		/* When ICP is active we don't write to the MySQL buffer
@@ -5260,9 +5335,7 @@ row_search_check_if_query_cache_permitted(
 		if (trx->isolation_level >= TRX_ISO_REPEATABLE_READ
 		    && !trx->read_view) {
 
-			trx->read_view =
-				read_view_open_now(trx->id,
-						   trx->prebuilt_view);
+			trx->read_view = read_view_open_now(trx);
 			trx->global_read_view = trx->read_view;
 		}
 	}
@@ -1863,7 +1863,13 @@ row_upd_sec_step(
 	if (node->state == UPD_NODE_UPDATE_ALL_SEC
 	    || row_upd_changes_ord_field_binary(node->index, node->update,
 						thr, node->row, node->ext)) {
-		return(row_upd_sec_index_entry(node, thr));
+		dberr_t	err = row_upd_sec_index_entry(node, thr);
+
+		if (err == DB_SUCCESS) {
+			node->index->stat_modified_counter++;
+		}
+
+		return(err);
 	}
 
 	return(DB_SUCCESS);
@@ -2074,7 +2080,7 @@ err_exit:
 
 	err = row_ins_clust_index_entry(
 		index, entry, thr,
-		node->upd_ext ? node->upd_ext->n_ext : 0);
+		node->upd_ext ? node->upd_ext->n_ext : 0, NULL);
 	node->state = change_ownership
 		? UPD_NODE_INSERT_BLOB
 		: UPD_NODE_INSERT_CLUSTERED;
@@ -2328,6 +2334,10 @@ row_upd_clust_step(
 
 	pcur = node->pcur;
 
+	if (dict_index_is_online_ddl(index)) {
+		row_log_table_throttle(index);
+	}
+
 	/* We have to restore the cursor to its position */
 
 	mtr_start(&mtr);
@@ -2557,6 +2567,9 @@ row_upd(
 
 			return(err);
 		}
+
+		dict_table_get_first_index(node->table)
+			->stat_modified_counter++;
 	}
 
 	if (node->index == NULL
@@ -49,7 +49,9 @@ SQL query after it has once got the ticket. */
 UNIV_INTERN ulong	srv_n_free_tickets_to_enter = 500;
 
 #ifdef HAVE_ATOMIC_BUILTINS
-/** Maximum sleep delay (in micro-seconds), value of 0 disables it. */
+/** Maximum sleep delay (in micro-seconds), value of 0 disables it. Threads
+wait in a queue and are woken up when they can enter, so this is only used
+when the server is built without atomic builtins. */
 UNIV_INTERN ulong	srv_adaptive_max_sleep_delay = 150000;
 #endif /* HAVE_ATOMIC_BUILTINS */
 
@@ -68,14 +70,58 @@ we could get a deadlock. Value of 0 will disable the concurrency check. */
 
 UNIV_INTERN ulong	srv_thread_concurrency	= 0;
 
-#ifndef HAVE_ATOMIC_BUILTINS
-
 /** This mutex protects srv_conc data structures */
 static os_fast_mutex_t	srv_conc_mutex;
 
+#if defined(UNIV_PFS_MUTEX)
+/* Key to register srv_conc_mutex_key with performance schema */
+UNIV_INTERN mysql_pfs_key_t	srv_conc_mutex_key;
+#endif /* UNIV_PFS_MUTEX */
+
 /** Concurrency list node */
 typedef UT_LIST_NODE_T(struct srv_conc_slot_t)	srv_conc_node_t;
 
+#ifdef HAVE_ATOMIC_BUILTINS
+
+/** Admission classes of the concurrency queue */
+enum srv_conc_class_t {
+	SRV_CONC_SHORT = 0,		/*!< statements that have not used
+					up their tickets */
+	SRV_CONC_LONG,			/*!< statements that have used up
+					their tickets at least once, such
+					as long scans */
+	SRV_CONC_N_CLASSES
+};
+
+/** After this many threads of the short class have been let in while a
+thread of the long class was waiting, the long one goes first */
+#define SRV_CONC_SHORT_BATCH	8
+
+/** Slot for a thread waiting in the concurrency control queue. */
+struct srv_conc_slot_t{
+	os_event_t	event;		/*!< event to wait */
+	bool		granted;	/*!< true when a thread leaving
+					InnoDB has handed its place over
+					to the thread in this slot */
+	srv_conc_node_t	srv_conc_queue;	/*!< node in a wait queue or in
+					the list of free slots */
+};
+
+/** Queue of threads waiting to get in */
+typedef UT_LIST_BASE_NODE_T(srv_conc_slot_t)	srv_conc_queue_t;
+
+/** Threads waiting to get in, in FIFO order, for each class */
+static srv_conc_queue_t	srv_conc_queue[SRV_CONC_N_CLASSES];
+
+/** Wait slots that are not in use */
+static srv_conc_queue_t	srv_conc_free_slots;
+
+/** Number of threads of the short class let in since a thread of the long
+class was last let in while it was waiting */
+static ulint		srv_conc_n_short_grants;
+
+#else /* HAVE_ATOMIC_BUILTINS */
+
 /** Slot for a thread waiting in the concurrency control queue. */
 struct srv_conc_slot_t{
 	os_event_t	event;		/*!< event to wait */
@@ -97,12 +143,7 @@ static srv_conc_queue_t	srv_conc_queue;
 /** Array of wait slots */
 static srv_conc_slot_t*	srv_conc_slots;
 
-#if defined(UNIV_PFS_MUTEX)
-/* Key to register srv_conc_mutex_key with performance schema */
-UNIV_INTERN mysql_pfs_key_t	srv_conc_mutex_key;
-#endif /* UNIV_PFS_MUTEX */
-
-#endif /* !HAVE_ATOMIC_BUILTINS */
+#endif /* HAVE_ATOMIC_BUILTINS */
 
 /** Variables tracking the active and waiting threads. */
 struct srv_conc_t {
@@ -118,6 +159,10 @@ struct srv_conc_t {
 	/** Number of OS threads waiting in the FIFO for permission to
 	enter InnoDB */
 	volatile lint	n_waiting;
+
+	/** Number of transactions inside InnoDB that entered as long
+	statements (trx_t::conc_long) */
+	volatile lint	n_long;
 };
 
 /* Control variables for tracking concurrency. */
@@ -129,13 +174,19 @@ void
 srv_conc_init(void)
 /*===============*/
 {
-#ifndef HAVE_ATOMIC_BUILTINS
-	ulint		i;
-
 	/* Init the server concurrency restriction data structures */
 
 	os_fast_mutex_init(srv_conc_mutex_key, &srv_conc_mutex);
 
+#ifdef HAVE_ATOMIC_BUILTINS
+	for (ulint i = 0; i < SRV_CONC_N_CLASSES; i++) {
+		UT_LIST_INIT(srv_conc_queue[i]);
+	}
+
+	UT_LIST_INIT(srv_conc_free_slots);
+#else
+	ulint		i;
+
 	UT_LIST_INIT(srv_conc_queue);
 
 	srv_conc_slots = static_cast<srv_conc_slot_t*>(
@@ -147,7 +198,7 @@ srv_conc_init(void)
 		conc_slot->event = os_event_create();
 		ut_a(conc_slot->event);
 	}
-#endif /* !HAVE_ATOMIC_BUILTINS */
+#endif /* HAVE_ATOMIC_BUILTINS */
 }
 
 /*********************************************************************//**
@@ -156,15 +207,27 @@ void
 srv_conc_free(void)
 /*===============*/
 {
-#ifndef HAVE_ATOMIC_BUILTINS
 	os_fast_mutex_free(&srv_conc_mutex);
 
+#ifdef HAVE_ATOMIC_BUILTINS
+	for (ulint i = 0; i < SRV_CONC_N_CLASSES; i++) {
+		ut_a(UT_LIST_GET_LEN(srv_conc_queue[i]) == 0);
+	}
+
+	while (srv_conc_slot_t* slot
+	       = UT_LIST_GET_FIRST(srv_conc_free_slots)) {
+
+		UT_LIST_REMOVE(srv_conc_queue, srv_conc_free_slots, slot);
+		os_event_free(slot->event);
+		ut_free(slot);
+	}
+#else
 	for (ulint i = 0; i < OS_THREAD_MAX_N; i++)
 		os_event_free(srv_conc_slots[i].event);
 
 	mem_free(srv_conc_slots);
 	srv_conc_slots = NULL;
-#endif /* !HAVE_ATOMIC_BUILTINS */
+#endif /* HAVE_ATOMIC_BUILTINS */
 }
 
 #ifdef HAVE_ATOMIC_BUILTINS
@@ -182,17 +245,116 @@ srv_enter_innodb_with_tickets(
 }
 
 /*********************************************************************//**
-Handle the scheduling of a user thread that wants to enter InnoDB.  Setting
-srv_adaptive_max_sleep_delay > 0 switches the adaptive sleep calibration to
-ON. When set, we want to wait in the queue for as little time as possible.
-However, very short waits will result in a lot of context switches and that
-is also not desirable. When threads need to sleep multiple times we increment
-os_thread_sleep_delay by one. When we see threads getting a slot without
-waiting and there are no other threads waiting in the queue, we try and reduce
-the wait as much as we can. Currently we reduce it by half each time. If the
-thread only had to wait for one turn before it was able to enter InnoDB we
-decrement it by one. This is to try and keep the sleep time stable around the
-"optimum" sleep time. */
+Get the number of threads of the long class that may be inside InnoDB at
+the same time. A quarter of the places, and at least one place when there
+is more than one, is kept for short statements, so that point queries are
+not stuck behind long scans.
+@return maximum number of long statements inside InnoDB */
+static
+lint
+srv_conc_get_long_limit(
+/*====================*/
+	ulint	concurrency)	/*!< in: innodb_thread_concurrency */
+{
+	ulint	n_short = ut_max(concurrency / 4, 1);
+
+	return(static_cast<lint>(ut_max(concurrency - n_short, 1)));
+}
+
+/*********************************************************************//**
+Try to reserve a place inside InnoDB.
+@return true if a place was reserved */
+static
+bool
+srv_conc_reserve(
+/*=============*/
+	bool	is_long)	/*!< in: whether the place is for a
+				statement of the long class */
+{
+	ulint	concurrency = srv_thread_concurrency;
+
+	if (is_long) {
+		lint	n_long = os_atomic_increment_lint(&srv_conc.n_long, 1);
+
+		if (concurrency > 0
+		    && n_long > srv_conc_get_long_limit(concurrency)) {
+
+			(void) os_atomic_decrement_lint(&srv_conc.n_long, 1);
+			return(false);
+		}
+	}
+
+	lint	n_active = os_atomic_increment_lint(&srv_conc.n_active, 1);
+
+	if (concurrency > 0 && n_active > static_cast<lint>(concurrency)) {
+
+		/* Since there were no free seats, we relinquish
+		the overbooked ticket. */
+
+		(void) os_atomic_decrement_lint(&srv_conc.n_active, 1);
+
+		if (is_long) {
+			(void) os_atomic_decrement_lint(&srv_conc.n_long, 1);
+		}
+
+		return(false);
+	}
+
+	return(true);
+}
+
+/*********************************************************************//**
+Let waiting threads into InnoDB for as long as there are places for them.
+The place is reserved on behalf of the waiting thread before it is woken
+up. Threads of the short class go first, but after SRV_CONC_SHORT_BATCH of
+them a waiting thread of the long class is let in, so that long statements
+cannot starve. The caller must hold srv_conc_mutex. */
+static
+void
+srv_conc_grant_waiters(void)
+/*========================*/
+{
+	for (;;) {
+		srv_conc_slot_t*	slot;
+		ulint			cls;
+		bool			long_waits;
+
+		long_waits = UT_LIST_GET_LEN(srv_conc_queue[SRV_CONC_LONG]) > 0;
+
+		if (long_waits
+		    && (UT_LIST_GET_LEN(srv_conc_queue[SRV_CONC_SHORT]) == 0
+			|| srv_conc_n_short_grants >= SRV_CONC_SHORT_BATCH)
+		    && srv_conc_reserve(true)) {
+
+			cls = SRV_CONC_LONG;
+			srv_conc_n_short_grants = 0;
+
+		} else if (UT_LIST_GET_LEN(srv_conc_queue[SRV_CONC_SHORT]) > 0
+			   && srv_conc_reserve(false)) {
+
+			cls = SRV_CONC_SHORT;
+
+			if (long_waits) {
+				++srv_conc_n_short_grants;
+			}
+		} else {
+			break;
+		}
+
+		slot = UT_LIST_GET_FIRST(srv_conc_queue[cls]);
+		UT_LIST_REMOVE(srv_conc_queue, srv_conc_queue[cls], slot);
+
+		(void) os_atomic_decrement_lint(&srv_conc.n_waiting, 1);
+
+		slot->granted = true;
+		os_event_set(slot->event);
+	}
+}
+
+/*********************************************************************//**
+Handle the scheduling of a user thread that wants to enter InnoDB. If there
+is no place inside InnoDB, the thread waits in the FIFO queue of its class
+until a thread leaving InnoDB hands its place over to it. */
 static
 void
 srv_conc_enter_innodb_with_atomics(
@@ -200,95 +362,105 @@ srv_conc_enter_innodb_with_atomics(
 	trx_t*	trx)			/*!< in/out: transaction that wants
 					to enter InnoDB */
 {
-	ulint	n_sleeps = 0;
-	ibool	notified_mysql = FALSE;
+	srv_conc_slot_t*	slot;
+	bool			is_long = trx->conc_long;
+	ulint			cls = is_long ? SRV_CONC_LONG : SRV_CONC_SHORT;
+	ib_uint64_t		start_time;
+	ulint			sec;
+	ulint			ms;
 
 	ut_a(!trx->declared_to_be_inside_innodb);
 
-	for (;;) {
-		ulint	sleep_in_us;
+	/* Do not overtake the threads that are already waiting. */
 
-		if (srv_conc.n_active < (lint) srv_thread_concurrency) {
-			ulint	n_active;
+	if (srv_conc.n_waiting == 0 && srv_conc_reserve(is_long)) {
 
-			/* Check if there are any free tickets. */
-			n_active = os_atomic_increment_lint(
-				&srv_conc.n_active, 1);
+		srv_enter_innodb_with_tickets(trx);
+		return;
+	}
 
-			if (n_active <= srv_thread_concurrency) {
+	os_fast_mutex_lock(&srv_conc_mutex);
 
-				srv_enter_innodb_with_tickets(trx);
+	/* Count ourselves as waiting before checking again for a free
+	place. A thread leaving InnoDB releases its place before it reads
+	n_waiting, so either we see the free place here or it sees us and
+	lets us in. */
 
-				if (notified_mysql) {
+	(void) os_atomic_increment_lint(&srv_conc.n_waiting, 1);
 
-					(void) os_atomic_decrement_lint(
-						&srv_conc.n_waiting, 1);
+	if (UT_LIST_GET_LEN(srv_conc_queue[cls]) == 0
+	    && srv_conc_reserve(is_long)) {
 
-					thd_wait_end(trx->mysql_thd);
-				}
+		(void) os_atomic_decrement_lint(&srv_conc.n_waiting, 1);
 
-				if (srv_adaptive_max_sleep_delay > 0) {
-					if (srv_thread_sleep_delay > 20
-					    && n_sleeps == 1) {
+		os_fast_mutex_unlock(&srv_conc_mutex);
 
-						--srv_thread_sleep_delay;
-					}
+		srv_enter_innodb_with_tickets(trx);
+		return;
+	}
 
-					if (srv_conc.n_waiting == 0) {
-						srv_thread_sleep_delay >>= 1;
-					}
-				}
+	slot = UT_LIST_GET_FIRST(srv_conc_free_slots);
 
-				return;
-			}
+	if (slot != NULL) {
+		UT_LIST_REMOVE(srv_conc_queue, srv_conc_free_slots, slot);
+	} else {
+		slot = static_cast<srv_conc_slot_t*>(
+			ut_malloc(sizeof(*slot)));
 
-			/* Since there were no free seats, we relinquish
-			the overbooked ticket. */
+		slot->event = os_event_create();
+		ut_a(slot->event);
+	}
 
-			(void) os_atomic_decrement_lint(
-				&srv_conc.n_active, 1);
-		}
+	slot->granted = false;
+	os_event_reset(slot->event);
 
-		if (!notified_mysql) {
-			(void) os_atomic_increment_lint(
-				&srv_conc.n_waiting, 1);
+	UT_LIST_ADD_LAST(srv_conc_queue, srv_conc_queue[cls], slot);
 
-			/* Release possible search system latch this
-			thread has */
+	os_fast_mutex_unlock(&srv_conc_mutex);
 
-			if (trx->has_search_latch) {
-				trx_search_latch_release_if_reserved(trx);
-			}
+	/* Release possible search system latch this thread has */
+	if (trx->has_search_latch) {
+		trx_search_latch_release_if_reserved(trx);
+	}
 
-			thd_wait_begin(trx->mysql_thd, THD_WAIT_USER_LOCK);
+	/* Go to wait for the event; when a thread leaves InnoDB it will
+	release this thread */
 
-			notified_mysql = TRUE;
-		}
+	if (UNIV_UNLIKELY(trx->take_stats)) {
+		ut_usectime(&sec, &ms);
+		start_time = (ib_uint64_t)sec * 1000000 + ms;
+	} else {
+		start_time = 0;
+	}
 
-		trx->op_info = "sleeping before entering InnoDB";
+	trx->op_info = "waiting in InnoDB queue";
 
-		sleep_in_us = srv_thread_sleep_delay;
+	thd_wait_begin(trx->mysql_thd, THD_WAIT_USER_LOCK);
 
-		/* Guard against overflow when adaptive sleep delay is on. */
+	os_event_wait(slot->event);
 
-		if (srv_adaptive_max_sleep_delay > 0
-		    && sleep_in_us > srv_adaptive_max_sleep_delay) {
+	thd_wait_end(trx->mysql_thd);
 
-			sleep_in_us = srv_adaptive_max_sleep_delay;
-			srv_thread_sleep_delay = static_cast<ulong>(sleep_in_us);
-		}
+	trx->op_info = "";
 
-		os_thread_sleep(sleep_in_us);
-		trx->innodb_que_wait_timer += sleep_in_us;
+	if (UNIV_UNLIKELY(start_time != 0)) {
+		ut_usectime(&sec, &ms);
+		trx->innodb_que_wait_timer += (ulint)
+			((ib_uint64_t)sec * 1000000 + ms - start_time);
+	}
 
-		trx->op_info = "";
+	os_fast_mutex_lock(&srv_conc_mutex);
 
-		++n_sleeps;
+	ut_ad(slot->granted);
 
-		if (srv_adaptive_max_sleep_delay > 0 && n_sleeps > 1) {
-			++srv_thread_sleep_delay;
-		}
-	}
+	UT_LIST_ADD_FIRST(srv_conc_queue, srv_conc_free_slots, slot);
+
+	os_fast_mutex_unlock(&srv_conc_mutex);
+
+	/* NOTE that the thread which released this thread already
+	reserved the place on behalf of this thread */
+
+	srv_enter_innodb_with_tickets(trx);
 }
 
 /*********************************************************************//**
@@ -302,7 +474,20 @@ srv_conc_exit_innodb_with_atomics(
 	trx->n_tickets_to_enter_innodb = 0;
 	trx->declared_to_be_inside_innodb = FALSE;
 
+	if (trx->conc_long) {
+		(void) os_atomic_decrement_lint(&srv_conc.n_long, 1);
+	}
+
 	(void) os_atomic_decrement_lint(&srv_conc.n_active, 1);
+
+	if (srv_conc.n_waiting > 0) {
+
+		os_fast_mutex_lock(&srv_conc_mutex);
+
+		srv_conc_grant_waiters();
+
+		os_fast_mutex_unlock(&srv_conc_mutex);
+	}
 }
 #else
 /*********************************************************************//**
@@ -561,6 +746,10 @@ srv_conc_force_enter_innodb(
 	ut_ad(srv_conc.n_active >= 0);
 
 #ifdef HAVE_ATOMIC_BUILTINS
+	if (trx->conc_long) {
+		(void) os_atomic_increment_lint(&srv_conc.n_long, 1);
+	}
+
 	(void) os_atomic_increment_lint(&srv_conc.n_active, 1);
 #else
 	os_fast_mutex_lock(&srv_conc_mutex);
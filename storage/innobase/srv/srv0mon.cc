@@ -778,6 +778,34 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_DISPLAY_CURRENT,
 	 MONITOR_DEFAULT_START, MONITOR_PURGE_RESUME_COUNT},
 
+	{"purge_batch_size", "purge",
+	 "Number of undo log pages handled in one purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_BATCH_SIZE},
+
+	{"purge_table_groups", "purge",
+	 "Number of per table groups of undo records handed to"
+	 " purge threads",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_TABLE_GROUPS},
+
+	{"purge_thread_records_min", "purge",
+	 "Number of undo records handed to the least loaded purge thread"
+	 " in the last batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_THREAD_RECS_MIN},
+
+	{"purge_thread_records_max", "purge",
+	 "Number of undo records handed to the most loaded purge thread"
+	 " in the last batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_THREAD_RECS_MAX},
+
+	{"purge_pessimistic_operations", "purge",
+	 "Number of purge operations retried with the index tree latch",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_PESSIMISTIC},
+
 	/* ========== Counters for Recovery Module ========== */
 	{"module_log", "recovery", "Recovery Module",
 	 MONITOR_MODULE,
@@ -1191,6 +1219,34 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_PENDING_ALTER_TABLE},
 
+	/* ===== Counters for Online ALTER TABLE Module ===== */
+	{"module_online_alter", "online_alter",
+	 "Modification logs of tables rebuilt online",
+	 MONITOR_MODULE,
+	 MONITOR_DEFAULT_START, MONITOR_MODULE_ONLINE_ALTER},
+
+	{"online_alter_log_written", "online_alter",
+	 "Bytes written to the modification logs of tables rebuilt online",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ONLINE_LOG_WRITTEN},
+
+	{"online_alter_log_applied", "online_alter",
+	 "Bytes applied from the modification logs of tables rebuilt online",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ONLINE_LOG_APPLIED},
+
+	{"online_alter_log_applied_ops", "online_alter",
+	 "Number of row operations applied from the modification logs"
+	 " of tables rebuilt online",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ONLINE_LOG_APPLIED_OPS},
+
+	{"online_alter_log_throttled", "online_alter",
+	 "Number of DML operations delayed because the modification log"
+	 " of a table rebuilt online was more than half full",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ONLINE_LOG_THROTTLED},
+
 	/* ===== Counters for ICP (Index Condition Pushdown) Module ===== */
 	{"module_icp", "icp", "Index Condition Pushdown",
 	 MONITOR_MODULE,
@@ -91,6 +91,8 @@ UNIV_INTERN ibool	srv_error_monitor_active = FALSE;
 
 UNIV_INTERN ibool	srv_buf_dump_thread_active = FALSE;
 
+UNIV_INTERN ibool	srv_buf_resize_thread_active = FALSE;
+
 UNIV_INTERN ibool	srv_dict_stats_thread_active = FALSE;
 
 UNIV_INTERN const char*	srv_main_thread_op_info = "";
@@ -150,12 +152,19 @@ UNIV_INTERN ibool	srv_locks_unsafe_for_binlog = FALSE;
 UNIV_INTERN ulong	srv_sort_buf_size = 1048576;
 /** Maximum modification log file size for online index creation */
 UNIV_INTERN unsigned long long	srv_online_max_size;
+/** Maximum delay in microseconds of a DML operation on a table that is
+being rebuilt online while its modification log is more than half full */
+UNIV_INTERN ulong	srv_online_max_delay = 0;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 UNIV_INTERN my_bool	srv_use_native_aio = TRUE;
+/* If this flag is TRUE, the native aio requests that are posted in a
+batch with OS_AIO_SIMULATED_WAKE_LATER are submitted to the kernel
+together when the batch is complete. Linux native aio only. */
+UNIV_INTERN my_bool	srv_use_native_aio_batch = TRUE;
 UNIV_INTERN my_bool	srv_numa_interleave = FALSE;
 
 #ifdef __WIN__
@@ -215,6 +224,8 @@ UNIV_INTERN ib_uint64_t	srv_log_file_size_requested;
 /* size in database pages */
 UNIV_INTERN ulint	srv_log_buffer_size	= ULINT_MAX;
 UNIV_INTERN uint	srv_flush_log_at_timeout = 1;
+UNIV_INTERN my_bool	srv_log_concurrent_mtr_commit = FALSE;
+UNIV_INTERN my_bool	srv_log_writer_threads = FALSE;
 UNIV_INTERN ulong	srv_page_size		= UNIV_PAGE_SIZE_DEF;
 UNIV_INTERN ulong	srv_page_size_shift	= UNIV_PAGE_SIZE_SHIFT_DEF;
 UNIV_INTERN char	srv_use_global_flush_log_at_trx_commit	= TRUE;
@@ -244,6 +255,8 @@ UNIV_INTERN const byte*	srv_latin1_ordering;
 UNIV_INTERN my_bool	srv_use_sys_malloc	= TRUE;
 /* requested size in kilobytes */
 UNIV_INTERN ulint	srv_buf_pool_size	= ULINT_MAX;
+/* size in bytes of a buffer pool chunk */
+UNIV_INTERN ulong	srv_buf_pool_chunk_unit;
 /* requested number of buffer pool instances */
 UNIV_INTERN ulint       srv_buf_pool_instances  = 1;
 /* number of locks to protect buf_pool->page_hash */
@@ -293,6 +306,10 @@ UNIV_INTERN my_bool	srv_cleaner_eviction_factor = FALSE;
 UNIV_INTERN ulong	srv_cleaner_lsn_age_factor
 	= SRV_CLEANER_LSN_AGE_FACTOR_HIGH_CHECKPOINT;
 
+/** Number of page cleaner slots the buffer pool instances are divided
+into, each flushed by its own thread */
+UNIV_INTERN ulong	srv_n_page_cleaners = 1;
+
 /** Empty free list for a query thread handling algorithm option  */
 UNIV_INTERN ulong	srv_empty_free_list_algorithm
 	= SRV_EMPTY_FREE_LIST_BACKOFF;
@@ -417,6 +434,15 @@ starting from SRV_FORCE_IGNORE_CORRUPT, so that data can be recovered
 by SELECT or mysqldump. When this is nonzero, we do not allow any user
 modifications to the data. */
 UNIV_INTERN ulong	srv_force_recovery;
+/** Number of threads that apply the redo log records to the pages during
+crash recovery */
+UNIV_INTERN ulong	srv_n_recv_apply_threads = 1;
+/** Number of threads that open and validate the .ibd files found in the
+database directories at the start of crash recovery */
+UNIV_INTERN ulong	srv_n_tablespace_discovery_threads = 1;
+/** If TRUE, the redo log is read ahead by a separate thread while the
+recovery thread parses it */
+UNIV_INTERN my_bool	srv_recv_log_read_ahead = FALSE;
 #ifndef DBUG_OFF
 /** Inject a crash at different steps of the recovery process.
 This is for testing and debugging only. */
@@ -449,6 +475,15 @@ UNIV_INTERN unsigned long long	srv_stats_transient_sample_pages = 8;
 UNIV_INTERN my_bool		srv_stats_persistent = TRUE;
 UNIV_INTERN unsigned long long	srv_stats_persistent_sample_pages = 20;
 UNIV_INTERN my_bool		srv_stats_auto_recalc = TRUE;
+/* Number of threads that analyze the indexes of a table in parallel
+when calculating persistent statistics */
+UNIV_INTERN ulong		srv_stats_analyze_threads = 1;
+/* Number of buckets in the histograms that are built on the key prefixes
+of an index together with its persistent statistics, 0 disables them */
+UNIV_INTERN ulong		srv_stats_histogram_buckets = 0;
+/* Maximum number of index pages per second that the automatic
+recalculation of persistent statistics may read, 0 means no limit */
+UNIV_INTERN ulong		srv_stats_auto_recalc_pages_per_sec = 0;
 
 UNIV_INTERN ibool	srv_use_doublewrite_buf	= TRUE;
 UNIV_INTERN ibool       srv_use_atomic_writes = FALSE;
@@ -462,6 +497,13 @@ batch flushing i.e.: LRU flushing and flush_list flushing. The rest
 of the pages are used for single page flushing. */
 UNIV_INTERN ulong	srv_doublewrite_batch_size	= 120;
 
+/** If true, the pages are doublewritten to one file per buffer pool
+instance instead of the doublewrite buffer in the system tablespace.
+Each file has separate areas for flush list and LRU list flushing. */
+UNIV_INTERN my_bool	srv_parallel_doublewrite	= FALSE;
+/** Directory of the parallel doublewrite files */
+UNIV_INTERN char*	srv_parallel_doublewrite_path	= NULL;
+
 UNIV_INTERN ulong	srv_replication_delay		= 0;
 
 UNIV_INTERN ulint	srv_pass_corrupt_table = 0; /* 0:disable 1:enable */
@@ -728,6 +770,9 @@ UNIV_INTERN os_event_t	srv_error_event;
 /** Event to signal the buffer pool dump/load thread */
 UNIV_INTERN os_event_t	srv_buf_dump_event;
 
+/** Event to signal the buffer pool resize thread */
+UNIV_INTERN os_event_t	srv_buf_resize_event;
+
 /** The buffer pool dump/load file name */
 UNIV_INTERN char*	srv_buf_dump_filename;
 
@@ -1101,6 +1146,8 @@ srv_init(void)
 
 		srv_buf_dump_event = os_event_create();
 
+		srv_buf_resize_event = os_event_create();
+
 		srv_checkpoint_completed_event = os_event_create();
 
 		srv_redo_log_tracked_event = os_event_create();
@@ -1155,6 +1202,7 @@ srv_free(void)
 		os_event_free(srv_error_event);
 		os_event_free(srv_monitor_event);
 		os_event_free(srv_buf_dump_event);
+		os_event_free(srv_buf_resize_event);
 		os_event_free(srv_checkpoint_completed_event);
 		os_event_free(srv_redo_log_tracked_event);
 		mutex_free(&srv_sys->mutex);
@@ -1289,6 +1337,7 @@ srv_printf_innodb_monitor(
 	time_t	current_time;
 	ulint	n_reserved;
 	ibool	ret;
+	read_view_t*	oldest_view = NULL;
 
 	ulong	btr_search_sys_constant;
 	ulong	btr_search_sys_variable;
@@ -1511,7 +1560,7 @@ srv_printf_innodb_monitor(
 	mutex_enter(&trx_sys->mutex);
 
 	fprintf(file, "%lu read views open inside InnoDB\n",
-		UT_LIST_GET_LEN(trx_sys->view_list));
+		read_view_get_n_open());
 
 	fprintf(file, "%lu RW transactions active inside InnoDB\n",
 		UT_LIST_GET_LEN(trx_sys->rw_trx_list));
@@ -1522,18 +1571,16 @@ srv_printf_innodb_monitor(
 	fprintf(file, "%lu out of %lu descriptors used\n",
 		trx_sys->descr_n_used, trx_sys->descr_n_max);
 
-	if (UT_LIST_GET_LEN(trx_sys->view_list)) {
-		read_view_t*	view = UT_LIST_GET_LAST(trx_sys->view_list);
-
-		if (view) {
-			fprintf(file, "---OLDEST VIEW---\n");
-			read_view_print(file, view);
-			fprintf(file, "-----------------\n");
-		}
+	if (read_view_clone_oldest(oldest_view)) {
+		fprintf(file, "---OLDEST VIEW---\n");
+		read_view_print(file, oldest_view);
+		fprintf(file, "-----------------\n");
 	}
 
 	mutex_exit(&trx_sys->mutex);
 
+	read_view_free(oldest_view);
+
 	n_reserved = fil_space_get_n_reserved_extents(0);
 	if (n_reserved > 0) {
 		fprintf(file,
@@ -1599,7 +1646,7 @@ srv_export_innodb_status(void)
 	ulint			free_len;
 	ulint			flush_list_len;
 	ulint			mem_adaptive_hash, mem_dictionary;
-	read_view_t*		oldest_view;
+	read_view_t*		oldest_view	= NULL;
 	ulint			i;
 
 	buf_get_total_stat(&stat);
@@ -1770,9 +1817,12 @@ srv_export_innodb_status(void)
 	export_vars.innodb_x_lock_spin_waits
 		= rw_lock_stats.rw_x_spin_wait_count;
 
-	oldest_view = UT_LIST_GET_LAST(trx_sys->view_list);
+	mutex_enter(&trx_sys->mutex);
 	export_vars.innodb_oldest_view_low_limit_trx_id
-		= oldest_view ? oldest_view->low_limit_id : 0;
+		= read_view_clone_oldest(oldest_view)
+		? oldest_view->low_limit_id : 0;
+	mutex_exit(&trx_sys->mutex);
+	read_view_free(oldest_view);
 
 	export_vars.innodb_purge_trx_id = purge_sys->limit.trx_no;
 	export_vars.innodb_purge_undo_no = purge_sys->limit.undo_no;
@@ -1836,6 +1886,16 @@ srv_export_innodb_status(void)
 
 	export_vars.innodb_rows_inserted = srv_stats.n_rows_inserted;
 
+	export_vars.innodb_rows_prefetched = srv_stats.n_rows_prefetched;
+
+	export_vars.innodb_rows_prefetch_batches =
+		srv_stats.n_rows_prefetch_batches;
+
+	export_vars.innodb_fts_topn_queries = srv_stats.n_fts_topn_queries;
+
+	export_vars.innodb_fts_topn_blocks_skipped =
+		srv_stats.n_fts_topn_blocks_skipped;
+
 	export_vars.innodb_rows_updated = srv_stats.n_rows_updated;
 
 	export_vars.innodb_rows_deleted = srv_stats.n_rows_deleted;
@@ -2252,6 +2312,8 @@ srv_any_background_threads_are_active(void)
 		thread_active = "srv_monitor_thread";
 	} else if (srv_buf_dump_thread_active) {
 		thread_active = "buf_dump_thread";
+	} else if (srv_buf_resize_thread_active) {
+		thread_active = "buf_resize_thread";
 	} else if (srv_dict_stats_thread_active) {
 		thread_active = "dict_stats_thread";
 	}
@@ -2259,6 +2321,7 @@ srv_any_background_threads_are_active(void)
 	os_event_set(srv_error_event);
 	os_event_set(srv_monitor_event);
 	os_event_set(srv_buf_dump_event);
+	os_event_set(srv_buf_resize_event);
 	os_event_set(lock_sys->timeout_event);
 	os_event_set(dict_stats_event);
 
@@ -3183,6 +3246,7 @@ srv_do_purge(
 	static ulint	count = 0;
 	static ulint	n_use_threads = 0;
 	static ulint	rseg_history_len = 0;
+	static ulint	batch_size = 0;
 	ulint		old_activity_count = srv_get_activity_count();
 
 	ut_a(n_threads > 0);
@@ -3229,13 +3293,30 @@ srv_do_purge(
 		ut_a(n_use_threads > 0);
 		ut_a(n_use_threads <= n_threads);
 
+		/* Double the batch while the history list keeps growing,
+		so that every purge thread gets up to innodb_purge_batch_size
+		undo log pages of its own, and halve it again once purge
+		catches up. */
+
+		if (trx_sys->rseg_history_len > rseg_history_len) {
+			batch_size *= 2;
+		} else if (trx_sys->rseg_history_len < rseg_history_len) {
+			batch_size /= 2;
+		}
+
+		batch_size = ut_min(batch_size,
+				    srv_purge_batch_size * n_use_threads);
+		batch_size = ut_max(batch_size, srv_purge_batch_size);
+
+		MONITOR_SET(MONITOR_PURGE_BATCH_SIZE, batch_size);
+
 		/* Take a snapshot of the history list before purge. */
 		if ((rseg_history_len = trx_sys->rseg_history_len) == 0) {
 			break;
 		}
 
 		n_pages_purged = trx_purge(
-			n_use_threads, srv_purge_batch_size,
+			n_use_threads, batch_size,
 			(++count % TRX_SYS_N_RSEGS) == 0);
 
 		*n_total_purged += n_pages_purged;
@@ -1872,7 +1872,6 @@ innobase_start_or_create_for_mysql(void)
 	maximum number of threads that can wait in the 'srv_conc array' for
 	their time to enter InnoDB. */
 
-#define BUF_POOL_SIZE_THRESHOLD (1024 * 1024 * 1024)
 	srv_max_n_threads = 1   /* io_ibuf_thread */
 			    + 1 /* io_log_thread */
 			    + 1 /* lock_wait_timeout_thread */
@@ -1882,10 +1881,18 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* srv_redo_log_follow_thread */
 			    + 1 /* srv_purge_coordinator_thread */
 			    + 1 /* buf_dump_thread */
+			    + 1 /* buf_resize_thread */
 			    + 1 /* dict_stats_thread */
 			    + 1 /* fts_optimize_thread */
+			    + fts_optimize_threads
+			      /* fts_optimize_worker_thread */
 			    + 1 /* recv_writer_thread */
+			    + srv_n_recv_apply_threads /* recv_apply_thread */
+			    + srv_n_tablespace_discovery_threads
+			      /* fil_discovery_thread */
+			    + 1 /* recv_log_read_ahead_thread */
 			    + 1 /* buf_flush_page_cleaner_thread */
+			    + srv_n_page_cleaners /* page cleaner workers */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
 			    + 128 /* added as margin, for use of
 				  InnoDB Memcached etc. */
@@ -1903,6 +1910,25 @@ innobase_start_or_create_for_mysql(void)
 		srv_buf_pool_instances = 1;
 	}
 
+	if (srv_buf_pool_chunk_unit * srv_buf_pool_instances
+	    > srv_buf_pool_size) {
+		/* The chunks of each instance must fit in the requested
+		size, so shrink the chunk to the instance size */
+		srv_buf_pool_chunk_unit = static_cast<ulong>(
+			ut_calc_align(srv_buf_pool_size
+				      / srv_buf_pool_instances,
+				      UNIV_PAGE_SIZE));
+	}
+
+	/* The buffer pool grows and shrinks in whole chunks */
+	srv_buf_pool_size = buf_pool_size_align(srv_buf_pool_size);
+
+	if (srv_n_page_cleaners > srv_buf_pool_instances) {
+		/* A page cleaner slot without buffer pool
+		instances would have nothing to flush */
+		srv_n_page_cleaners = srv_buf_pool_instances;
+	}
+
 	srv_boot();
 
 	ib_logf(IB_LOG_LEVEL_INFO,
@@ -2027,7 +2053,8 @@ innobase_start_or_create_for_mysql(void)
 
 	/* Print time to initialize the buffer pool */
 	ib_logf(IB_LOG_LEVEL_INFO,
-		"Initializing buffer pool, size = %.1f%c", size, unit);
+		"Initializing buffer pool, size = %.1f%c, chunk size = %luM",
+		size, unit, srv_buf_pool_chunk_unit / 1024 / 1024);
 
 	err = buf_pool_init(srv_buf_pool_size, srv_buf_pool_instances);
 
@@ -2655,6 +2682,12 @@ files_checked:
 		buf_dblwr_create();
 	}
 
+	err = buf_dblwr_create_parallel();
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
 	/* Here the double write buffer has already been created and so
 	any new rollback segments will be allocated after the double
 	write buffer. The default segment should already exist.
@@ -2757,8 +2790,15 @@ files_checked:
 		purge_sys->state = PURGE_STATE_DISABLED;
 	}
 
+	buf_flush_page_cleaner_init();
+
 	if (!srv_read_only_mode) {
 		os_thread_create(buf_flush_page_cleaner_thread, NULL, NULL);
+
+		if (srv_log_writer_threads) {
+			os_thread_create(log_writer_thread, NULL, NULL);
+			os_thread_create(log_flusher_thread, NULL, NULL);
+		}
 	}
 	os_thread_create(buf_flush_lru_manager_thread, NULL, NULL);
 
@@ -2913,6 +2953,9 @@ files_checked:
 		/* Create the buffer pool dump/load thread */
 		os_thread_create(buf_dump_thread, NULL, NULL);
 
+		/* Create the buffer pool resize thread */
+		os_thread_create(buf_resize_thread, NULL, NULL);
+
 		/* Create the dict stats gathering thread */
 		os_thread_create(dict_stats_thread, NULL, NULL);
 
@@ -3107,6 +3150,7 @@ innobase_shutdown_for_mysql(void)
 	srv_mon_free();
 	srv_free();
 	fil_close();
+	buf_flush_page_cleaner_free();
 
 	/* 4. Free all allocated memory */
 
@@ -109,6 +109,12 @@ struct sync_cell_t {
 					wait call. */
 	time_t		reservation_time;/*!< time when the thread reserved
 					the wait cell */
+#ifdef HAVE_IB_LINUX_FUTEX
+	volatile os_futex_t*
+			futex;		/*!< futex word of wait_object that
+					the thread sleeps on instead of
+					its event, or NULL */
+#endif /* HAVE_IB_LINUX_FUTEX */
 };
 
 /* NOTE: It is allowed for a thread to wait
@@ -315,15 +321,21 @@ sync_cell_get_event(
 
 /******************************************************************//**
 Reserves a wait array cell for waiting for an object.
-The event of the cell is reset to nonsignalled state.
+The event of the cell is reset to nonsignalled state, unless the thread
+sleeps on a futex word instead.
 @return true if free cell is found, otherwise false */
-UNIV_INTERN
+static
 bool
-sync_array_reserve_cell(
-/*====================*/
+sync_array_reserve_cell_low(
+/*========================*/
 	sync_array_t*	arr,	/*!< in: wait array */
 	void*		object, /*!< in: pointer to the object to wait for */
 	ulint		type,	/*!< in: lock request type */
+#ifdef HAVE_IB_LINUX_FUTEX
+	volatile os_futex_t*
+			futex,	/*!< in: futex word of the object to sleep
+				on instead of its event, or NULL */
+#endif /* HAVE_IB_LINUX_FUTEX */
 	const char*	file,	/*!< in: file where requested */
 	ulint		line,	/*!< in: line where requested */
 	ulint*		index)	/*!< out: index of the reserved cell */
@@ -359,17 +371,30 @@ sync_array_reserve_cell(
 			cell->file = file;
 			cell->line = line;
 
+#ifdef HAVE_IB_LINUX_FUTEX
+			cell->futex = futex;
+#endif /* HAVE_IB_LINUX_FUTEX */
+
 			arr->n_reserved++;
 
 			*index = i;
 
 			sync_array_exit(arr);
 
-			/* Make sure the event is reset and also store
-			the value of signal_count at which the event
-			was reset. */
-                        event = sync_cell_get_event(cell);
-			cell->signal_count = os_event_reset(event);
+#ifdef HAVE_IB_LINUX_FUTEX
+			if (futex != NULL) {
+				/* The caller has read the futex word,
+				which plays the role of os_event_reset() */
+				cell->signal_count = 0;
+			} else
+#endif /* HAVE_IB_LINUX_FUTEX */
+			{
+				/* Make sure the event is reset and also
+				store the value of signal_count at which
+				the event was reset. */
+				event = sync_cell_get_event(cell);
+				cell->signal_count = os_event_reset(event);
+			}
 
 			cell->reservation_time = ut_time();
 
@@ -383,6 +408,53 @@ sync_array_reserve_cell(
 	return false;
 }
 
+/******************************************************************//**
+Reserves a wait array cell for waiting for an object.
+The event of the cell is reset to nonsignalled state.
+@return true if free cell is found, otherwise false */
+UNIV_INTERN
+bool
+sync_array_reserve_cell(
+/*====================*/
+	sync_array_t*	arr,	/*!< in: wait array */
+	void*		object, /*!< in: pointer to the object to wait for */
+	ulint		type,	/*!< in: lock request type */
+	const char*	file,	/*!< in: file where requested */
+	ulint		line,	/*!< in: line where requested */
+	ulint*		index)	/*!< out: index of the reserved cell */
+{
+	return(sync_array_reserve_cell_low(arr, object, type,
+#ifdef HAVE_IB_LINUX_FUTEX
+					   NULL,
+#endif /* HAVE_IB_LINUX_FUTEX */
+					   file, line, index));
+}
+
+#ifdef HAVE_IB_LINUX_FUTEX
+/******************************************************************//**
+Reserves a wait array cell for a thread that will sleep on a futex
+word of the object instead of its event. The event is not touched.
+@return true if free cell is found, otherwise false */
+UNIV_INTERN
+bool
+sync_array_reserve_futex_cell(
+/*==========================*/
+	sync_array_t*		arr,	/*!< in: wait array */
+	void*			object,	/*!< in: pointer to the object to
+					wait for */
+	ulint			type,	/*!< in: lock request type */
+	volatile os_futex_t*	futex,	/*!< in: futex word of the object */
+	const char*		file,	/*!< in: file where requested */
+	ulint			line,	/*!< in: line where requested */
+	ulint*			index)	/*!< out: index of the reserved cell */
+{
+	ut_ad(futex != NULL);
+
+	return(sync_array_reserve_cell_low(arr, object, type, futex,
+					   file, line, index));
+}
+#endif /* HAVE_IB_LINUX_FUTEX */
+
 /******************************************************************//**
 This function should be called when a thread starts to wait on
 a wait array cell. In the debug version this function checks
@@ -435,6 +507,77 @@ sync_array_wait_event(
 	sync_array_free_cell(arr, index);
 }
 
+#ifdef HAVE_IB_LINUX_FUTEX
+/******************************************************************//**
+Sleeps on the futex word of a latch, unless the word no longer has the
+value read before the waited condition was last checked. The sync array
+is not used for short waits. If the wait lasts longer than
+SYNC_ARRAY_FUTEX_CELL_DELAY, a cell is reserved for it, so that it can be
+seen by the long semaphore wait checks, and the thread sleeps on until it
+is woken up. In the debug version the deadlock check is then run. */
+UNIV_INTERN
+void
+sync_array_wait_futex(
+/*==================*/
+	void*			object,	/*!< in: pointer to the object to
+					wait for */
+	ulint			type,	/*!< in: lock request type */
+	volatile os_futex_t*	futex,	/*!< in: futex word of the object */
+	os_futex_t		val,	/*!< in: value of the futex word
+					read before the waited condition
+					was last checked */
+	const char*		file,	/*!< in: file where requested */
+	ulint			line)	/*!< in: line where requested */
+{
+	sync_array_t*	arr;
+	sync_cell_t*	cell;
+	ulint		index;
+
+	if (os_futex_wait_time(futex, val, SYNC_ARRAY_FUTEX_CELL_DELAY)
+	    != OS_SYNC_TIME_EXCEEDED) {
+
+		return;
+	}
+
+	/* The futex word was not changed while we slept, so the value
+	that was read still stands in for os_event_reset(): a wake-up
+	after this point makes os_futex_wait() below return at once. */
+
+	arr = sync_array_get_and_reserve_futex_cell(
+		object, type, futex, file, line, &index);
+
+	sync_array_enter(arr);
+
+	cell = sync_array_get_nth_cell(arr, index);
+
+	ut_a(cell->wait_object);
+	ut_a(cell->futex == futex);
+	ut_a(!cell->waiting);
+	ut_ad(os_thread_get_curr_id() == cell->thread);
+
+	/* Count the time slept before the cell was reserved */
+	cell->reservation_time -= SYNC_ARRAY_FUTEX_CELL_DELAY / 1000000;
+	cell->waiting = TRUE;
+
+#ifdef UNIV_SYNC_DEBUG
+	rw_lock_debug_mutex_enter();
+
+	if (TRUE == sync_array_detect_deadlock(arr, cell, cell, 0)) {
+
+		fputs("########################################\n", stderr);
+		ut_error;
+	}
+
+	rw_lock_debug_mutex_exit();
+#endif
+	sync_array_exit(arr);
+
+	os_futex_wait(futex, val);
+
+	sync_array_free_cell(arr, index);
+}
+#endif /* HAVE_IB_LINUX_FUTEX */
+
 /******************************************************************//**
 Reports info of a wait array cell. */
 static
@@ -871,6 +1014,9 @@ sync_array_free_cell(
 	cell->waiting = FALSE;
 	cell->wait_object =  NULL;
 	cell->signal_count = 0;
+#ifdef HAVE_IB_LINUX_FUTEX
+	cell->futex = NULL;
+#endif /* HAVE_IB_LINUX_FUTEX */
 
 	ut_a(arr->n_reserved > 0);
 	arr->n_reserved--;
@@ -923,9 +1069,16 @@ sync_array_wake_threads_if_sema_free_low(
 			if (sync_arr_cell_can_wake_up(cell)) {
 				os_event_t      event;
 
-				event = sync_cell_get_event(cell);
+#ifdef HAVE_IB_LINUX_FUTEX
+				if (cell->futex != NULL) {
+					os_futex_wake(cell->futex);
+				} else
+#endif /* HAVE_IB_LINUX_FUTEX */
+				{
+					event = sync_cell_get_event(cell);
 
-				os_event_set(event);
+					os_event_set(event);
+				}
 			}
 		}
 	}
@@ -266,6 +266,10 @@ rw_lock_create_func(
 	lock->last_x_line = 0;
 	os_event_create(&lock->event);
 	os_event_create(&lock->wait_ex_event);
+#ifdef HAVE_IB_LINUX_FUTEX
+	lock->futex = 0;
+	lock->wait_ex_futex = 0;
+#endif /* HAVE_IB_LINUX_FUTEX */
 
 	mutex_enter(&rw_lock_list_mutex);
 
@@ -438,6 +442,9 @@ rw_lock_s_lock_spin(
 	ulint		index;	/* index of the reserved wait cell */
 	ulint		i = 0;	/* spin round count */
 	sync_array_t*	sync_arr;
+#ifdef HAVE_IB_LINUX_FUTEX
+	os_futex_t	futex_val = 0;
+#endif /* HAVE_IB_LINUX_FUTEX */
 	size_t		counter_index;
 	rw_lock_t*	lock = (rw_lock_t *) _lock;
 
@@ -500,6 +507,13 @@ lock_loop:
 
 		rw_lock_stats.rw_s_spin_round_count.add(counter_index, i);
 
+#ifdef HAVE_IB_LINUX_FUTEX
+		if (!high_priority) {
+			sync_arr = NULL;
+			futex_val = lock->futex;
+			os_rmb;
+		} else
+#endif /* HAVE_IB_LINUX_FUTEX */
 		sync_arr = sync_array_get_and_reserve_cell(lock,
 							   high_priority
 							   ? PRIO_RW_LOCK_SHARED
@@ -525,7 +539,9 @@ lock_loop:
 						       high_priority, lock)
 		    && (TRUE == rw_lock_s_lock_low(lock, pass,
 						   file_name, line))) {
-			sync_array_free_cell(sync_arr, index);
+			if (sync_arr != NULL) {
+				sync_array_free_cell(sync_arr, index);
+			}
 			if (prio_rw_lock) {
 
 				os_atomic_decrement_ulint(
@@ -547,6 +563,13 @@ lock_loop:
 		lock->count_os_wait++;
 		rw_lock_stats.rw_s_os_wait_count.add(counter_index, 1);
 
+#ifdef HAVE_IB_LINUX_FUTEX
+		if (sync_arr == NULL) {
+			sync_array_wait_futex(lock, RW_LOCK_SHARED,
+					      &lock->futex, futex_val,
+					      file_name, line);
+		} else
+#endif /* HAVE_IB_LINUX_FUTEX */
 		sync_array_wait_event(sync_arr, index);
 
 		if (prio_rw_lock) {
@@ -600,11 +623,15 @@ rw_lock_x_lock_wait(
 	const char*	file_name,/*!< in: file name where lock requested */
 	ulint		line)	/*!< in: line where requested */
 {
-	ulint		index;
 	ulint		i = 0;
-	sync_array_t*	sync_arr;
 	size_t		counter_index;
 	prio_rw_lock_t*	prio_rw_lock = NULL;
+#ifdef HAVE_IB_LINUX_FUTEX
+	os_futex_t	futex_val;
+#else
+	ulint		index;
+	sync_array_t*	sync_arr;
+#endif /* HAVE_IB_LINUX_FUTEX */
 
 	/* We reuse the thread id to index into the counter, cache
 	it here for efficiency. */
@@ -633,10 +660,15 @@ rw_lock_x_lock_wait(
 		/* If there is still a reader, then go to sleep.*/
 		rw_lock_stats.rw_x_spin_round_count.add(counter_index, i);
 
+#ifdef HAVE_IB_LINUX_FUTEX
+		futex_val = lock->wait_ex_futex;
+		os_rmb;
+#else
 		sync_arr = sync_array_get_and_reserve_cell(lock,
 							   RW_LOCK_WAIT_EX,
 							   file_name,
 							   line, &index);
+#endif /* HAVE_IB_LINUX_FUTEX */
 
 		i = 0;
 
@@ -655,16 +687,25 @@ rw_lock_x_lock_wait(
 					       file_name, line);
 #endif
 
+#ifdef HAVE_IB_LINUX_FUTEX
+			sync_array_wait_futex(lock, RW_LOCK_WAIT_EX,
+					      &lock->wait_ex_futex,
+					      futex_val, file_name, line);
+#else
 			sync_array_wait_event(sync_arr, index);
+#endif /* HAVE_IB_LINUX_FUTEX */
 #ifdef UNIV_SYNC_DEBUG
 			rw_lock_remove_debug_info(
 				lock, pass, RW_LOCK_WAIT_EX);
 #endif
 			/* It is possible to wake when lock_word < 0.
 			We must pass the while-loop check to proceed.*/
-		} else {
+		}
+#ifndef HAVE_IB_LINUX_FUTEX
+		else {
 			sync_array_free_cell(sync_arr, index);
 		}
+#endif /* !HAVE_IB_LINUX_FUTEX */
 	}
 
 	if (prio_rw_lock) {
@@ -768,6 +809,9 @@ rw_lock_x_lock_func(
 	ulint		i;	/*!< spin round count */
 	ulint		index;	/*!< index of the reserved wait cell */
 	sync_array_t*	sync_arr;
+#ifdef HAVE_IB_LINUX_FUTEX
+	os_futex_t	futex_val = 0;
+#endif /* HAVE_IB_LINUX_FUTEX */
 	ibool		spinning = FALSE;
 	size_t		counter_index;
 	prio_rw_lock_t*	prio_lock = NULL;
@@ -843,6 +887,13 @@ lock_loop:
 		}
 	}
 
+#ifdef HAVE_IB_LINUX_FUTEX
+	if (!high_priority) {
+		sync_arr = NULL;
+		futex_val = lock->futex;
+		os_rmb;
+	} else
+#endif /* HAVE_IB_LINUX_FUTEX */
 	sync_arr = sync_array_get_and_reserve_cell(lock,
 						   high_priority
 						   ? PRIO_RW_LOCK_EX
@@ -861,7 +912,9 @@ lock_loop:
 	}
 
 	if (rw_lock_x_lock_low(lock, high_priority, pass, file_name, line)) {
-		sync_array_free_cell(sync_arr, index);
+		if (sync_arr != NULL) {
+			sync_array_free_cell(sync_arr, index);
+		}
 		if (prio_lock) {
 
 			os_atomic_decrement_ulint(
@@ -883,6 +936,12 @@ lock_loop:
 	lock->count_os_wait++;
 	rw_lock_stats.rw_x_os_wait_count.add(counter_index, 1);
 
+#ifdef HAVE_IB_LINUX_FUTEX
+	if (sync_arr == NULL) {
+		sync_array_wait_futex(lock, RW_LOCK_EX, &lock->futex,
+				      futex_val, file_name, line);
+	} else
+#endif /* HAVE_IB_LINUX_FUTEX */
 	sync_array_wait_event(sync_arr, index);
 
 	if (prio_lock) {
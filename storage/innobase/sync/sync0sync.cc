@@ -167,7 +167,28 @@ Since only one thread can wait on this event there is no chance
 of this event getting reset before the writer starts wait on it.
 Therefore, this thread is guaranteed to catch the os_set_event()
 signalled unconditionally at the release of the lock.
-Q.E.D. */
+Q.E.D.
+
+FUTEX WAITS
+===========
+
+If InnoDB is built WITH_INNODB_FUTEX, mutexes and rw-locks do not reserve a
+cell in the sync array when an ordinary (not high priority) wait starts.
+Instead, the thread sleeps on a 32-bit futex word embedded in the latch.
+Reading the futex word takes the place of os_event_reset(), and
+os_futex_wake(), which increments the word before waking up the sleepers,
+takes the place of os_event_set(). LEMMA 2 holds because FUTEX_WAIT returns
+at once if the word no longer has the value that was read. The sync array
+mutex is then not taken for short waits.
+
+Only if the wait lasts longer than SYNC_ARRAY_FUTEX_CELL_DELAY does
+sync_array_wait_futex() reserve a cell for it, without an event. From then
+on the wait is shown in the SEMAPHORES section of SHOW ENGINE INNODB STATUS,
+is checked by the long semaphore wait watchdog and by the UNIV_SYNC_DEBUG
+deadlock detection, and is woken up by sync_arr_wake_threads_if_sema_free().
+Shorter waits are not seen by any of these, so mutex_exit() has a full
+memory barrier between resetting the lock word and reading the waiters
+field. */
 
 /* Number of spin waits on mutexes: for performance monitoring */
 
@@ -281,6 +302,9 @@ mutex_create_func(
 	mutex->lock_word = 0;
 #endif
 	os_event_create(&mutex->event);
+#ifdef HAVE_IB_LINUX_FUTEX
+	mutex->futex = 0;
+#endif /* HAVE_IB_LINUX_FUTEX */
 	mutex_set_waiters(mutex, 0);
 #ifdef UNIV_DEBUG
 	mutex->magic_n = MUTEX_MAGIC_N;
@@ -548,6 +572,10 @@ mutex_spin_wait(
 	ulint		i;		/* spin round count */
 	ulint		index;		/* index of the reserved wait cell */
 	sync_array_t*	sync_arr;
+#ifdef HAVE_IB_LINUX_FUTEX
+	os_futex_t	futex_val = 0;	/* value of mutex->futex before
+					the last check of lock_word */
+#endif /* HAVE_IB_LINUX_FUTEX */
 	size_t		counter_index;
 	/* The typecast below is performed for some of the priority mutexes
 	too, when !high_priority.  This exploits the fact that regular mutex is
@@ -614,6 +642,19 @@ spin_loop:
 		goto spin_loop;
 	}
 
+#ifdef HAVE_IB_LINUX_FUTEX
+	if (!high_priority) {
+		/* Sleep on the futex of the mutex instead of a cell in
+		the sync array. Reading the futex word here plays the
+		role of os_event_reset() in the cell reservation. A
+		cell is only reserved if the wait lasts long, see
+		sync_array_wait_futex(). */
+
+		sync_arr = NULL;
+		futex_val = mutex->futex;
+		os_rmb;
+	} else
+#endif /* HAVE_IB_LINUX_FUTEX */
 	sync_arr = sync_array_get_and_reserve_cell(mutex,
 						   high_priority
 						   ? SYNC_PRIO_MUTEX
@@ -641,7 +682,9 @@ spin_loop:
 		if (ib_mutex_test_and_set(mutex) == 0) {
 			/* Succeeded! Free the reserved wait cell */
 
-			sync_array_free_cell(sync_arr, index);
+			if (sync_arr != NULL) {
+				sync_array_free_cell(sync_arr, index);
+			}
 
 			ut_d(mutex->thread_id = os_thread_get_curr_id());
 #ifdef UNIV_SYNC_DEBUG
@@ -669,6 +712,12 @@ spin_loop:
 
 	mutex->count_os_wait++;
 
+#ifdef HAVE_IB_LINUX_FUTEX
+	if (sync_arr == NULL) {
+		sync_array_wait_futex(mutex, SYNC_MUTEX, &mutex->futex,
+				      futex_val, file_name, line);
+	} else
+#endif /* HAVE_IB_LINUX_FUTEX */
 	sync_array_wait_event(sync_arr, index);
 
 	if (prio_mutex) {
@@ -692,8 +741,12 @@ mutex_signal_object(
 
 	/* The memory order of resetting the waiters field and
 	signaling the object is important. See LEMMA 1 above. */
+#ifdef HAVE_IB_LINUX_FUTEX
+	os_futex_wake(&mutex->futex);
+#else
 	os_event_set(&mutex->event);
 	sync_array_object_signalled();
+#endif /* HAVE_IB_LINUX_FUTEX */
 }
 
 #ifdef UNIV_SYNC_DEBUG
@@ -1269,6 +1322,15 @@ sync_thread_add_level(
 			ut_error;
 		}
 		break;
+	case SYNC_LOCK_SYS_PARTITION:
+		/* Either the thread must own the lock_sys->mutex, or
+		it is allowed to own only ONE lock_sys partition mutex. */
+		if (sync_thread_levels_contain(array, SYNC_LOCK_SYS)) {
+			ut_a(sync_thread_levels_g(array, level - 1, TRUE));
+		} else {
+			ut_a(sync_thread_levels_g(array, level, TRUE));
+		}
+		break;
 	case SYNC_TRX:
 		/* Either the thread must own the lock_sys->mutex, or
 		it is allowed to own only ONE trx->mutex. */
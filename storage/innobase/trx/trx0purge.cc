@@ -46,6 +46,10 @@ Created 3/26/1996 Heikki Tuuri
 #include "srv0mon.h"
 #include "mtr0log.h"
 
+#include <algorithm>
+#include <map>
+#include <vector>
+
 /** Maximum allowable purge history length.  <=0 means 'infinite'. */
 UNIV_INTERN ulong		srv_max_purge_lag = 0;
 
@@ -959,6 +963,75 @@ trx_purge_fetch_next_rec(
 	return(trx_purge_get_next_rec(n_pages_handled, heap));
 }
 
+/** Undo records of one table, collected in one purge batch */
+struct trx_purge_group_t {
+	ulint		n_recs;		/*!< number of undo records */
+	ulint		thr_no;		/*!< purge thread the records
+					are attached to */
+};
+
+/** Map of table id to the undo records of that table in a batch */
+typedef std::map<table_id_t, trx_purge_group_t> trx_purge_groups_t;
+
+/** Order the undo record groups of a batch by size, largest first */
+struct trx_purge_group_cmp {
+	bool operator()(
+		const trx_purge_groups_t::value_type*	a,
+		const trx_purge_groups_t::value_type*	b) const
+	{
+		return(a->second.n_recs > b->second.n_recs);
+	}
+};
+
+/*******************************************************************//**
+Distribute the undo record groups of a batch to the purge threads.
+All undo records of a table are handed to the same thread, so that
+the threads do not contend on the index latches of the same table.
+The largest groups are placed first, each one on the thread that has
+the fewest records so far. */
+static
+void
+trx_purge_distribute_groups(
+/*========================*/
+	trx_purge_groups_t*	groups,		/*!< in/out: undo record
+						groups of the batch */
+	ulint*			n_recs,		/*!< out: number of records
+						for each purge thread */
+	ulint			n_purge_threads)/*!< in: number of purge
+						threads */
+{
+	std::vector<trx_purge_groups_t::value_type*>	sorted;
+
+	sorted.reserve(groups->size());
+
+	for (trx_purge_groups_t::iterator it = groups->begin();
+	     it != groups->end();
+	     ++it) {
+
+		sorted.push_back(&*it);
+	}
+
+	std::sort(sorted.begin(), sorted.end(), trx_purge_group_cmp());
+
+	memset(n_recs, 0x0, n_purge_threads * sizeof(*n_recs));
+
+	for (ulint i = 0; i < sorted.size(); ++i) {
+		trx_purge_group_t*	group = &sorted[i]->second;
+		ulint			thr_no = 0;
+
+		for (ulint j = 1; j < n_purge_threads; ++j) {
+			if (n_recs[j] < n_recs[thr_no]) {
+				thr_no = j;
+			}
+		}
+
+		group->thr_no = thr_no;
+		n_recs[thr_no] += group->n_recs;
+	}
+
+	MONITOR_INC_VALUE(MONITOR_PURGE_TABLE_GROUPS, sorted.size());
+}
+
 /*******************************************************************//**
 This function runs a purge batch.
 @return	number of undo log pages handled in the batch */
@@ -975,11 +1048,21 @@ trx_purge_attach_undo_recs(
 	ulint		i = 0;
 	ulint		n_pages_handled = 0;
 	ulint		n_thrs = UT_LIST_GET_LEN(purge_sys->query->thrs);
+	purge_node_t**	nodes;
+	ulint*		n_recs;
 
 	ut_a(n_purge_threads > 0);
 
 	*limit = purge_sys->iter;
 
+	nodes = static_cast<purge_node_t**>(
+		mem_heap_alloc(purge_sys->heap,
+			       n_purge_threads * sizeof(*nodes)));
+
+	n_recs = static_cast<ulint*>(
+		mem_heap_alloc(purge_sys->heap,
+			       n_purge_threads * sizeof(*n_recs)));
+
 	/* Debug code to validate some pre-requisites and reset done flag. */
 	for (thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
 	     thr != NULL && i < n_purge_threads;
@@ -990,38 +1073,36 @@ trx_purge_attach_undo_recs(
 		/* Get the purge node. */
 		node = (purge_node_t*) thr->child;
 
+		ut_a(!thr->is_active);
 		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
 		ut_a(node->undo_recs == NULL);
 		ut_a(node->done);
 
 		node->done = FALSE;
+
+		nodes[i] = node;
 	}
 
 	/* There should never be fewer nodes than threads, the inverse
 	however is allowed because we only use purge threads as needed. */
 	ut_a(i == n_purge_threads);
-
-	/* Fetch and parse the UNDO records. The UNDO records are added
-	to a per purge node vector. */
-	thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
-	ut_a(n_thrs > 0 && thr != NULL);
+	ut_a(n_thrs > 0);
 
 	ut_ad(trx_purge_check_limit());
 
-	i = 0;
+	/* Fetch and parse the UNDO records. The records are copied to
+	purge_sys->heap, which is emptied only when all the purge threads
+	have completed the batch, and grouped by table id. */
+	ib_vector_t*		recs = ib_vector_create(
+		ib_heap_allocator_create(purge_sys->heap),
+		sizeof(trx_purge_rec_t), batch_size);
+	ib_vector_t*		table_ids = ib_vector_create(
+		ib_heap_allocator_create(purge_sys->heap),
+		sizeof(table_id_t), batch_size);
+	trx_purge_groups_t	groups;
 
 	for (;;) {
-		purge_node_t*		node;
-		trx_purge_rec_t*	purge_rec;
-
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
-		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+		trx_purge_rec_t		purge_rec;
 
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
@@ -1034,37 +1115,73 @@ trx_purge_attach_undo_recs(
 		}
 
 		/* Fetch the next record, and advance the purge_sys->iter. */
-		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
-
-		if (purge_rec->undo_rec != NULL) {
-
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
-			}
+		purge_rec.undo_rec = trx_purge_fetch_next_rec(
+			&purge_rec.roll_ptr, &n_pages_handled,
+			purge_sys->heap);
 
-			ib_vector_push(node->undo_recs, purge_rec);
+		if (purge_rec.undo_rec == NULL) {
+			break;
+		}
 
-			if (n_pages_handled >= batch_size) {
+		/* The dummy record does not refer to any table and needs
+		no purging. */
+		if (purge_rec.undo_rec != &trx_purge_dummy_rec) {
+			ulint		type;
+			ulint		cmpl_info;
+			bool		updated_extern;
+			undo_no_t	undo_no;
+			table_id_t	table_id;
+
+			trx_undo_rec_get_pars(
+				purge_rec.undo_rec, &type, &cmpl_info,
+				&updated_extern, &undo_no, &table_id);
+
+			ib_vector_push(recs, &purge_rec);
+			ib_vector_push(table_ids, &table_id);
+
+			++groups[table_id].n_recs;
+		}
+
+		if (n_pages_handled >= batch_size) {
 
-				break;
-			}
-		} else {
 			break;
 		}
+	}
+
+	trx_purge_distribute_groups(&groups, n_recs, n_purge_threads);
+
+	/* Attach the records to the purge nodes in the order they were
+	read from the UNDO logs. */
+	for (i = 0; i < ib_vector_size(recs); ++i) {
+		const table_id_t*	table_id;
+		purge_node_t*		node;
+
+		table_id = static_cast<const table_id_t*>(
+			ib_vector_get(table_ids, i));
+
+		node = nodes[groups[*table_id].thr_no];
+
+		if (node->undo_recs == NULL) {
+			node->undo_recs = ib_vector_create(
+				ib_heap_allocator_create(node->heap),
+				sizeof(trx_purge_rec_t),
+				n_recs[groups[*table_id].thr_no]);
+		}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
+		ib_vector_push(node->undo_recs, ib_vector_get(recs, i));
+	}
+
+	if (!ib_vector_is_empty(recs)) {
+		ulint	n_recs_min = ULINT_MAX;
+		ulint	n_recs_max = 0;
 
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
+		for (i = 0; i < n_purge_threads; ++i) {
+			n_recs_min = ut_min(n_recs_min, n_recs[i]);
+			n_recs_max = ut_max(n_recs_max, n_recs[i]);
 		}
 
-		ut_a(thr != NULL);
+		MONITOR_SET(MONITOR_PURGE_THREAD_RECS_MIN, n_recs_min);
+		MONITOR_SET(MONITOR_PURGE_THREAD_RECS_MAX, n_recs_max);
 	}
 
 	ut_ad(trx_purge_check_limit());
@@ -510,11 +510,15 @@ trx_sys_init_at_db_start(void)
 	mtr_start(&mtr);
 
 	/* Allocate the trx descriptors array */
+	trx_sys->descr_heap = mem_heap_create(
+		sizeof(trx_id_t) * TRX_DESCR_ARRAY_INITIAL_SIZE);
 	trx_sys->descriptors = static_cast<trx_id_t*>(
-		ut_malloc(sizeof(trx_id_t) *
-			  TRX_DESCR_ARRAY_INITIAL_SIZE));
+		mem_heap_alloc(trx_sys->descr_heap,
+			       sizeof(trx_id_t) *
+			       TRX_DESCR_ARRAY_INITIAL_SIZE));
 	trx_sys->descr_n_max = TRX_DESCR_ARRAY_INITIAL_SIZE;
 	trx_sys->descr_n_used = 0;
+	trx_sys->serial_min_no = TRX_ID_MAX;
 	srv_descriptors_memory = TRX_DESCR_ARRAY_INITIAL_SIZE *
 		sizeof(trx_id_t);
 
@@ -1178,12 +1182,12 @@ trx_sys_close(void)
 
 	mutex_enter(&trx_sys->mutex);
 
-	if (UT_LIST_GET_LEN(trx_sys->view_list) > 1) {
+	if (read_view_get_n_open() > 1) {
 		fprintf(stderr,
 			"InnoDB: Error: all read views were not closed"
 			" before shutdown:\n"
 			"InnoDB: %lu read views open \n",
-			UT_LIST_GET_LEN(trx_sys->view_list) - 1);
+			read_view_get_n_open() - 1);
 	}
 
 	mutex_exit(&trx_sys->mutex);
@@ -1238,7 +1242,7 @@ trx_sys_close(void)
 	mutex_free(&trx_sys->mutex);
 
 	ut_ad(trx_sys->descr_n_used == 0);
-	ut_free(trx_sys->descriptors);
+	mem_heap_free(trx_sys->descr_heap);
 
 	mem_free(trx_sys);
 
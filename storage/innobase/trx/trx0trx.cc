@@ -124,6 +124,7 @@ trx_reserve_descriptor(
 	trx_id_t*	descr;
 
 	ut_ad(mutex_own(&trx_sys->mutex) || srv_is_being_started);
+	ut_ad(srv_is_being_started || (trx_sys->descr_version & 1));
 	ut_ad(srv_is_being_started ||
 	      !trx_find_descriptor(trx_sys->descriptors,
 				   trx_sys->descr_n_used,
@@ -136,10 +137,21 @@ trx_reserve_descriptor(
 
 		n_max = n_max * 2;
 
-		trx_sys->descriptors = static_cast<trx_id_t*>(
-			ut_realloc(trx_sys->descriptors,
-				   n_max * sizeof(trx_id_t)));
+		/* read_view_open_now() may be copying the old array
+		without holding trx_sys->mutex. Keep it allocated until
+		shutdown, and make the new array visible before its size,
+		so that the size read by read_view_open_now() never
+		exceeds the array that it reads. */
 
+		descr = static_cast<trx_id_t*>(
+			mem_heap_alloc(trx_sys->descr_heap,
+				       n_max * sizeof(trx_id_t)));
+
+		memcpy(descr, trx_sys->descriptors,
+		       trx_sys->descr_n_used * sizeof(trx_id_t));
+
+		trx_sys->descriptors = descr;
+		os_wmb;
 		trx_sys->descr_n_max = n_max;
 		srv_descriptors_memory = n_max * sizeof(trx_id_t);
 	}
@@ -185,31 +197,49 @@ trx_release_descriptor(
 
 	ut_ad(mutex_own(&trx_sys->mutex));
 
+	descr = trx_find_descriptor(trx_sys->descriptors,
+				    trx_sys->descr_n_used,
+				    trx->id);
+
+	if (UNIV_UNLIKELY(descr == NULL && !trx->in_trx_serial_list)) {
+
+		return;
+	}
+
+	trx_sys_descr_change_begin();
+
 	if (UNIV_LIKELY(trx->in_trx_serial_list)) {
 
 		UT_LIST_REMOVE(trx_serial_list, trx_sys->trx_serial_list,
 			       trx);
 		trx->in_trx_serial_list = false;
-	}
 
-	descr = trx_find_descriptor(trx_sys->descriptors,
-				    trx_sys->descr_n_used,
-				    trx->id);
+		if (UT_LIST_GET_LEN(trx_sys->trx_serial_list) > 0) {
+			trx_sys->serial_min_no = UT_LIST_GET_FIRST(
+				trx_sys->trx_serial_list)->no;
+		} else {
+			trx_sys->serial_min_no = TRX_ID_MAX;
+		}
+	}
 
-	if (UNIV_UNLIKELY(descr == NULL)) {
+	if (UNIV_LIKELY(descr != NULL)) {
 
-		return;
-	}
+		size = (trx_sys->descriptors + trx_sys->descr_n_used - 1
+			- descr) * sizeof(trx_id_t);
 
-	size = (trx_sys->descriptors + trx_sys->descr_n_used - 1 - descr) *
-		sizeof(trx_id_t);
+		if (UNIV_LIKELY(size > 0)) {
 
-	if (UNIV_LIKELY(size > 0)) {
+			ut_memmove(descr, descr + 1, size);
+		}
 
-		ut_memmove(descr, descr + 1, size);
+		trx_sys->descr_n_used--;
 	}
 
-	trx_sys->descr_n_used--;
+	/* Read views opened before this cannot be reused, because they
+	do not see the changes of this transaction. */
+	trx_sys->descr_n_released++;
+
+	trx_sys_descr_change_end();
 }
 
 /****************************************************************//**
@@ -387,10 +417,13 @@ trx_free_low(
 		ib_vector_free(trx->lock.table_locks);
 	}
 
-	mutex_free(&trx->mutex);
-
+	/* Purge may be examining the view under trx->mutex until it
+has been removed from trx_sys->view_list. */
+	read_view_remove(trx->prebuilt_view, false);
 	read_view_free(trx->prebuilt_view);
 
+	mutex_free(&trx->mutex);
+
 	mem_free(trx);
 }
 
@@ -1058,6 +1091,10 @@ trx_start_low(
 
 	trx->state = TRX_STATE_ACTIVE;
 
+	/* The trx id must be allocated and added to the descriptors
+	array atomically for read_view_open_now(). */
+	trx_sys_descr_change_begin();
+
 	trx->id = trx_sys_get_new_trx_id();
 
 	/* Cache the state of fake_changes that transaction will use for
@@ -1097,6 +1134,8 @@ trx_start_low(
 		trx_reserve_descriptor(trx);
 	}
 
+	trx_sys_descr_change_end();
+
 	ut_ad(trx_sys_validate_trx_list());
 
 	mutex_exit(&trx_sys->mutex);
@@ -1122,6 +1161,8 @@ trx_serialisation_number_get(
 
 	mutex_enter(&trx_sys->mutex);
 
+	trx_sys_descr_change_begin();
+
 	trx->no = trx_sys_get_new_trx_id();
 
 	if (UNIV_LIKELY(!trx->in_trx_serial_list)) {
@@ -1132,6 +1173,11 @@ trx_serialisation_number_get(
 		trx->in_trx_serial_list = true;
 	}
 
+	trx_sys->serial_min_no =
+		UT_LIST_GET_FIRST(trx_sys->trx_serial_list)->no;
+
+	trx_sys_descr_change_end();
+
 	/* If the rollack segment is not empty then the
 	new trx_t::no can't be less than any trx_t::no
 	already in the rollback segment. User threads only
@@ -1394,7 +1440,7 @@ trx_commit_in_memory(
 
 		trx->state = TRX_STATE_NOT_STARTED;
 
-		read_view_remove(trx->global_read_view, false);
+		read_view_close(trx->global_read_view, false);
 
 		MONITOR_INC(MONITOR_TRX_NL_RO_COMMIT);
 	} else {
@@ -1431,7 +1477,7 @@ trx_commit_in_memory(
 
 		/* We already own the trx_sys_t::mutex, by doing it here we
 		avoid a potential context switch later. */
-		read_view_remove(trx->global_read_view, true);
+		read_view_close(trx->global_read_view, true);
 
 		ut_ad(trx_sys_validate_trx_list());
 
@@ -1699,7 +1745,7 @@ trx_assign_read_view(
 		return(trx->read_view);
 	}
 
-	trx->read_view = read_view_open_now(trx->id, trx->prebuilt_view);
+	trx->read_view = read_view_open_now(trx);
 	trx->global_read_view = trx->read_view;
 
 	return(trx->read_view);
@@ -1727,10 +1773,7 @@ trx_clone_read_view(
 		return(NULL);
 	}
 
-	trx->read_view = read_view_clone(from_trx->read_view,
-					 trx->prebuilt_view);
-
-	read_view_add(trx->read_view);
+	trx->read_view = read_view_open_clone(trx, from_trx->read_view);
 
 	trx->global_read_view = trx->read_view;
 
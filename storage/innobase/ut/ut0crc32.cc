@@ -177,7 +177,7 @@ for RHEL4 support (GCC 3 doesn't support this instruction) */
 /********************************************************************//**
 Calculates CRC32 using CPU instructions.
 @return CRC-32C (polynomial 0x11EDC6F41) */
-UNIV_INLINE
+UNIV_INTERN
 ib_uint32_t
 ut_crc32_sse42(
 /*===========*/
@@ -216,6 +216,215 @@ ut_crc32_sse42(
 #endif /* defined(__GNUC__) && defined(__x86_64__) */
 }
 
+#if defined(__GNUC__) && defined(__x86_64__)
+/* The crc32 instruction has a latency of three cycles and a throughput of
+one per cycle. Long buffers are processed as three streams that are
+interleaved, and the CRCs of the streams are combined by shifting the
+CRC of the preceding stream over the length of the following one.
+Buffers of at least 3 * UT_CRC32_LONG bytes use long streams; the rest
+is processed in streams of UT_CRC32_SHORT bytes. */
+#define UT_CRC32_LONG	4096
+#define UT_CRC32_SHORT	128
+
+/* Tables for shifting a CRC over UT_CRC32_LONG and UT_CRC32_SHORT zero
+bytes, one byte of the CRC at a time */
+static ib_uint32_t	ut_crc32_shift_long_table[4][256];
+static ib_uint32_t	ut_crc32_shift_short_table[4][256];
+
+/********************************************************************//**
+Multiplies a 32x32 matrix over GF(2) by a vector.
+@return the product */
+static
+ib_uint32_t
+ut_crc32_gf2_matrix_times(
+/*======================*/
+	const ib_uint32_t*	mat,	/*!< in: matrix, one column per bit */
+	ib_uint32_t		vec)	/*!< in: vector */
+{
+	ib_uint32_t	sum = 0;
+
+	for (; vec; vec >>= 1, mat++) {
+		if (vec & 1) {
+			sum ^= *mat;
+		}
+	}
+
+	return(sum);
+}
+
+/********************************************************************//**
+Squares a 32x32 matrix over GF(2). */
+static
+void
+ut_crc32_gf2_matrix_square(
+/*=======================*/
+	ib_uint32_t*		square,	/*!< out: mat * mat */
+	const ib_uint32_t*	mat)	/*!< in: matrix */
+{
+	for (ulint n = 0; n < 32; n++) {
+		square[n] = ut_crc32_gf2_matrix_times(mat, mat[n]);
+	}
+}
+
+/********************************************************************//**
+Initializes a table for shifting a CRC over len zero bytes. */
+static
+void
+ut_crc32_shift_table_init(
+/*======================*/
+	ib_uint32_t	table[4][256],	/*!< out: shift table */
+	ulint		len)		/*!< in: number of bytes, a power
+					of two */
+{
+	ib_uint32_t	even[32];
+	ib_uint32_t	odd[32];
+	ib_uint32_t*	op;
+	ib_uint32_t	row = 1;
+
+	ut_ad(!(len & (len - 1)));
+
+	/* The operator for one zero bit */
+	odd[0] = 0x82f63b78;
+	for (ulint n = 1; n < 32; n++) {
+		odd[n] = row;
+		row <<= 1;
+	}
+
+	/* The operators for two and four zero bits */
+	ut_crc32_gf2_matrix_square(even, odd);
+	ut_crc32_gf2_matrix_square(odd, even);
+
+	/* Square the operator until it shifts over len bytes */
+	for (op = odd;;) {
+		ut_crc32_gf2_matrix_square(even, odd);
+		op = even;
+		len >>= 1;
+
+		if (!len) {
+			break;
+		}
+
+		ut_crc32_gf2_matrix_square(odd, even);
+		op = odd;
+		len >>= 1;
+
+		if (!len) {
+			break;
+		}
+	}
+
+	for (ib_uint32_t n = 0; n < 256; n++) {
+		table[0][n] = ut_crc32_gf2_matrix_times(op, n);
+		table[1][n] = ut_crc32_gf2_matrix_times(op, n << 8);
+		table[2][n] = ut_crc32_gf2_matrix_times(op, n << 16);
+		table[3][n] = ut_crc32_gf2_matrix_times(op, n << 24);
+	}
+}
+
+/********************************************************************//**
+Shifts a CRC over the number of zero bytes of a shift table.
+@return the shifted CRC */
+static inline
+ib_uint64_t
+ut_crc32_shift(
+/*===========*/
+	const ib_uint32_t	table[4][256],	/*!< in: shift table */
+	ib_uint64_t		crc)		/*!< in: CRC */
+{
+	return(table[0][crc & 0xFF]
+	       ^ table[1][(crc >> 8) & 0xFF]
+	       ^ table[2][(crc >> 16) & 0xFF]
+	       ^ table[3][(crc >> 24) & 0xFF]);
+}
+
+/********************************************************************//**
+Calculates CRC32 of three interleaved streams of stream_len bytes each,
+using CPU instructions, and combines them.
+@return the CRC of the three streams, not inverted */
+static inline
+ib_uint64_t
+ut_crc32_sse42_3way(
+/*================*/
+	ib_uint64_t		crc0,	/*!< in: CRC of the preceding data */
+	const byte*		buf,	/*!< in: 8-byte aligned data */
+	ulint			stream_len,
+					/*!< in: UT_CRC32_LONG or
+					UT_CRC32_SHORT */
+	const ib_uint32_t	table[4][256])
+					/*!< in: table for shifting over
+					stream_len bytes */
+{
+	ib_uint64_t	crc1 = 0;
+	ib_uint64_t	crc2 = 0;
+	const byte*	end = buf + stream_len;
+
+	do {
+		asm("crc32q %3, %0\n\t"
+		    "crc32q %4, %1\n\t"
+		    "crc32q %5, %2"
+		    : "+r" (crc0), "+r" (crc1), "+r" (crc2)
+		    : "m" (*(const ib_uint64_t*) buf),
+		      "m" (*(const ib_uint64_t*) (buf + stream_len)),
+		      "m" (*(const ib_uint64_t*) (buf + 2 * stream_len)));
+		buf += 8;
+	} while (buf < end);
+
+	crc0 = ut_crc32_shift(table, crc0) ^ crc1;
+
+	return(ut_crc32_shift(table, crc0) ^ crc2);
+}
+#endif /* defined(__GNUC__) && defined(__x86_64__) */
+
+/********************************************************************//**
+Calculates CRC32 using CPU instructions, interleaving three streams of
+crc32 instructions over long buffers.
+@return CRC-32C (polynomial 0x11EDC6F41) */
+UNIV_INTERN
+ib_uint32_t
+ut_crc32_sse42_interleaved(
+/*=======================*/
+	const byte*	buf,	/*!< in: data over which to calculate CRC32 */
+	ulint		len)	/*!< in: data length */
+{
+#if defined(__GNUC__) && defined(__x86_64__)
+	ib_uint64_t	crc = (ib_uint32_t) (-1);
+
+	ut_a(ut_crc32_sse2_enabled);
+
+	while (len && ((ulint) buf & 7)) {
+		ut_crc32_sse42_byte;
+	}
+
+	while (len >= 3 * UT_CRC32_LONG) {
+		crc = ut_crc32_sse42_3way(crc, buf, UT_CRC32_LONG,
+					  ut_crc32_shift_long_table);
+		buf += 3 * UT_CRC32_LONG;
+		len -= 3 * UT_CRC32_LONG;
+	}
+
+	while (len >= 3 * UT_CRC32_SHORT) {
+		crc = ut_crc32_sse42_3way(crc, buf, UT_CRC32_SHORT,
+					  ut_crc32_shift_short_table);
+		buf += 3 * UT_CRC32_SHORT;
+		len -= 3 * UT_CRC32_SHORT;
+	}
+
+	while (len >= 8) {
+		ut_crc32_sse42_quadword;
+	}
+
+	while (len) {
+		ut_crc32_sse42_byte;
+	}
+
+	return((ib_uint32_t) ((~crc) & 0xFFFFFFFF));
+#else
+	ut_error;
+	/* silence compiler warning about unused parameters */
+	return((ib_uint32_t) buf[len]);
+#endif /* defined(__GNUC__) && defined(__x86_64__) */
+}
+
 #define ut_crc32_slice8_byte \
 	crc = (crc >> 8) ^ ut_crc32_slice8_table[0][(crc ^ *buf++) & 0xFF]; \
 	len--
@@ -235,7 +444,7 @@ ut_crc32_sse42(
 /********************************************************************//**
 Calculates CRC32 manually.
 @return CRC-32C (polynomial 0x11EDC6F41) */
-UNIV_INLINE
+UNIV_INTERN
 ib_uint32_t
 ut_crc32_slice8(
 /*============*/
@@ -309,10 +518,17 @@ ut_crc32_init()
 
 #endif /* defined(__GNUC__) && defined(__x86_64__) */
 
+	ut_crc32_slice8_table_init();
+
 	if (ut_crc32_sse2_enabled) {
-		ut_crc32 = ut_crc32_sse42;
+#if defined(__GNUC__) && defined(__x86_64__)
+		ut_crc32_shift_table_init(ut_crc32_shift_long_table,
+					  UT_CRC32_LONG);
+		ut_crc32_shift_table_init(ut_crc32_shift_short_table,
+					  UT_CRC32_SHORT);
+#endif /* defined(__GNUC__) && defined(__x86_64__) */
+		ut_crc32 = ut_crc32_sse42_interleaved;
 	} else {
-		ut_crc32_slice8_table_init();
 		ut_crc32 = ut_crc32_slice8;
 	}
 }
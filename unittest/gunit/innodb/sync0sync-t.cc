@@ -0,0 +1,220 @@
+/* Copyright (c) 2016, Percona Inc. All Rights Reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+#include <gtest/gtest.h>
+
+#include "thread_utils.h"
+
+#include "univ.i"
+#include "os0sync.h"
+#include "srv0srv.h"
+#include "sync0rw.h"
+#include "sync0sync.h"
+#include "ut0mem.h"
+
+#include <stdio.h>
+
+namespace sync0sync_unittest {
+
+/*
+  Runs threads that take the same mutex or rw-lock in a loop, checks that
+  the latch keeps them from entering the critical section together, and
+  prints the time per acquisition and the number of OS waits.
+  Build InnoDB with and without -DWITH_INNODB_FUTEX=ON to compare the
+  waits on the futex in the latch with the waits in the sync array.
+ */
+class LatchTest : public ::testing::Test
+{
+protected:
+  // Increase num_iterations for actual benchmarking!
+  static const ulint num_iterations= 20000;
+  static const ulint max_threads= 16;
+
+  static void SetUpTestCase()
+  {
+    srv_max_n_threads= 1000;
+    ut_mem_init();
+    os_sync_init();
+    sync_init();
+  }
+
+  static void TearDownTestCase()
+  {
+    sync_close();
+    ut_free_all_mem();
+  }
+
+  static void report(const char *latch, ulint n_threads, ulonglong start,
+                     ulint os_waits)
+  {
+    ulonglong usec= my_micro_time() - start;
+
+    printf("%s, %s, %2lu threads: %6.3f usec per acquisition,"
+           " %lu OS waits\n",
+#ifdef HAVE_IB_LINUX_FUTEX
+           "futex",
+#else
+           "sync array",
+#endif /* HAVE_IB_LINUX_FUTEX */
+           latch, n_threads,
+           static_cast<double>(usec) / (n_threads * num_iterations),
+           os_waits);
+  }
+};
+
+
+class Mutex_thread : public thread::Thread
+{
+public:
+  Mutex_thread(ib_mutex_t *mutex, ulint n_iterations, ulint *counter)
+    : m_mutex(mutex), m_iterations(n_iterations), m_counter(counter)
+  {}
+
+  virtual void run()
+  {
+    for (ulint i= 0; i < m_iterations; ++i)
+    {
+      mutex_enter(m_mutex);
+      // Not atomic: a lost update means that the mutex failed.
+      *m_counter= *m_counter + 1;
+      mutex_exit(m_mutex);
+    }
+  }
+
+private:
+  ib_mutex_t *m_mutex;
+  ulint m_iterations;
+  ulint *m_counter;
+};
+
+
+/*
+  Takes the rw-lock in exclusive mode every fourth time and in shared mode
+  otherwise. The exclusive holders modify the two counters, and the shared
+  holders check that they never see them differ.
+ */
+class Rw_lock_thread : public thread::Thread
+{
+public:
+  Rw_lock_thread(rw_lock_t *lock, ulint n_iterations, ulint *counter,
+                 ulint *shadow)
+    : m_lock(lock), m_iterations(n_iterations), m_counter(counter),
+      m_shadow(shadow), m_torn_reads(0)
+  {}
+
+  virtual void run()
+  {
+    for (ulint i= 0; i < m_iterations; ++i)
+    {
+      if (i % 4 == 0)
+      {
+        rw_lock_x_lock(m_lock);
+        *m_counter= *m_counter + 1;
+        *m_shadow= *m_shadow + 1;
+        rw_lock_x_unlock(m_lock);
+      }
+      else
+      {
+        rw_lock_s_lock(m_lock);
+        if (*m_counter != *m_shadow)
+          ++m_torn_reads;
+        rw_lock_s_unlock(m_lock);
+      }
+    }
+  }
+
+  ulint torn_reads() const { return m_torn_reads; }
+
+private:
+  rw_lock_t *m_lock;
+  ulint m_iterations;
+  ulint *m_counter;
+  ulint *m_shadow;
+  ulint m_torn_reads;
+};
+
+
+TEST_F(LatchTest, Mutex)
+{
+  for (ulint n_threads= 1; n_threads <= max_threads; n_threads*= 2)
+  {
+    ib_mutex_t mutex;
+    ulint counter= 0;
+    Mutex_thread *threads[max_threads];
+
+    mutex_create(PFS_NOT_INSTRUMENTED, &mutex, SYNC_NO_ORDER_CHECK);
+
+    ulonglong start= my_micro_time();
+
+    for (ulint i= 0; i < n_threads; ++i)
+    {
+      threads[i]= new Mutex_thread(&mutex, num_iterations, &counter);
+      threads[i]->start();
+    }
+    for (ulint i= 0; i < n_threads; ++i)
+    {
+      threads[i]->join();
+      delete threads[i];
+    }
+
+    report("mutex", n_threads, start, mutex.count_os_wait);
+
+    EXPECT_EQ(n_threads * num_iterations, counter);
+
+    mutex_free(&mutex);
+  }
+}
+
+
+TEST_F(LatchTest, RwLock)
+{
+  for (ulint n_threads= 1; n_threads <= max_threads; n_threads*= 2)
+  {
+    rw_lock_t lock;
+    ulint counter= 0;
+    ulint shadow= 0;
+    ulint torn_reads= 0;
+    Rw_lock_thread *threads[max_threads];
+
+    rw_lock_create(PFS_NOT_INSTRUMENTED, &lock, SYNC_NO_ORDER_CHECK);
+
+    ulonglong start= my_micro_time();
+
+    for (ulint i= 0; i < n_threads; ++i)
+    {
+      threads[i]= new Rw_lock_thread(&lock, num_iterations,
+                                     &counter, &shadow);
+      threads[i]->start();
+    }
+    for (ulint i= 0; i < n_threads; ++i)
+    {
+      threads[i]->join();
+      torn_reads+= threads[i]->torn_reads();
+      delete threads[i];
+    }
+
+    report("rw-lock", n_threads, start, lock.count_os_wait);
+
+    EXPECT_EQ(n_threads * ((num_iterations + 3) / 4), counter);
+    EXPECT_EQ(counter, shadow);
+    EXPECT_EQ(0U, torn_reads);
+
+    rw_lock_free(&lock);
+  }
+}
+
+}
@@ -0,0 +1,119 @@
+/* Copyright (c) 2016, Percona Inc. All Rights Reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+#include <gtest/gtest.h>
+
+#include "univ.i"
+#include "ut0crc32.h"
+
+#include <stdlib.h>
+
+namespace ut0crc32_unittest {
+
+/*
+  Tests that the CRC32 implementations agree, and compares their
+  performance on the buffer sizes of pages and page groups.
+  The interleaved SSE 4.2 implementation is expected to be the fastest
+  one for buffers of 16K and more.
+ */
+class Crc32Test : public ::testing::Test
+{
+protected:
+  // Increase num_iterations for actual benchmarking!
+  static const int num_iterations= 1;
+  static const ulint max_len= 64 * 1024;
+
+  static byte *data;
+
+  static void SetUpTestCase()
+  {
+    ut_crc32_init();
+    // Room for the misaligned buffers below.
+    data= static_cast<byte*>(malloc(max_len + 16));
+    srand(0);
+    for (ulint ix= 0; ix < max_len + 16; ++ix)
+      data[ix]= static_cast<byte>(rand());
+  }
+
+  static void TearDownTestCase()
+  {
+    free(data);
+    data= NULL;
+  }
+
+  static void benchmark(ib_ut_crc32_t crc32, ulint len)
+  {
+    ib_uint32_t sum= 0;
+    for (int iter= 0; iter < num_iterations; ++iter)
+    {
+      for (ulint offset= 0; offset + len <= max_len; offset+= len)
+        sum^= crc32(data + offset, len);
+    }
+    // Do not let the compiler optimize the calls away.
+    EXPECT_NE(0U, sum + 1);
+  }
+};
+
+byte *Crc32Test::data= NULL;
+
+TEST_F(Crc32Test, AllAlgorithmsAgree)
+{
+  if (!ut_crc32_sse2_enabled)
+    return;
+
+  for (ulint offset= 0; offset < 16; ++offset)
+  {
+    for (ulint len= 0; len + offset <= max_len;
+         len+= (len < 2048) ? 1 : 509)
+    {
+      const byte *buf= data + offset;
+      const ib_uint32_t expected= ut_crc32_slice8(buf, len);
+      EXPECT_EQ(expected, ut_crc32_sse42(buf, len))
+        << "offset " << offset << " length " << len;
+      EXPECT_EQ(expected, ut_crc32_sse42_interleaved(buf, len))
+        << "offset " << offset << " length " << len;
+    }
+  }
+}
+
+TEST_F(Crc32Test, KnownValue)
+{
+  // The CRC-32C check value of "123456789".
+  const byte check[]= "123456789";
+  EXPECT_EQ(0xE3069283U, ut_crc32_slice8(check, 9));
+  EXPECT_EQ(0xE3069283U, ut_crc32(check, 9));
+}
+
+#define CRC32_BENCHMARK(name, crc32, requires_sse42, len)       \
+  TEST_F(Crc32Test, name)                                       \
+  {                                                             \
+    if (requires_sse42 && !ut_crc32_sse2_enabled)               \
+      return;                                                   \
+    benchmark(crc32, len);                                      \
+  }
+
+CRC32_BENCHMARK(Slice8_4K, ut_crc32_slice8, false, 4096)
+CRC32_BENCHMARK(Slice8_16K, ut_crc32_slice8, false, 16384)
+CRC32_BENCHMARK(Slice8_64K, ut_crc32_slice8, false, 65536)
+CRC32_BENCHMARK(Sse42_4K, ut_crc32_sse42, true, 4096)
+CRC32_BENCHMARK(Sse42_16K, ut_crc32_sse42, true, 16384)
+CRC32_BENCHMARK(Sse42_64K, ut_crc32_sse42, true, 65536)
+CRC32_BENCHMARK(Interleaved_4K, ut_crc32_sse42_interleaved, true, 4096)
+CRC32_BENCHMARK(Interleaved_16K, ut_crc32_sse42_interleaved, true, 16384)
+CRC32_BENCHMARK(Interleaved_64K, ut_crc32_sse42_interleaved, true, 65536)
+
+}